@@ -0,0 +1,170 @@
+#include "MeshCache.hpp"
+
+#include "Utilities/Log.hpp"
+
+#include <fstream>
+#include <filesystem>
+
+namespace Assets
+{
+    static const uint32_t MESH_CACHE_MAGIC = 0x4853454D; // "MESH"
+    // 格式或烘焙参数（meshlet 大小等）变化时需要递增
+    static const uint32_t MESH_CACHE_VERSION = 2;
+    static const uint64_t MESH_CACHE_ALIGNMENT = 16;
+
+    static inline uint64_t AlignOffset(uint64_t offset)
+    {
+        return (offset + MESH_CACHE_ALIGNMENT - 1) & ~(MESH_CACHE_ALIGNMENT - 1);
+    }
+
+    struct FMeshCacheHeader
+    {
+        uint32_t Magic;
+        uint32_t Version;
+        uint64_t SourceHash;
+        uint32_t MeshCount;
+        uint32_t _Padding;
+        uint64_t FileSize;
+    };
+
+    void FBakedMeshData::SetStream(EBakedMeshStream stream, const void *data, uint32_t size, uint32_t stride)
+    {
+        Streams[(uint32_t)stream].assign((const uint8_t*)data, (const uint8_t*)data + size);
+        Desc.Streams[(uint32_t)stream].Size = size;
+        Desc.Streams[(uint32_t)stream].Stride = stride;
+    }
+
+    void FMeshCacheWriter::AddMesh(FBakedMeshData &&mesh)
+    {
+        for (size_t i = 0; i < m_Meshes.size(); i++)
+        {
+            if (m_Meshes[i].Desc.MeshIndex == mesh.Desc.MeshIndex && m_Meshes[i].Desc.PrimitiveIndex == mesh.Desc.PrimitiveIndex)
+            {
+                return;
+            }
+        }
+        m_Meshes.push_back(eastl::move(mesh));
+    }
+
+    bool FMeshCacheWriter::Save(const eastl::string &file, uint64_t sourceHash) const
+    {
+        eastl::vector<FBakedMesh> meshes;
+        meshes.reserve(m_Meshes.size());
+
+        uint64_t offset = AlignOffset(sizeof(FMeshCacheHeader) + sizeof(FBakedMesh) * m_Meshes.size());
+        for (size_t i = 0; i < m_Meshes.size(); i++)
+        {
+            FBakedMesh mesh = m_Meshes[i].Desc;
+            for (uint32_t s = 0; s < (uint32_t)EBakedMeshStream::Count; s++)
+            {
+                mesh.Streams[s].Offset = offset;
+                offset = AlignOffset(offset + mesh.Streams[s].Size);
+            }
+            meshes.push_back(mesh);
+        }
+
+        FMeshCacheHeader header {};
+        header.Magic = MESH_CACHE_MAGIC;
+        header.Version = MESH_CACHE_VERSION;
+        header.SourceHash = sourceHash;
+        header.MeshCount = (uint32_t)meshes.size();
+        header.FileSize = offset;
+
+        std::filesystem::path path(file.c_str());
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+
+        std::filesystem::path tempPath = path;
+        tempPath += ".tmp";
+
+        std::ofstream os(tempPath, std::ios::binary | std::ios::trunc);
+        if (os.fail())
+        {
+            VTNA_LOG_ERROR("[MeshCache] Failed to write {}", tempPath.string());
+            return false;
+        }
+
+        const char zeros[MESH_CACHE_ALIGNMENT] = {};
+        auto pad = [&]()
+        {
+            uint64_t position = (uint64_t)os.tellp();
+            os.write(zeros, AlignOffset(position) - position);
+        };
+
+        os.write((const char*)&header, sizeof(header));
+        os.write((const char*)meshes.data(), sizeof(FBakedMesh) * meshes.size());
+        pad();
+        for (size_t i = 0; i < m_Meshes.size(); i++)
+        {
+            for (uint32_t s = 0; s < (uint32_t)EBakedMeshStream::Count; s++)
+            {
+                os.write((const char*)m_Meshes[i].Streams[s].data(), m_Meshes[i].Streams[s].size());
+                pad();
+            }
+        }
+        os.close();
+
+        std::filesystem::rename(tempPath, path, ec);
+        if (ec)
+        {
+            VTNA_LOG_ERROR("[MeshCache] Failed to write {}", file);
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+        return true;
+    }
+
+    bool FMeshCacheReader::Open(const eastl::string &file, uint64_t sourceHash)
+    {
+        if (!m_File.Open(file))
+        {
+            return false;
+        }
+
+        const FMeshCacheHeader* header = (const FMeshCacheHeader*)m_File.GetData();
+        bool valid = m_File.GetSize() >= sizeof(FMeshCacheHeader) &&
+            header->Magic == MESH_CACHE_MAGIC &&
+            header->Version == MESH_CACHE_VERSION &&
+            header->SourceHash == sourceHash &&
+            header->FileSize == m_File.GetSize() &&
+            sizeof(FMeshCacheHeader) + sizeof(FBakedMesh) * (uint64_t)header->MeshCount <= m_File.GetSize();
+
+        m_pMeshes = (const FBakedMesh*)((const char*)m_File.GetData() + sizeof(FMeshCacheHeader));
+        m_MeshCount = valid ? header->MeshCount : 0;
+
+        for (uint32_t i = 0; i < m_MeshCount && valid; i++)
+        {
+            for (uint32_t s = 0; s < (uint32_t)EBakedMeshStream::Count; s++)
+            {
+                const FBakedMeshStream& stream = m_pMeshes[i].Streams[s];
+                valid &= stream.Offset + stream.Size <= m_File.GetSize();
+            }
+        }
+
+        if (!valid)
+        {
+            m_File.Close();
+            m_pMeshes = nullptr;
+            m_MeshCount = 0;
+            return false;
+        }
+        return true;
+    }
+
+    const FBakedMesh *FMeshCacheReader::FindMesh(uint32_t meshIndex, uint32_t primitiveIndex) const
+    {
+        for (uint32_t i = 0; i < m_MeshCount; i++)
+        {
+            if (m_pMeshes[i].MeshIndex == meshIndex && m_pMeshes[i].PrimitiveIndex == primitiveIndex)
+            {
+                return &m_pMeshes[i];
+            }
+        }
+        return nullptr;
+    }
+
+    const void *FMeshCacheReader::GetStreamData(const FBakedMesh &mesh, EBakedMeshStream stream) const
+    {
+        return (const char*)m_File.GetData() + mesh.Streams[(uint32_t)stream].Offset;
+    }
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Utilities/Math.hpp"
+#include "Utilities/MappedFile.hpp"
+
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+namespace Assets
+{
+    enum class EBakedMeshStream : uint32_t
+    {
+        Index,
+        Position,
+        TexCoord,
+        Normal,
+        Tangent,
+        MeshletBounds,
+        MeshletVertices,
+        MeshletIndices,
+        Count,
+    };
+
+    // 与 shader 中的 meshlet 结构保持一致
+    struct FMeshletBound
+    {
+        float3 Center;
+        float Radius;
+
+        union
+        {
+            struct
+            {
+                int8_t AxisX;
+                int8_t AxisY;
+                int8_t AxisZ;
+                int8_t Cutoff;
+            };
+            uint32_t Cone;
+        };
+
+        uint VertexCount;
+        uint TriangleCount;
+
+        uint vertexOffset;
+        uint triangleOffset;
+
+        // 产生该 meshlet 的简化组，以及它继续被简化时所在组的包围球和误差（世界单位）
+        float3 LodCenter;
+        float LodRadius;
+        float3 ParentLodCenter;
+        float ParentLodRadius;
+        float LodError;
+        float ParentLodError;
+    };
+
+    struct FBakedMeshStream
+    {
+        uint64_t Offset = 0;
+        uint32_t Size = 0;
+        uint32_t Stride = 0;
+    };
+
+    // 文件中的每个 primitive 描述，数据段按 16 字节对齐，可以直接从映射内存上传
+    struct FBakedMesh
+    {
+        uint32_t MeshIndex = 0;
+        uint32_t PrimitiveIndex = 0;
+        float3 Center = float3(0.0f);
+        float Radius = 0.0f;
+        uint32_t IndexCount = 0;
+        uint32_t VertexCount = 0;
+        uint32_t MeshletCount = 0;
+        uint32_t _Padding = 0;
+        FBakedMeshStream Streams[(uint32_t)EBakedMeshStream::Count];
+    };
+
+    struct FBakedMeshData
+    {
+        FBakedMesh Desc;
+        eastl::vector<uint8_t> Streams[(uint32_t)EBakedMeshStream::Count];
+
+        void SetStream(EBakedMeshStream stream, const void* data, uint32_t size, uint32_t stride);
+        const void* GetStreamData(EBakedMeshStream stream) const { return Streams[(uint32_t)stream].data(); }
+    };
+
+    class FMeshCacheWriter
+    {
+    public:
+        // 同一个 mesh 被多个节点引用时只保留一份
+        void AddMesh(FBakedMeshData&& mesh);
+        bool Save(const eastl::string& file, uint64_t sourceHash) const;
+
+    private:
+        eastl::vector<FBakedMeshData> m_Meshes;
+    };
+
+    class FMeshCacheReader
+    {
+    public:
+        // 源文件 hash 或版本不一致时返回 false，调用方应重新烘焙
+        bool Open(const eastl::string& file, uint64_t sourceHash);
+
+        const FBakedMesh* FindMesh(uint32_t meshIndex, uint32_t primitiveIndex) const;
+        const void* GetStreamData(const FBakedMesh& mesh, EBakedMeshStream stream) const;
+
+    private:
+        Utility::FMappedFile m_File;
+        const FBakedMesh* m_pMeshes = nullptr;
+        uint32_t m_MeshCount = 0;
+    };
+}
@@ -1,6 +1,7 @@
 #include "MeshMaterial.hpp"
 #include "ResourceCache.hpp"
 #include "Core/VultanaEngine.hpp"
+#include "Renderer/TextureStreamer.hpp"
 
 namespace Assets
 {
@@ -31,8 +32,13 @@ namespace Assets
             if (m_bAlphaTest) defines.push_back("ALPHA_TEST=1");
 
             RHI::FRHIGraphicsPipelineStateDesc psoDesc {};
-            psoDesc.VS = pRenderer->GetShader("Model.hlsl", "VSMain", RHI::ERHIShaderType::VS, defines);
-            psoDesc.PS = pRenderer->GetShader("Model.hlsl", "PSMain", RHI::ERHIShaderType::PS, defines);
+            psoDesc.VS = pRenderer->GetShaderAsync("Model.hlsl", "VSMain", RHI::ERHIShaderType::VS, defines);
+            psoDesc.PS = pRenderer->GetShaderAsync("Model.hlsl", "PSMain", RHI::ERHIShaderType::PS, defines);
+            if (psoDesc.VS == nullptr || psoDesc.PS == nullptr)
+            {
+                // shader 仍在后台编译，本帧先跳过绘制
+                return nullptr;
+            }
             psoDesc.RasterizerState.CullMode = m_bDoubleSided ? RHI::ERHICullMode::None : RHI::ERHICullMode::Back;
             psoDesc.RasterizerState.bFrontCCW = m_bFrontFaceCCW;
             psoDesc.DepthStencilState.bDepthTest = true;
@@ -62,8 +68,12 @@ namespace Assets
             if (m_bAlphaTest) defines.push_back("ALPHA_TEST=1");
 
             RHI::FRHIGraphicsPipelineStateDesc psoDesc {};
-            psoDesc.VS = pRenderer->GetShader("ModelID.hlsl", "VSMain", RHI::ERHIShaderType::VS, defines);
-            psoDesc.PS = pRenderer->GetShader("ModelID.hlsl", "PSMain", RHI::ERHIShaderType::PS, defines);
+            psoDesc.VS = pRenderer->GetShaderAsync("ModelID.hlsl", "VSMain", RHI::ERHIShaderType::VS, defines);
+            psoDesc.PS = pRenderer->GetShaderAsync("ModelID.hlsl", "PSMain", RHI::ERHIShaderType::PS, defines);
+            if (psoDesc.VS == nullptr || psoDesc.PS == nullptr)
+            {
+                return nullptr;
+            }
             psoDesc.RasterizerState.CullMode = m_bDoubleSided ? RHI::ERHICullMode::None : RHI::ERHICullMode::Back;
             psoDesc.RasterizerState.bFrontCCW = m_bFrontFaceCCW;
             psoDesc.DepthStencilState.bDepthTest = true;
@@ -89,8 +99,12 @@ namespace Assets
             if (m_bAlphaTest) defines.push_back("ALPHA_TEST=1");
 
             RHI::FRHIGraphicsPipelineStateDesc psoDesc {};
-            psoDesc.VS = pRenderer->GetShader("ModelOutline.hlsl", "VSMain", RHI::ERHIShaderType::VS, defines);
-            psoDesc.PS = pRenderer->GetShader("ModelOutline.hlsl", "PSMain", RHI::ERHIShaderType::PS, defines);
+            psoDesc.VS = pRenderer->GetShaderAsync("ModelOutline.hlsl", "VSMain", RHI::ERHIShaderType::VS, defines);
+            psoDesc.PS = pRenderer->GetShaderAsync("ModelOutline.hlsl", "PSMain", RHI::ERHIShaderType::PS, defines);
+            if (psoDesc.VS == nullptr || psoDesc.PS == nullptr)
+            {
+                return nullptr;
+            }
             psoDesc.RasterizerState.CullMode = RHI::ERHICullMode::Front;
             psoDesc.RasterizerState.bFrontCCW = m_bFrontFaceCCW;
             psoDesc.DepthStencilState.bDepthTest = true;
@@ -114,9 +128,13 @@ namespace Assets
             AddMaterialDefines(defines);
 
             RHI::FRHIMeshShadingPipelineStateDesc psoDesc {};
-            psoDesc.AS = pRenderer->GetShader("MeshletCulling.hlsl", "ASMain", RHI::ERHIShaderType::AS, defines);
-            psoDesc.MS = pRenderer->GetShader("ModelMeshlet.hlsl", "MSMain", RHI::ERHIShaderType::MS, defines);
-            psoDesc.PS = pRenderer->GetShader("Model.hlsl", "PSMain", RHI::ERHIShaderType::PS, defines);
+            psoDesc.AS = pRenderer->GetShaderAsync("MeshletCulling.hlsl", "ASMain", RHI::ERHIShaderType::AS, defines);
+            psoDesc.MS = pRenderer->GetShaderAsync("ModelMeshlet.hlsl", "MSMain", RHI::ERHIShaderType::MS, defines);
+            psoDesc.PS = pRenderer->GetShaderAsync("Model.hlsl", "PSMain", RHI::ERHIShaderType::PS, defines);
+            if (psoDesc.AS == nullptr || psoDesc.MS == nullptr || psoDesc.PS == nullptr)
+            {
+                return nullptr;
+            }
             psoDesc.RasterizerState.CullMode = m_bDoubleSided ? RHI::ERHICullMode::None : RHI::ERHICullMode::Back;
             psoDesc.RasterizerState.bFrontCCW = m_bFrontFaceCCW;
             psoDesc.DepthStencilState.bDepthTest = true;
@@ -146,8 +164,46 @@ namespace Assets
         return m_pVertexSkinningPSO;
     }
 
+    static void UpdateTextureInfo(FMaterialTextureInfo& info, const RenderResources::FTexture2D* texture, Renderer::ETexturePlaceholder placeholder)
+    {
+        if (texture == nullptr)
+        {
+            return;
+        }
+
+        if (!texture->IsResident())
+        {
+            Renderer::FRendererBase* pRenderer = Core::FVultanaEngine::GetEngineInstance()->GetRenderer();
+            texture = pRenderer->GetTextureStreamer()->GetPlaceholder(placeholder);
+        }
+        info.Index = texture->GetSRV()->GetHeapIndex();
+        info.Width = texture->GetTexture()->GetDesc().Width;
+        info.Height = texture->GetTexture()->GetDesc().Height;
+    }
+
+    uint32_t FMeshMaterial::GetResidentTextureCount() const
+    {
+        const RenderResources::FTexture2D* textures[] = { m_pAlbedoTexture, m_pMetallicRoughTexture, m_pNormalTexture, m_pEmissiveTexture, m_pAOTexture, m_pDiffuseTexture, m_pSpecularGlossinessTexture };
+
+        uint32_t count = 0;
+        for (uint32_t i = 0; i < sizeof(textures) / sizeof(textures[0]); i++)
+        {
+            count += textures[i] && textures[i]->IsResident() ? 1 : 0;
+        }
+        return count;
+    }
+
     void FMeshMaterial::UpdateConstants()
     {
+        UpdateTextureInfo(m_MaterialCB.AlbedoTexture, m_pAlbedoTexture, Renderer::ETexturePlaceholder::White);
+        UpdateTextureInfo(m_MaterialCB.MetallicRoughnessTexture, m_pMetallicRoughTexture, Renderer::ETexturePlaceholder::White);
+        UpdateTextureInfo(m_MaterialCB.NormalTexture, m_pNormalTexture, Renderer::ETexturePlaceholder::FlatNormal);
+        UpdateTextureInfo(m_MaterialCB.EmissiveTexture, m_pEmissiveTexture, Renderer::ETexturePlaceholder::Black);
+        UpdateTextureInfo(m_MaterialCB.AmbientOcclusionTexture, m_pAOTexture, Renderer::ETexturePlaceholder::White);
+        UpdateTextureInfo(m_MaterialCB.DiffuseTexture, m_pDiffuseTexture, Renderer::ETexturePlaceholder::White);
+        UpdateTextureInfo(m_MaterialCB.SpecularGlossinessTexture, m_pSpecularGlossinessTexture, Renderer::ETexturePlaceholder::White);
+        m_ResidentTextureCount = GetResidentTextureCount();
+
         m_MaterialCB.ShadingModel = (uint)m_ShadingModel;
         m_MaterialCB.Albedo = m_AlbedoColor;
         m_MaterialCB.Emissive = m_EmissiveColor;
@@ -160,8 +216,10 @@ namespace Assets
 
         m_MaterialCB.bPBRMetallicRoughness = m_WorkFlow == MaterialWorkFlow::PBRMetallicRoughness;
         m_MaterialCB.bPBRSpecularGlossiness = m_WorkFlow == MaterialWorkFlow::PBRSpecularGlossiness;
-        m_MaterialCB.bRGNormalTexture = m_pNormalTexture && (m_pNormalTexture->GetTexture()->GetDesc().Format == RHI::ERHIFormat::BC5UNORM);
+        m_MaterialCB.bRGNormalTexture = m_pNormalTexture && m_pNormalTexture->IsResident() && (m_pNormalTexture->GetTexture()->GetDesc().Format == RHI::ERHIFormat::BC5UNORM);
         m_MaterialCB.bDoubleSided = m_bDoubleSided;
+
+        m_bConstantsDirty = false;
     }
 
     void FMeshMaterial::OnGUI()
@@ -218,7 +276,7 @@ namespace Assets
         if (m_pNormalTexture)
         {
             defines.push_back("NORMAL_TEXTURE=1");
-            if (m_pNormalTexture->GetTexture()->GetDesc().Format == RHI::ERHIFormat::BC5UNORM)
+            if (m_pNormalTexture->IsResident() && m_pNormalTexture->GetTexture()->GetDesc().Format == RHI::ERHIFormat::BC5UNORM)
             {
                 defines.push_back("RG_NORMAL_TEXTURE=1");
             }
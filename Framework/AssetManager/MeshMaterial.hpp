@@ -25,6 +25,7 @@ namespace Assets
     public:
         ~FMeshMaterial();
 
+        // 以下 PSO 的 shader 在后台编译，尚未就绪时返回 nullptr
         RHI::FRHIPipelineState* GetPSO();
         RHI::FRHIPipelineState* GetIDPSO();
         RHI::FRHIPipelineState* GetOutlinePSO();
@@ -35,6 +36,8 @@ namespace Assets
 
         void UpdateConstants();
         const FModelMaterialConstants* GetMaterialConstants() const { return &m_MaterialCB; }
+        // 参数只在加载时设置，首次使用时上传；流式纹理驻留后需要重新上传，把描述符从占位纹理切换过去
+        bool IsConstantsDirty() const { return m_bConstantsDirty || GetResidentTextureCount() != m_ResidentTextureCount; }
         void OnGUI();
 
         bool IsFrontFaceCCW() const { return m_bFrontFaceCCW; }
@@ -45,6 +48,7 @@ namespace Assets
 
     private:
         void AddMaterialDefines(eastl::vector<eastl::string>& defines);
+        uint32_t GetResidentTextureCount() const;
 
     private:
         eastl::string m_Name;
@@ -84,6 +88,8 @@ namespace Assets
         bool m_bFrontFaceCCW = false;
         bool m_bDoubleSided = false;
         bool m_bPBRSpecularGlossiness = false;
+        bool m_bConstantsDirty = true;
+        uint32_t m_ResidentTextureCount = 0;
 
         MaterialWorkFlow m_WorkFlow = MaterialWorkFlow::PBRMetallicRoughness;
     };
@@ -0,0 +1,210 @@
+#include "MeshletLod.hpp"
+
+#include <EASTL/algorithm.h>
+#include <meshoptimizer.h>
+
+#include <cfloat>
+
+namespace Assets
+{
+    // 根节点的父误差为无穷大，任何距离下都不会被替换
+    static const float ROOT_PARENT_LOD_ERROR = FLT_MAX;
+
+#if MESHOPTIMIZER_VERSION >= 210
+    // Sparse 模式只访问组内顶点，此时误差相对于组的包围盒而不是整个 mesh
+    static const unsigned int SIMPLIFY_OPTIONS = meshopt_SimplifyLockBorder | meshopt_SimplifySparse;
+    static const bool SIMPLIFY_ERROR_RELATIVE_TO_GROUP = true;
+#else
+    static const unsigned int SIMPLIFY_OPTIONS = meshopt_SimplifyLockBorder;
+    static const bool SIMPLIFY_ERROR_RELATIVE_TO_GROUP = false;
+#endif
+
+    static float ComputeExtent(const uint32_t* indices, size_t indexCount, const float* positions, size_t positionStride)
+    {
+        float3 boundMin = float3(FLT_MAX);
+        float3 boundMax = float3(-FLT_MAX);
+        for (size_t i = 0; i < indexCount; ++i)
+        {
+            float3 position = float3(positions + indices[i] * (positionStride / sizeof(float)));
+            boundMin = min(boundMin, position);
+            boundMax = max(boundMax, position);
+        }
+        float3 extent = boundMax - boundMin;
+        return max(max(extent.x, extent.y), extent.z);
+    }
+
+    // 包围所有子球的球，保证父节点的投影误差不小于子节点
+    static float4 MergeSpheres(const float4* spheres, size_t count)
+    {
+        float3 boundMin = spheres[0].xyz() - spheres[0].w;
+        float3 boundMax = spheres[0].xyz() + spheres[0].w;
+        for (size_t i = 1; i < count; ++i)
+        {
+            boundMin = min(boundMin, spheres[i].xyz() - spheres[i].w);
+            boundMax = max(boundMax, spheres[i].xyz() + spheres[i].w);
+        }
+
+        float3 center = (boundMin + boundMax) * 0.5f;
+        float radius = 0.0f;
+        for (size_t i = 0; i < count; ++i)
+        {
+            radius = max(radius, length(spheres[i].xyz() - center) + spheres[i].w);
+        }
+        return float4(center, radius);
+    }
+
+    static size_t AppendMeshlets(const eastl::vector<uint32_t>& indices, const float* positions, size_t vertexCount, size_t positionStride, const FMeshletLodSettings& settings, FMeshletLodData& output)
+    {
+        size_t maxMeshlets = meshopt_buildMeshletsBound(indices.size(), settings.MaxVertices, settings.MaxTriangles);
+
+        eastl::vector<meshopt_Meshlet> meshlets(maxMeshlets);
+        eastl::vector<unsigned int> meshletVertices(maxMeshlets * settings.MaxVertices);
+        eastl::vector<unsigned char> meshletTriangles(maxMeshlets * settings.MaxTriangles * 3);
+
+        size_t meshletCount = meshopt_buildMeshlets(meshlets.data(), meshletVertices.data(), meshletTriangles.data(), indices.data(), indices.size(), positions, vertexCount, positionStride, settings.MaxVertices, settings.MaxTriangles, settings.ConeWeight);
+        if (meshletCount == 0)
+        {
+            return 0;
+        }
+
+        uint32_t vertexBase = (uint32_t)output.MeshletVertices.size();
+        uint32_t triangleBase = (uint32_t)output.MeshletTriangles.size();
+
+        const meshopt_Meshlet& lastMeshlet = meshlets[meshletCount - 1];
+        output.MeshletVertices.insert(output.MeshletVertices.end(), meshletVertices.begin(), meshletVertices.begin() + lastMeshlet.vertex_offset + lastMeshlet.vertex_count);
+        output.MeshletTriangles.insert(output.MeshletTriangles.end(), meshletTriangles.begin(), meshletTriangles.begin() + lastMeshlet.triangle_offset + ((lastMeshlet.triangle_count * 3 + 3) & ~3));
+
+        for (size_t i = 0; i < meshletCount; ++i)
+        {
+            const meshopt_Meshlet& meshlet = meshlets[i];
+            meshopt_Bounds meshoptBounds = meshopt_computeMeshletBounds(&meshletVertices[meshlet.vertex_offset], &meshletTriangles[meshlet.triangle_offset], meshlet.triangle_count, positions, vertexCount, positionStride);
+
+            FMeshletBound bound;
+            bound.Center = float3(meshoptBounds.center);
+            bound.Radius = meshoptBounds.radius;
+            bound.AxisX = meshoptBounds.cone_axis_s8[0];
+            bound.AxisY = meshoptBounds.cone_axis_s8[1];
+            bound.AxisZ = meshoptBounds.cone_axis_s8[2];
+            bound.Cutoff = meshoptBounds.cone_cutoff_s8;
+            bound.VertexCount = meshlet.vertex_count;
+            bound.TriangleCount = meshlet.triangle_count;
+            bound.vertexOffset = vertexBase + meshlet.vertex_offset;
+            bound.triangleOffset = triangleBase + meshlet.triangle_offset;
+
+            bound.LodCenter = bound.Center;
+            bound.LodRadius = bound.Radius;
+            bound.ParentLodCenter = bound.Center;
+            bound.ParentLodRadius = bound.Radius;
+            bound.LodError = 0.0f;
+            bound.ParentLodError = ROOT_PARENT_LOD_ERROR;
+
+            output.Meshlets.push_back(bound);
+        }
+        return meshletCount;
+    }
+
+    void BuildMeshletLods(const uint32_t* indices, size_t indexCount, const float* positions, size_t vertexCount, size_t positionStride, const FMeshletLodSettings& settings, FMeshletLodData& output)
+    {
+        output.Meshlets.clear();
+        output.MeshletVertices.clear();
+        output.MeshletTriangles.clear();
+        output.LevelCount = 0;
+
+        eastl::vector<uint32_t> lodIndices(indices, indices + indexCount);
+        size_t meshletCount = AppendMeshlets(lodIndices, positions, vertexCount, positionStride, settings, output);
+        if (meshletCount == 0)
+        {
+            return;
+        }
+        output.LevelCount = 1;
+
+        float meshExtent = meshopt_simplifyScale(positions, vertexCount, positionStride);
+
+        eastl::vector<uint32_t> levelMeshlets(meshletCount);
+        for (size_t i = 0; i < meshletCount; ++i)
+        {
+            levelMeshlets[i] = (uint32_t)i;
+        }
+
+        eastl::vector<uint32_t> nextLevelMeshlets;
+        eastl::vector<uint32_t> groupIndices;
+        eastl::vector<uint32_t> simplifiedIndices;
+        eastl::vector<float4> groupSpheres;
+
+        while (levelMeshlets.size() > 1 && output.LevelCount < settings.MaxLevelCount)
+        {
+            nextLevelMeshlets.clear();
+            bool bSimplified = false;
+
+            // meshopt_buildMeshlets 按邻接顺序输出，连续的 meshlet 在空间上也相邻
+            for (size_t groupStart = 0; groupStart < levelMeshlets.size(); groupStart += settings.GroupSize)
+            {
+                size_t groupEnd = eastl::min(groupStart + (size_t)settings.GroupSize, levelMeshlets.size());
+
+                groupIndices.clear();
+                groupSpheres.clear();
+                float groupError = 0.0f;
+                for (size_t i = groupStart; i < groupEnd; ++i)
+                {
+                    const FMeshletBound& meshlet = output.Meshlets[levelMeshlets[i]];
+                    for (uint32_t j = 0; j < meshlet.TriangleCount * 3; ++j)
+                    {
+                        uint8_t localIndex = output.MeshletTriangles[meshlet.triangleOffset + j];
+                        groupIndices.push_back(output.MeshletVertices[meshlet.vertexOffset + localIndex]);
+                    }
+                    groupSpheres.push_back(float4(meshlet.LodCenter, meshlet.LodRadius));
+                    groupError = max(groupError, meshlet.LodError);
+                }
+
+                // 组边界被锁定，单个 meshlet 几乎无法简化，留到下一层和其他 meshlet 重新分组
+                size_t simplifiedCount = 0;
+                float simplifyError = 0.0f;
+                if (groupEnd - groupStart > 1)
+                {
+                    size_t targetIndexCount = groupIndices.size() / 6 * 3;
+                    simplifiedIndices.resize(groupIndices.size());
+                    simplifiedCount = meshopt_simplify(simplifiedIndices.data(), groupIndices.data(), groupIndices.size(), positions, vertexCount, positionStride, targetIndexCount, FLT_MAX, SIMPLIFY_OPTIONS, &simplifyError);
+                }
+
+                if (simplifiedCount == 0 || simplifiedCount > (size_t)(groupIndices.size() * settings.MaxReduction))
+                {
+                    nextLevelMeshlets.insert(nextLevelMeshlets.end(), levelMeshlets.begin() + groupStart, levelMeshlets.begin() + groupEnd);
+                    continue;
+                }
+                simplifiedIndices.resize(simplifiedCount);
+
+                // 误差沿 DAG 向上累加，保证单调递增
+                float extent = SIMPLIFY_ERROR_RELATIVE_TO_GROUP ? ComputeExtent(groupIndices.data(), groupIndices.size(), positions, positionStride) : meshExtent;
+                groupError += simplifyError * extent;
+                float4 groupSphere = MergeSpheres(groupSpheres.data(), groupSpheres.size());
+
+                for (size_t i = groupStart; i < groupEnd; ++i)
+                {
+                    FMeshletBound& meshlet = output.Meshlets[levelMeshlets[i]];
+                    meshlet.ParentLodCenter = groupSphere.xyz();
+                    meshlet.ParentLodRadius = groupSphere.w;
+                    meshlet.ParentLodError = groupError;
+                }
+
+                size_t firstMeshlet = output.Meshlets.size();
+                size_t count = AppendMeshlets(simplifiedIndices, positions, vertexCount, positionStride, settings, output);
+                for (size_t i = firstMeshlet; i < firstMeshlet + count; ++i)
+                {
+                    FMeshletBound& meshlet = output.Meshlets[i];
+                    meshlet.LodCenter = groupSphere.xyz();
+                    meshlet.LodRadius = groupSphere.w;
+                    meshlet.LodError = groupError;
+                    nextLevelMeshlets.push_back((uint32_t)i);
+                }
+                bSimplified = true;
+            }
+
+            if (!bSimplified)
+            {
+                break;
+            }
+            levelMeshlets.swap(nextLevelMeshlets);
+            output.LevelCount++;
+        }
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "MeshCache.hpp"
+
+namespace Assets
+{
+    struct FMeshletLodSettings
+    {
+        uint32_t MaxVertices = 64;
+        uint32_t MaxTriangles = 124;
+        float ConeWeight = 0.5f;
+
+        uint32_t GroupSize = 4;         // 每次合并后一起简化的 meshlet 数
+        uint32_t MaxLevelCount = 16;
+        float MaxReduction = 0.85f;     // 简化后剩余的三角形超过该比例时，这一组不再生成更粗的层级
+    };
+
+    struct FMeshletLodData
+    {
+        // 所有层级的 meshlet 放在一起，LOD 0 在最前面
+        eastl::vector<FMeshletBound> Meshlets;
+        eastl::vector<uint32_t> MeshletVertices;
+        eastl::vector<uint8_t> MeshletTriangles;
+        uint32_t LevelCount = 0;
+    };
+
+    // 构建 meshlet LOD DAG：每一层把相邻 meshlet 分组，锁住组边界把三角形简化到一半，再重新切分为 meshlet
+    // 渲染时选出 LodError 可接受而 ParentLodError 不可接受的 meshlet，任意视点下都构成一个无裂缝的切面
+    void BuildMeshletLods(const uint32_t* indices, size_t indexCount, const float* positions, size_t vertexCount, size_t positionStride, const FMeshletLodSettings& settings, FMeshletLodData& output);
+}
@@ -3,9 +3,12 @@
 #include "Scene/SceneComponent/StaticMesh.hpp"
 #include "Scene/SceneComponent/SkeletalMesh.hpp"
 #include "MeshMaterial.hpp"
+#include "MeshCache.hpp"
+#include "MeshletLod.hpp"
 #include "ResourceCache.hpp"
 #include "Core/VultanaEngine.hpp"
 
+#include "Utilities/Hash.hpp"
 #include "Utilities/Log.hpp"
 #include "Utilities/Memory.hpp"
 #include "Utilities/String.hpp"
@@ -17,6 +20,7 @@
 #include <meshoptimizer.h>
 
 #include <cassert>
+#include <filesystem>
 
 inline float3 strToFloat3(const eastl::string& str)
 {
@@ -92,6 +96,32 @@ inline uint32_t GetNodeIndex(const cgltf_data* data, const cgltf_node* node)
     return 0;
 }
 
+// glTF 及其引用的 buffer 文件的大小和修改时间，任意一个变化都需要重新烘焙
+inline uint64_t GetSourceHash(const eastl::string& file, const cgltf_data* data)
+{
+    std::filesystem::path path(file.c_str());
+
+    eastl::string stamp;
+    auto appendStamp = [&](const std::filesystem::path& p)
+    {
+        std::error_code ec;
+        uint64_t size = std::filesystem::file_size(p, ec);
+        int64_t time = std::filesystem::last_write_time(p, ec).time_since_epoch().count();
+        stamp += fmt::format("{}:{}:{};", p.filename().string(), size, time).c_str();
+    };
+
+    appendStamp(path);
+    for (cgltf_size i = 0; i < data->buffers_count; i++)
+    {
+        const char* uri = data->buffers[i].uri;
+        if (uri && strncmp(uri, "data:", 5) != 0)
+        {
+            appendStamp(path.parent_path() / uri);
+        }
+    }
+    return Utility::FHashUtils::CityHash(stamp.data(), stamp.size());
+}
+
 namespace Assets
 {
     FModelLoader::FModelLoader(Scene::FWorld *pWorld)
@@ -148,10 +178,10 @@ namespace Assets
             return;
         }
 
-        cgltf_load_buffers(&options, data, file.c_str());
-
         if (data->animations_count > 0)
         {
+            cgltf_load_buffers(&options, data, file.c_str());
+
             Scene::FSkeletalMesh* mesh = new Scene::FSkeletalMesh(m_File);
             mesh->m_pRenderer = Core::FVultanaEngine::GetEngineInstance()->GetRenderer();
             mesh->m_pAnimation.reset(LoadAnimation(data, &data->animations[0]));
@@ -174,6 +204,29 @@ namespace Assets
         }
         else
         {
+            uint64_t sourceHash = GetSourceHash(file, data);
+            eastl::string cacheFile = Core::FVultanaEngine::GetEngineInstance()->GetWorkingPath() + 
+                fmt::format("Cache/Meshes/{:016x}.mesh", Utility::FHashUtils::CityHash(file.data(), file.size())).c_str();
+
+            // 缓存有效时完全跳过 buffer 读取和 meshopt 处理
+            m_pMeshCacheReader = eastl::make_unique<FMeshCacheReader>();
+            bool bCacheValid = m_pMeshCacheReader->Open(cacheFile, sourceHash);
+            for (cgltf_size i = 0; i < data->nodes_count && bCacheValid; i++)
+            {
+                const cgltf_mesh* gltfMesh = data->nodes[i].mesh;
+                for (cgltf_size p = 0; gltfMesh && p < gltfMesh->primitives_count && bCacheValid; p++)
+                {
+                    bCacheValid = m_pMeshCacheReader->FindMesh(GetMeshIndex(data, gltfMesh), (uint32_t)p) != nullptr;
+                }
+            }
+
+            if (!bCacheValid)
+            {
+                m_pMeshCacheReader.reset();
+                m_pMeshCacheWriter = eastl::make_unique<FMeshCacheWriter>();
+                cgltf_load_buffers(&options, data, file.c_str());
+            }
+
             for (cgltf_size i = 0; i < data->scenes_count; i++)
             {
                 for (cgltf_size node = 0; node < data->scenes[i].nodes_count; node++)
@@ -181,6 +234,13 @@ namespace Assets
                     LoadStaticMeshNode(data, data->scenes[i].nodes[node], m_MtxWorld);
                 }
             }
+
+            if (m_pMeshCacheWriter)
+            {
+                m_pMeshCacheWriter->Save(cacheFile, sourceHash);
+            }
+            m_pMeshCacheReader.reset();
+            m_pMeshCacheWriter.reset();
         }
         
         cgltf_free(data);
@@ -206,7 +266,7 @@ namespace Assets
             for (cgltf_size i = 0; i < node->mesh->primitives_count; i++)
             {
                 eastl::string name = fmt::format("Mesh_{}_{} : {}", meshIdx, i, (node->mesh->name ? node->mesh->name : "")).c_str();
-                Scene::FStaticMesh* mesh = LoadStaticMesh(&node->mesh->primitives[i], name, bFrontFaceCCW);
+                Scene::FStaticMesh* mesh = LoadStaticMesh(&node->mesh->primitives[i], meshIdx, (uint32_t)i, name, bFrontFaceCCW);
                 mesh->m_pMaterial->m_bFrontFaceCCW = bFrontFaceCCW;
                 mesh->SetPosition(position);
                 mesh->SetRotation(rotation);
@@ -247,17 +307,15 @@ namespace Assets
         return stream;
     }
 
-    Scene::FStaticMesh *FModelLoader::LoadStaticMesh(const cgltf_primitive *primitive, const eastl::string &name, bool bFrontFaceCCW)
+    // 去重顶点、生成 meshlet LOD 层级及其包围体，结果可以直接写入 mesh cache
+    static void BakeStaticMesh(const cgltf_primitive* primitive, FBakedMeshData& output)
     {
-        Scene::FStaticMesh* mesh = new Scene::FStaticMesh(m_File + " " + name);
-        mesh->m_pMaterial.reset(LoadMaterial(primitive->material));
-
         size_t indexCount;
         meshopt_Stream indices = LoadBufferStream(primitive->indices, false, indexCount);
 
         size_t vertexCount;
         eastl::vector<meshopt_Stream> vertexStreams;
-        eastl::vector<cgltf_attribute_type> vertexTypes;
+        eastl::vector<EBakedMeshStream> vertexTypes;
 
         for (cgltf_size i = 0; i < primitive->attributes_count; i++)
         {
@@ -265,7 +323,7 @@ namespace Assets
             {
             case cgltf_attribute_type_position:
                 vertexStreams.push_back(LoadBufferStream(primitive->attributes[i].data, true, vertexCount));
-                vertexTypes.push_back(primitive->attributes[i].type);
+                vertexTypes.push_back(EBakedMeshStream::Position);
                 {
                     float3 min = float3(primitive->attributes[i].data->min);
                     min.z = -min.z;
@@ -275,29 +333,43 @@ namespace Assets
                     float3 center = (min + max) * 0.5f;
                     float radius = length(max - min) * 0.5f;
 
-                    mesh->m_Center = center;
-                    mesh->m_Radius = radius;
+                    output.Desc.Center = center;
+                    output.Desc.Radius = radius;
                 }
                 break;
             case cgltf_attribute_type_texcoord:
                 if (primitive->attributes[i].index == 0)
                 {
                     vertexStreams.push_back(LoadBufferStream(primitive->attributes[i].data, false, vertexCount));
-                    vertexTypes.push_back(primitive->attributes[i].type);
+                    vertexTypes.push_back(EBakedMeshStream::TexCoord);
                 }
                 break;
             case cgltf_attribute_type_normal:
                 vertexStreams.push_back(LoadBufferStream(primitive->attributes[i].data, true, vertexCount));
-                vertexTypes.push_back(primitive->attributes[i].type);
+                vertexTypes.push_back(EBakedMeshStream::Normal);
                 break;
             case cgltf_attribute_type_tangent:
                 vertexStreams.push_back(LoadBufferStream(primitive->attributes[i].data, true, vertexCount));
-                vertexTypes.push_back(primitive->attributes[i].type);
+                vertexTypes.push_back(EBakedMeshStream::Tangent);
                 break;
             default:
                 break;
             }
         }
+
+        // 8 位索引统一转换成 16 位，GPU 端只支持 R16UI/R32UI
+        if (indices.stride == 1)
+        {
+            uint16_t* data = (uint16_t*)VTNA_ALLOC(sizeof(uint16_t) * indexCount);
+            for (size_t i = 0; i < indexCount; i++)
+            {
+                data[i] = ((const uint8_t*)indices.data)[i];
+            }
+            VTNA_FREE((void*)indices.data);
+            indices.data = data;
+            indices.stride = 2;
+        }
+
         eastl::vector<unsigned int> remap(indexCount);
 
         void* remappedIndices = VTNA_ALLOC(indices.stride * indexCount);
@@ -314,10 +386,6 @@ namespace Assets
             remappedVertexCount = meshopt_generateVertexRemapMulti(&remap[0], (const unsigned short*)indices.data, indexCount, vertexCount, vertexStreams.data(), vertexStreams.size());
             meshopt_remapIndexBuffer((unsigned short*)remappedIndices, (const unsigned short*)indices.data, indexCount, &remap[0]);
             break;
-        case 1:
-            remappedVertexCount = meshopt_generateVertexRemapMulti(&remap[0], (const unsigned char*)indices.data, indexCount, vertexCount, vertexStreams.data(), vertexStreams.size());
-            meshopt_remapIndexBuffer((unsigned char*)remappedIndices, (const unsigned char*)indices.data, indexCount, &remap[0]);
-            break;
         default:
             assert(false);
             break;
@@ -331,157 +399,124 @@ namespace Assets
             meshopt_remapVertexBuffer(vertices, vertexStreams[i].data, vertexCount, vertexStreams[i].stride, &remap[0]);
             remappedVertices.push_back(vertices);
 
-            if (vertexTypes[i] == cgltf_attribute_type_position)
+            if (vertexTypes[i] == EBakedMeshStream::Position)
             {
                 posVertices = vertices;
                 posStride = vertexStreams[i].stride;
             }
         }
 
-        size_t maxVertices = 64;
-        size_t maxTriangles = 124;
-        const float coneWeight = 0.5f;
-        size_t maxMeshlets = meshopt_buildMeshletsBound(indexCount, maxVertices, maxTriangles);
-
-        eastl::vector<meshopt_Meshlet> meshlets(maxMeshlets);
-        eastl::vector<unsigned int> meshletVertices(maxMeshlets * maxVertices);
-        eastl::vector<unsigned char> meshletTriangles(maxMeshlets * maxTriangles * 3);
-
-        size_t meshletCount;
-        switch (indices.stride)
+        // meshopt 的简化只接受 32 位索引
+        eastl::vector<uint32_t> lodIndices(indexCount);
+        for (size_t i = 0; i < indexCount; i++)
         {
-        case 4:
-            meshletCount = meshopt_buildMeshlets(meshlets.data(), meshletVertices.data(), meshletTriangles.data(), (const unsigned int*)remappedIndices, indexCount, (const float*)posVertices, remappedVertexCount, posStride, maxVertices, maxTriangles, coneWeight);
-            break;
-        case 2:
-            meshletCount = meshopt_buildMeshlets(meshlets.data(), meshletVertices.data(), meshletTriangles.data(), (const unsigned short*)remappedIndices, indexCount, (const float*)posVertices, remappedVertexCount, posStride, maxVertices, maxTriangles, coneWeight);
-            break;
-        case 1:
-            meshletCount = meshopt_buildMeshlets(meshlets.data(), meshletVertices.data(), meshletTriangles.data(), (const unsigned char*)remappedIndices, indexCount, (const float*)posVertices, remappedVertexCount, posStride, maxVertices, maxTriangles, coneWeight);
-            break;
-        default:
-            assert(false);
-            break;
+            lodIndices[i] = indices.stride == 4 ? ((const uint32_t*)remappedIndices)[i] : ((const uint16_t*)remappedIndices)[i];
         }
 
-        const meshopt_Meshlet& lastMeshlet = meshlets[meshletCount - 1];
-        meshletVertices.resize(lastMeshlet.vertex_offset + lastMeshlet.vertex_count);
-        meshletTriangles.resize(lastMeshlet.triangle_offset + ((lastMeshlet.triangle_count * 3 + 3) & ~3));
-        meshlets.resize(meshletCount);
+        FMeshletLodData lodData;
+        BuildMeshletLods(lodIndices.data(), indexCount, (const float*)posVertices, remappedVertexCount, posStride, FMeshletLodSettings(), lodData);
 
         eastl::vector<unsigned short> meshletTriangles16;
-        meshletTriangles16.reserve(meshletTriangles.size());
-        for (size_t i = 0; i < meshletTriangles.size(); i++)
+        meshletTriangles16.reserve(lodData.MeshletTriangles.size());
+        for (size_t i = 0; i < lodData.MeshletTriangles.size(); i++)
         {
-            meshletTriangles16.push_back(meshletTriangles[i]);
+            meshletTriangles16.push_back(lodData.MeshletTriangles[i]);
         }
 
-        struct FMeshletBound
+        output.Desc.IndexCount = (uint32_t)indexCount;
+        output.Desc.VertexCount = (uint32_t)remappedVertexCount;
+        output.Desc.MeshletCount = (uint32_t)lodData.Meshlets.size();
+
+        output.SetStream(EBakedMeshStream::Index, remappedIndices, (uint32_t)indices.stride * (uint32_t)indexCount, (uint32_t)indices.stride);
+        for (size_t i = 0; i < vertexTypes.size(); i++)
         {
-            float3 Center;
-            float Radius;
+            output.SetStream(vertexTypes[i], remappedVertices[i], (uint32_t)vertexStreams[i].stride * (uint32_t)remappedVertexCount, (uint32_t)vertexStreams[i].stride);
+        }
+        output.SetStream(EBakedMeshStream::MeshletBounds, lodData.Meshlets.data(), sizeof(FMeshletBound) * (uint32_t)lodData.Meshlets.size(), sizeof(FMeshletBound));
+        output.SetStream(EBakedMeshStream::MeshletVertices, lodData.MeshletVertices.data(), sizeof(unsigned int) * (uint32_t)lodData.MeshletVertices.size(), sizeof(unsigned int));
+        output.SetStream(EBakedMeshStream::MeshletIndices, meshletTriangles16.data(), sizeof(unsigned short) * (uint32_t)meshletTriangles16.size(), sizeof(unsigned short));
 
-            union
-            {
-                struct 
-                {
-                    int8_t AxisX;
-                    int8_t AxisY;
-                    int8_t AxisZ;
-                    int8_t Cutoff;
-                };
-                uint32_t Cone;
-            };
+        VTNA_FREE((void*)indices.data);
+        for (size_t i = 0; i < vertexStreams.size(); i++)
+        {
+            VTNA_FREE((void*)vertexStreams[i].data);
+        }
+        VTNA_FREE(remappedIndices);
+        for (size_t i = 0; i < remappedVertices.size(); i++)
+        {
+            VTNA_FREE(remappedVertices[i]);
+        }
+    }
 
-            uint VertexCount;
-            uint TriangleCount;
+    Scene::FStaticMesh *FModelLoader::LoadStaticMesh(const cgltf_primitive *primitive, uint32_t meshIndex, uint32_t primitiveIndex, const eastl::string &name, bool bFrontFaceCCW)
+    {
+        Scene::FStaticMesh* mesh = new Scene::FStaticMesh(m_File + " " + name);
+        mesh->m_pMaterial.reset(LoadMaterial(primitive->material));
 
-            uint vertexOffset;
-            uint triangleOffset;
-        };
-        eastl::vector<FMeshletBound> meshletBounds(meshletCount);
+        // 命中缓存时直接从映射的文件内存上传，否则烘焙一次并记录下来
+        const FBakedMesh* bakedMesh = m_pMeshCacheReader ? m_pMeshCacheReader->FindMesh(meshIndex, primitiveIndex) : nullptr;
+        const void* streams[(uint32_t)EBakedMeshStream::Count] = {};
 
-        for (size_t i = 0; i < meshletCount; i++)
+        FBakedMeshData bakedData;
+        if (bakedMesh)
         {
-            const meshopt_Meshlet& meshlet = meshlets[i];
-            meshopt_Bounds meshoptBounds = meshopt_computeMeshletBounds(&meshletVertices[meshlet.vertex_offset], &meshletTriangles[meshlet.triangle_offset], meshlet.triangle_count, (const float*)posVertices, remappedVertexCount, posStride);
-
-            FMeshletBound bound;
-            bound.Center = float3(meshoptBounds.center);
-            bound.Radius = meshoptBounds.radius;    
-            bound.AxisX = meshoptBounds.cone_axis_s8[0];
-            bound.AxisY = meshoptBounds.cone_axis_s8[1];
-            bound.AxisZ = meshoptBounds.cone_axis_s8[2];
-            bound.Cutoff = meshoptBounds.cone_cutoff_s8;
-            bound.VertexCount = meshlet.vertex_count;
-            bound.TriangleCount = meshlet.triangle_count;
-            bound.vertexOffset = meshlet.vertex_offset;
-            bound.triangleOffset = meshlet.triangle_offset;
+            for (uint32_t i = 0; i < (uint32_t)EBakedMeshStream::Count; i++)
+            {
+                streams[i] = m_pMeshCacheReader->GetStreamData(*bakedMesh, (EBakedMeshStream)i);
+            }
+        }
+        else
+        {
+            bakedData.Desc.MeshIndex = meshIndex;
+            bakedData.Desc.PrimitiveIndex = primitiveIndex;
+            BakeStaticMesh(primitive, bakedData);
 
-            meshletBounds[i] = bound;
+            bakedMesh = &bakedData.Desc;
+            for (uint32_t i = 0; i < (uint32_t)EBakedMeshStream::Count; i++)
+            {
+                streams[i] = bakedData.GetStreamData((EBakedMeshStream)i);
+            }
         }
 
         auto pRenderer = Core::FVultanaEngine::GetEngineInstance()->GetRenderer();
         auto resourceCache = FResourceCache::GetInstance();
 
         mesh->m_pRenderer = pRenderer;
+        mesh->m_Center = bakedMesh->Center;
+        mesh->m_Radius = bakedMesh->Radius;
 
-        if (indices.stride == 1)
+        auto getBuffer = [&](EBakedMeshStream stream, const char* suffix)
         {
-            uint16_t* data = (uint16_t*)VTNA_ALLOC(sizeof(uint16_t) * indexCount);
-            for (uint32_t i = 0; i < indexCount; i++)
+            uint32_t size = bakedMesh->Streams[(uint32_t)stream].Size;
+            if (size == 0)
             {
-                data[i] = ((const char*)indices.data)[i];
+                return OffsetAllocator::Allocation();
             }
-            indices.stride = 2;
-            VTNA_FREE((void*)indices.data);
-            indices.data = data;
-        }
-        
-        mesh->m_IndexBuffer = resourceCache->GetSceneBuffer("Model(" + m_File + " " + name + ")_IndexBuffer", remappedIndices, (uint32_t)indices.stride * (uint32_t)indexCount);
-        mesh->m_IndexBufferFormat = indices.stride == 4 ? RHI::ERHIFormat::R32UI : RHI::ERHIFormat::R16UI;
-        mesh->m_IndexCount = (uint32_t)indexCount;
-        mesh->m_VertexCount = (uint32_t)remappedVertexCount;
+            return resourceCache->GetSceneBuffer("Model(" + m_File + " " + name + ")_" + suffix, streams[(uint32_t)stream], size);
+        };
 
-        for (size_t i = 0; i < vertexTypes.size(); i++)
-        {
-            switch (vertexTypes[i])
-            {
-            case cgltf_attribute_type_position:
-                mesh->m_PositionBuffer = resourceCache->GetSceneBuffer("Model(" + m_File + " " + name + ")_PositionBuffer", remappedVertices[i], (uint32_t)vertexStreams[i].stride * (uint32_t)remappedVertexCount);
-                break;
-            case cgltf_attribute_type_texcoord:
-                mesh->m_TexCoordBuffer = resourceCache->GetSceneBuffer("Model(" + m_File + " " + name + ")_TexCoordBuffer", remappedVertices[i], (uint32_t)vertexStreams[i].stride * (uint32_t)remappedVertexCount);
-                break;
-            case cgltf_attribute_type_normal:
-                mesh->m_NormalBuffer = resourceCache->GetSceneBuffer("Model(" + m_File + " " + name + ")_NormalBuffer", remappedVertices[i], (uint32_t)vertexStreams[i].stride * (uint32_t)remappedVertexCount);
-                break;
-            case cgltf_attribute_type_tangent:
-                mesh->m_TangentBuffer = resourceCache->GetSceneBuffer("Model(" + m_File + " " + name + ")_TangentBuffer", remappedVertices[i], (uint32_t)vertexStreams[i].stride * (uint32_t)remappedVertexCount);
-                break;
-            default:
-                break;
-            }
-        }
+        mesh->m_IndexBuffer = getBuffer(EBakedMeshStream::Index, "IndexBuffer");
+        mesh->m_IndexBufferFormat = bakedMesh->Streams[(uint32_t)EBakedMeshStream::Index].Stride == 4 ? RHI::ERHIFormat::R32UI : RHI::ERHIFormat::R16UI;
+        mesh->m_IndexCount = bakedMesh->IndexCount;
+        mesh->m_VertexCount = bakedMesh->VertexCount;
 
-        mesh->m_MeshletCount = (uint32_t)meshletCount;
-        mesh->m_MeshletBuffer = resourceCache->GetSceneBuffer("Model(" + m_File + " " + name + ")_MeshletBuffer", meshletBounds.data(), sizeof(FMeshletBound) * (uint32_t)meshletBounds.size());
-        mesh->m_MeshletIndicesBuffer = resourceCache->GetSceneBuffer("Model(" + m_File + " " + name + ")_MeshletIndicesBuffer", meshletTriangles16.data(), sizeof(unsigned short) * (uint32_t)meshletTriangles16.size());
-        mesh->m_MeshletVertexBuffer = resourceCache->GetSceneBuffer("Model(" + m_File + " " + name + ")_MeshletVertexBuffer", meshletVertices.data(), sizeof(unsigned int) * (uint32_t)meshletVertices.size());
+        mesh->m_PositionBuffer = getBuffer(EBakedMeshStream::Position, "PositionBuffer");
+        mesh->m_TexCoordBuffer = getBuffer(EBakedMeshStream::TexCoord, "TexCoordBuffer");
+        mesh->m_NormalBuffer = getBuffer(EBakedMeshStream::Normal, "NormalBuffer");
+        mesh->m_TangentBuffer = getBuffer(EBakedMeshStream::Tangent, "TangentBuffer");
+
+        mesh->m_MeshletCount = bakedMesh->MeshletCount;
+        mesh->m_MeshletBuffer = getBuffer(EBakedMeshStream::MeshletBounds, "MeshletBuffer");
+        mesh->m_MeshletIndicesBuffer = getBuffer(EBakedMeshStream::MeshletIndices, "MeshletIndicesBuffer");
+        mesh->m_MeshletVertexBuffer = getBuffer(EBakedMeshStream::MeshletVertices, "MeshletVertexBuffer");
 
         mesh->Create();
 
         m_pWorld->AddObject(mesh);
 
-        VTNA_FREE((void*)indices.data);
-        for (size_t i = 0; i < vertexStreams.size(); i++)
+        if (m_pMeshCacheWriter && bakedMesh == &bakedData.Desc)
         {
-            VTNA_FREE((void*)vertexStreams[i].data);
-        }
-        VTNA_FREE(remappedIndices);
-        for (size_t i = 0; i < remappedVertices.size(); i++)
-        {
-            VTNA_FREE(remappedVertices[i]);
+            m_pMeshCacheWriter->AddMesh(eastl::move(bakedData));
         }
 
         return mesh;
@@ -746,9 +781,7 @@ namespace Assets
         FMaterialTextureInfo info;
         if (texture)
         {
-            info.Index = texture->GetSRV()->GetHeapIndex();
-            info.Width = texture->GetTexture()->GetDesc().Width;
-            info.Height = texture->GetTexture()->GetDesc().Height;
+            // Index 和尺寸随纹理驻留状态在 FMeshMaterial::UpdateConstants 中更新
             if (textureView.has_transform)
             {
                 info.IsTransform = true;
@@ -772,9 +805,9 @@ namespace Assets
         if (gltfMaterial->has_pbr_metallic_roughness)
         {
             material->m_WorkFlow = MaterialWorkFlow::PBRMetallicRoughness;
-            material->m_pAlbedoTexture = LoadTexture(gltfMaterial->pbr_metallic_roughness.base_color_texture, true);
+            material->m_pAlbedoTexture = LoadTexture(gltfMaterial->pbr_metallic_roughness.base_color_texture, true, ETextureRole::Albedo);
             material->m_MaterialCB.AlbedoTexture = LoadTextureInfo(material->m_pAlbedoTexture, gltfMaterial->pbr_metallic_roughness.base_color_texture);
-            material->m_pMetallicRoughTexture = LoadTexture(gltfMaterial->pbr_metallic_roughness.metallic_roughness_texture, false);
+            material->m_pMetallicRoughTexture = LoadTexture(gltfMaterial->pbr_metallic_roughness.metallic_roughness_texture, false, ETextureRole::RoughnessMetallic);
             material->m_MaterialCB.MetallicRoughnessTexture = LoadTextureInfo(material->m_pMetallicRoughTexture, gltfMaterial->pbr_metallic_roughness.metallic_roughness_texture);
             material->m_AlbedoColor = float3(gltfMaterial->pbr_metallic_roughness.base_color_factor);
             material->m_Metallic = gltfMaterial->pbr_metallic_roughness.metallic_factor;
@@ -783,19 +816,19 @@ namespace Assets
         else if (gltfMaterial->has_pbr_specular_glossiness)
         {
             material->m_WorkFlow = MaterialWorkFlow::PBRSpecularGlossiness;
-            material->m_pDiffuseTexture = LoadTexture(gltfMaterial->pbr_specular_glossiness.diffuse_texture, true);
+            material->m_pDiffuseTexture = LoadTexture(gltfMaterial->pbr_specular_glossiness.diffuse_texture, true, ETextureRole::Albedo);
             material->m_MaterialCB.DiffuseTexture = LoadTextureInfo(material->m_pDiffuseTexture, gltfMaterial->pbr_specular_glossiness.diffuse_texture);
-            material->m_pSpecularGlossinessTexture = LoadTexture(gltfMaterial->pbr_specular_glossiness.specular_glossiness_texture, false);
+            material->m_pSpecularGlossinessTexture = LoadTexture(gltfMaterial->pbr_specular_glossiness.specular_glossiness_texture, false, ETextureRole::RoughnessMetallic);
             material->m_MaterialCB.SpecularGlossinessTexture = LoadTextureInfo(material->m_pSpecularGlossinessTexture, gltfMaterial->pbr_specular_glossiness.specular_glossiness_texture);
             material->m_DiffuseColor = float3(gltfMaterial->pbr_specular_glossiness.diffuse_factor);
             material->m_SpecularColor = float3(gltfMaterial->pbr_specular_glossiness.specular_factor);
             material->m_Glossiness = gltfMaterial->pbr_specular_glossiness.glossiness_factor;
         }
-        material->m_pNormalTexture = LoadTexture(gltfMaterial->normal_texture, false);
+        material->m_pNormalTexture = LoadTexture(gltfMaterial->normal_texture, false, ETextureRole::Normal);
         material->m_MaterialCB.NormalTexture = LoadTextureInfo(material->m_pNormalTexture, gltfMaterial->normal_texture);
-        material->m_pEmissiveTexture = LoadTexture(gltfMaterial->emissive_texture, true);
+        material->m_pEmissiveTexture = LoadTexture(gltfMaterial->emissive_texture, true, ETextureRole::Albedo);
         material->m_MaterialCB.EmissiveTexture = LoadTextureInfo(material->m_pEmissiveTexture, gltfMaterial->emissive_texture);
-        material->m_pAOTexture = LoadTexture(gltfMaterial->occlusion_texture, false);
+        material->m_pAOTexture = LoadTexture(gltfMaterial->occlusion_texture, false, ETextureRole::Occlusion);
         material->m_MaterialCB.AmbientOcclusionTexture = LoadTextureInfo(material->m_pAOTexture, gltfMaterial->occlusion_texture);
 
         material->m_EmissiveColor = float3(gltfMaterial->emissive_factor);
@@ -807,14 +840,14 @@ namespace Assets
         return material;
     }
 
-    RenderResources::FTexture2D *FModelLoader::LoadTexture(const cgltf_texture_view& textureView, bool srgb)
+    RenderResources::FTexture2D *FModelLoader::LoadTexture(const cgltf_texture_view& textureView, bool srgb, ETextureRole role)
     {
         if (textureView.texture == nullptr || textureView.texture->image->uri == nullptr) return nullptr;
 
         size_t lastSlash = m_File.find_last_of('/');
         eastl::string texturePath = Core::FVultanaEngine::GetEngineInstance()->GetAssetsPath() + m_File.substr(0, lastSlash + 1);
         Renderer::FRendererBase* pRenderer = Core::FVultanaEngine::GetEngineInstance()->GetRenderer();
-        auto texture = FResourceCache::GetInstance()->GetTexture2D(texturePath + textureView.texture->image->uri, srgb);
+        auto texture = FResourceCache::GetInstance()->GetTexture2D(texturePath + textureView.texture->image->uri, srgb, role);
         return texture;
     }
 }
\ No newline at end of file
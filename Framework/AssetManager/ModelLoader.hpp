@@ -4,9 +4,11 @@
 #include <cassert>
 #include <string>
 
+#include "TextureCompressor.hpp"
 #include "Utilities/Math.hpp"
 
 #include <EASTL/string.h>
+#include <EASTL/unique_ptr.h>
 
 namespace tinyxml2
 {
@@ -39,6 +41,8 @@ namespace Scene
 namespace Assets
 {
     class FMeshMaterial;
+    class FMeshCacheReader;
+    class FMeshCacheWriter;
     
     class FModelLoader
     {
@@ -51,7 +55,7 @@ namespace Assets
 
     private:
         void LoadStaticMeshNode(const cgltf_data* data, cgltf_node* node, const float4x4& parentMtx);
-        Scene::FStaticMesh* LoadStaticMesh(const cgltf_primitive* primitive, const eastl::string& name, bool bFrontFaceCCW);
+        Scene::FStaticMesh* LoadStaticMesh(const cgltf_primitive* primitive, uint32_t meshIndex, uint32_t primitiveIndex, const eastl::string& name, bool bFrontFaceCCW);
         
         Scene::FAnimation* LoadAnimation(const cgltf_data* data, const cgltf_animation* gltfAnimation);
         Scene::FSkeleton* LoadSkeleton(const cgltf_data* data, const cgltf_skin* gltfSkin);
@@ -59,7 +63,7 @@ namespace Assets
         Scene::FSkeletalMeshData* LoadSkeletalMeshData(const cgltf_primitive* primitive, const eastl::string& name);
 
         FMeshMaterial* LoadMaterial(const cgltf_material* gltfMaterial);
-        RenderResources::FTexture2D* LoadTexture(const cgltf_texture_view& textureView, bool srgb);
+        RenderResources::FTexture2D* LoadTexture(const cgltf_texture_view& textureView, bool srgb, ETextureRole role = ETextureRole::Generic);
 
     private:
         Scene::FWorld* m_pWorld = nullptr;
@@ -69,5 +73,9 @@ namespace Assets
         quaternion m_Rotation = quaternion(0.0f, 0.0f, 0.0f, 1.0f);
         float3 m_Scale = float3(1.0f);
         float4x4 m_MtxWorld;
+
+        // 仅在 LoadGLTF 期间有效
+        eastl::unique_ptr<FMeshCacheReader> m_pMeshCacheReader;
+        eastl::unique_ptr<FMeshCacheWriter> m_pMeshCacheWriter;
     };
 }
\ No newline at end of file
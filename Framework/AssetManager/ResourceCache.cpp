@@ -1,5 +1,6 @@
 #include "ResourceCache.hpp"
 #include "Core/VultanaEngine.hpp"
+#include "Renderer/TextureStreamer.hpp"
 
 namespace Assets
 {
@@ -9,7 +10,7 @@ namespace Assets
         return &instance;
     }
 
-    RenderResources::FTexture2D *FResourceCache::GetTexture2D(const eastl::string &file, bool srgb)
+    RenderResources::FTexture2D *FResourceCache::GetTexture2D(const eastl::string &file, bool srgb, ETextureRole role)
     {
         auto iter = m_CachedTexture2D.find(file);
         if (iter != m_CachedTexture2D.end())
@@ -20,7 +21,8 @@ namespace Assets
         auto pRenderer = Core::FVultanaEngine::GetEngineInstance()->GetRenderer();
         FResource texture;
         texture.RefCount = 1;
-        texture.Data = pRenderer->CreateTexture2D(file, srgb);
+        // 先返回未驻留的纹理，解码和上传在后台进行
+        texture.Data = pRenderer->GetTextureStreamer()->RequestTexture2D(file, srgb, role);
         m_CachedTexture2D.insert(eastl::make_pair(file, texture));
 
         return (RenderResources::FTexture2D*)texture.Data;
@@ -39,6 +41,8 @@ namespace Assets
                 iter->second.RefCount--;
                 if (iter->second.RefCount == 0)
                 {
+                    auto pRenderer = Core::FVultanaEngine::GetEngineInstance()->GetRenderer();
+                    pRenderer->GetTextureStreamer()->CancelRequest(texture);
                     delete texture;
                     m_CachedTexture2D.erase(iter);
                 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Renderer/RendererBase.hpp"
+#include "TextureCompressor.hpp"
 
 #include <EASTL/hash_map.h>
 
@@ -11,7 +12,7 @@ namespace Assets
     public:
         static FResourceCache* GetInstance();
 
-        RenderResources::FTexture2D* GetTexture2D(const eastl::string& file, bool srgb = true);
+        RenderResources::FTexture2D* GetTexture2D(const eastl::string& file, bool srgb = true, ETextureRole role = ETextureRole::Generic);
         void ReleaseTexture2D(RenderResources::FTexture2D* texture);
 
         OffsetAllocator::Allocation GetSceneBuffer(const eastl::string& name, const void* data, uint32_t size);
@@ -0,0 +1,786 @@
+#include "TextureCompressor.hpp"
+
+#include <EASTL/algorithm.h>
+
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace Assets
+{
+    static const uint32_t BC7_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+    // 每个块做几轮“选索引 -> 最小二乘求端点”的迭代
+    static const uint32_t REFINE_ITERATIONS = 3;
+
+    static inline float Clamp255(float value)
+    {
+        return eastl::min(eastl::max(value, 0.0f), 255.0f);
+    }
+
+    static inline uint32_t GetBlockSize(RHI::ERHIFormat format)
+    {
+        switch (format)
+        {
+        case RHI::ERHIFormat::BC1UNORM:
+        case RHI::ERHIFormat::BC1SRGB:
+        case RHI::ERHIFormat::BC4UNORM:
+            return 8;
+        case RHI::ERHIFormat::BC3UNORM:
+        case RHI::ERHIFormat::BC3SRGB:
+        case RHI::ERHIFormat::BC5UNORM:
+        case RHI::ERHIFormat::BC7UNORM:
+        case RHI::ERHIFormat::BC7SRGB:
+            return 16;
+        default:
+            return 0;
+        }
+    }
+
+    static void LoadBlock(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, float block[16][4])
+    {
+        for (uint32_t y = 0; y < 4; y++)
+        {
+            for (uint32_t x = 0; x < 4; x++)
+            {
+                uint32_t px = eastl::min(blockX * 4 + x, width - 1);
+                uint32_t py = eastl::min(blockY * 4 + y, height - 1);
+                const uint8_t* pixel = rgba + (py * width + px) * 4;
+                for (uint32_t c = 0; c < 4; c++)
+                {
+                    block[y * 4 + x][c] = (float)pixel[c];
+                }
+            }
+        }
+    }
+
+    static void StoreBlock(const int block[16][4], uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, uint8_t* rgba)
+    {
+        for (uint32_t y = 0; y < 4; y++)
+        {
+            for (uint32_t x = 0; x < 4; x++)
+            {
+                uint32_t px = blockX * 4 + x;
+                uint32_t py = blockY * 4 + y;
+                if (px >= width || py >= height)
+                {
+                    continue;
+                }
+                uint8_t* pixel = rgba + (py * width + px) * 4;
+                for (uint32_t c = 0; c < 4; c++)
+                {
+                    pixel[c] = (uint8_t)block[y * 4 + x][c];
+                }
+            }
+        }
+    }
+
+    // 前 channelCount 个通道上的主轴，端点取像素在主轴上投影的两端
+    static void FitPrincipalAxis(const float block[16][4], uint32_t channelCount, float endpoint0[4], float endpoint1[4])
+    {
+        float mean[4] = {};
+        float minValue[4] = { FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX };
+        float maxValue[4] = { -FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            for (uint32_t c = 0; c < channelCount; c++)
+            {
+                mean[c] += block[i][c] / 16.0f;
+                minValue[c] = eastl::min(minValue[c], block[i][c]);
+                maxValue[c] = eastl::max(maxValue[c], block[i][c]);
+            }
+        }
+
+        float covariance[4][4] = {};
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            for (uint32_t a = 0; a < channelCount; a++)
+            {
+                for (uint32_t b = 0; b < channelCount; b++)
+                {
+                    covariance[a][b] += (block[i][a] - mean[a]) * (block[i][b] - mean[b]);
+                }
+            }
+        }
+
+        // 以包围盒对角线为初值做幂迭代
+        float axis[4] = {};
+        for (uint32_t c = 0; c < channelCount; c++)
+        {
+            axis[c] = maxValue[c] - minValue[c];
+        }
+        for (uint32_t iteration = 0; iteration < 8; iteration++)
+        {
+            float next[4] = {};
+            float maxComponent = 0.0f;
+            for (uint32_t a = 0; a < channelCount; a++)
+            {
+                for (uint32_t b = 0; b < channelCount; b++)
+                {
+                    next[a] += covariance[a][b] * axis[b];
+                }
+                maxComponent = eastl::max(maxComponent, fabsf(next[a]));
+            }
+            if (maxComponent <= 0.0f)
+            {
+                break;
+            }
+            for (uint32_t c = 0; c < channelCount; c++)
+            {
+                axis[c] = next[c] / maxComponent;
+            }
+        }
+
+        float lengthSquared = 0.0f;
+        for (uint32_t c = 0; c < channelCount; c++)
+        {
+            lengthSquared += axis[c] * axis[c];
+        }
+
+        float minProjection = 0.0f;
+        float maxProjection = 0.0f;
+        if (lengthSquared > 0.0f)
+        {
+            float invLength = 1.0f / sqrtf(lengthSquared);
+            for (uint32_t c = 0; c < channelCount; c++)
+            {
+                axis[c] *= invLength;
+            }
+
+            minProjection = FLT_MAX;
+            maxProjection = -FLT_MAX;
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                float projection = 0.0f;
+                for (uint32_t c = 0; c < channelCount; c++)
+                {
+                    projection += (block[i][c] - mean[c]) * axis[c];
+                }
+                minProjection = eastl::min(minProjection, projection);
+                maxProjection = eastl::max(maxProjection, projection);
+            }
+        }
+
+        for (uint32_t c = 0; c < 4; c++)
+        {
+            endpoint0[c] = c < channelCount ? Clamp255(mean[c] + axis[c] * minProjection) : 255.0f;
+            endpoint1[c] = c < channelCount ? Clamp255(mean[c] + axis[c] * maxProjection) : 255.0f;
+        }
+    }
+
+    // weights[i] 为像素 i 在 endpoint0 到 endpoint1 之间的插值位置，最小二乘求端点
+    static bool RefineEndpoints(const float block[16][4], uint32_t channelCount, const float weights[16], float endpoint0[4], float endpoint1[4])
+    {
+        float a = 0.0f, b = 0.0f, c = 0.0f;
+        float rhs0[4] = {};
+        float rhs1[4] = {};
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            float t = weights[i];
+            a += (1.0f - t) * (1.0f - t);
+            b += (1.0f - t) * t;
+            c += t * t;
+            for (uint32_t ch = 0; ch < channelCount; ch++)
+            {
+                rhs0[ch] += (1.0f - t) * block[i][ch];
+                rhs1[ch] += t * block[i][ch];
+            }
+        }
+
+        float det = a * c - b * b;
+        if (fabsf(det) < 1e-6f)
+        {
+            return false;
+        }
+
+        for (uint32_t ch = 0; ch < channelCount; ch++)
+        {
+            endpoint0[ch] = Clamp255((c * rhs0[ch] - b * rhs1[ch]) / det);
+            endpoint1[ch] = Clamp255((a * rhs1[ch] - b * rhs0[ch]) / det);
+        }
+        return true;
+    }
+
+    static inline void WriteBits(uint8_t* data, uint32_t& offset, uint32_t value, uint32_t bitCount)
+    {
+        for (uint32_t i = 0; i < bitCount; i++, offset++)
+        {
+            data[offset / 8] |= (uint8_t)(((value >> i) & 1) << (offset % 8));
+        }
+    }
+
+    static inline uint32_t ReadBits(const uint8_t* data, uint32_t& offset, uint32_t bitCount)
+    {
+        uint32_t value = 0;
+        for (uint32_t i = 0; i < bitCount; i++, offset++)
+        {
+            value |= (uint32_t)((data[offset / 8] >> (offset % 8)) & 1) << i;
+        }
+        return value;
+    }
+
+    // ---------------------------------------------------------------- BC1
+
+    static inline uint16_t QuantizeRGB565(const float color[4])
+    {
+        uint32_t r = (uint32_t)(Clamp255(color[0]) * 31.0f / 255.0f + 0.5f);
+        uint32_t g = (uint32_t)(Clamp255(color[1]) * 63.0f / 255.0f + 0.5f);
+        uint32_t b = (uint32_t)(Clamp255(color[2]) * 31.0f / 255.0f + 0.5f);
+        return (uint16_t)((r << 11) | (g << 5) | b);
+    }
+
+    static inline void DequantizeRGB565(uint16_t value, int color[3])
+    {
+        uint32_t r = (value >> 11) & 31;
+        uint32_t g = (value >> 5) & 63;
+        uint32_t b = value & 31;
+        color[0] = (int)((r << 3) | (r >> 2));
+        color[1] = (int)((g << 2) | (g >> 4));
+        color[2] = (int)((b << 3) | (b >> 2));
+    }
+
+    static void GetBC1Palette(uint16_t color0, uint16_t color1, bool fourColorMode, int palette[4][4])
+    {
+        DequantizeRGB565(color0, palette[0]);
+        DequantizeRGB565(color1, palette[1]);
+        for (uint32_t c = 0; c < 3; c++)
+        {
+            if (fourColorMode)
+            {
+                palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+                palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+            }
+            else
+            {
+                palette[2][c] = (palette[0][c] + palette[1][c] + 1) / 2;
+                palette[3][c] = 0;
+            }
+        }
+        palette[0][3] = palette[1][3] = palette[2][3] = 255;
+        palette[3][3] = fourColorMode ? 255 : 0;
+    }
+
+    // 总是使用 4 色模式，BC3 的颜色块也只支持 4 色
+    static void EncodeBC1Block(const float block[16][4], uint8_t* output)
+    {
+        static const float INDEX_WEIGHTS[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+        float endpoint0[4], endpoint1[4];
+        FitPrincipalAxis(block, 3, endpoint0, endpoint1);
+
+        float bestError = FLT_MAX;
+        uint16_t bestColor0 = 0, bestColor1 = 0;
+        uint32_t bestIndices = 0;
+
+        for (uint32_t iteration = 0; iteration < REFINE_ITERATIONS; iteration++)
+        {
+            uint16_t color0 = QuantizeRGB565(endpoint0);
+            uint16_t color1 = QuantizeRGB565(endpoint1);
+            if (color0 < color1)
+            {
+                eastl::swap(color0, color1);
+            }
+
+            int palette[4][4];
+            GetBC1Palette(color0, color1, true, palette);
+
+            float error = 0.0f;
+            uint32_t indices = 0;
+            float weights[16];
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                uint32_t bestIndex = 0;
+                float bestDistance = FLT_MAX;
+                for (uint32_t p = 0; p < (color0 == color1 ? 1u : 4u); p++)
+                {
+                    float distance = 0.0f;
+                    for (uint32_t c = 0; c < 3; c++)
+                    {
+                        float d = block[i][c] - (float)palette[p][c];
+                        distance += d * d;
+                    }
+                    if (distance < bestDistance)
+                    {
+                        bestDistance = distance;
+                        bestIndex = p;
+                    }
+                }
+                error += bestDistance;
+                indices |= bestIndex << (i * 2);
+                weights[i] = INDEX_WEIGHTS[bestIndex];
+            }
+
+            if (error < bestError)
+            {
+                bestError = error;
+                bestColor0 = color0;
+                bestColor1 = color1;
+                bestIndices = indices;
+            }
+
+            if (error == 0.0f || color0 == color1 || !RefineEndpoints(block, 3, weights, endpoint0, endpoint1))
+            {
+                break;
+            }
+        }
+
+        output[0] = (uint8_t)(bestColor0 & 0xFF);
+        output[1] = (uint8_t)(bestColor0 >> 8);
+        output[2] = (uint8_t)(bestColor1 & 0xFF);
+        output[3] = (uint8_t)(bestColor1 >> 8);
+        memcpy(output + 4, &bestIndices, sizeof(uint32_t));
+    }
+
+    static void DecodeBC1Block(const uint8_t* input, bool forceFourColorMode, int block[16][4])
+    {
+        uint16_t color0 = (uint16_t)(input[0] | (input[1] << 8));
+        uint16_t color1 = (uint16_t)(input[2] | (input[3] << 8));
+        uint32_t indices;
+        memcpy(&indices, input + 4, sizeof(uint32_t));
+
+        int palette[4][4];
+        GetBC1Palette(color0, color1, forceFourColorMode || color0 > color1, palette);
+
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            memcpy(block[i], palette[(indices >> (i * 2)) & 3], sizeof(int) * 4);
+        }
+    }
+
+    // ---------------------------------------------------------------- BC4
+
+    static void GetBC4Palette(uint32_t endpoint0, uint32_t endpoint1, int palette[8])
+    {
+        palette[0] = (int)endpoint0;
+        palette[1] = (int)endpoint1;
+        if (endpoint0 > endpoint1)
+        {
+            for (uint32_t i = 2; i < 8; i++)
+            {
+                palette[i] = (int)(((8 - i) * endpoint0 + (i - 1) * endpoint1 + 3) / 7);
+            }
+        }
+        else
+        {
+            for (uint32_t i = 2; i < 6; i++)
+            {
+                palette[i] = (int)(((6 - i) * endpoint0 + (i - 1) * endpoint1 + 2) / 5);
+            }
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+    }
+
+    static float SelectBC4Indices(const float values[16], const int palette[8], uint64_t& indices)
+    {
+        float error = 0.0f;
+        indices = 0;
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            uint32_t bestIndex = 0;
+            float bestDistance = FLT_MAX;
+            for (uint32_t p = 0; p < 8; p++)
+            {
+                float d = values[i] - (float)palette[p];
+                if (d * d < bestDistance)
+                {
+                    bestDistance = d * d;
+                    bestIndex = p;
+                }
+            }
+            error += bestDistance;
+            indices |= (uint64_t)bestIndex << (i * 3);
+        }
+        return error;
+    }
+
+    // 分别尝试 8 级插值和带 0/255 的 6 级插值，取误差小的
+    static void EncodeBC4Block(const float values[16], uint8_t* output)
+    {
+        float minValue = 255.0f, maxValue = 0.0f;
+        float minInner = 255.0f, maxInner = 0.0f;
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            minValue = eastl::min(minValue, values[i]);
+            maxValue = eastl::max(maxValue, values[i]);
+            if (values[i] > 0.0f && values[i] < 255.0f)
+            {
+                minInner = eastl::min(minInner, values[i]);
+                maxInner = eastl::max(maxInner, values[i]);
+            }
+        }
+
+        int palette[8];
+        uint64_t indices;
+
+        uint32_t endpoint0 = (uint32_t)(maxValue + 0.5f);
+        uint32_t endpoint1 = (uint32_t)(minValue + 0.5f);
+        GetBC4Palette(endpoint0, endpoint1, palette);
+        float bestError = SelectBC4Indices(values, palette, indices);
+        uint32_t bestEndpoint0 = endpoint0;
+        uint32_t bestEndpoint1 = endpoint1;
+        uint64_t bestIndices = indices;
+
+        if (minInner <= maxInner && bestError > 0.0f)
+        {
+            endpoint0 = (uint32_t)(minInner + 0.5f);
+            endpoint1 = (uint32_t)(maxInner + 0.5f);
+            GetBC4Palette(endpoint0, endpoint1, palette);
+            float error = SelectBC4Indices(values, palette, indices);
+            if (error < bestError)
+            {
+                bestEndpoint0 = endpoint0;
+                bestEndpoint1 = endpoint1;
+                bestIndices = indices;
+            }
+        }
+
+        output[0] = (uint8_t)bestEndpoint0;
+        output[1] = (uint8_t)bestEndpoint1;
+        for (uint32_t i = 0; i < 6; i++)
+        {
+            output[2 + i] = (uint8_t)(bestIndices >> (i * 8));
+        }
+    }
+
+    static void DecodeBC4Block(const uint8_t* input, int values[16])
+    {
+        int palette[8];
+        GetBC4Palette(input[0], input[1], palette);
+
+        uint64_t indices = 0;
+        for (uint32_t i = 0; i < 6; i++)
+        {
+            indices |= (uint64_t)input[2 + i] << (i * 8);
+        }
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            values[i] = palette[(indices >> (i * 3)) & 7];
+        }
+    }
+
+    static void EncodeBC4Channel(const float block[16][4], uint32_t channel, uint8_t* output)
+    {
+        float values[16];
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            values[i] = block[i][channel];
+        }
+        EncodeBC4Block(values, output);
+    }
+
+    // ---------------------------------------------------------------- BC7
+
+    static void QuantizeBC7Endpoint(const float color[4], uint32_t quantized[4], uint32_t& pbit)
+    {
+        float bestError = FLT_MAX;
+        for (uint32_t p = 0; p < 2; p++)
+        {
+            uint32_t candidate[4];
+            float error = 0.0f;
+            for (uint32_t c = 0; c < 4; c++)
+            {
+                int q = (int)((color[c] - (float)p) * 0.5f + 0.5f);
+                candidate[c] = (uint32_t)eastl::min(eastl::max(q, 0), 127);
+                float d = color[c] - (float)((candidate[c] << 1) | p);
+                error += d * d;
+            }
+            if (error < bestError)
+            {
+                bestError = error;
+                pbit = p;
+                memcpy(quantized, candidate, sizeof(candidate));
+            }
+        }
+    }
+
+    static void GetBC7Palette(const uint32_t quantized0[4], uint32_t pbit0, const uint32_t quantized1[4], uint32_t pbit1, int palette[16][4])
+    {
+        for (uint32_t c = 0; c < 4; c++)
+        {
+            uint32_t e0 = (quantized0[c] << 1) | pbit0;
+            uint32_t e1 = (quantized1[c] << 1) | pbit1;
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                palette[i][c] = (int)(((64 - BC7_WEIGHTS[i]) * e0 + BC7_WEIGHTS[i] * e1 + 32) >> 6);
+            }
+        }
+    }
+
+    // 只使用 mode 6：单个分区，RGBA 端点 7 位 + p-bit，4 位索引
+    static void EncodeBC7Block(const float block[16][4], uint8_t* output)
+    {
+        float endpoint0[4], endpoint1[4];
+        FitPrincipalAxis(block, 4, endpoint0, endpoint1);
+
+        float bestError = FLT_MAX;
+        uint32_t bestQuantized0[4] = {}, bestQuantized1[4] = {};
+        uint32_t bestPBit0 = 0, bestPBit1 = 0;
+        uint32_t bestIndices[16] = {};
+
+        for (uint32_t iteration = 0; iteration < REFINE_ITERATIONS; iteration++)
+        {
+            uint32_t quantized0[4], quantized1[4];
+            uint32_t pbit0, pbit1;
+            QuantizeBC7Endpoint(endpoint0, quantized0, pbit0);
+            QuantizeBC7Endpoint(endpoint1, quantized1, pbit1);
+
+            int palette[16][4];
+            GetBC7Palette(quantized0, pbit0, quantized1, pbit1, palette);
+
+            float error = 0.0f;
+            uint32_t indices[16];
+            float weights[16];
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                uint32_t bestIndex = 0;
+                float bestDistance = FLT_MAX;
+                for (uint32_t p = 0; p < 16; p++)
+                {
+                    float distance = 0.0f;
+                    for (uint32_t c = 0; c < 4; c++)
+                    {
+                        float d = block[i][c] - (float)palette[p][c];
+                        distance += d * d;
+                    }
+                    if (distance < bestDistance)
+                    {
+                        bestDistance = distance;
+                        bestIndex = p;
+                    }
+                }
+                error += bestDistance;
+                indices[i] = bestIndex;
+                weights[i] = (float)BC7_WEIGHTS[bestIndex] / 64.0f;
+            }
+
+            if (error < bestError)
+            {
+                bestError = error;
+                memcpy(bestQuantized0, quantized0, sizeof(quantized0));
+                memcpy(bestQuantized1, quantized1, sizeof(quantized1));
+                bestPBit0 = pbit0;
+                bestPBit1 = pbit1;
+                memcpy(bestIndices, indices, sizeof(indices));
+            }
+
+            if (error == 0.0f || !RefineEndpoints(block, 4, weights, endpoint0, endpoint1))
+            {
+                break;
+            }
+        }
+
+        // 第一个像素是锚点，索引最高位隐含为 0
+        if (bestIndices[0] >= 8)
+        {
+            for (uint32_t c = 0; c < 4; c++)
+            {
+                eastl::swap(bestQuantized0[c], bestQuantized1[c]);
+            }
+            eastl::swap(bestPBit0, bestPBit1);
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                bestIndices[i] = 15 - bestIndices[i];
+            }
+        }
+
+        memset(output, 0, 16);
+        uint32_t offset = 0;
+        WriteBits(output, offset, 1 << 6, 7);
+        for (uint32_t c = 0; c < 4; c++)
+        {
+            WriteBits(output, offset, bestQuantized0[c], 7);
+            WriteBits(output, offset, bestQuantized1[c], 7);
+        }
+        WriteBits(output, offset, bestPBit0, 1);
+        WriteBits(output, offset, bestPBit1, 1);
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            WriteBits(output, offset, bestIndices[i], i == 0 ? 3 : 4);
+        }
+        assert(offset == 128);
+    }
+
+    static bool DecodeBC7Block(const uint8_t* input, int block[16][4])
+    {
+        uint32_t offset = 0;
+        if (ReadBits(input, offset, 7) != (1 << 6))
+        {
+            return false;
+        }
+
+        uint32_t quantized0[4], quantized1[4];
+        for (uint32_t c = 0; c < 4; c++)
+        {
+            quantized0[c] = ReadBits(input, offset, 7);
+            quantized1[c] = ReadBits(input, offset, 7);
+        }
+        uint32_t pbit0 = ReadBits(input, offset, 1);
+        uint32_t pbit1 = ReadBits(input, offset, 1);
+
+        int palette[16][4];
+        GetBC7Palette(quantized0, pbit0, quantized1, pbit1, palette);
+
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            uint32_t index = ReadBits(input, offset, i == 0 ? 3 : 4);
+            memcpy(block[i], palette[index], sizeof(int) * 4);
+        }
+        return true;
+    }
+
+    // ----------------------------------------------------------------
+
+    RHI::ERHIFormat SelectCompressedFormat(ETextureRole role, bool srgb, bool hasAlpha)
+    {
+        switch (role)
+        {
+        case ETextureRole::Albedo:
+            if (hasAlpha)
+            {
+                return srgb ? RHI::ERHIFormat::BC3SRGB : RHI::ERHIFormat::BC3UNORM;
+            }
+            return srgb ? RHI::ERHIFormat::BC1SRGB : RHI::ERHIFormat::BC1UNORM;
+        case ETextureRole::Normal:
+            return RHI::ERHIFormat::BC5UNORM;
+        case ETextureRole::RoughnessMetallic:
+            return srgb ? RHI::ERHIFormat::BC7SRGB : RHI::ERHIFormat::BC7UNORM;
+        case ETextureRole::Occlusion:
+            return RHI::ERHIFormat::BC4UNORM;
+        default:
+            return RHI::ERHIFormat::Unknown;
+        }
+    }
+
+    uint32_t GetCompressedSize(RHI::ERHIFormat format, uint32_t width, uint32_t height)
+    {
+        return ((width + 3) / 4) * ((height + 3) / 4) * GetBlockSize(format);
+    }
+
+    bool CompressTexture(const uint8_t *rgba, uint32_t width, uint32_t height, RHI::ERHIFormat format, eastl::vector<uint8_t> &output)
+    {
+        uint32_t blockSize = GetBlockSize(format);
+        if (blockSize == 0 || width == 0 || height == 0)
+        {
+            return false;
+        }
+
+        uint32_t blockCountX = (width + 3) / 4;
+        uint32_t blockCountY = (height + 3) / 4;
+        size_t offset = output.size();
+        output.resize(offset + blockCountX * blockCountY * blockSize);
+
+        for (uint32_t blockY = 0; blockY < blockCountY; blockY++)
+        {
+            for (uint32_t blockX = 0; blockX < blockCountX; blockX++)
+            {
+                float block[16][4];
+                LoadBlock(rgba, width, height, blockX, blockY, block);
+
+                uint8_t* data = output.data() + offset + (blockY * blockCountX + blockX) * blockSize;
+                switch (format)
+                {
+                case RHI::ERHIFormat::BC1UNORM:
+                case RHI::ERHIFormat::BC1SRGB:
+                    EncodeBC1Block(block, data);
+                    break;
+                case RHI::ERHIFormat::BC3UNORM:
+                case RHI::ERHIFormat::BC3SRGB:
+                    EncodeBC4Channel(block, 3, data);
+                    EncodeBC1Block(block, data + 8);
+                    break;
+                case RHI::ERHIFormat::BC4UNORM:
+                    EncodeBC4Channel(block, 0, data);
+                    break;
+                case RHI::ERHIFormat::BC5UNORM:
+                    EncodeBC4Channel(block, 0, data);
+                    EncodeBC4Channel(block, 1, data + 8);
+                    break;
+                case RHI::ERHIFormat::BC7UNORM:
+                case RHI::ERHIFormat::BC7SRGB:
+                    EncodeBC7Block(block, data);
+                    break;
+                default:
+                    assert(false);
+                    break;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool DecompressTexture(const uint8_t *data, uint32_t width, uint32_t height, RHI::ERHIFormat format, eastl::vector<uint8_t> &rgba)
+    {
+        uint32_t blockSize = GetBlockSize(format);
+        if (blockSize == 0)
+        {
+            return false;
+        }
+
+        uint32_t blockCountX = (width + 3) / 4;
+        uint32_t blockCountY = (height + 3) / 4;
+        rgba.resize(width * height * 4);
+
+        for (uint32_t blockY = 0; blockY < blockCountY; blockY++)
+        {
+            for (uint32_t blockX = 0; blockX < blockCountX; blockX++)
+            {
+                const uint8_t* input = data + (blockY * blockCountX + blockX) * blockSize;
+                int block[16][4];
+                int values[16];
+
+                switch (format)
+                {
+                case RHI::ERHIFormat::BC1UNORM:
+                case RHI::ERHIFormat::BC1SRGB:
+                    DecodeBC1Block(input, false, block);
+                    break;
+                case RHI::ERHIFormat::BC3UNORM:
+                case RHI::ERHIFormat::BC3SRGB:
+                    DecodeBC1Block(input + 8, true, block);
+                    DecodeBC4Block(input, values);
+                    for (uint32_t i = 0; i < 16; i++)
+                    {
+                        block[i][3] = values[i];
+                    }
+                    break;
+                case RHI::ERHIFormat::BC4UNORM:
+                    DecodeBC4Block(input, values);
+                    for (uint32_t i = 0; i < 16; i++)
+                    {
+                        block[i][0] = values[i];
+                        block[i][1] = block[i][2] = 0;
+                        block[i][3] = 255;
+                    }
+                    break;
+                case RHI::ERHIFormat::BC5UNORM:
+                    DecodeBC4Block(input, values);
+                    for (uint32_t i = 0; i < 16; i++)
+                    {
+                        block[i][0] = values[i];
+                    }
+                    DecodeBC4Block(input + 8, values);
+                    for (uint32_t i = 0; i < 16; i++)
+                    {
+                        block[i][1] = values[i];
+                        block[i][2] = 0;
+                        block[i][3] = 255;
+                    }
+                    break;
+                case RHI::ERHIFormat::BC7UNORM:
+                case RHI::ERHIFormat::BC7SRGB:
+                    if (!DecodeBC7Block(input, block))
+                    {
+                        return false;
+                    }
+                    break;
+                default:
+                    return false;
+                }
+
+                StoreBlock(block, width, height, blockX, blockY, rgba.data());
+            }
+        }
+        return true;
+    }
+}
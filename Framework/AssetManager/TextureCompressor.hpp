@@ -0,0 +1,30 @@
+#pragma once
+
+#include "RHI/RHICommon.hpp"
+
+#include <EASTL/vector.h>
+
+namespace Assets
+{
+    // 纹理在材质中的用途，决定压缩格式和 mip 的过滤方式
+    enum class ETextureRole : uint32_t
+    {
+        Generic,                // 不压缩，UI 等需要精确像素的纹理
+        Albedo,                 // 颜色：不透明 BC1，带 alpha 时 BC3
+        Normal,                 // 切线空间法线：BC5 只保留 XY，Z 在 shader 中重建
+        RoughnessMetallic,      // 多通道相互独立的数据：BC7
+        Occlusion,              // 单通道：BC4
+    };
+
+    // Generic 或不支持的组合返回 Unknown
+    RHI::ERHIFormat SelectCompressedFormat(ETextureRole role, bool srgb, bool hasAlpha);
+
+    uint32_t GetCompressedSize(RHI::ERHIFormat format, uint32_t width, uint32_t height);
+
+    // 输入为 RGBA8，边缘不足 4 个像素的块按 clamp 填充，结果按块行紧密排列追加到 output
+    // 只依赖整数和单精度运算，相同输入总是得到相同输出
+    bool CompressTexture(const uint8_t* rgba, uint32_t width, uint32_t height, RHI::ERHIFormat format, eastl::vector<uint8_t>& output);
+
+    // 解码为 RGBA8，BC7 只支持编码器产生的 mode 6
+    bool DecompressTexture(const uint8_t* data, uint32_t width, uint32_t height, RHI::ERHIFormat format, eastl::vector<uint8_t>& rgba);
+}
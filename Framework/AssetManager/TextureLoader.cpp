@@ -1,10 +1,13 @@
 #include "TextureLoader.hpp"
+#include "Utilities/Hash.hpp"
 #include "Utilities/Log.hpp"
+#include "Utilities/Math.hpp"
 
 #include "ddspp/ddspp.h"
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 #include <fstream>
+#include <filesystem>
 
 #define STB_IMAGE_RESIZE_IMPLEMENTATION
 #include <stb_image_resize2.h>
@@ -143,8 +146,89 @@ static inline RHI::ERHIFormat GetTextureFormat(ddspp::DXGIFormat format, bool sr
     }
 }
 
+static inline stbir_datatype GetResizeDataType(RHI::ERHIFormat format)
+{
+    switch (format)
+    {
+    case RHI::ERHIFormat::RGBA8SRGB:
+        return STBIR_TYPE_UINT8_SRGB;
+    case RHI::ERHIFormat::R8UNORM:
+    case RHI::ERHIFormat::RG8UNORM:
+    case RHI::ERHIFormat::RGBA8UNORM:
+        return STBIR_TYPE_UINT8;
+    case RHI::ERHIFormat::R16UNORM:
+    case RHI::ERHIFormat::RG16UNORM:
+    case RHI::ERHIFormat::RGBA16UNORM:
+        return STBIR_TYPE_UINT16;
+    default:
+        return STBIR_TYPE_FLOAT;
+    }
+}
+
+static inline stbir_pixel_layout GetResizePixelLayout(RHI::ERHIFormat format, bool normalMap)
+{
+    switch (format)
+    {
+    case RHI::ERHIFormat::R8UNORM:
+    case RHI::ERHIFormat::R16UNORM:
+    case RHI::ERHIFormat::R32F:
+        return STBIR_1CHANNEL;
+    case RHI::ERHIFormat::RG8UNORM:
+    case RHI::ERHIFormat::RG16UNORM:
+    case RHI::ERHIFormat::RG32F:
+        return STBIR_2CHANNEL;
+    default:
+        // 颜色按 alpha 加权过滤，避免透明像素的颜色渗出；数据纹理的 4 个通道相互独立
+        return format == RHI::ERHIFormat::RGBA8SRGB && !normalMap ? STBIR_RGBA : STBIR_4CHANNEL;
+    }
+}
+
+// 缩小后的法线长度小于 1，重新归一化以保持光照强度
+template<typename T>
+static void RenormalizeNormals(T* data, uint32_t pixelCount, uint32_t channels)
+{
+    if (channels < 3)
+    {
+        return;
+    }
+
+    const float maxValue = (float)((1u << (sizeof(T) * 8)) - 1);
+    for (uint32_t i = 0; i < pixelCount; i++)
+    {
+        T* pixel = data + i * channels;
+        float3 normal = float3(pixel[0], pixel[1], pixel[2]) / maxValue * 2.0f - 1.0f;
+        float len = length(normal);
+        normal = len > 0.0f ? normal / len : float3(0.0f, 0.0f, 1.0f);
+
+        float3 encoded = (normal * 0.5f + 0.5f) * maxValue + 0.5f;
+        pixel[0] = (T)encoded.x;
+        pixel[1] = (T)encoded.y;
+        pixel[2] = (T)encoded.z;
+    }
+}
+
 namespace Assets
 {
+    static const uint32_t COMPRESSED_TEXTURE_MAGIC = 0x43544256; // "VBTC"
+    // 编码器输出或文件格式变化时需要递增，旧缓存随之失效
+    static const uint32_t COMPRESSED_TEXTURE_VERSION = 1;
+
+    struct FCompressedTextureHeader
+    {
+        uint32_t Magic;
+        uint32_t Version;
+        uint64_t SourceHash;
+        uint32_t Role;
+        uint32_t SRGB;
+        uint32_t Format;
+        uint32_t Width;
+        uint32_t Height;
+        uint32_t MipLevels;
+        uint64_t DataHash;
+        uint32_t DataSize;
+        uint32_t _Padding;
+    };
+
     FTextureLoader::~FTextureLoader()
     {
         if (m_pDecompressedData)
@@ -153,7 +237,7 @@ namespace Assets
         }
     }
 
-    bool FTextureLoader::Load(const eastl::string &filename, bool srgb)
+    bool FTextureLoader::Load(const eastl::string &filename, bool srgb, ETextureRole role)
     {
         std::ifstream is;
         is.open(filename.c_str(), std::ios::binary);
@@ -177,10 +261,30 @@ namespace Assets
         {
             return LoadDDS(srgb);
         }
-        else
+
+        bool normalMap = role == ETextureRole::Normal;
+        if (role == ETextureRole::Generic)
+        {
+            return LoadSTB(srgb) && GenerateMips(false);
+        }
+
+        eastl::string cachePath = filename + ".bc";
+        uint64_t sourceHash = Utility::FHashUtils::CityHash(m_FileData.data(), m_FileData.size());
+        if (LoadCompressedCache(cachePath, sourceHash, role, srgb))
         {
-            return LoadSTB(srgb);
+            return true;
         }
+
+        if (!LoadSTB(srgb && !normalMap) || !GenerateMips(normalMap))
+        {
+            return false;
+        }
+        // 不满足压缩条件时保留未压缩的 mip 链
+        if (CompressMips(role))
+        {
+            StoreCompressedCache(cachePath, sourceHash, role, srgb);
+        }
+        return true;
     }
 
     bool FTextureLoader::Resize(uint32_t width, uint32_t height)
@@ -205,6 +309,240 @@ namespace Assets
         return true;
     }
 
+    bool FTextureLoader::GenerateMips(bool normalMap)
+    {
+        uint32_t mipLevels = 1;
+        while ((eastl::max(m_Width, m_Height) >> mipLevels) > 0)
+        {
+            mipLevels++;
+        }
+
+        uint32_t totalSize = 0;
+        for (uint32_t mip = 0; mip < mipLevels; mip++)
+        {
+            totalSize += GetFormatRowPitch(m_Format, eastl::max(m_Width >> mip, 1u)) * eastl::max(m_Height >> mip, 1u);
+        }
+
+        m_MipData.resize(totalSize);
+        memcpy(m_MipData.data(), m_pDecompressedData, m_TextureSize);
+
+        stbir_datatype dataType = GetResizeDataType(m_Format);
+        stbir_pixel_layout pixelLayout = GetResizePixelLayout(m_Format, normalMap);
+        uint32_t channels = pixelLayout == STBIR_1CHANNEL ? 1 : (pixelLayout == STBIR_2CHANNEL ? 2 : 4);
+
+        // 每一级由上一级缩小得到，wrap 边界与材质的 repeat 采样一致
+        uint32_t srcOffset = 0;
+        uint32_t dstOffset = m_TextureSize;
+        for (uint32_t mip = 1; mip < mipLevels; mip++)
+        {
+            uint32_t srcWidth = eastl::max(m_Width >> (mip - 1), 1u);
+            uint32_t srcHeight = eastl::max(m_Height >> (mip - 1), 1u);
+            uint32_t dstWidth = eastl::max(m_Width >> mip, 1u);
+            uint32_t dstHeight = eastl::max(m_Height >> mip, 1u);
+            uint32_t srcRowPitch = GetFormatRowPitch(m_Format, srcWidth);
+            uint32_t dstRowPitch = GetFormatRowPitch(m_Format, dstWidth);
+
+            uint8_t* srcData = m_MipData.data() + srcOffset;
+            uint8_t* dstData = m_MipData.data() + dstOffset;
+            if (stbir_resize(srcData, srcWidth, srcHeight, srcRowPitch, dstData, dstWidth, dstHeight, dstRowPitch, pixelLayout, dataType, STBIR_EDGE_WRAP, STBIR_FILTER_DEFAULT) == nullptr)
+            {
+                VTNA_LOG_DEBUG("[TextureLoader::GenerateMips] failed to resize mip {}", mip);
+                m_MipData.clear();
+                return false;
+            }
+
+            if (normalMap)
+            {
+                if (dataType == STBIR_TYPE_UINT8)
+                {
+                    RenormalizeNormals((uint8_t*)dstData, dstWidth * dstHeight, channels);
+                }
+                else if (dataType == STBIR_TYPE_UINT16)
+                {
+                    RenormalizeNormals((uint16_t*)dstData, dstWidth * dstHeight, channels);
+                }
+            }
+
+            srcOffset = dstOffset;
+            dstOffset += dstRowPitch * dstHeight;
+        }
+
+        stbi_image_free(m_pDecompressedData);
+        m_pDecompressedData = nullptr;
+
+        m_MipLevels = mipLevels;
+        m_TextureSize = totalSize;
+        return true;
+    }
+
+    bool FTextureLoader::CompressMips(ETextureRole role)
+    {
+        uint32_t channels = 0;
+        switch (m_Format)
+        {
+        case RHI::ERHIFormat::R8UNORM:
+            channels = 1;
+            break;
+        case RHI::ERHIFormat::RG8UNORM:
+            channels = 2;
+            break;
+        case RHI::ERHIFormat::RGBA8UNORM:
+        case RHI::ERHIFormat::RGBA8SRGB:
+            channels = 4;
+            break;
+        default:
+            return false;
+        }
+
+        // BC 纹理的第 0 级尺寸必须是 4 的倍数
+        if (m_MipData.empty() || m_Width % 4 != 0 || m_Height % 4 != 0)
+        {
+            return false;
+        }
+
+        bool hasAlpha = false;
+        if (channels == 4)
+        {
+            for (uint32_t i = 0; i < m_Width * m_Height && !hasAlpha; i++)
+            {
+                hasAlpha = m_MipData[i * 4 + 3] != 255;
+            }
+        }
+
+        RHI::ERHIFormat format = SelectCompressedFormat(role, m_Format == RHI::ERHIFormat::RGBA8SRGB, hasAlpha);
+        if (format == RHI::ERHIFormat::Unknown)
+        {
+            return false;
+        }
+
+        uint32_t compressedSize = 0;
+        for (uint32_t mip = 0; mip < m_MipLevels; mip++)
+        {
+            compressedSize += GetCompressedSize(format, eastl::max(m_Width >> mip, 1u), eastl::max(m_Height >> mip, 1u));
+        }
+
+        eastl::vector<uint8_t> compressed;
+        compressed.reserve(compressedSize);
+
+        eastl::vector<uint8_t> rgba;
+        uint32_t offset = 0;
+        for (uint32_t mip = 0; mip < m_MipLevels; mip++)
+        {
+            uint32_t width = eastl::max(m_Width >> mip, 1u);
+            uint32_t height = eastl::max(m_Height >> mip, 1u);
+            const uint8_t* src = m_MipData.data() + offset;
+
+            // 单/双通道补齐成 RGBA，缺失的通道与硬件采样 R8/RG8 的结果一致
+            if (channels != 4)
+            {
+                rgba.resize(width * height * 4);
+                for (uint32_t i = 0; i < width * height; i++)
+                {
+                    rgba[i * 4 + 0] = src[i * channels];
+                    rgba[i * 4 + 1] = channels > 1 ? src[i * channels + 1] : 0;
+                    rgba[i * 4 + 2] = 0;
+                    rgba[i * 4 + 3] = 255;
+                }
+                src = rgba.data();
+            }
+
+            if (!CompressTexture(src, width, height, format, compressed))
+            {
+                return false;
+            }
+            offset += GetFormatRowPitch(m_Format, width) * height;
+        }
+
+        m_MipData.swap(compressed);
+        m_Format = format;
+        m_TextureSize = (uint32_t)m_MipData.size();
+        return true;
+    }
+
+    bool FTextureLoader::LoadCompressedCache(const eastl::string &path, uint64_t sourceHash, ETextureRole role, bool srgb)
+    {
+        std::ifstream is(path.c_str(), std::ios::binary);
+        if (is.fail())
+        {
+            return false;
+        }
+
+        is.seekg(0, std::ios::end);
+        size_t fileSize = (size_t)is.tellg();
+        is.seekg(0, std::ios::beg);
+
+        FCompressedTextureHeader header {};
+        bool valid = fileSize >= sizeof(FCompressedTextureHeader);
+        if (valid)
+        {
+            is.read((char*)&header, sizeof(header));
+            valid = header.Magic == COMPRESSED_TEXTURE_MAGIC &&
+                header.Version == COMPRESSED_TEXTURE_VERSION &&
+                header.SourceHash == sourceHash &&
+                header.Role == (uint32_t)role &&
+                header.SRGB == (uint32_t)srgb &&
+                header.DataSize == fileSize - sizeof(FCompressedTextureHeader);
+        }
+        if (valid)
+        {
+            m_MipData.resize(header.DataSize);
+            is.read((char*)m_MipData.data(), header.DataSize);
+            valid = !is.fail() && Utility::FHashUtils::CityHash(m_MipData.data(), m_MipData.size()) == header.DataHash;
+        }
+        is.close();
+
+        if (!valid)
+        {
+            // 源文件已修改或缓存损坏，重新压缩后覆盖
+            VTNA_LOG_DEBUG("[TextureLoader::LoadCompressedCache] stale cache file: {}", path);
+            m_MipData.clear();
+            return false;
+        }
+
+        m_Width = header.Width;
+        m_Height = header.Height;
+        m_MipLevels = header.MipLevels;
+        m_Format = (RHI::ERHIFormat)header.Format;
+        m_TextureSize = header.DataSize;
+        return true;
+    }
+
+    void FTextureLoader::StoreCompressedCache(const eastl::string &path, uint64_t sourceHash, ETextureRole role, bool srgb)
+    {
+        FCompressedTextureHeader header {};
+        header.Magic = COMPRESSED_TEXTURE_MAGIC;
+        header.Version = COMPRESSED_TEXTURE_VERSION;
+        header.SourceHash = sourceHash;
+        header.Role = (uint32_t)role;
+        header.SRGB = (uint32_t)srgb;
+        header.Format = (uint32_t)m_Format;
+        header.Width = m_Width;
+        header.Height = m_Height;
+        header.MipLevels = m_MipLevels;
+        header.DataHash = Utility::FHashUtils::CityHash(m_MipData.data(), m_MipData.size());
+        header.DataSize = (uint32_t)m_MipData.size();
+
+        // 多个流送任务可能同时压缩同一张纹理，各自写临时文件再重命名
+        eastl::string tempPath = path + ".tmp" + eastl::to_string((uint64_t)(uintptr_t)this);
+
+        std::ofstream os(tempPath.c_str(), std::ios::binary | std::ios::trunc);
+        if (os.fail())
+        {
+            VTNA_LOG_DEBUG("[TextureLoader::StoreCompressedCache] failed to write cache file: {}", tempPath);
+            return;
+        }
+        os.write((const char*)&header, sizeof(header));
+        os.write((const char*)m_MipData.data(), m_MipData.size());
+        os.close();
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath.c_str(), path.c_str(), ec);
+        if (ec)
+        {
+            std::filesystem::remove(tempPath.c_str(), ec);
+        }
+    }
+
     bool FTextureLoader::LoadDDS(bool srgb)
     {
         uint8_t* data = m_FileData.data();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RHI/RHI.hpp"
+#include "TextureCompressor.hpp"
 
 namespace Assets
 {
@@ -10,7 +11,9 @@ namespace Assets
         FTextureLoader() = default;
         ~FTextureLoader();
 
-        bool Load(const eastl::string& filename, bool srgb);
+        // stb 解码的纹理会在 CPU 上生成完整的 mip 链，法线贴图每级重新归一化
+        // role 不为 Generic 时再按用途压缩成 BC 格式，结果缓存在源文件旁的 .bc 文件中
+        bool Load(const eastl::string& filename, bool srgb, ETextureRole role = ETextureRole::Generic);
 
         uint32_t GetWidth() const { return m_Width; }
         uint32_t GetHeight() const { return m_Height; }
@@ -20,7 +23,7 @@ namespace Assets
         RHI::ERHIFormat GetFormat() const { return m_Format; }
         RHI::ERHITextureType GetType() const { return m_Type; }
 
-        void* GetData() const { return m_pDecompressedData != nullptr ? m_pDecompressedData : m_pTextureData; }
+        void* GetData() const { return !m_MipData.empty() ? (void*)m_MipData.data() : m_pDecompressedData != nullptr ? m_pDecompressedData : m_pTextureData; }
         uint32_t GetDataSize() const { return m_TextureSize; }
 
         bool Resize(uint32_t width, uint32_t height);
@@ -28,6 +31,11 @@ namespace Assets
     private:
         bool LoadDDS(bool srgb);
         bool LoadSTB(bool srgb);
+        bool GenerateMips(bool normalMap);
+        bool CompressMips(ETextureRole role);
+
+        bool LoadCompressedCache(const eastl::string& path, uint64_t sourceHash, ETextureRole role, bool srgb);
+        void StoreCompressedCache(const eastl::string& path, uint64_t sourceHash, ETextureRole role, bool srgb);
 
     private:
         uint32_t m_Width = 1;
@@ -43,5 +51,7 @@ namespace Assets
         uint32_t m_TextureSize = 0;
 
         eastl::vector<uint8_t> m_FileData;
+        // 所有 mip 依次紧密排列，与 FRendererBase::UploadTexture 的输入布局一致
+        eastl::vector<uint8_t> m_MipData;
     };
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "Editor/VultanaEditor.hpp"
 #include "Utilities/Log.hpp"
 #include "Utilities/String.hpp"
+#include "Renderer/TextureStreamer.hpp"
 
 #include <rpmalloc/rpmalloc.h>
 #include <spdlog/sinks/msvc_sink.h>
@@ -37,6 +38,8 @@ namespace Core
         spdlog::flush_every(std::chrono::milliseconds(10));
 
         enki::TaskSchedulerConfig tsConfig;
+        // 渲染线程
+        tsConfig.numExternalTaskThreads = 1;
         tsConfig.profilerCallbacks.threadStart = [](uint32_t i)
         {
             rpmalloc_thread_initialize();
@@ -73,6 +76,10 @@ namespace Core
         m_ShaderPath = configIni.GetValue("Vultana", "ShaderPath");
 
         RHI::ERHIRenderBackend renderBackend = RHI::ERHIRenderBackend::Vulkan;
+        if (strcmp(configIni.GetValue("Renderer", "RenderBackend", "Vulkan"), "Null") == 0)
+        {
+            renderBackend = RHI::ERHIRenderBackend::Null;
+        }
 
         m_pRenderer = eastl::make_unique<Renderer::FRendererBase>();
         if (!m_pRenderer->CreateDevice(renderBackend, m_WndHandle, width, height))
@@ -80,17 +87,27 @@ namespace Core
             VTNA_LOG_ERROR("Failed to create renderer device");
             exit(0);
         }
+        m_pRenderer->GetRenderGraph()->SetParallelRecording(configIni.GetBoolValue("Renderer", "ParallelRecording", true));
+        m_pRenderer->GetTextureStreamer()->SetUploadBudget((uint32_t)configIni.GetLongValue("Renderer", "TextureStreamingBudgetMB", 32) * 1024 * 1024);
 
         m_pWorld = eastl::make_unique<Scene::FWorld>();
         m_pWorld->LoadScene(m_AssetsPath + configIni.GetValue("World", "SceneFile"));
+        if (configIni.GetBoolValue("Renderer", "PrecompileShaders", true))
+        {
+            m_pWorld->PrecompileShaders();
+        }
 
         m_pEditor = eastl::make_unique<Editor::FVultanaEditor>(m_pRenderer.get());
 
+        m_pRenderer->SetRenderThreadEnabled(configIni.GetBoolValue("Renderer", "RenderThread", true));
+
         stm_setup();
     }
 
     void FVultanaEngine::Shutdown()
     {
+        // 渲染线程引用 world 和 editor，先让它处理完已提交的帧并退出
+        m_pRenderer->SetRenderThreadEnabled(false);
         m_pTaskScheduler->WaitforAll();
 
         m_pWorld.reset();
@@ -118,9 +135,11 @@ namespace Core
         }
         else
         {
+            // 模拟阶段和上一帧的渲染阶段并行，SubmitFrame 等待渲染线程空闲后交换 frame packet
             m_pEditor->Tick();
             m_pWorld->Tick(m_FrameTime);
-            m_pRenderer->RenderFrame();
+            m_pEditor->EndFrame();
+            m_pRenderer->SubmitFrame();
         }
     }
     
@@ -8,6 +8,15 @@
 
 namespace Editor
 {
+    static void ClearDrawData(ImDrawData* drawData)
+    {
+        for (int n = 0; n < drawData->CmdLists.Size; n++)
+        {
+            IM_DELETE(drawData->CmdLists[n]);
+        }
+        drawData->Clear();
+    }
+
     FImGuiImplement::FImGuiImplement(Renderer::FRendererBase* pRenderer) : m_pRenderer(pRenderer)
     {
         IMGUI_CHECKVERSION();
@@ -30,6 +39,14 @@ namespace Editor
 
     FImGuiImplement::~FImGuiImplement()
     {
+        for (uint32_t i = 0; i < Renderer::FRAME_PACKET_COUNT; i++)
+        {
+            if (m_pDrawData[i])
+            {
+                ClearDrawData(m_pDrawData[i].get());
+            }
+        }
+
         ImGui_ImplWin32_Shutdown();
 
         ImGui::DestroyContext();
@@ -91,16 +108,39 @@ namespace Editor
         ImGuizmo::SetRect(0, 0, io.DisplaySize.x, io.DisplaySize.y);
     }
 
-    void FImGuiImplement::Render(RHI::FRHICommandList *pCmdList)
+    void FImGuiImplement::EndFrame(uint32_t packetIndex)
     {
-        GPU_EVENT_DEBUG(pCmdList, "ImGUI::Render");
-        
         ImGui::Render();
 
+        if (m_pDrawData[packetIndex] == nullptr)
+        {
+            m_pDrawData[packetIndex] = eastl::make_unique<ImDrawData>();
+        }
+        ImDrawData* snapshot = m_pDrawData[packetIndex].get();
+        ClearDrawData(snapshot);
+
+        const ImDrawData* drawData = ImGui::GetDrawData();
+        snapshot->Valid = drawData->Valid;
+        snapshot->TotalIdxCount = drawData->TotalIdxCount;
+        snapshot->TotalVtxCount = drawData->TotalVtxCount;
+        snapshot->DisplayPos = drawData->DisplayPos;
+        snapshot->DisplaySize = drawData->DisplaySize;
+        snapshot->FramebufferScale = drawData->FramebufferScale;
+        for (int n = 0; n < drawData->CmdListsCount; n++)
+        {
+            snapshot->CmdLists.push_back(drawData->CmdLists[n]->CloneOutput());
+        }
+        snapshot->CmdListsCount = snapshot->CmdLists.Size;
+    }
+
+    void FImGuiImplement::Render(RHI::FRHICommandList *pCmdList, uint32_t packetIndex)
+    {
+        GPU_EVENT_DEBUG(pCmdList, "ImGUI::Render");
+
         auto pDevice = m_pRenderer->GetDevice();
-        ImDrawData* drawData = ImGui::GetDrawData();
+        const ImDrawData* drawData = m_pDrawData[packetIndex].get();
 
-        if (drawData->DisplaySize.x <= 0.0f || drawData->DisplaySize.y <= 0.0f)
+        if (drawData == nullptr || drawData->DisplaySize.x <= 0.0f || drawData->DisplaySize.y <= 0.0f)
         {
             return;
         }
@@ -127,7 +167,7 @@ namespace Editor
             vtxDst += cmdList->VtxBuffer.Size;
             idxDst += cmdList->IdxBuffer.Size;
         }
-        SetupRenderStates(pCmdList, frameIndex);
+        SetupRenderStates(pCmdList, drawData, frameIndex);
 
         int globalVtxOffset = 0;
         int globalIdxOffset = 0;
@@ -147,7 +187,7 @@ namespace Editor
                 {
                     if (pCmd->UserCallback == ImDrawCallback_ResetRenderState)
                     {
-                        SetupRenderStates(pCmdList, frameIndex);
+                        SetupRenderStates(pCmdList, drawData, frameIndex);
                     }
                     else
                     {
@@ -185,10 +225,8 @@ namespace Editor
         }
     }
 
-    void FImGuiImplement::SetupRenderStates(RHI::FRHICommandList *pCmdList, uint32_t frameIdx)
+    void FImGuiImplement::SetupRenderStates(RHI::FRHICommandList *pCmdList, const ImDrawData* drawData, uint32_t frameIdx)
     {
-        ImDrawData* drawData = ImGui::GetDrawData();
-
         pCmdList->SetViewport(0, 0, 
             (uint32_t)(drawData->DisplaySize.x * drawData->FramebufferScale.x),
             (uint32_t)(drawData->DisplaySize.y * drawData->FramebufferScale.y));
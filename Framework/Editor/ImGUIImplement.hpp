@@ -5,6 +5,8 @@
 #include <EASTL/hash_map.h>
 #include <EASTL/functional.h>
 
+struct ImDrawData;
+
 namespace Editor
 {
     class FImGuiImplement
@@ -15,10 +17,13 @@ namespace Editor
 
         bool Init();
         void NewFrame();
-        void Render(RHI::FRHICommandList* pCmdList);
+        // 模拟线程：生成本帧的 draw data 并保存到 packetIndex 对应的副本
+        void EndFrame(uint32_t packetIndex);
+        // 渲染线程：绘制 packetIndex 对应的副本
+        void Render(RHI::FRHICommandList* pCmdList, uint32_t packetIndex);
     
     private:
-        void SetupRenderStates(RHI::FRHICommandList* pCmdList, uint32_t frameIdx);
+        void SetupRenderStates(RHI::FRHICommandList* pCmdList, const ImDrawData* drawData, uint32_t frameIdx);
     
     private:
         Renderer::FRendererBase* m_pRenderer = nullptr;
@@ -27,5 +32,8 @@ namespace Editor
         eastl::unique_ptr<RenderResources::FTexture2D> m_pFontTexture;
         eastl::unique_ptr<RenderResources::FStructuredBuffer> m_pVertexBuffer[RHI::RHI_MAX_INFLIGHT_FRAMES];
         eastl::unique_ptr<RenderResources::FIndexBuffer> m_pIndexBuffer[RHI::RHI_MAX_INFLIGHT_FRAMES];
+
+        // ImGui 在下一次 NewFrame 时复用 draw list，渲染线程使用的是 EndFrame 时深拷贝的副本
+        eastl::unique_ptr<ImDrawData> m_pDrawData[Renderer::FRAME_PACKET_COUNT];
     };
 }
\ No newline at end of file
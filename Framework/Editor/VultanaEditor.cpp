@@ -111,9 +111,13 @@ namespace Editor
         {
             m_pRenderer->GetGPUDrivenStats()->OnGui();
         }
+        if (m_bShowGPUProfiler)
+        {
+            DrawGPUProfiler();
+        }
     }
 
-    void FVultanaEditor::Render(RHI::FRHICommandList *pCmdList)
+    void FVultanaEditor::EndFrame()
     {
         if (m_bShowInspector)
         {
@@ -123,10 +127,15 @@ namespace Editor
         {
             DrawWindow("Settings", &m_bShowSettings);
         }
-        m_pGUI->Render(pCmdList);
+        m_pGUI->EndFrame(m_pRenderer->GetSimPacketIndex());
         m_Commands.clear();
     }
 
+    void FVultanaEditor::Render(RHI::FRHICommandList *pCmdList)
+    {
+        m_pGUI->Render(pCmdList, m_pRenderer->GetRenderPacketIndex());
+    }
+
     void FVultanaEditor::AddGUICommand(const eastl::string &window, const eastl::string &section, const eastl::function<void()> &command)
     {
         m_Commands[window].push_back({ section, command });
@@ -220,11 +229,22 @@ namespace Editor
                     m_pRenderer->SetGPUDrivenStatsEnabled(m_bShowGPUDrivenStats);
                 }
 
+                if (ImGui::MenuItem("GPU Profiler", "", &m_bShowGPUProfiler))
+                {
+                    m_pRenderer->GetRenderGraph()->GetProfiler().SetEnabled(m_bShowGPUProfiler);
+                }
+
                 if (ImGui::MenuItem("Show Meshlets", "", &m_bShowMeshlets))
                 {
                     m_pRenderer->SetShowMeshletsEnabled(m_bShowMeshlets);
                 }
 
+                float lodErrorThreshold = m_pRenderer->GetMeshletLodErrorThreshold();
+                if (ImGui::SliderFloat("Meshlet LOD Error", &lodErrorThreshold, 0.0f, 8.0f, "%.1f px"))
+                {
+                    m_pRenderer->SetMeshletLodErrorThreshold(lodErrorThreshold);
+                }
+
                 if (ImGui::MenuItem("VSync", "", &m_bVSync))
                 {
                     m_pRenderer->GetSwapchain()->SetVSyncEnabled(m_bVSync);
@@ -366,11 +386,159 @@ namespace Editor
         }
 
         ImGui::SetNextWindowPos(windowPos);
-        ImGui::SetNextWindowSize(ImVec2(200.0f, 50.0f));
+        ImGui::SetNextWindowSize(ImVec2(200.0f, 110.0f));
         ImGui::Begin("Frame Stats", nullptr, 
             ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoBackground | 
             ImGuiWindowFlags_NoScrollWithMouse | ImGuiWindowFlags_NoNavInputs | ImGuiWindowFlags_NoNavFocus);
         ImGui::Text("%.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+        const RHI::FRHIPipelineCacheStats& psoStats = m_pRenderer->GetDevice()->GetPipelineCacheStats();
+        ImGui::Text("PSO cache: %u hit / %u miss", psoStats.HitCount, psoStats.MissCount);
+        const RG::FRenderGraphTransientStats& rgStats = m_pRenderer->GetRenderGraph()->GetTransientStats();
+        ImGui::Text("RG transient: %.1f / %.1f MB", rgStats.PackedSize / (1024.0f * 1024.0f), rgStats.RequestedSize / (1024.0f * 1024.0f));
+        const RHI::FRHIBarrierStats& barrierStats = m_pRenderer->GetRenderGraph()->GetBarrierStats();
+        ImGui::Text("RG barriers: %u cmd / %u (%u split)", barrierStats.BarrierCommands, barrierStats.Barriers, barrierStats.SplitBarriers);
+        ImGui::End();
+    }
+
+    void FVultanaEditor::DrawGPUProfiler()
+    {
+        RG::FRenderGraphProfiler& profiler = m_pRenderer->GetRenderGraph()->GetProfiler();
+
+        ImGui::SetNextWindowSize(ImVec2(720.0f, 420.0f), ImGuiCond_FirstUseEver);
+        const bool bVisible = ImGui::Begin("GPU Profiler", &m_bShowGPUProfiler);
+        if (!m_bShowGPUProfiler)
+        {
+            profiler.SetEnabled(false);
+        }
+        if (!bVisible)
+        {
+            ImGui::End();
+            return;
+        }
+
+        if (!m_bPauseGPUProfiler || m_GPUProfileHistory.empty())
+        {
+            m_GPUProfileHistory = profiler.GetHistory();
+        }
+
+        ImGui::Checkbox("Pause", &m_bPauseGPUProfiler);
+        ImGui::SameLine();
+        if (ImGui::Button("Export CSV"))
+        {
+            eastl::string file = Core::FVultanaEngine::GetEngineInstance()->GetWorkingPath() + "GPUProfile.csv";
+            if (profiler.ExportCSV(file))
+            {
+                VTNA_LOG_INFO("[Editor] GPU profile exported to {}", file.c_str());
+            }
+        }
+
+        if (m_GPUProfileHistory.empty())
+        {
+            ImGui::Text("Waiting for GPU timestamps...");
+            ImGui::End();
+            return;
+        }
+
+        const RG::FRenderGraphFrameTiming& latest = m_GPUProfileHistory.back();
+        ImGui::SameLine();
+        ImGui::Text("Frame %llu : %.3f ms", (unsigned long long)latest.FrameID, latest.TotalMs);
+
+        // 时间线，每个队列一行
+        const char* queueNames[] = { "Graphics", "Compute" };
+        const float labelWidth = 70.0f;
+        const float rowHeight = ImGui::GetFrameHeight();
+        const float timelineWidth = eastl::max(ImGui::GetContentRegionAvail().x - labelWidth, 1.0f);
+        const double msToPixel = latest.TotalMs > 0.0 ? timelineWidth / latest.TotalMs : 0.0;
+
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+        for (uint32_t row = 0; row < 2; row++)
+        {
+            const RHI::ERHICommandQueueType queue = row == 0 ? RHI::ERHICommandQueueType::Graphics : RHI::ERHICommandQueueType::Compute;
+            const float y = origin.y + row * (rowHeight + 2.0f);
+            drawList->AddText(ImVec2(origin.x, y + ImGui::GetStyle().FramePadding.y), ImGui::GetColorU32(ImGuiCol_Text), queueNames[row]);
+
+            for (const RG::FRenderGraphPassTiming& pass : latest.Passes)
+            {
+                if (pass.Queue != queue)
+                {
+                    continue;
+                }
+
+                ImVec2 min(origin.x + labelWidth + (float)(pass.BeginMs * msToPixel), y);
+                ImVec2 max(eastl::max(origin.x + labelWidth + (float)(pass.EndMs * msToPixel), min.x + 1.0f), y + rowHeight);
+
+                // 按名字取色，同一个 pass 每帧颜色不变
+                const uint32_t hash = (uint32_t)eastl::hash<eastl::string>()(pass.Name);
+                const ImU32 color = IM_COL32(80 + (hash & 0x7F), 80 + ((hash >> 8) & 0x7F), 80 + ((hash >> 16) & 0x7F), 255);
+                drawList->AddRectFilled(min, max, color);
+                drawList->AddRect(min, max, IM_COL32(0, 0, 0, 128));
+
+                const ImVec2 textSize = ImGui::CalcTextSize(pass.Name.c_str());
+                if (textSize.x + 4.0f < max.x - min.x)
+                {
+                    drawList->AddText(ImVec2(min.x + 2.0f, min.y + ImGui::GetStyle().FramePadding.y), IM_COL32(0, 0, 0, 255), pass.Name.c_str());
+                }
+
+                if (ImGui::IsMouseHoveringRect(min, max))
+                {
+                    ImGui::SetTooltip("%s\n%.3f ms (%.3f - %.3f)", pass.Name.c_str(), pass.GetDurationMs(), pass.BeginMs, pass.EndMs);
+                }
+            }
+        }
+        ImGui::Dummy(ImVec2(labelWidth + timelineWidth, 2.0f * (rowHeight + 2.0f)));
+
+        // 以最新一帧的 pass 顺序列出，平均值取整个历史
+        struct FPassStats
+        {
+            const RG::FRenderGraphPassTiming* Latest;
+            double SumMs;
+            uint32_t Count;
+        };
+        eastl::vector<FPassStats> passStats;
+        eastl::hash_map<eastl::string, uint32_t> passIndices;
+        for (const RG::FRenderGraphPassTiming& pass : latest.Passes)
+        {
+            passIndices.insert(eastl::make_pair(pass.Name, (uint32_t)passStats.size()));
+            passStats.push_back({ &pass, 0.0, 0 });
+        }
+        for (const RG::FRenderGraphFrameTiming& frame : m_GPUProfileHistory)
+        {
+            for (const RG::FRenderGraphPassTiming& pass : frame.Passes)
+            {
+                auto iter = passIndices.find(pass.Name);
+                if (iter != passIndices.end())
+                {
+                    passStats[iter->second].SumMs += pass.GetDurationMs();
+                    passStats[iter->second].Count++;
+                }
+            }
+        }
+
+        if (ImGui::BeginTable("GPUProfilerPasses", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY | ImGuiTableFlags_SizingStretchProp))
+        {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("Pass");
+            ImGui::TableSetupColumn("Queue");
+            ImGui::TableSetupColumn("Latest (ms)");
+            ImGui::TableSetupColumn("Average (ms)");
+            ImGui::TableHeadersRow();
+
+            for (const FPassStats& stats : passStats)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(stats.Latest->Name.c_str());
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(stats.Latest->Queue == RHI::ERHICommandQueueType::Compute ? "Compute" : "Graphics");
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", stats.Latest->GetDurationMs());
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", stats.Count > 0 ? stats.SumMs / stats.Count : 0.0);
+            }
+            ImGui::EndTable();
+        }
+
         ImGui::End();
     }
 
@@ -416,16 +584,18 @@ namespace Editor
 
     void FVultanaEditor::FlushPendingTextureDeletions()
     {
-        for (size_t i = 0; i < m_PendingDeletions.size(); i++)
+        // 上一帧的 draw data 可能还在渲染线程上引用这些图标，多保留一帧再删除
+        for (size_t i = 0; i < m_RetiredDeletions.size(); i++)
         {
-            RHI::FRHIDescriptor* srv = m_PendingDeletions[i];
+            RHI::FRHIDescriptor* srv = m_RetiredDeletions[i];
             auto iter = m_FileDialogIcons.find(srv);
             assert(iter != m_FileDialogIcons.end());
             auto texture = iter->second;
             m_FileDialogIcons.erase(srv);
             delete texture;
         }
-        m_PendingDeletions.clear();
+        m_RetiredDeletions.clear();
+        m_RetiredDeletions.swap(m_PendingDeletions);
     }
 
     void FVultanaEditor::DrawWindow(const eastl::string &window, bool *pOpen)
@@ -22,6 +22,8 @@ namespace Editor
 
         void NewFrame();
         void Tick();
+        // 模拟阶段末尾调用，结束本帧的 GUI，之后渲染线程才会绘制
+        void EndFrame();
         void Render(RHI::FRHICommandList* pCmdList);
 
         void AddGUICommand(const eastl::string& window, const eastl::string& section, const eastl::function<void()>& command);
@@ -33,6 +35,7 @@ namespace Editor
         void DrawGizmo();
 
         void DrawFrameStats();
+        void DrawGPUProfiler();
         void ShowRenderGraph();
         void FlushPendingTextureDeletions();
 
@@ -52,6 +55,10 @@ namespace Editor
         bool m_bShowWorldOutliner = false;
         bool m_bShowGPUDrivenStats = false;
         bool m_bShowMeshlets = false;
+        bool m_bShowGPUProfiler = false;
+        bool m_bPauseGPUProfiler = false;
+        // 暂停时保留的快照
+        eastl::vector<RG::FRenderGraphFrameTiming> m_GPUProfileHistory;
 
         unsigned int m_DockSpace = 0;
 
@@ -65,6 +72,7 @@ namespace Editor
 
         eastl::hash_map<RHI::FRHIDescriptor*, RenderResources::FTexture2D*> m_FileDialogIcons;
         eastl::vector<RHI::FRHIDescriptor*> m_PendingDeletions;
+        eastl::vector<RHI::FRHIDescriptor*> m_RetiredDeletions;
 
         enum class ESelectEditMode
         {
@@ -1,5 +1,6 @@
 #include "RHI.hpp"
 #include "RHIVulkan/RHIDeviceVK.hpp"
+#include "RHINull/RHIDeviceNull.hpp"
 
 namespace RHI
 {
@@ -12,6 +13,9 @@ namespace RHI
         case ERHIRenderBackend::Vulkan:
             device = new RHI::FVulkanDevice(desc);
             break;
+        case ERHIRenderBackend::Null:
+            device = new RHI::FNullDevice(desc);
+            break;
         default:
             break;
         }
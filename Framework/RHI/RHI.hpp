@@ -8,6 +8,7 @@
 #include "RHIFence.hpp"
 #include "RHIHeap.hpp"
 #include "RHIPipelineState.hpp"
+#include "RHIQueryPool.hpp"
 #include "RHIShader.hpp"
 #include "RHISwapchain.hpp"
 #include "RHITexture.hpp"
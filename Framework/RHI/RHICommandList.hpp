@@ -8,6 +8,7 @@ namespace RHI
     class FRHITexture;
     class FRHIFence;
     class FRHIHeap;
+    class FRHIQueryPool;
     class FRHIDescriptor;
     class FRHIPipelineState;
     class FRHISwapchain;
@@ -18,6 +19,7 @@ namespace RHI
         virtual ~FRHICommandList() = default;
 
         ERHICommandQueueType GetQueueType() const { return m_CmdQueueType; }
+        bool IsSecondary() const { return m_bSecondary; }
 
         virtual void ResetAllocator() = 0;
         virtual void Begin() = 0;
@@ -27,14 +29,24 @@ namespace RHI
         virtual void Present(FRHISwapchain* swapchain) = 0;
         virtual void Submit() = 0;
         virtual void ResetState() = 0;
+        // 执行已 End 的二级命令列表，之后绑定的状态和常量需要重新设置
+        virtual void ExecuteCommandList(FRHICommandList* secondaryCmdList) = 0;
 
         virtual void BeginProfiling() = 0;
         virtual void EndProfiling() = 0;
         virtual void BeginEvent(const eastl::string& eventName) = 0;
         virtual void EndEvent() = 0;
 
+        // 查询在写入前需要重置，Reset/Resolve 只能在 render pass 之外调用
+        virtual void ResetQueries(FRHIQueryPool* pool, uint32_t firstQuery, uint32_t queryCount) = 0;
+        virtual void WriteTimestamp(FRHIQueryPool* pool, uint32_t query) = 0;
+        // 每个查询按顺序写入两个 uint64_t：结果和可用性，未写入的查询可用性为 0
+        virtual void ResolveQueries(FRHIQueryPool* pool, uint32_t firstQuery, uint32_t queryCount, FRHIBuffer* dstBuffer, uint32_t dstOffset) = 0;
+
         virtual void CopyBufferToTexture(FRHIBuffer* srcBuffer, FRHITexture* dstTexture, uint32_t mipLevel, uint32_t arraySlice, uint32_t offset) = 0;
         virtual void CopyTextureToBuffer(FRHITexture* srcTexture, FRHIBuffer* dstBuffer, uint32_t mipLevel, uint32_t arraySlice, uint32_t offset) = 0;
+        // 拷贝纹理的一个矩形区域，buffer 中按 width 紧密排列
+        virtual void CopyTextureRegionToBuffer(FRHITexture* srcTexture, FRHIBuffer* dstBuffer, uint32_t mipLevel, uint32_t arraySlice, uint32_t offset, uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
         virtual void CopyBuffer(FRHIBuffer* src, FRHIBuffer* dst, uint32_t srcOffset, uint32_t dstOffset, uint32_t size) = 0;
         virtual void CopyTexture(FRHITexture* src, FRHITexture* dst, uint32_t srcMipLevel, uint32_t dstMipLevel, uint32_t srcArraySlice, uint32_t dstArraySlice) = 0;
         virtual void ClearUAV(FRHIResource* resource, FRHIDescriptor* uav, const float* clearValue) = 0;
@@ -45,6 +57,13 @@ namespace RHI
         virtual void BufferBarrier(FRHIBuffer* buffer, ERHIAccessFlags accessFlagBefore, ERHIAccessFlags accessFlagAfter) = 0;
         virtual void GlobalBarrier(ERHIAccessFlags accessFlagBefore, ERHIAccessFlags accessFlagAfter) = 0;
         virtual void FlushBarriers() = 0;
+        // 拆分 barrier：BeginSplitBarriers 把已排队的 barrier 作为 id 的前半段立即提交，
+        // 之后在同一队列上排入完全相同的 barrier 并调用 EndSplitBarriers(id)，等待在下一次 FlushBarriers 时提交
+        virtual void BeginSplitBarriers(uint64_t id) = 0;
+        virtual void EndSplitBarriers(uint64_t id) = 0;
+
+        const FRHIBarrierStats& GetBarrierStats() const { return m_BarrierStats; }
+        void ResetBarrierStats() { m_BarrierStats = {}; }
 
         virtual void BeginRenderPass(const FRHIRenderPassDesc& desc) = 0;
         virtual void EndRenderPass() = 0;
@@ -74,5 +93,7 @@ namespace RHI
 
     protected:
         ERHICommandQueueType m_CmdQueueType;
+        bool m_bSecondary = false;
+        FRHIBarrierStats m_BarrierStats;
     };
 }
\ No newline at end of file
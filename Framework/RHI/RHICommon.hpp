@@ -23,6 +23,7 @@ namespace RHI
     {
         Vulkan,
         D3D12,
+        Null,
         Count,
     };
 
@@ -135,6 +136,8 @@ namespace RHI
         RHITextureUsageDepthStencil     = 1 << 1,
         RHITextureUsageUnorderedAccess  = 1 << 2,
         RHITextureUsageShaderResource   = 1 << 3,
+        // 只作为 attachment 使用，内容不离开 render pass，后端可以使用 lazily allocated 内存
+        RHITextureUsageTransientAttachment = 1 << 4,
     };
     using ERHITextureUsageFlags = uint32_t;
 
@@ -234,6 +237,24 @@ namespace RHI
     struct FRHIDeviceDesc
     {
         ERHIRenderBackend RenderBackend = ERHIRenderBackend::Vulkan;
+        // 为空时不持久化 pipeline cache
+        eastl::string PipelineCacheFile;
+    };
+
+    struct FRHIPipelineCacheStats
+    {
+        uint32_t HitCount = 0;
+        uint32_t MissCount = 0;
+        uint32_t LoadedSize = 0;
+        double CreateTimeMS = 0.0;
+    };
+
+    struct FRHIBarrierStats
+    {
+        // pipeline barrier 以及拆分 barrier 的 set/wait 命令数
+        uint32_t BarrierCommands = 0;
+        uint32_t Barriers = 0;
+        uint32_t SplitBarriers = 0;
     };
 
     struct FRHISwapchainDesc
@@ -251,6 +272,17 @@ namespace RHI
         ERHIMemoryType MemoryType = ERHIMemoryType::GPUOnly;
     };
 
+    enum class ERHIQueryType
+    {
+        Timestamp,
+    };
+
+    struct FRHIQueryPoolDesc
+    {
+        ERHIQueryType Type = ERHIQueryType::Timestamp;
+        uint32_t QueryCount = 1;
+    };
+
     struct FRHIBufferDesc
     {
         uint32_t Stride = 1;
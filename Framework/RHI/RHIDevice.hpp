@@ -14,6 +14,7 @@ namespace RHI
     class FRHIPipelineState;
     class FRHIDescriptor;
     class FRHIHeap;
+    class FRHIQueryPool;
 
     class FRHIDevice
     {
@@ -30,8 +31,11 @@ namespace RHI
 
         virtual FRHISwapchain* CreateSwapchain(const FRHISwapchainDesc& desc, const eastl::string& name) = 0;
         virtual FRHICommandList* CreateCommandList(ERHICommandQueueType queueType, const eastl::string& name) = 0;
+        // 二级命令列表只能通过 ExecuteCommandList 提交，每个列表有独立的分配器，可在工作线程上录制
+        virtual FRHICommandList* CreateSecondaryCommandList(ERHICommandQueueType queueType, const eastl::string& name) = 0;
         virtual FRHIFence* CreateFence(const eastl::string& name) = 0;
         virtual FRHIHeap* CreateHeap(const FRHIHeapDesc& desc, const eastl::string& name) = 0;
+        virtual FRHIQueryPool* CreateQueryPool(const FRHIQueryPoolDesc& desc, const eastl::string& name) = 0;
         virtual FRHIBuffer* CreateBuffer(const FRHIBufferDesc& desc, const eastl::string& name) = 0;
         virtual FRHITexture* CreateTexture(const FRHITextureDesc& desc, const eastl::string& name) = 0;
         virtual FRHIShader* CreateShader(const FRHIShaderDesc& desc, eastl::span<uint8_t> data, const eastl::string& name) = 0;
@@ -45,11 +49,19 @@ namespace RHI
 
         virtual uint32_t GetAllocationSize(const FRHIBufferDesc& desc) = 0;
         virtual uint32_t GetAllocationSize(const FRHITextureDesc& desc) = 0;
+        // 时间戳每秒的 tick 数，图形和计算队列使用同一时钟
+        virtual uint64_t GetTimestampFrequency() const = 0;
+        // 计算队列所在的队列族可能不支持时间戳
+        virtual bool IsComputeTimestampSupported() const = 0;
 
         virtual bool DumpMemoryStats(const eastl::string& filename) = 0;
 
+        virtual bool SavePipelineCache() = 0;
+        const FRHIPipelineCacheStats& GetPipelineCacheStats() const { return m_PipelineCacheStats; }
+
     protected:
         FRHIDeviceDesc m_Desc;
         uint64_t m_FrameID = 0;
+        FRHIPipelineCacheStats m_PipelineCacheStats;
     };
 }
\ No newline at end of file
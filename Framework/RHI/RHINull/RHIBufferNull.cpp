@@ -0,0 +1,38 @@
+#include "RHIBufferNull.hpp"
+#include "RHIDeviceNull.hpp"
+#include "RHIHeapNull.hpp"
+#include "Utilities/Log.hpp"
+
+namespace RHI
+{
+    FNullBuffer::FNullBuffer(FNullDevice *device, const FRHIBufferDesc &desc, const eastl::string &name)
+    {
+        m_pDevice = device;
+        m_Desc = desc;
+        m_Name = name;
+    }
+
+    bool FNullBuffer::Create()
+    {
+        if (m_Desc.AllocationType == ERHIAllocationType::Placed && m_Desc.Heap != nullptr)
+        {
+            if (m_Desc.HeapOffset + m_Desc.Size > m_Desc.Heap->GetDesc().Size)
+            {
+                VTNA_LOG_ERROR("[RHIBufferNull] {} is out of the heap range", m_Name);
+                return false;
+            }
+            m_pData = ((FNullHeap*)m_Desc.Heap)->GetData() + m_Desc.HeapOffset;
+        }
+        else
+        {
+            m_Storage.resize(m_Desc.Size);
+            m_pData = m_Storage.data();
+        }
+        return true;
+    }
+
+    void *FNullBuffer::GetCPUAddress()
+    {
+        return m_Desc.MemoryType == ERHIMemoryType::GPUOnly ? nullptr : m_pData;
+    }
+}
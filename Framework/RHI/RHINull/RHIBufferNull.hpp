@@ -0,0 +1,29 @@
+#pragma once
+
+#include "RHI/RHIBuffer.hpp"
+
+namespace RHI
+{
+    class FNullDevice;
+
+    class FNullBuffer : public FRHIBuffer
+    {
+    public:
+        FNullBuffer(FNullDevice* device, const FRHIBufferDesc& desc, const eastl::string& name);
+
+        bool Create();
+
+        virtual void* GetNativeHandle() const override { return m_pData; }
+        // 与真实后端一致，只有 CPU 可见的内存类型才返回映射地址
+        virtual void* GetCPUAddress() override;
+        virtual uint64_t GetGPUAddress() override { return (uint64_t)m_pData; }
+        virtual uint32_t GetRequiredStagingBufferSize() const override { return m_Desc.Size; }
+
+        // 不区分内存类型，供命令回放和测试直接读写
+        uint8_t* GetData() const { return m_pData; }
+
+    private:
+        eastl::vector<uint8_t> m_Storage;
+        uint8_t* m_pData = nullptr;
+    };
+}
@@ -0,0 +1,502 @@
+#include "RHICommandListNull.hpp"
+#include "RHIDeviceNull.hpp"
+#include "RHI/RHI.hpp"
+#include "RHIBufferNull.hpp"
+#include "RHIFenceNull.hpp"
+#include "RHIQueryPoolNull.hpp"
+#include "RHISwapchainNull.hpp"
+#include "Utilities/Log.hpp"
+
+#include <EASTL/algorithm.h>
+
+namespace RHI
+{
+    FNullCommandList::FNullCommandList(FNullDevice *device, ERHICommandQueueType queueType, const eastl::string &name, bool bSecondary)
+    {
+        m_pDevice = device;
+        m_CmdQueueType = queueType;
+        m_Name = name;
+        m_bSecondary = bSecondary;
+    }
+
+    uint32_t FNullCommandList::GetCommandCount(ENullCommandType type) const
+    {
+        return (uint32_t)eastl::count_if(m_Commands.begin(), m_Commands.end(), [type](const FNullCommand& command) { return command.Type == type; });
+    }
+
+    void FNullCommandList::Begin()
+    {
+        // 上一次提交的命令保留到下一次 Begin，方便测试在 Submit 之后检查
+        m_Commands.clear();
+        m_QueuedBarrierCount = 0;
+        m_SplitWaitBarrierCount = 0;
+        m_bRecording = true;
+    }
+
+    void FNullCommandList::End()
+    {
+        FlushBarriers();
+        m_bRecording = false;
+    }
+
+    void FNullCommandList::Wait(FRHIFence *fence, uint64_t value)
+    {
+        FNullCommand& command = m_Commands.emplace_back();
+        command.Type = ENullCommandType::Wait;
+        command.Resources[0] = fence;
+        command.Args[0] = value;
+    }
+
+    void FNullCommandList::Signal(FRHIFence *fence, uint64_t value)
+    {
+        // 与 Vulkan 后端一样属于提交而不是命令缓冲，End 之后仍然可以调用
+        FNullCommand& command = m_Commands.emplace_back();
+        command.Type = ENullCommandType::Signal;
+        command.Resources[0] = fence;
+        command.Args[0] = value;
+    }
+
+    void FNullCommandList::Present(FRHISwapchain *swapchain)
+    {
+        Record(ENullCommandType::Present, swapchain);
+    }
+
+    void FNullCommandList::Submit()
+    {
+        assert(!m_bRecording && !m_bSecondary);
+
+        for (size_t i = 0; i < m_Commands.size(); i++)
+        {
+            Execute(m_Commands[i]);
+        }
+        ((FNullDevice*)m_pDevice)->OnCommandListSubmitted(this);
+    }
+
+    void FNullCommandList::ExecuteCommandList(FRHICommandList *secondaryCmdList)
+    {
+        assert(m_bRecording && !m_bSecondary);
+        assert(secondaryCmdList->IsSecondary() && secondaryCmdList->GetQueueType() == m_CmdQueueType);
+
+        // 二级列表的命令直接展开到主列表里，Submit 时按顺序回放
+        const eastl::vector<FNullCommand>& commands = ((FNullCommandList*)secondaryCmdList)->GetCommands();
+        m_Commands.insert(m_Commands.end(), commands.begin(), commands.end());
+    }
+
+    void FNullCommandList::BeginEvent(const eastl::string &eventName)
+    {
+        Record(ENullCommandType::BeginEvent).Label = eventName;
+    }
+
+    void FNullCommandList::EndEvent()
+    {
+        Record(ENullCommandType::EndEvent);
+    }
+
+    void FNullCommandList::ResetQueries(FRHIQueryPool *pool, uint32_t firstQuery, uint32_t queryCount)
+    {
+        FNullCommand& command = Record(ENullCommandType::ResetQueries, pool);
+        command.Args[0] = firstQuery;
+        command.Args[1] = queryCount;
+    }
+
+    void FNullCommandList::WriteTimestamp(FRHIQueryPool *pool, uint32_t query)
+    {
+        Record(ENullCommandType::WriteTimestamp, pool).Args[0] = query;
+    }
+
+    void FNullCommandList::ResolveQueries(FRHIQueryPool *pool, uint32_t firstQuery, uint32_t queryCount, FRHIBuffer *dstBuffer, uint32_t dstOffset)
+    {
+        FNullCommand& command = Record(ENullCommandType::ResolveQueries, pool, dstBuffer);
+        command.Args[0] = firstQuery;
+        command.Args[1] = queryCount;
+        command.Args[2] = dstOffset;
+    }
+
+    void FNullCommandList::CopyBufferToTexture(FRHIBuffer *srcBuffer, FRHITexture *dstTexture, uint32_t mipLevel, uint32_t arraySlice, uint32_t offset)
+    {
+        FNullCommand& command = Record(ENullCommandType::CopyBufferToTexture, srcBuffer, dstTexture);
+        command.Args[0] = mipLevel;
+        command.Args[1] = arraySlice;
+        command.Args[2] = offset;
+    }
+
+    void FNullCommandList::CopyTextureToBuffer(FRHITexture *srcTexture, FRHIBuffer *dstBuffer, uint32_t mipLevel, uint32_t arraySlice, uint32_t offset)
+    {
+        FNullCommand& command = Record(ENullCommandType::CopyTextureToBuffer, srcTexture, dstBuffer);
+        command.Args[0] = mipLevel;
+        command.Args[1] = arraySlice;
+        command.Args[2] = offset;
+    }
+
+    void FNullCommandList::CopyTextureRegionToBuffer(FRHITexture *srcTexture, FRHIBuffer *dstBuffer, uint32_t mipLevel, uint32_t arraySlice, uint32_t offset, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+    {
+        FNullCommand& command = Record(ENullCommandType::CopyTextureRegionToBuffer, srcTexture, dstBuffer);
+        command.Args[0] = mipLevel;
+        command.Args[1] = arraySlice;
+        command.Args[2] = offset;
+        command.Args[3] = x;
+        command.Args[4] = y;
+        command.Args[5] = ((uint64_t)width << 32) | height;
+    }
+
+    void FNullCommandList::CopyBuffer(FRHIBuffer *src, FRHIBuffer *dst, uint32_t srcOffset, uint32_t dstOffset, uint32_t size)
+    {
+        FNullCommand& command = Record(ENullCommandType::CopyBuffer, src, dst);
+        command.Args[0] = srcOffset;
+        command.Args[1] = dstOffset;
+        command.Args[2] = size;
+    }
+
+    void FNullCommandList::CopyTexture(FRHITexture *src, FRHITexture *dst, uint32_t srcMipLevel, uint32_t dstMipLevel, uint32_t srcArraySlice, uint32_t dstArraySlice)
+    {
+        FNullCommand& command = Record(ENullCommandType::CopyTexture, src, dst);
+        command.Args[0] = srcMipLevel;
+        command.Args[1] = dstMipLevel;
+        command.Args[2] = srcArraySlice;
+        command.Args[3] = dstArraySlice;
+    }
+
+    void FNullCommandList::ClearUAV(FRHIResource *resource, FRHIDescriptor *uav, const float *clearValue)
+    {
+        FNullCommand& command = Record(ENullCommandType::ClearUAV, resource, uav);
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            command.Args[i] = *(const uint32_t*)&clearValue[i];
+        }
+    }
+
+    void FNullCommandList::ClearUAV(FRHIResource *resource, FRHIDescriptor *uav, const uint32_t *clearValue)
+    {
+        FNullCommand& command = Record(ENullCommandType::ClearUAV, resource, uav);
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            command.Args[i] = clearValue[i];
+        }
+    }
+
+    void FNullCommandList::WriteBuffer(FRHIBuffer *buffer, uint32_t offset, uint32_t data)
+    {
+        FNullCommand& command = Record(ENullCommandType::WriteBuffer, buffer);
+        command.Args[0] = offset;
+        command.Args[1] = data;
+    }
+
+    void FNullCommandList::TextureBarrier(FRHITexture *texture, uint32_t subResouce, ERHIAccessFlags accessFlagBefore, ERHIAccessFlags accessFlagAfter)
+    {
+        FNullCommand& command = Record(ENullCommandType::TextureBarrier, texture);
+        command.Args[0] = subResouce;
+        command.Args[1] = accessFlagBefore;
+        command.Args[2] = accessFlagAfter;
+        m_QueuedBarrierCount++;
+    }
+
+    void FNullCommandList::BufferBarrier(FRHIBuffer *buffer, ERHIAccessFlags accessFlagBefore, ERHIAccessFlags accessFlagAfter)
+    {
+        FNullCommand& command = Record(ENullCommandType::BufferBarrier, buffer);
+        command.Args[0] = accessFlagBefore;
+        command.Args[1] = accessFlagAfter;
+        m_QueuedBarrierCount++;
+    }
+
+    void FNullCommandList::GlobalBarrier(ERHIAccessFlags accessFlagBefore, ERHIAccessFlags accessFlagAfter)
+    {
+        FNullCommand& command = Record(ENullCommandType::GlobalBarrier);
+        command.Args[0] = accessFlagBefore;
+        command.Args[1] = accessFlagAfter;
+        m_QueuedBarrierCount++;
+    }
+
+    void FNullCommandList::FlushBarriers()
+    {
+        // 统计口径与 Vulkan 后端一致：所有拆分等待合成一条命令，其余 barrier 合成一条命令
+        if (m_SplitWaitBarrierCount > 0)
+        {
+            m_BarrierStats.BarrierCommands++;
+            m_BarrierStats.Barriers += m_SplitWaitBarrierCount;
+            m_SplitWaitBarrierCount = 0;
+        }
+
+        if (m_QueuedBarrierCount > 0)
+        {
+            m_BarrierStats.BarrierCommands++;
+            m_BarrierStats.Barriers += m_QueuedBarrierCount;
+            m_QueuedBarrierCount = 0;
+        }
+    }
+
+    void FNullCommandList::BeginSplitBarriers(uint64_t id)
+    {
+        if (m_QueuedBarrierCount == 0)
+        {
+            return;
+        }
+
+        Record(ENullCommandType::BeginSplitBarriers).Args[0] = id;
+        m_BarrierStats.BarrierCommands++;
+        m_BarrierStats.SplitBarriers += m_QueuedBarrierCount;
+        m_QueuedBarrierCount = 0;
+    }
+
+    void FNullCommandList::EndSplitBarriers(uint64_t id)
+    {
+        if (m_QueuedBarrierCount == 0)
+        {
+            return;
+        }
+
+        Record(ENullCommandType::EndSplitBarriers).Args[0] = id;
+        m_SplitWaitBarrierCount += m_QueuedBarrierCount;
+        m_QueuedBarrierCount = 0;
+    }
+
+    void FNullCommandList::BeginRenderPass(const FRHIRenderPassDesc &desc)
+    {
+        // 只记录第一个颜色和深度附件，数量放在 Args[0]
+        FNullCommand& command = Record(ENullCommandType::BeginRenderPass, desc.Color[0].Texture, desc.Depth.Texture);
+        for (uint32_t i = 0; i < RHI_MAX_COLOR_ATTACHMENT_COUNT; i++)
+        {
+            if (desc.Color[i].Texture != nullptr)
+            {
+                command.Args[0]++;
+            }
+        }
+        command.Args[1] = (uint64_t)desc.Color[0].LoadOp;
+        command.Args[2] = (uint64_t)desc.Color[0].StoreOp;
+        command.Args[3] = (uint64_t)desc.Depth.DepthLoadOp;
+        command.Args[4] = (uint64_t)desc.Depth.DepthStoreOp;
+    }
+
+    void FNullCommandList::EndRenderPass()
+    {
+        Record(ENullCommandType::EndRenderPass);
+    }
+
+    void FNullCommandList::SetPipelineState(FRHIPipelineState *pipelineState)
+    {
+        Record(ENullCommandType::SetPipelineState, pipelineState);
+    }
+
+    void FNullCommandList::SetStencilReference(uint8_t stencil)
+    {
+        Record(ENullCommandType::SetStencilReference).Args[0] = stencil;
+    }
+
+    void FNullCommandList::SetBlendFactor(const float *blendFactor)
+    {
+        FNullCommand& command = Record(ENullCommandType::SetBlendFactor);
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            command.Args[i] = *(const uint32_t*)&blendFactor[i];
+        }
+    }
+
+    void FNullCommandList::SetIndexBuffer(FRHIBuffer *buffer, uint32_t offset, ERHIFormat format)
+    {
+        FNullCommand& command = Record(ENullCommandType::SetIndexBuffer, buffer);
+        command.Args[0] = offset;
+        command.Args[1] = (uint64_t)format;
+    }
+
+    void FNullCommandList::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+    {
+        FNullCommand& command = Record(ENullCommandType::SetViewport);
+        command.Args[0] = x;
+        command.Args[1] = y;
+        command.Args[2] = width;
+        command.Args[3] = height;
+    }
+
+    void FNullCommandList::SetScissorRect(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+    {
+        FNullCommand& command = Record(ENullCommandType::SetScissorRect);
+        command.Args[0] = x;
+        command.Args[1] = y;
+        command.Args[2] = width;
+        command.Args[3] = height;
+    }
+
+    void FNullCommandList::SetGraphicsConstants(uint32_t slot, const void *data, size_t dataSize)
+    {
+        FNullCommand& command = Record(ENullCommandType::SetGraphicsConstants);
+        command.Args[0] = slot;
+        command.Args[1] = dataSize;
+    }
+
+    void FNullCommandList::SetComputeConstants(uint32_t slot, const void *data, size_t dataSize)
+    {
+        FNullCommand& command = Record(ENullCommandType::SetComputeConstants);
+        command.Args[0] = slot;
+        command.Args[1] = dataSize;
+    }
+
+    void FNullCommandList::Draw(uint32_t vertexCount, uint32_t instanceCount)
+    {
+        FNullCommand& command = Record(ENullCommandType::Draw);
+        command.Args[0] = vertexCount;
+        command.Args[1] = instanceCount;
+    }
+
+    void FNullCommandList::DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t indexOffset)
+    {
+        FNullCommand& command = Record(ENullCommandType::DrawIndexed);
+        command.Args[0] = indexCount;
+        command.Args[1] = instanceCount;
+        command.Args[2] = indexOffset;
+    }
+
+    void FNullCommandList::Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+    {
+        FNullCommand& command = Record(ENullCommandType::Dispatch);
+        command.Args[0] = groupCountX;
+        command.Args[1] = groupCountY;
+        command.Args[2] = groupCountZ;
+    }
+
+    void FNullCommandList::DispatchMesh(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+    {
+        FNullCommand& command = Record(ENullCommandType::DispatchMesh);
+        command.Args[0] = groupCountX;
+        command.Args[1] = groupCountY;
+        command.Args[2] = groupCountZ;
+    }
+
+    void FNullCommandList::DrawIndirect(FRHIBuffer *buffer, uint32_t offset)
+    {
+        Record(ENullCommandType::DrawIndirect, buffer).Args[0] = offset;
+    }
+
+    void FNullCommandList::DrawIndexedIndirect(FRHIBuffer *buffer, uint32_t offset)
+    {
+        Record(ENullCommandType::DrawIndexedIndirect, buffer).Args[0] = offset;
+    }
+
+    void FNullCommandList::DispatchIndirect(FRHIBuffer *buffer, uint32_t offset)
+    {
+        Record(ENullCommandType::DispatchIndirect, buffer).Args[0] = offset;
+    }
+
+    void FNullCommandList::DispatchMeshIndirect(FRHIBuffer *buffer, uint32_t offset)
+    {
+        Record(ENullCommandType::DispatchMeshIndirect, buffer).Args[0] = offset;
+    }
+
+    void FNullCommandList::MultiDrawIndirect(uint32_t maxCount, FRHIBuffer *argsBuffer, uint32_t argsBufferOffset, FRHIBuffer *countBuffer, uint32_t countBufferOffset)
+    {
+        FNullCommand& command = Record(ENullCommandType::MultiDrawIndirect, argsBuffer, countBuffer);
+        command.Args[0] = maxCount;
+        command.Args[1] = argsBufferOffset;
+        command.Args[2] = countBufferOffset;
+    }
+
+    void FNullCommandList::MultiDrawIndexedIndirect(uint32_t maxCount, FRHIBuffer *argsBuffer, uint32_t argsBufferOffset, FRHIBuffer *countBuffer, uint32_t countBufferOffset)
+    {
+        FNullCommand& command = Record(ENullCommandType::MultiDrawIndexedIndirect, argsBuffer, countBuffer);
+        command.Args[0] = maxCount;
+        command.Args[1] = argsBufferOffset;
+        command.Args[2] = countBufferOffset;
+    }
+
+    void FNullCommandList::MultiDispatchIndirect(uint32_t maxCount, FRHIBuffer *argsBuffer, uint32_t argsBufferOffset, FRHIBuffer *countBuffer, uint32_t countBufferOffset)
+    {
+        FNullCommand& command = Record(ENullCommandType::MultiDispatchIndirect, argsBuffer, countBuffer);
+        command.Args[0] = maxCount;
+        command.Args[1] = argsBufferOffset;
+        command.Args[2] = countBufferOffset;
+    }
+
+    void FNullCommandList::MultiDispatchMeshIndirect(uint32_t maxCount, FRHIBuffer *argsBuffer, uint32_t argsBufferOffset, FRHIBuffer *countBuffer, uint32_t countBufferOffset)
+    {
+        FNullCommand& command = Record(ENullCommandType::MultiDispatchMeshIndirect, argsBuffer, countBuffer);
+        command.Args[0] = maxCount;
+        command.Args[1] = argsBufferOffset;
+        command.Args[2] = countBufferOffset;
+    }
+
+    FNullCommand &FNullCommandList::Record(ENullCommandType type, FRHIResource *resource0, FRHIResource *resource1)
+    {
+        assert(m_bRecording);
+
+        FNullCommand& command = m_Commands.emplace_back();
+        command.Type = type;
+        command.Resources[0] = resource0;
+        command.Resources[1] = resource1;
+        return command;
+    }
+
+    void FNullCommandList::Execute(const FNullCommand &command)
+    {
+        switch (command.Type)
+        {
+        case ENullCommandType::Wait:
+            ((FNullFence*)command.Resources[0])->Wait(command.Args[0]);
+            break;
+        case ENullCommandType::Signal:
+            ((FNullFence*)command.Resources[0])->Signal(command.Args[0]);
+            break;
+        case ENullCommandType::Present:
+            ((FNullSwapchain*)command.Resources[0])->Present();
+            break;
+        case ENullCommandType::ResetQueries:
+        {
+            FNullQueryPool* pool = (FNullQueryPool*)command.Resources[0];
+            assert(command.Args[0] + command.Args[1] <= pool->GetDesc().QueryCount);
+            eastl::fill(pool->GetData() + command.Args[0], pool->GetData() + command.Args[0] + command.Args[1], 0);
+            break;
+        }
+        case ENullCommandType::WriteTimestamp:
+        {
+            FNullQueryPool* pool = (FNullQueryPool*)command.Resources[0];
+            assert(command.Args[0] < pool->GetDesc().QueryCount);
+            pool->GetData()[command.Args[0]] = ((FNullDevice*)m_pDevice)->AdvanceTimestamp();
+            break;
+        }
+        case ENullCommandType::ResolveQueries:
+        {
+            FNullQueryPool* pool = (FNullQueryPool*)command.Resources[0];
+            FNullBuffer* dst = (FNullBuffer*)command.Resources[1];
+            assert(command.Args[0] + command.Args[1] <= pool->GetDesc().QueryCount);
+            assert(command.Args[2] + command.Args[1] * 2 * sizeof(uint64_t) <= dst->GetDesc().Size);
+            // 空设备的时间戳从不为 0，重置后的 0 即未写入
+            uint64_t* pResults = (uint64_t*)(dst->GetData() + command.Args[2]);
+            for (uint64_t i = 0; i < command.Args[1]; i++)
+            {
+                const uint64_t value = pool->GetData()[command.Args[0] + i];
+                pResults[i * 2] = value;
+                pResults[i * 2 + 1] = value != 0 ? 1 : 0;
+            }
+            break;
+        }
+        case ENullCommandType::CopyBuffer:
+        {
+            FNullBuffer* src = (FNullBuffer*)command.Resources[0];
+            FNullBuffer* dst = (FNullBuffer*)command.Resources[1];
+            assert(command.Args[0] + command.Args[2] <= src->GetDesc().Size);
+            assert(command.Args[1] + command.Args[2] <= dst->GetDesc().Size);
+            memmove(dst->GetData() + command.Args[1], src->GetData() + command.Args[0], command.Args[2]);
+            break;
+        }
+        case ENullCommandType::WriteBuffer:
+        {
+            FNullBuffer* buffer = (FNullBuffer*)command.Resources[0];
+            assert(command.Args[0] + sizeof(uint32_t) <= buffer->GetDesc().Size);
+            uint32_t data = (uint32_t)command.Args[1];
+            memcpy(buffer->GetData() + command.Args[0], &data, sizeof(uint32_t));
+            break;
+        }
+        case ENullCommandType::ClearUAV:
+        {
+            // 纹理没有 CPU 内存，只回放 buffer 的清除
+            if (command.Resources[0]->IsBuffer())
+            {
+                FNullBuffer* buffer = (FNullBuffer*)command.Resources[0];
+                uint32_t value = (uint32_t)command.Args[0];
+                uint32_t* data = (uint32_t*)buffer->GetData();
+                eastl::fill(data, data + buffer->GetDesc().Size / sizeof(uint32_t), value);
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
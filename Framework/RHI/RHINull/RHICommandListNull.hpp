@@ -0,0 +1,154 @@
+#pragma once
+
+#include "RHI/RHICommandList.hpp"
+
+namespace RHI
+{
+    class FNullDevice;
+
+    enum class ENullCommandType
+    {
+        Wait,
+        Signal,
+        Present,
+        BeginEvent,
+        EndEvent,
+
+        ResetQueries,
+        WriteTimestamp,
+        ResolveQueries,
+
+        CopyBufferToTexture,
+        CopyTextureToBuffer,
+        CopyTextureRegionToBuffer,
+        CopyBuffer,
+        CopyTexture,
+        ClearUAV,
+        WriteBuffer,
+
+        TextureBarrier,
+        BufferBarrier,
+        GlobalBarrier,
+        BeginSplitBarriers,
+        EndSplitBarriers,
+
+        BeginRenderPass,
+        EndRenderPass,
+        SetPipelineState,
+        SetStencilReference,
+        SetBlendFactor,
+        SetIndexBuffer,
+        SetViewport,
+        SetScissorRect,
+        SetGraphicsConstants,
+        SetComputeConstants,
+
+        Draw,
+        DrawIndexed,
+        Dispatch,
+        DispatchMesh,
+        DrawIndirect,
+        DrawIndexedIndirect,
+        DispatchIndirect,
+        DispatchMeshIndirect,
+        MultiDrawIndirect,
+        MultiDrawIndexedIndirect,
+        MultiDispatchIndirect,
+        MultiDispatchMeshIndirect,
+    };
+
+    // 一条录制下来的命令，参数按 RHI 接口的声明顺序存放
+    struct FNullCommand
+    {
+        ENullCommandType Type;
+        FRHIResource* Resources[2] = {};
+        uint64_t Args[6] = {};
+        eastl::string Label;
+    };
+
+    // 只录制命令，Submit 时在 CPU 上回放 buffer 拷贝/写入和 fence signal
+    class FNullCommandList : public FRHICommandList
+    {
+    public:
+        FNullCommandList(FNullDevice* device, ERHICommandQueueType queueType, const eastl::string& name, bool bSecondary = false);
+
+        bool Create() { return true; }
+
+        const eastl::vector<FNullCommand>& GetCommands() const { return m_Commands; }
+        uint32_t GetCommandCount(ENullCommandType type) const;
+
+        virtual void* GetNativeHandle() const override { return (void*)this; }
+
+        virtual void ResetAllocator() override {}
+        virtual void Begin() override;
+        virtual void End() override;
+        virtual void Wait(FRHIFence* fence, uint64_t value) override;
+        virtual void Signal(FRHIFence* fence, uint64_t value) override;
+        virtual void Present(FRHISwapchain* swapchain) override;
+        virtual void Submit() override;
+        virtual void ResetState() override {}
+        virtual void ExecuteCommandList(FRHICommandList* secondaryCmdList) override;
+
+        virtual void BeginProfiling() override {}
+        virtual void EndProfiling() override {}
+        virtual void BeginEvent(const eastl::string& eventName) override;
+        virtual void EndEvent() override;
+
+        virtual void ResetQueries(FRHIQueryPool* pool, uint32_t firstQuery, uint32_t queryCount) override;
+        virtual void WriteTimestamp(FRHIQueryPool* pool, uint32_t query) override;
+        virtual void ResolveQueries(FRHIQueryPool* pool, uint32_t firstQuery, uint32_t queryCount, FRHIBuffer* dstBuffer, uint32_t dstOffset) override;
+
+        virtual void CopyBufferToTexture(FRHIBuffer* srcBuffer, FRHITexture* dstTexture, uint32_t mipLevel, uint32_t arraySlice, uint32_t offset) override;
+        virtual void CopyTextureToBuffer(FRHITexture* srcTexture, FRHIBuffer* dstBuffer, uint32_t mipLevel, uint32_t arraySlice, uint32_t offset) override;
+        virtual void CopyTextureRegionToBuffer(FRHITexture* srcTexture, FRHIBuffer* dstBuffer, uint32_t mipLevel, uint32_t arraySlice, uint32_t offset, uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+        virtual void CopyBuffer(FRHIBuffer* src, FRHIBuffer* dst, uint32_t srcOffset, uint32_t dstOffset, uint32_t size) override;
+        virtual void CopyTexture(FRHITexture* src, FRHITexture* dst, uint32_t srcMipLevel, uint32_t dstMipLevel, uint32_t srcArraySlice, uint32_t dstArraySlice) override;
+        virtual void ClearUAV(FRHIResource* resource, FRHIDescriptor* uav, const float* clearValue) override;
+        virtual void ClearUAV(FRHIResource* resource, FRHIDescriptor* uav, const uint32_t* clearValue) override;
+        virtual void WriteBuffer(FRHIBuffer* buffer, uint32_t offset, uint32_t data) override;
+
+        virtual void TextureBarrier(FRHITexture* texture, uint32_t subResouce, ERHIAccessFlags accessFlagBefore, ERHIAccessFlags accessFlagAfter) override;
+        virtual void BufferBarrier(FRHIBuffer* buffer, ERHIAccessFlags accessFlagBefore, ERHIAccessFlags accessFlagAfter) override;
+        virtual void GlobalBarrier(ERHIAccessFlags accessFlagBefore, ERHIAccessFlags accessFlagAfter) override;
+        virtual void FlushBarriers() override;
+        virtual void BeginSplitBarriers(uint64_t id) override;
+        virtual void EndSplitBarriers(uint64_t id) override;
+
+        virtual void BeginRenderPass(const FRHIRenderPassDesc& desc) override;
+        virtual void EndRenderPass() override;
+        virtual void SetPipelineState(FRHIPipelineState* pipelineState) override;
+        virtual void SetStencilReference(uint8_t stencil) override;
+        virtual void SetBlendFactor(const float* blendFactor) override;
+        virtual void SetIndexBuffer(FRHIBuffer* buffer, uint32_t offset, ERHIFormat format) override;
+        virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+        virtual void SetScissorRect(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+        virtual void SetGraphicsConstants(uint32_t slot, const void* data, size_t dataSize) override;
+        virtual void SetComputeConstants(uint32_t slot, const void* data, size_t dataSize) override;
+
+        virtual void Draw(uint32_t vertexCount, uint32_t instanceCount = 1) override;
+        virtual void DrawIndexed(uint32_t indexCount, uint32_t instanceCount = 1, uint32_t indexOffset = 0) override;
+        virtual void Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) override;
+        virtual void DispatchMesh(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) override;
+
+        virtual void DrawIndirect(FRHIBuffer* buffer, uint32_t offset) override;
+        virtual void DrawIndexedIndirect(FRHIBuffer* buffer, uint32_t offset) override;
+        virtual void DispatchIndirect(FRHIBuffer* buffer, uint32_t offset) override;
+        virtual void DispatchMeshIndirect(FRHIBuffer* buffer, uint32_t offset) override;
+
+        virtual void MultiDrawIndirect(uint32_t maxCount, FRHIBuffer* argsBuffer, uint32_t argsBufferOffset, FRHIBuffer* countBuffer, uint32_t countBufferOffset) override;
+        virtual void MultiDrawIndexedIndirect(uint32_t maxCount, FRHIBuffer* argsBuffer, uint32_t argsBufferOffset, FRHIBuffer* countBuffer, uint32_t countBufferOffset) override;
+        virtual void MultiDispatchIndirect(uint32_t maxCount, FRHIBuffer* argsBuffer, uint32_t argsBufferOffset, FRHIBuffer* countBuffer, uint32_t countBufferOffset) override;
+        virtual void MultiDispatchMeshIndirect(uint32_t maxCount, FRHIBuffer* argsBuffer, uint32_t argsBufferOffset, FRHIBuffer* countBuffer, uint32_t countBufferOffset) override;
+
+    private:
+        FNullCommand& Record(ENullCommandType type, FRHIResource* resource0 = nullptr, FRHIResource* resource1 = nullptr);
+        void Execute(const FNullCommand& command);
+
+    private:
+        eastl::vector<FNullCommand> m_Commands;
+        bool m_bRecording = false;
+        // 与 Vulkan 后端一样排队到 FlushBarriers 或拆分 barrier 时合成一条命令
+        uint32_t m_QueuedBarrierCount = 0;
+        uint32_t m_SplitWaitBarrierCount = 0;
+    };
+}
@@ -0,0 +1,80 @@
+#include "RHIDescriptorNull.hpp"
+#include "RHIDeviceNull.hpp"
+
+namespace RHI
+{
+    FNullShaderResourceView::FNullShaderResourceView(FNullDevice *device, FRHIResource *pResource, const FRHIShaderResourceViewDesc &desc, const eastl::string &name)
+    {
+        m_pDevice = device;
+        m_Resource = pResource;
+        m_Desc = desc;
+        m_Name = name;
+    }
+
+    FNullShaderResourceView::~FNullShaderResourceView()
+    {
+        ((FNullDevice*)m_pDevice)->FreeResourceDescriptor(m_HeapIndex);
+    }
+
+    bool FNullShaderResourceView::Create()
+    {
+        m_HeapIndex = ((FNullDevice*)m_pDevice)->AllocateResourceDescriptor();
+        return m_HeapIndex != RHI_INVALID_RESOURCE;
+    }
+
+    FNullUnorderedAccessView::FNullUnorderedAccessView(FNullDevice *device, FRHIResource *pResource, const FRHIUnorderedAccessViewDesc &desc, const eastl::string &name)
+    {
+        m_pDevice = device;
+        m_Resource = pResource;
+        m_Desc = desc;
+        m_Name = name;
+    }
+
+    FNullUnorderedAccessView::~FNullUnorderedAccessView()
+    {
+        ((FNullDevice*)m_pDevice)->FreeResourceDescriptor(m_HeapIndex);
+    }
+
+    bool FNullUnorderedAccessView::Create()
+    {
+        m_HeapIndex = ((FNullDevice*)m_pDevice)->AllocateResourceDescriptor();
+        return m_HeapIndex != RHI_INVALID_RESOURCE;
+    }
+
+    FNullConstantBufferView::FNullConstantBufferView(FNullDevice *device, FRHIBuffer *buffer, const FRHIConstantBufferViewDesc &desc, const eastl::string &name)
+    {
+        m_pDevice = device;
+        m_Buffer = buffer;
+        m_Desc = desc;
+        m_Name = name;
+    }
+
+    FNullConstantBufferView::~FNullConstantBufferView()
+    {
+        ((FNullDevice*)m_pDevice)->FreeResourceDescriptor(m_HeapIndex);
+    }
+
+    bool FNullConstantBufferView::Create()
+    {
+        m_HeapIndex = ((FNullDevice*)m_pDevice)->AllocateResourceDescriptor();
+        return m_HeapIndex != RHI_INVALID_RESOURCE;
+    }
+
+    FNullSampler::FNullSampler(FNullDevice *device, const FRHISamplerDesc &desc, const eastl::string &name)
+    {
+        m_pDevice = device;
+        m_Desc = desc;
+        m_Name = name;
+    }
+
+    FNullSampler::~FNullSampler()
+    {
+        ((FNullDevice*)m_pDevice)->FreeSamplerDescriptor(m_HeapIndex);
+    }
+
+    bool FNullSampler::Create()
+    {
+        m_HeapIndex = ((FNullDevice*)m_pDevice)->AllocateSamplerDescriptor();
+        return m_HeapIndex != RHI_INVALID_RESOURCE;
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "RHI/RHIDescriptor.hpp"
+#include "RHI/RHIBuffer.hpp"
+
+namespace RHI
+{
+    class FNullDevice;
+
+    class FNullShaderResourceView : public FRHIDescriptor
+    {
+    public:
+        FNullShaderResourceView(FNullDevice* device, FRHIResource* pResource, const FRHIShaderResourceViewDesc& desc, const eastl::string& name);
+        ~FNullShaderResourceView();
+
+        bool Create();
+
+        const FRHIShaderResourceViewDesc& GetDesc() const { return m_Desc; }
+        virtual void* GetNativeHandle() const override { return m_Resource->GetNativeHandle(); }
+        virtual uint32_t GetHeapIndex() const override { return m_HeapIndex; }
+
+    private:
+        FRHIResource* m_Resource = nullptr;
+        FRHIShaderResourceViewDesc m_Desc {};
+        uint32_t m_HeapIndex = RHI_INVALID_RESOURCE;
+    };
+
+    class FNullUnorderedAccessView : public FRHIDescriptor
+    {
+    public:
+        FNullUnorderedAccessView(FNullDevice* device, FRHIResource* pResource, const FRHIUnorderedAccessViewDesc& desc, const eastl::string& name);
+        ~FNullUnorderedAccessView();
+
+        bool Create();
+
+        const FRHIUnorderedAccessViewDesc& GetDesc() const { return m_Desc; }
+        virtual void* GetNativeHandle() const override { return m_Resource->GetNativeHandle(); }
+        virtual uint32_t GetHeapIndex() const override { return m_HeapIndex; }
+
+    private:
+        FRHIResource* m_Resource = nullptr;
+        FRHIUnorderedAccessViewDesc m_Desc {};
+        uint32_t m_HeapIndex = RHI_INVALID_RESOURCE;
+    };
+
+    class FNullConstantBufferView : public FRHIDescriptor
+    {
+    public:
+        FNullConstantBufferView(FNullDevice* device, FRHIBuffer* buffer, const FRHIConstantBufferViewDesc& desc, const eastl::string& name);
+        ~FNullConstantBufferView();
+
+        bool Create();
+
+        const FRHIConstantBufferViewDesc& GetDesc() const { return m_Desc; }
+        virtual void* GetNativeHandle() const override { return m_Buffer->GetNativeHandle(); }
+        virtual uint32_t GetHeapIndex() const override { return m_HeapIndex; }
+
+    private:
+        FRHIBuffer* m_Buffer = nullptr;
+        FRHIConstantBufferViewDesc m_Desc {};
+        uint32_t m_HeapIndex = RHI_INVALID_RESOURCE;
+    };
+
+    class FNullSampler : public FRHIDescriptor
+    {
+    public:
+        FNullSampler(FNullDevice* device, const FRHISamplerDesc& desc, const eastl::string& name);
+        ~FNullSampler();
+
+        bool Create();
+
+        const FRHISamplerDesc& GetDesc() const { return m_Desc; }
+        virtual void* GetNativeHandle() const override { return (void*)this; }
+        virtual uint32_t GetHeapIndex() const override { return m_HeapIndex; }
+
+    private:
+        FRHISamplerDesc m_Desc {};
+        uint32_t m_HeapIndex = RHI_INVALID_RESOURCE;
+    };
+}
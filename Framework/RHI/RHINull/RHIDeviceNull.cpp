@@ -0,0 +1,259 @@
+#include "RHIDeviceNull.hpp"
+#include "RHIBufferNull.hpp"
+#include "RHICommandListNull.hpp"
+#include "RHIDescriptorNull.hpp"
+#include "RHIFenceNull.hpp"
+#include "RHIHeapNull.hpp"
+#include "RHIPipelineStateNull.hpp"
+#include "RHIQueryPoolNull.hpp"
+#include "RHIShaderNull.hpp"
+#include "RHISwapchainNull.hpp"
+#include "RHITextureNull.hpp"
+#include "RHI/RHI.hpp"
+#include "Utilities/Log.hpp"
+
+#include <EASTL/algorithm.h>
+
+namespace RHI
+{
+    uint32_t FNullDevice::FDescriptorAllocator::Allocate()
+    {
+        std::lock_guard<std::mutex> lock(Mutex);
+        if (!FreeList.empty())
+        {
+            uint32_t index = FreeList.back();
+            FreeList.pop_back();
+            return index;
+        }
+        if (Next >= Capacity)
+        {
+            VTNA_LOG_ERROR("[RHIDeviceNull] Descriptor heap is full ({})", Capacity);
+            return RHI_INVALID_RESOURCE;
+        }
+        return Next++;
+    }
+
+    void FNullDevice::FDescriptorAllocator::Free(uint32_t index)
+    {
+        if (index != RHI_INVALID_RESOURCE)
+        {
+            std::lock_guard<std::mutex> lock(Mutex);
+            FreeList.push_back(index);
+        }
+    }
+
+    FNullDevice::FNullDevice(const FRHIDeviceDesc &desc)
+    {
+        m_Desc = desc;
+        m_ResourceDescriptors.Capacity = RHI_MAX_RESOURCE_DESCRIPTOR_COUNT;
+        m_SamplerDescriptors.Capacity = RHI_MAX_SAMPLER_DESCRIPTOR_COUNT;
+    }
+
+    FRHISwapchain *FNullDevice::CreateSwapchain(const FRHISwapchainDesc &desc, const eastl::string &name)
+    {
+        FNullSwapchain* swapchain = new FNullSwapchain(this, desc, name);
+        if (!swapchain->Create())
+        {
+            delete swapchain;
+            return nullptr;
+        }
+        return swapchain;
+    }
+
+    FRHICommandList *FNullDevice::CreateCommandList(ERHICommandQueueType queueType, const eastl::string &name)
+    {
+        FNullCommandList* cmdList = new FNullCommandList(this, queueType, name);
+        if (!cmdList->Create())
+        {
+            delete cmdList;
+            return nullptr;
+        }
+        return cmdList;
+    }
+
+    FRHICommandList *FNullDevice::CreateSecondaryCommandList(ERHICommandQueueType queueType, const eastl::string &name)
+    {
+        FNullCommandList* cmdList = new FNullCommandList(this, queueType, name, true);
+        if (!cmdList->Create())
+        {
+            delete cmdList;
+            return nullptr;
+        }
+        return cmdList;
+    }
+
+    FRHIFence *FNullDevice::CreateFence(const eastl::string &name)
+    {
+        return new FNullFence(this, name);
+    }
+
+    FRHIHeap *FNullDevice::CreateHeap(const FRHIHeapDesc &desc, const eastl::string &name)
+    {
+        FNullHeap* heap = new FNullHeap(this, desc, name);
+        if (!heap->Create())
+        {
+            delete heap;
+            return nullptr;
+        }
+        return heap;
+    }
+
+    FRHIQueryPool *FNullDevice::CreateQueryPool(const FRHIQueryPoolDesc &desc, const eastl::string &name)
+    {
+        FNullQueryPool* pool = new FNullQueryPool(this, desc, name);
+        if (!pool->Create())
+        {
+            delete pool;
+            return nullptr;
+        }
+        return pool;
+    }
+
+    FRHIBuffer *FNullDevice::CreateBuffer(const FRHIBufferDesc &desc, const eastl::string &name)
+    {
+        FNullBuffer* buffer = new FNullBuffer(this, desc, name);
+        if (!buffer->Create())
+        {
+            delete buffer;
+            return nullptr;
+        }
+        return buffer;
+    }
+
+    FRHITexture *FNullDevice::CreateTexture(const FRHITextureDesc &desc, const eastl::string &name)
+    {
+        FNullTexture* texture = new FNullTexture(this, desc, name);
+        if (!texture->Create())
+        {
+            delete texture;
+            return nullptr;
+        }
+        return texture;
+    }
+
+    FRHIShader *FNullDevice::CreateShader(const FRHIShaderDesc &desc, eastl::span<uint8_t> data, const eastl::string &name)
+    {
+        FNullShader* shader = new FNullShader(this, desc, name);
+        if (!shader->Create(data))
+        {
+            delete shader;
+            return nullptr;
+        }
+        return shader;
+    }
+
+    FRHIPipelineState *FNullDevice::CreateGraphicsPipelineState(const FRHIGraphicsPipelineStateDesc &desc, const eastl::string &name)
+    {
+        FNullGraphicsPipelineState* pipeline = new FNullGraphicsPipelineState(this, desc, name);
+        if (!pipeline->Create())
+        {
+            delete pipeline;
+            return nullptr;
+        }
+        return pipeline;
+    }
+
+    FRHIPipelineState *FNullDevice::CreateMeshShadingPipelineState(const FRHIMeshShadingPipelineStateDesc &desc, const eastl::string &name)
+    {
+        FNullMeshShadingPipelineState* pipeline = new FNullMeshShadingPipelineState(this, desc, name);
+        if (!pipeline->Create())
+        {
+            delete pipeline;
+            return nullptr;
+        }
+        return pipeline;
+    }
+
+    FRHIPipelineState *FNullDevice::CreateComputePipelineState(const FRHIComputePipelineStateDesc &desc, const eastl::string &name)
+    {
+        FNullComputePipelineState* pipeline = new FNullComputePipelineState(this, desc, name);
+        if (!pipeline->Create())
+        {
+            delete pipeline;
+            return nullptr;
+        }
+        return pipeline;
+    }
+
+    FRHIDescriptor *FNullDevice::CreateShaderResourceView(FRHIResource *resource, const FRHIShaderResourceViewDesc &desc, const eastl::string &name)
+    {
+        FNullShaderResourceView* srv = new FNullShaderResourceView(this, resource, desc, name);
+        if (!srv->Create())
+        {
+            delete srv;
+            return nullptr;
+        }
+        return srv;
+    }
+
+    FRHIDescriptor *FNullDevice::CreateUnorderedAccessView(FRHIResource *resource, const FRHIUnorderedAccessViewDesc &desc, const eastl::string &name)
+    {
+        FNullUnorderedAccessView* uav = new FNullUnorderedAccessView(this, resource, desc, name);
+        if (!uav->Create())
+        {
+            delete uav;
+            return nullptr;
+        }
+        return uav;
+    }
+
+    FRHIDescriptor *FNullDevice::CreateConstantBufferView(FRHIBuffer *resource, const FRHIConstantBufferViewDesc &desc, const eastl::string &name)
+    {
+        FNullConstantBufferView* cbv = new FNullConstantBufferView(this, resource, desc, name);
+        if (!cbv->Create())
+        {
+            delete cbv;
+            return nullptr;
+        }
+        return cbv;
+    }
+
+    FRHIDescriptor *FNullDevice::CreateSampler(const FRHISamplerDesc &desc, const eastl::string &name)
+    {
+        FNullSampler* sampler = new FNullSampler(this, desc, name);
+        if (!sampler->Create())
+        {
+            delete sampler;
+            return nullptr;
+        }
+        return sampler;
+    }
+
+    uint32_t FNullDevice::GetAllocationSize(const FRHITextureDesc &desc)
+    {
+        // 按紧密排列的子资源大小累加，没有对齐要求
+        uint32_t blockWidth = GetFormatBlockWidth(desc.Format);
+        uint32_t blockHeight = GetFormatBlockHeight(desc.Format);
+
+        uint32_t size = 0;
+        for (uint32_t mip = 0; mip < desc.MipLevels; mip++)
+        {
+            uint32_t width = (eastl::max(desc.Width >> mip, 1u) + blockWidth - 1) / blockWidth * blockWidth;
+            uint32_t height = (eastl::max(desc.Height >> mip, 1u) + blockHeight - 1) / blockHeight * blockHeight;
+            uint32_t depth = eastl::max(1u, desc.Depth >> mip);
+
+            size += GetFormatRowPitch(desc.Format, width) * (height / blockHeight) * depth;
+        }
+        return size * desc.ArraySize;
+    }
+
+    uint32_t FNullDevice::AllocateResourceDescriptor()
+    {
+        return m_ResourceDescriptors.Allocate();
+    }
+
+    uint32_t FNullDevice::AllocateSamplerDescriptor()
+    {
+        return m_SamplerDescriptors.Allocate();
+    }
+
+    void FNullDevice::FreeResourceDescriptor(uint32_t index)
+    {
+        m_ResourceDescriptors.Free(index);
+    }
+
+    void FNullDevice::FreeSamplerDescriptor(uint32_t index)
+    {
+        m_SamplerDescriptors.Free(index);
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "RHI/RHIDevice.hpp"
+
+#include <mutex>
+
+namespace RHI
+{
+    class FNullCommandList;
+
+    // 不依赖 GPU 和窗口的后端，用于无头测试和 CPU 侧性能分析
+    class FNullDevice : public FRHIDevice
+    {
+    public:
+        FNullDevice(const FRHIDeviceDesc& desc);
+
+        virtual bool Initialize() override { return true; }
+        virtual void BeginFrame() override {}
+        virtual void EndFrame() override { ++m_FrameID; }
+        virtual void* GetNativeHandle() const override { return (void*)this; }
+
+        virtual FRHISwapchain* CreateSwapchain(const FRHISwapchainDesc& desc, const eastl::string& name) override;
+        virtual FRHICommandList* CreateCommandList(ERHICommandQueueType queueType, const eastl::string& name) override;
+        virtual FRHICommandList* CreateSecondaryCommandList(ERHICommandQueueType queueType, const eastl::string& name) override;
+        virtual FRHIFence* CreateFence(const eastl::string& name) override;
+        virtual FRHIHeap* CreateHeap(const FRHIHeapDesc& desc, const eastl::string& name) override;
+        virtual FRHIQueryPool* CreateQueryPool(const FRHIQueryPoolDesc& desc, const eastl::string& name) override;
+        virtual FRHIBuffer* CreateBuffer(const FRHIBufferDesc& desc, const eastl::string& name) override;
+        virtual FRHITexture* CreateTexture(const FRHITextureDesc& desc, const eastl::string& name) override;
+        virtual FRHIShader* CreateShader(const FRHIShaderDesc& desc, eastl::span<uint8_t> data, const eastl::string& name) override;
+        virtual FRHIPipelineState* CreateGraphicsPipelineState(const FRHIGraphicsPipelineStateDesc& desc, const eastl::string& name) override;
+        virtual FRHIPipelineState* CreateMeshShadingPipelineState(const FRHIMeshShadingPipelineStateDesc& desc, const eastl::string& name) override;
+        virtual FRHIPipelineState* CreateComputePipelineState(const FRHIComputePipelineStateDesc& desc, const eastl::string& name) override;
+        virtual FRHIDescriptor* CreateShaderResourceView(FRHIResource* resource, const FRHIShaderResourceViewDesc& desc, const eastl::string& name) override;
+        virtual FRHIDescriptor* CreateUnorderedAccessView(FRHIResource* resource, const FRHIUnorderedAccessViewDesc& desc, const eastl::string& name) override;
+        virtual FRHIDescriptor* CreateConstantBufferView(FRHIBuffer* resource, const FRHIConstantBufferViewDesc& desc, const eastl::string& name) override;
+        virtual FRHIDescriptor* CreateSampler(const FRHISamplerDesc& desc, const eastl::string& name) override;
+
+        virtual uint32_t GetAllocationSize(const FRHIBufferDesc& desc) override { return desc.Size; }
+        virtual uint32_t GetAllocationSize(const FRHITextureDesc& desc) override;
+        virtual uint64_t GetTimestampFrequency() const override { return 1000000000; }
+        virtual bool IsComputeTimestampSupported() const override { return true; }
+
+        virtual bool DumpMemoryStats(const eastl::string& file) override { return false; }
+
+        virtual bool SavePipelineCache() override { return true; }
+
+        uint32_t AllocateResourceDescriptor();
+        uint32_t AllocateSamplerDescriptor();
+        void FreeResourceDescriptor(uint32_t index);
+        void FreeSamplerDescriptor(uint32_t index);
+
+        void OnCommandListSubmitted(FNullCommandList* cmdList) { m_SubmitCount++; }
+        uint64_t GetSubmitCount() const { return m_SubmitCount; }
+        // 每写一次时间戳前进 NULL_TIMESTAMP_STEP 个 tick，结果可预测
+        uint64_t AdvanceTimestamp() { return m_Timestamp += NULL_TIMESTAMP_STEP; }
+
+        static constexpr uint64_t NULL_TIMESTAMP_STEP = 1000;
+
+    private:
+        struct FDescriptorAllocator
+        {
+            std::mutex Mutex;
+            uint32_t Capacity = 0;
+            uint32_t Next = 0;
+            eastl::vector<uint32_t> FreeList;
+
+            uint32_t Allocate();
+            void Free(uint32_t index);
+        };
+
+        FDescriptorAllocator m_ResourceDescriptors;
+        FDescriptorAllocator m_SamplerDescriptors;
+        uint64_t m_SubmitCount = 0;
+        uint64_t m_Timestamp = 0;
+    };
+}
@@ -0,0 +1,29 @@
+#include "RHIFenceNull.hpp"
+#include "RHIDeviceNull.hpp"
+#include "Utilities/Log.hpp"
+
+#include <EASTL/algorithm.h>
+
+namespace RHI
+{
+    FNullFence::FNullFence(FNullDevice *device, const eastl::string &name)
+    {
+        m_pDevice = device;
+        m_Name = name;
+    }
+
+    void FNullFence::Wait(uint64_t value)
+    {
+        // 等待一个从未提交过的值在真实 GPU 上会死锁
+        if (value > m_Value)
+        {
+            VTNA_LOG_ERROR("[RHIFenceNull] {} waits for {} which is never signaled (completed: {})", m_Name, value, m_Value);
+            assert(false);
+        }
+    }
+
+    void FNullFence::Signal(uint64_t value)
+    {
+        m_Value = eastl::max(m_Value, value);
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "RHI/RHIFence.hpp"
+
+namespace RHI
+{
+    class FNullDevice;
+
+    // 命令在 Submit 时立即“执行”，Signal 之后 fence 就已完成
+    class FNullFence : public FRHIFence
+    {
+    public:
+        FNullFence(FNullDevice* device, const eastl::string& name);
+
+        virtual void* GetNativeHandle() const override { return (void*)this; }
+        virtual void Wait(uint64_t value) override;
+        virtual void Signal(uint64_t value) override;
+        virtual uint64_t GetCompletedValue() const override { return m_Value; }
+
+    private:
+        uint64_t m_Value = 0;
+    };
+}
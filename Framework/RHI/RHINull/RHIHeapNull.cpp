@@ -0,0 +1,18 @@
+#include "RHIHeapNull.hpp"
+#include "RHIDeviceNull.hpp"
+
+namespace RHI
+{
+    FNullHeap::FNullHeap(FNullDevice *device, const FRHIHeapDesc &desc, const eastl::string &name)
+    {
+        m_pDevice = device;
+        m_Desc = desc;
+        m_Name = name;
+    }
+
+    bool FNullHeap::Create()
+    {
+        m_Data.resize(m_Desc.Size);
+        return true;
+    }
+}
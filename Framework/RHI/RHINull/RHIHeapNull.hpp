@@ -0,0 +1,23 @@
+#pragma once
+
+#include "RHI/RHIHeap.hpp"
+
+namespace RHI
+{
+    class FNullDevice;
+
+    // placed 资源直接映射到 heap 的 CPU 内存上，便于验证资源别名
+    class FNullHeap : public FRHIHeap
+    {
+    public:
+        FNullHeap(FNullDevice* device, const FRHIHeapDesc& desc, const eastl::string& name);
+
+        bool Create();
+
+        virtual void* GetNativeHandle() const override { return (void*)m_Data.data(); }
+        uint8_t* GetData() { return m_Data.data(); }
+
+    private:
+        eastl::vector<uint8_t> m_Data;
+    };
+}
@@ -0,0 +1,29 @@
+#include "RHIPipelineStateNull.hpp"
+#include "RHIDeviceNull.hpp"
+
+namespace RHI
+{
+    FNullGraphicsPipelineState::FNullGraphicsPipelineState(FNullDevice *device, const FRHIGraphicsPipelineStateDesc &desc, const eastl::string &name)
+    {
+        m_pDevice = device;
+        m_Desc = desc;
+        m_Name = name;
+        m_Type = ERHIPipelineType::Graphics;
+    }
+
+    FNullMeshShadingPipelineState::FNullMeshShadingPipelineState(FNullDevice *device, const FRHIMeshShadingPipelineStateDesc &desc, const eastl::string &name)
+    {
+        m_pDevice = device;
+        m_Desc = desc;
+        m_Name = name;
+        m_Type = ERHIPipelineType::MeshShading;
+    }
+
+    FNullComputePipelineState::FNullComputePipelineState(FNullDevice *device, const FRHIComputePipelineStateDesc &desc, const eastl::string &name)
+    {
+        m_pDevice = device;
+        m_Desc = desc;
+        m_Name = name;
+        m_Type = ERHIPipelineType::Compute;
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "RHI/RHIPipelineState.hpp"
+
+namespace RHI
+{
+    class FNullDevice;
+
+    class FNullGraphicsPipelineState : public FRHIPipelineState
+    {
+    public:
+        FNullGraphicsPipelineState(FNullDevice* device, const FRHIGraphicsPipelineStateDesc& desc, const eastl::string& name);
+
+        virtual void* GetNativeHandle() const override { return (void*)this; }
+        virtual bool Create() override { return true; }
+
+        const FRHIGraphicsPipelineStateDesc& GetDesc() const { return m_Desc; }
+
+    private:
+        FRHIGraphicsPipelineStateDesc m_Desc;
+    };
+
+    class FNullMeshShadingPipelineState : public FRHIPipelineState
+    {
+    public:
+        FNullMeshShadingPipelineState(FNullDevice* device, const FRHIMeshShadingPipelineStateDesc& desc, const eastl::string& name);
+
+        virtual void* GetNativeHandle() const override { return (void*)this; }
+        virtual bool Create() override { return true; }
+
+        const FRHIMeshShadingPipelineStateDesc& GetDesc() const { return m_Desc; }
+
+    private:
+        FRHIMeshShadingPipelineStateDesc m_Desc;
+    };
+
+    class FNullComputePipelineState : public FRHIPipelineState
+    {
+    public:
+        FNullComputePipelineState(FNullDevice* device, const FRHIComputePipelineStateDesc& desc, const eastl::string& name);
+
+        virtual void* GetNativeHandle() const override { return (void*)this; }
+        virtual bool Create() override { return true; }
+
+        const FRHIComputePipelineStateDesc& GetDesc() const { return m_Desc; }
+
+    private:
+        FRHIComputePipelineStateDesc m_Desc;
+    };
+}
@@ -0,0 +1,18 @@
+#include "RHIQueryPoolNull.hpp"
+#include "RHIDeviceNull.hpp"
+
+namespace RHI
+{
+    FNullQueryPool::FNullQueryPool(FNullDevice *device, const FRHIQueryPoolDesc &desc, const eastl::string &name)
+    {
+        m_pDevice = device;
+        m_Desc = desc;
+        m_Name = name;
+    }
+
+    bool FNullQueryPool::Create()
+    {
+        m_Data.resize(m_Desc.QueryCount, 0);
+        return true;
+    }
+}
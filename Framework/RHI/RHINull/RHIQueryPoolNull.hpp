@@ -0,0 +1,23 @@
+#pragma once
+
+#include "RHI/RHIQueryPool.hpp"
+
+namespace RHI
+{
+    class FNullDevice;
+
+    // 查询结果存放在 CPU 内存中，Submit 回放时写入
+    class FNullQueryPool : public FRHIQueryPool
+    {
+    public:
+        FNullQueryPool(FNullDevice* device, const FRHIQueryPoolDesc& desc, const eastl::string& name);
+
+        bool Create();
+
+        virtual void* GetNativeHandle() const override { return (void*)m_Data.data(); }
+        uint64_t* GetData() { return m_Data.data(); }
+
+    private:
+        eastl::vector<uint64_t> m_Data;
+    };
+}
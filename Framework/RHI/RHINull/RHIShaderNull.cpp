@@ -0,0 +1,19 @@
+#include "RHIShaderNull.hpp"
+#include "RHIDeviceNull.hpp"
+#include "Utilities/Hash.hpp"
+
+namespace RHI
+{
+    FNullShader::FNullShader(FNullDevice *device, const FRHIShaderDesc &desc, const eastl::string &name)
+    {
+        m_pDevice = device;
+        m_Desc = desc;
+        m_Name = name;
+    }
+
+    bool FNullShader::Create(eastl::span<uint8_t> data)
+    {
+        m_Hash = CityHash64(reinterpret_cast<const char*>(data.data()), data.size());
+        return true;
+    }
+}
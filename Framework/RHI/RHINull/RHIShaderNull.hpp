@@ -0,0 +1,17 @@
+#pragma once
+
+#include "RHI/RHIShader.hpp"
+
+namespace RHI
+{
+    class FNullDevice;
+
+    class FNullShader : public FRHIShader
+    {
+    public:
+        FNullShader(FNullDevice* device, const FRHIShaderDesc& desc, const eastl::string& name);
+
+        virtual void* GetNativeHandle() const override { return (void*)this; }
+        virtual bool Create(eastl::span<uint8_t> data) override;
+    };
+}
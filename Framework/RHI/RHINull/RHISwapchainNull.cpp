@@ -0,0 +1,74 @@
+#include "RHISwapchainNull.hpp"
+#include "RHIDeviceNull.hpp"
+#include "RHI/RHITexture.hpp"
+
+#include <fmt/format.h>
+
+namespace RHI
+{
+    FNullSwapchain::FNullSwapchain(FNullDevice *device, const FRHISwapchainDesc &desc, const eastl::string &name)
+    {
+        m_pDevice = device;
+        m_Desc = desc;
+        m_Name = name;
+    }
+
+    FNullSwapchain::~FNullSwapchain()
+    {
+        DestroyTextures();
+    }
+
+    bool FNullSwapchain::Create()
+    {
+        return CreateTextures();
+    }
+
+    void FNullSwapchain::AcquireNextBackBuffer()
+    {
+        m_CurrentBackBuffer = (m_CurrentBackBuffer + 1) % (uint32_t)m_BackBuffers.size();
+    }
+
+    bool FNullSwapchain::Resize(uint32_t width, uint32_t height)
+    {
+        if (m_Desc.Width == width && m_Desc.Height == height)
+        {
+            return false;
+        }
+        m_Desc.Width = width;
+        m_Desc.Height = height;
+        m_CurrentBackBuffer = 0;
+
+        DestroyTextures();
+        return CreateTextures();
+    }
+
+    bool FNullSwapchain::CreateTextures()
+    {
+        FRHITextureDesc textureDesc {};
+        textureDesc.Width = m_Desc.Width;
+        textureDesc.Height = m_Desc.Height;
+        textureDesc.Format = m_Desc.ColorFormat;
+        textureDesc.Usage = RHITextureUsageRenderTarget;
+
+        for (uint32_t i = 0; i < m_Desc.BufferCount; i++)
+        {
+            eastl::string name = fmt::format("{} BackBuffer{}", m_Name, i).c_str();
+            FRHITexture* texture = m_pDevice->CreateTexture(textureDesc, name);
+            if (texture == nullptr)
+            {
+                return false;
+            }
+            m_BackBuffers.push_back(texture);
+        }
+        return true;
+    }
+
+    void FNullSwapchain::DestroyTextures()
+    {
+        for (size_t i = 0; i < m_BackBuffers.size(); i++)
+        {
+            delete m_BackBuffers[i];
+        }
+        m_BackBuffers.clear();
+    }
+}
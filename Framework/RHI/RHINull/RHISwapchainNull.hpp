@@ -0,0 +1,35 @@
+#pragma once
+
+#include "RHI/RHISwapchain.hpp"
+
+namespace RHI
+{
+    class FNullDevice;
+
+    // 没有窗口，back buffer 只是普通的 render target
+    class FNullSwapchain : public FRHISwapchain
+    {
+    public:
+        FNullSwapchain(FNullDevice* device, const FRHISwapchainDesc& desc, const eastl::string& name);
+        ~FNullSwapchain();
+
+        bool Create();
+        void Present() { m_PresentCount++; }
+        uint64_t GetPresentCount() const { return m_PresentCount; }
+
+        virtual void* GetNativeHandle() const override { return (void*)this; }
+        virtual void AcquireNextBackBuffer() override;
+        virtual FRHITexture* GetBackBuffer() const override { return m_BackBuffers[m_CurrentBackBuffer]; }
+        virtual bool Resize(uint32_t width, uint32_t height) override;
+        virtual void SetVSyncEnabled(bool enabled) override {}
+
+    private:
+        bool CreateTextures();
+        void DestroyTextures();
+
+    private:
+        uint32_t m_CurrentBackBuffer = 0;
+        eastl::vector<FRHITexture*> m_BackBuffers;
+        uint64_t m_PresentCount = 0;
+    };
+}
@@ -0,0 +1,34 @@
+#include "RHITextureNull.hpp"
+#include "RHIDeviceNull.hpp"
+#include "RHI/RHI.hpp"
+
+#include <EASTL/algorithm.h>
+
+namespace RHI
+{
+    FNullTexture::FNullTexture(FNullDevice *device, const FRHITextureDesc &desc, const eastl::string &name)
+    {
+        m_pDevice = device;
+        m_Desc = desc;
+        m_Name = name;
+    }
+
+    bool FNullTexture::Create()
+    {
+        return m_Desc.Width > 0 && m_Desc.Height > 0 && m_Desc.MipLevels > 0 && m_Desc.ArraySize > 0;
+    }
+
+    uint32_t FNullTexture::GetRequiredStagingBufferSize() const
+    {
+        return ((FNullDevice*)m_pDevice)->GetAllocationSize(m_Desc);
+    }
+
+    uint32_t FNullTexture::GetRowPitch(uint32_t mipLevel) const
+    {
+        // 块压缩格式按整块对齐，宽度不是 4 的倍数的 mip 也要包含最后一个块
+        uint32_t blockWidth = GetFormatBlockWidth(m_Desc.Format);
+        uint32_t width = (eastl::max(m_Desc.Width >> mipLevel, 1u) + blockWidth - 1) / blockWidth * blockWidth;
+
+        return GetFormatRowPitch(m_Desc.Format, width) * GetFormatBlockHeight(m_Desc.Format);
+    }
+}
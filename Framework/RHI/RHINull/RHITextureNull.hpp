@@ -0,0 +1,21 @@
+#pragma once
+
+#include "RHI/RHITexture.hpp"
+
+namespace RHI
+{
+    class FNullDevice;
+
+    class FNullTexture : public FRHITexture
+    {
+    public:
+        FNullTexture(FNullDevice* device, const FRHITextureDesc& desc, const eastl::string& name);
+
+        bool Create();
+
+        virtual void* GetNativeHandle() const override { return (void*)this; }
+        virtual uint32_t GetRequiredStagingBufferSize() const override;
+        virtual uint32_t GetRowPitch(uint32_t mipLevel = 0) const override;
+        virtual void* GetSharedHandle() const override { return nullptr; }
+    };
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "RHIResource.hpp"
+
+namespace RHI
+{
+    class FRHIQueryPool : public FRHIResource
+    {
+    public:
+        const FRHIQueryPoolDesc& GetDesc() const { return m_Desc; }
+    protected:
+        FRHIQueryPoolDesc m_Desc {};
+    };
+}
\ No newline at end of file
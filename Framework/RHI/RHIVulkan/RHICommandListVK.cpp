@@ -14,11 +14,12 @@
 
 namespace RHI
 {
-    FVulkanCommandList::FVulkanCommandList(FVulkanDevice *device, ERHICommandQueueType queueType, const eastl::string &name)
+    FVulkanCommandList::FVulkanCommandList(FVulkanDevice *device, ERHICommandQueueType queueType, const eastl::string &name, bool bSecondary)
     {
         m_pDevice = device;
         m_CmdQueueType = queueType;
         m_Name = name;
+        m_bSecondary = bSecondary;
     }
 
     FVulkanCommandList::~FVulkanCommandList()
@@ -88,7 +89,7 @@ namespace RHI
         {
             vk::CommandBufferAllocateInfo cmdBufferAI {};
             cmdBufferAI.setCommandPool(m_CmdPool);
-            cmdBufferAI.setLevel(vk::CommandBufferLevel::ePrimary);
+            cmdBufferAI.setLevel(m_bSecondary ? vk::CommandBufferLevel::eSecondary : vk::CommandBufferLevel::ePrimary);
             cmdBufferAI.setCommandBufferCount(1);
 
             vk::Device deviceHandle = ((FVulkanDevice*)m_pDevice)->GetDevice();
@@ -102,6 +103,13 @@ namespace RHI
         vk::CommandBufferBeginInfo cmdBufferBI {};
         cmdBufferBI.setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
 
+        // 二级命令缓冲自己开始和结束 render pass，不继承任何状态
+        vk::CommandBufferInheritanceInfo inheritanceInfo {};
+        if (m_bSecondary)
+        {
+            cmdBufferBI.setPInheritanceInfo(&inheritanceInfo);
+        }
+
         m_CmdBuffer.begin(cmdBufferBI);
 
         ResetState();
@@ -132,6 +140,7 @@ namespace RHI
 
     void FVulkanCommandList::Submit()
     {
+        assert(!m_bSecondary);
         ((FVulkanDevice*)m_pDevice)->FlushLayoutTransition(m_CmdQueueType);
 
         eastl::vector<vk::Semaphore> waitSemaphores;
@@ -215,6 +224,22 @@ namespace RHI
         }
     }
 
+    void FVulkanCommandList::ExecuteCommandList(FRHICommandList *secondaryCmdList)
+    {
+        assert(!m_bSecondary && secondaryCmdList->IsSecondary());
+        assert(secondaryCmdList->GetQueueType() == m_CmdQueueType);
+
+        FlushBarriers();
+
+        vk::CommandBuffer secondaryCmdBuffer = (VkCommandBuffer)secondaryCmdList->GetNativeHandle();
+        m_CmdBuffer.executeCommands(1, &secondaryCmdBuffer);
+
+        // 执行二级命令缓冲后主命令缓冲的绑定状态未定义
+        ResetState();
+        m_GraphicsConstants.dirty = true;
+        m_ComputeConstants.dirty = true;
+    }
+
     void FVulkanCommandList::BeginProfiling()
     {
     }
@@ -236,6 +261,29 @@ namespace RHI
         m_CmdBuffer.endDebugUtilsLabelEXT(m_DynamicLoader);
     }
 
+    void FVulkanCommandList::ResetQueries(FRHIQueryPool *pool, uint32_t firstQuery, uint32_t queryCount)
+    {
+        FlushBarriers();
+
+        m_CmdBuffer.resetQueryPool((VkQueryPool)pool->GetNativeHandle(), firstQuery, queryCount);
+    }
+
+    void FVulkanCommandList::WriteTimestamp(FRHIQueryPool *pool, uint32_t query)
+    {
+        FlushBarriers();
+
+        m_CmdBuffer.writeTimestamp2(vk::PipelineStageFlagBits2::eAllCommands, (VkQueryPool)pool->GetNativeHandle(), query);
+    }
+
+    void FVulkanCommandList::ResolveQueries(FRHIQueryPool *pool, uint32_t firstQuery, uint32_t queryCount, FRHIBuffer *dstBuffer, uint32_t dstOffset)
+    {
+        FlushBarriers();
+
+        // 不等待：未写入的查询可用性为 0，由读取方丢弃
+        m_CmdBuffer.copyQueryPoolResults((VkQueryPool)pool->GetNativeHandle(), firstQuery, queryCount, (VkBuffer)dstBuffer->GetNativeHandle(), dstOffset,
+            2 * sizeof(uint64_t), vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWithAvailability);
+    }
+
     void FVulkanCommandList::CopyBufferToTexture(FRHIBuffer *srcBuffer, FRHITexture *dstTexture, uint32_t mipLevel, uint32_t arraySlice, uint32_t offset)
     {
         FlushBarriers();
@@ -288,6 +336,33 @@ namespace RHI
         m_CmdBuffer.copyImageToBuffer2(copyInfo);
     }
 
+    void FVulkanCommandList::CopyTextureRegionToBuffer(FRHITexture *srcTexture, FRHIBuffer *dstBuffer, uint32_t mipLevel, uint32_t arraySlice, uint32_t offset, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+    {
+        FlushBarriers();
+
+        const FRHITextureDesc& desc = srcTexture->GetDesc();
+
+        vk::BufferImageCopy2 copy2 {};
+        copy2.bufferOffset = offset;
+        copy2.imageSubresource.aspectMask = GetAspectFlags(desc.Format);
+        copy2.imageSubresource.mipLevel = mipLevel;
+        copy2.imageSubresource.baseArrayLayer = arraySlice;
+        copy2.imageSubresource.layerCount = 1;
+        copy2.imageOffset = vk::Offset3D((int32_t)x, (int32_t)y, 0);
+        copy2.imageExtent.width = width;
+        copy2.imageExtent.height = height;
+        copy2.imageExtent.depth = 1;
+
+        vk::CopyImageToBufferInfo2 copyInfo {};
+        copyInfo.srcImage = (VkImage)srcTexture->GetNativeHandle();
+        copyInfo.srcImageLayout = vk::ImageLayout::eTransferSrcOptimal;
+        copyInfo.dstBuffer = (VkBuffer)dstBuffer->GetNativeHandle();
+        copyInfo.regionCount = 1;
+        copyInfo.pRegions = &copy2;
+
+        m_CmdBuffer.copyImageToBuffer2(copyInfo);
+    }
+
     void FVulkanCommandList::CopyBuffer(FRHIBuffer *src, FRHIBuffer *dst, uint32_t srcOffset, uint32_t dstOffset, uint32_t size)
     {
         FlushBarriers();
@@ -430,6 +505,39 @@ namespace RHI
 
     void FVulkanCommandList::FlushBarriers()
     {
+        if (!m_SplitBarrierWaits.empty())
+        {
+            // 所有拆分 barrier 的后半段合成一次 wait
+            eastl::vector<vk::Event> events;
+            eastl::vector<vk::DependencyInfo> dependencyInfos;
+            for (const FSplitBarrierWait& wait : m_SplitBarrierWaits)
+            {
+                vk::DependencyInfo& dependencyInfo = dependencyInfos.emplace_back();
+                dependencyInfo.setBufferMemoryBarriers(wait.BufferBarriers);
+                dependencyInfo.setImageMemoryBarriers(wait.ImageBarriers);
+                events.push_back(wait.Event);
+                m_BarrierStats.Barriers += (uint32_t)(wait.BufferBarriers.size() + wait.ImageBarriers.size());
+            }
+            m_CmdBuffer.waitEvents2((uint32_t)events.size(), events.data(), dependencyInfos.data());
+            m_BarrierStats.BarrierCommands++;
+
+            // 等待后立即 reset，下一次使用同一个事件时重新 set
+            for (const FSplitBarrierWait& wait : m_SplitBarrierWaits)
+            {
+                vk::PipelineStageFlags2 stageMask {};
+                for (const vk::BufferMemoryBarrier2& barrier : wait.BufferBarriers)
+                {
+                    stageMask |= barrier.dstStageMask;
+                }
+                for (const vk::ImageMemoryBarrier2& barrier : wait.ImageBarriers)
+                {
+                    stageMask |= barrier.dstStageMask;
+                }
+                m_CmdBuffer.resetEvent2(wait.Event, stageMask);
+            }
+            m_SplitBarrierWaits.clear();
+        }
+
         if (!m_MemoryBarriers.empty() || !m_BufferMemoryBarriers.empty() || !m_ImageMemoryBarriers.empty())
         {
             vk::DependencyInfo dependencyInfo {};
@@ -438,6 +546,8 @@ namespace RHI
             dependencyInfo.setImageMemoryBarriers(m_ImageMemoryBarriers);
 
             m_CmdBuffer.pipelineBarrier2(dependencyInfo);
+            m_BarrierStats.BarrierCommands++;
+            m_BarrierStats.Barriers += (uint32_t)(m_MemoryBarriers.size() + m_BufferMemoryBarriers.size() + m_ImageMemoryBarriers.size());
 
             m_MemoryBarriers.clear();
             m_BufferMemoryBarriers.clear();
@@ -445,6 +555,39 @@ namespace RHI
         }
     }
 
+    void FVulkanCommandList::BeginSplitBarriers(uint64_t id)
+    {
+        if (m_BufferMemoryBarriers.empty() && m_ImageMemoryBarriers.empty())
+        {
+            return;
+        }
+
+        vk::DependencyInfo dependencyInfo {};
+        dependencyInfo.setBufferMemoryBarriers(m_BufferMemoryBarriers);
+        dependencyInfo.setImageMemoryBarriers(m_ImageMemoryBarriers);
+
+        m_CmdBuffer.setEvent2(((FVulkanDevice*)m_pDevice)->GetSplitBarrierEvent(id), dependencyInfo);
+        m_BarrierStats.BarrierCommands++;
+        m_BarrierStats.SplitBarriers += (uint32_t)(m_BufferMemoryBarriers.size() + m_ImageMemoryBarriers.size());
+
+        m_BufferMemoryBarriers.clear();
+        m_ImageMemoryBarriers.clear();
+    }
+
+    void FVulkanCommandList::EndSplitBarriers(uint64_t id)
+    {
+        if (m_BufferMemoryBarriers.empty() && m_ImageMemoryBarriers.empty())
+        {
+            return;
+        }
+
+        // vkCmdWaitEvents2 要求与 set 时相同的 DependencyInfo
+        FSplitBarrierWait& wait = m_SplitBarrierWaits.emplace_back();
+        wait.Event = ((FVulkanDevice*)m_pDevice)->GetSplitBarrierEvent(id);
+        wait.BufferBarriers.swap(m_BufferMemoryBarriers);
+        wait.ImageBarriers.swap(m_ImageMemoryBarriers);
+    }
+
     void FVulkanCommandList::BeginRenderPass(const FRHIRenderPassDesc &desc)
     {
         FlushBarriers();
@@ -10,7 +10,7 @@ namespace RHI
     class FVulkanCommandList : public FRHICommandList
     {
     public:
-        FVulkanCommandList(FVulkanDevice* device, ERHICommandQueueType queueType, const eastl::string& name);
+        FVulkanCommandList(FVulkanDevice* device, ERHICommandQueueType queueType, const eastl::string& name, bool bSecondary = false);
         ~FVulkanCommandList();
 
         bool Create();
@@ -25,14 +25,20 @@ namespace RHI
         virtual void Present(FRHISwapchain* swapchain) override;
         virtual void Submit() override;
         virtual void ResetState() override;
+        virtual void ExecuteCommandList(FRHICommandList* secondaryCmdList) override;
 
         virtual void BeginProfiling() override;
         virtual void EndProfiling() override;
         virtual void BeginEvent(const eastl::string& eventName) override;
         virtual void EndEvent() override;
 
+        virtual void ResetQueries(FRHIQueryPool* pool, uint32_t firstQuery, uint32_t queryCount) override;
+        virtual void WriteTimestamp(FRHIQueryPool* pool, uint32_t query) override;
+        virtual void ResolveQueries(FRHIQueryPool* pool, uint32_t firstQuery, uint32_t queryCount, FRHIBuffer* dstBuffer, uint32_t dstOffset) override;
+
         virtual void CopyBufferToTexture(FRHIBuffer* srcBuffer, FRHITexture* dstTexture, uint32_t mipLevel, uint32_t arraySlice, uint32_t offset) override;
         virtual void CopyTextureToBuffer(FRHITexture* srcTexture, FRHIBuffer* dstBuffer, uint32_t mipLevel, uint32_t arraySlice, uint32_t offset) override;
+        virtual void CopyTextureRegionToBuffer(FRHITexture* srcTexture, FRHIBuffer* dstBuffer, uint32_t mipLevel, uint32_t arraySlice, uint32_t offset, uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
         virtual void CopyBuffer(FRHIBuffer* src, FRHIBuffer* dst, uint32_t srcOffset, uint32_t dstOffset, uint32_t size) override;
         virtual void CopyTexture(FRHITexture* src, FRHITexture* dst, uint32_t srcMipLevel, uint32_t dstMipLevel, uint32_t srcArraySlice, uint32_t dstArraySlice) override;
         virtual void ClearUAV(FRHIResource* resource, FRHIDescriptor* uav, const float* clearValue) override;
@@ -43,6 +49,8 @@ namespace RHI
         virtual void BufferBarrier(FRHIBuffer* buffer, ERHIAccessFlags accessFlagBefore, ERHIAccessFlags accessFlagAfter) override;
         virtual void GlobalBarrier(ERHIAccessFlags accessFlagBefore, ERHIAccessFlags accessFlagAfter) override;
         virtual void FlushBarriers() override;
+        virtual void BeginSplitBarriers(uint64_t id) override;
+        virtual void EndSplitBarriers(uint64_t id) override;
 
         virtual void BeginRenderPass(const FRHIRenderPassDesc& desc) override;
         virtual void EndRenderPass() override;
@@ -87,6 +95,14 @@ namespace RHI
         eastl::vector<vk::BufferMemoryBarrier2> m_BufferMemoryBarriers;
         eastl::vector<vk::ImageMemoryBarrier2> m_ImageMemoryBarriers;
 
+        struct FSplitBarrierWait
+        {
+            vk::Event Event;
+            eastl::vector<vk::BufferMemoryBarrier2> BufferBarriers;
+            eastl::vector<vk::ImageMemoryBarrier2> ImageBarriers;
+        };
+        eastl::vector<FSplitBarrierWait> m_SplitBarrierWaits;
+
         eastl::vector<eastl::pair<FRHIFence*, uint64_t>> m_PendingWaits;
         eastl::vector<eastl::pair<FRHIFence*, uint64_t>> m_PendingSignals;
         eastl::vector<FRHISwapchain*> m_PendingSwapchain;
@@ -209,6 +209,13 @@ namespace RHI
             createInfo.usage |= vk::ImageUsageFlagBits::eStorage;
         }
 
+        if (desc.Usage & RHITextureUsageTransientAttachment)
+        {
+            // transient attachment 只能带 attachment 用途
+            createInfo.usage &= vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eDepthStencilAttachment;
+            createInfo.usage |= vk::ImageUsageFlagBits::eTransientAttachment;
+        }
+
         if (desc.Type == ERHITextureType::TextureCube || desc.Type == ERHITextureType::TextureCubeArray)
         {
             assert(desc.ArraySize % 6 == 0);
@@ -16,6 +16,8 @@ namespace RHI
 
     void FVulkanDeletionQueue::Flush(bool forceDelete)
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
         uint64_t frameID = m_Device->GetFrameID();
         vk::Instance instance = m_Device->GetInstance();
         vk::Device device = m_Device->GetDevice();
@@ -42,6 +44,7 @@ namespace RHI
         ITERATE_QUEUE(m_SemaphoreQueue, device.destroySemaphore)
         ITERATE_QUEUE(m_SwapchainQueue, device.destroySwapchainKHR)
         ITERATE_QUEUE(m_CommandPoolQueue, device.destroyCommandPool)
+        ITERATE_QUEUE(m_QueryPoolQueue, device.destroyQueryPool)
 
         while (!m_SurfaceQueue.empty())
         {
@@ -87,77 +90,97 @@ namespace RHI
 
     void FVulkanDeletionQueue::FreeResourceDescriptor(uint32_t index, uint64_t frameID)
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         m_ResourceDescriptorQueue.push(eastl::make_pair(index, frameID));
     }
 
     void FVulkanDeletionQueue::FreeSamplerDescriptor(uint32_t index, uint64_t frameID)
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         m_SamplerDescriptorQueue.push(eastl::make_pair(index, frameID));
     }
 
     template<>
     void FVulkanDeletionQueue::Delete(vk::Image object, uint64_t frameID)
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         m_ImageQueue.push({ object, frameID });
     }
 
     template<>
     void FVulkanDeletionQueue::Delete(vk::ImageView object, uint64_t frameID)
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         m_ImageViewQueue.push({ object, frameID });
     }
 
     template<>
     void FVulkanDeletionQueue::Delete(vk::Buffer object, uint64_t frameID)
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         m_BufferQueue.push({ object, frameID });
     }
 
     template<>
     void FVulkanDeletionQueue::Delete(VmaAllocation object, uint64_t frameID)
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         m_AllocationQueue.push({ object, frameID });
     }
 
     template<>
     void FVulkanDeletionQueue::Delete(vk::Sampler object, uint64_t frameID)
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         m_SamplerQueue.push({ object, frameID });
     }
 
     template<>
     void FVulkanDeletionQueue::Delete(vk::Pipeline object, uint64_t frameID)
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         m_PipelineQueue.push({ object, frameID });
     }
 
     template<>
     void FVulkanDeletionQueue::Delete(vk::ShaderModule object, uint64_t frameID)
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         m_ShaderQueue.push({ object, frameID });
     }
 
     template<>
     void FVulkanDeletionQueue::Delete(vk::Semaphore object, uint64_t frameID)
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         m_SemaphoreQueue.push({ object, frameID });
     }
 
     template<>
     void FVulkanDeletionQueue::Delete(vk::SwapchainKHR object, uint64_t frameID)
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         m_SwapchainQueue.push({ object, frameID });
     }
 
     template<>
     void FVulkanDeletionQueue::Delete(vk::SurfaceKHR object, uint64_t frameID)
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         m_SurfaceQueue.push({ object, frameID });
     }
 
     template<>
     void FVulkanDeletionQueue::Delete(vk::CommandPool object, uint64_t frameID)
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         m_CommandPoolQueue.push({ object, frameID });
     }
+
+    template<>
+    void FVulkanDeletionQueue::Delete(vk::QueryPool object, uint64_t frameID)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_QueryPoolQueue.push({ object, frameID });
+    }
 }
\ No newline at end of file
@@ -4,6 +4,8 @@
 
 #include <EASTL/queue.h>
 
+#include <mutex>
+
 namespace RHI
 {
     class FVulkanDevice;
@@ -25,6 +27,9 @@ namespace RHI
     private:
         FVulkanDevice* m_Device = nullptr;
 
+        // 渲染线程 Flush 的同时，模拟线程可能正在销毁资源
+        std::mutex m_Mutex;
+
         eastl::queue<eastl::pair<vk::Image, uint64_t>>          m_ImageQueue;
         eastl::queue<eastl::pair<vk::ImageView, uint64_t>>      m_ImageViewQueue;
         eastl::queue<eastl::pair<vk::Buffer, uint64_t>>         m_BufferQueue;
@@ -36,6 +41,7 @@ namespace RHI
         eastl::queue<eastl::pair<vk::SwapchainKHR, uint64_t>>   m_SwapchainQueue;
         eastl::queue<eastl::pair<vk::SurfaceKHR, uint64_t>>     m_SurfaceQueue;
         eastl::queue<eastl::pair<vk::CommandPool, uint64_t>>    m_CommandPoolQueue;
+        eastl::queue<eastl::pair<vk::QueryPool, uint64_t>>      m_QueryPoolQueue;
 
         eastl::queue<eastl::pair<uint32_t, uint64_t>>           m_ResourceDescriptorQueue;
         eastl::queue<eastl::pair<uint32_t, uint64_t>>           m_SamplerDescriptorQueue;
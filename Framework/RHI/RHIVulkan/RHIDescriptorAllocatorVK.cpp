@@ -36,12 +36,11 @@ namespace RHI
 
     void FVulkanConstantBufferAllocator::Allocate(uint32_t size, void **cpuAddress, vk::DeviceAddress *gpuAddress)
     {
-        assert(m_AllocatedSize + size <= m_BufferSize);
+        uint32_t offset = m_AllocatedSize.fetch_add(RoundUpPow2(size, 256));
+        assert(offset + size <= m_BufferSize);
 
-        *cpuAddress = (char *)m_CPUAddress + m_AllocatedSize;
-        *gpuAddress = m_GPUAddress + m_AllocatedSize;
-
-        m_AllocatedSize += RoundUpPow2(size, 256);
+        *cpuAddress = (char *)m_CPUAddress + offset;
+        *gpuAddress = m_GPUAddress + offset;
     }
 
     void FVulkanConstantBufferAllocator::Reset()
@@ -80,6 +79,7 @@ namespace RHI
 
     uint32_t FVulkanDescriptorAllocator::Allocate(void **desc)
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         uint32_t index = 0;
 
         if (!m_FreeDescriptors.empty())
@@ -100,6 +100,7 @@ namespace RHI
 
     void FVulkanDescriptorAllocator::Free(uint32_t index)
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         m_FreeDescriptors.push_back(index);
     }
 } // namespace RHI
@@ -2,6 +2,9 @@
 
 #include "RHICommonVK.hpp"
 
+#include <atomic>
+#include <mutex>
+
 namespace RHI
 {
     class FVulkanDevice;
@@ -25,7 +28,8 @@ namespace RHI
         vk::DeviceAddress m_GPUAddress = 0;
         void* m_CPUAddress = nullptr;
         uint32_t m_BufferSize = 0;
-        uint32_t m_AllocatedSize = 0;
+        // 并行录制时多个线程同时分配
+        std::atomic<uint32_t> m_AllocatedSize = 0;
     };
 
     class FVulkanDescriptorAllocator
@@ -48,6 +52,7 @@ namespace RHI
         uint32_t m_DescriptorSize = 0;
         uint32_t m_DescriptorCount = 0;
 
+        std::mutex m_Mutex;
         uint32_t m_AllocatedCount = 0;
         eastl::vector<uint32_t> m_FreeDescriptors;
     };
@@ -6,17 +6,24 @@
 #include "RHIFenceVK.hpp"
 #include "RHIHeapVK.hpp"
 #include "RHIPipelineStateVK.hpp"
+#include "RHIQueryPoolVK.hpp"
 #include "RHIShaderVK.hpp"
 #include "RHISwapchainVK.hpp"
 #include "RHITextureVK.hpp"
 
 #include "Utilities/Log.hpp"
 
+#include <filesystem>
+#include <fstream>
+
 #define VMA_IMPLEMENTATION
 #include <vma/vk_mem_alloc.h>
 
 namespace RHI
 {
+    // 运行中每隔这么多帧，如果有新的 pipeline 就写一次磁盘，避免崩溃时丢失
+    static const uint64_t PIPELINE_CACHE_SAVE_INTERVAL = 600;
+
     static VKAPI_ATTR VkBool32 VKAPI_CALL ValidationLayerCallback(
         VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
         VkDebugUtilsMessageTypeFlagsEXT messageType,
@@ -41,12 +48,20 @@ namespace RHI
             delete m_TransitionCopyCmdList[i];
             delete m_TransitionGraphicsCmdList[i];
             delete m_ConstantBufferAllocators[i];
+
+            for (auto& iter : m_SplitBarrierEvents[i])
+            {
+                m_Device.destroyEvent(iter.second);
+            }
         }
         delete m_DeferredDeletionQueue;
 
         delete m_ResourceDesAllocator;
         delete m_SamplerDesAllocator;
 
+        SavePipelineCache();
+        m_Device.destroyPipelineCache(m_PipelineCache);
+
         vmaDestroyAllocator(m_Allocator);
         m_Device.destroyDescriptorSetLayout(m_DescSetLayout[0]);
         m_Device.destroyDescriptorSetLayout(m_DescSetLayout[1]);
@@ -63,6 +78,7 @@ namespace RHI
         CreateDevice();
         CreateVmaAllocator();
         CreatePipelineLayout();
+        CreatePipelineCache();
 
         m_DeferredDeletionQueue = new FVulkanDeletionQueue(this);
 
@@ -78,6 +94,10 @@ namespace RHI
         props2.pNext = &m_DescBufferProps;
         m_PhysicalDevice.getProperties2(&props2);
 
+        // timestampPeriod 为每个 tick 的纳秒数
+        m_TimestampFrequency = (uint64_t)(1000000000.0 / props2.properties.limits.timestampPeriod);
+        m_bComputeTimestampSupported = m_PhysicalDevice.getQueueFamilyProperties()[m_ComputeQueueIndex].timestampValidBits > 0;
+
         size_t resourceDescSize = m_DescBufferProps.sampledImageDescriptorSize;
         resourceDescSize = eastl::max(resourceDescSize, m_DescBufferProps.storageImageDescriptorSize);
         resourceDescSize = eastl::max(resourceDescSize, m_DescBufferProps.robustUniformTexelBufferDescriptorSize);
@@ -109,6 +129,11 @@ namespace RHI
         ++m_FrameID;
 
         vmaSetCurrentFrameIndex(m_Allocator, (uint32_t)m_FrameID);
+
+        if (m_bPipelineCacheDirty && m_FrameID % PIPELINE_CACHE_SAVE_INTERVAL == 0)
+        {
+            SavePipelineCache();
+        }
     }
 
     FRHISwapchain *FVulkanDevice::CreateSwapchain(const FRHISwapchainDesc &desc, const eastl::string &name)
@@ -133,6 +158,17 @@ namespace RHI
         return cmdList;
     }
 
+    FRHICommandList *FVulkanDevice::CreateSecondaryCommandList(ERHICommandQueueType queueType, const eastl::string &name)
+    {
+        FVulkanCommandList* cmdList = new FVulkanCommandList(this, queueType, name, true);
+        if (!cmdList->Create())
+        {
+            delete cmdList;
+            return nullptr;
+        }
+        return cmdList;
+    }
+
     FRHIFence *FVulkanDevice::CreateFence(const eastl::string &name)
     {
         FVulkanFence* fence = new FVulkanFence(this, name);
@@ -155,6 +191,17 @@ namespace RHI
         return heap;
     }
 
+    FRHIQueryPool *FVulkanDevice::CreateQueryPool(const FRHIQueryPoolDesc &desc, const eastl::string &name)
+    {
+        FVulkanQueryPool* queryPool = new FVulkanQueryPool(this, desc, name);
+        if (!queryPool->Create())
+        {
+            delete queryPool;
+            return nullptr;
+        }
+        return queryPool;
+    }
+
     FRHIBuffer *FVulkanDevice::CreateBuffer(const FRHIBufferDesc &desc, const eastl::string &name)
     {
         FVulkanBuffer* buffer = new FVulkanBuffer(this, desc, name);
@@ -462,6 +509,157 @@ namespace RHI
         }
     }
 
+    vk::Event FVulkanDevice::GetSplitBarrierEvent(uint64_t id)
+    {
+        std::lock_guard<std::mutex> lock(m_SplitBarrierEventMutex);
+
+        eastl::hash_map<uint64_t, vk::Event>& events = m_SplitBarrierEvents[m_FrameID % RHI_MAX_INFLIGHT_FRAMES];
+        auto iter = events.find(id);
+        if (iter != events.end())
+        {
+            return iter->second;
+        }
+
+        vk::EventCreateInfo eventCI {};
+        eventCI.setFlags(vk::EventCreateFlagBits::eDeviceOnly);
+
+        vk::Event event;
+        if (m_Device.createEvent(&eventCI, nullptr, &event) != vk::Result::eSuccess)
+        {
+            VTNA_LOG_ERROR("[FVulkanDevice::GetSplitBarrierEvent] failed to create event");
+            return VK_NULL_HANDLE;
+        }
+        events.insert(eastl::make_pair(id, event));
+        return event;
+    }
+
+    bool FVulkanDevice::SavePipelineCache()
+    {
+        if (m_PipelineCache == VK_NULL_HANDLE || m_Desc.PipelineCacheFile.empty())
+        {
+            return false;
+        }
+
+        size_t dataSize = 0;
+        if (m_Device.getPipelineCacheData(m_PipelineCache, &dataSize, nullptr) != vk::Result::eSuccess || dataSize == 0)
+        {
+            return false;
+        }
+
+        eastl::vector<uint8_t> data(dataSize);
+        if (m_Device.getPipelineCacheData(m_PipelineCache, &dataSize, data.data()) != vk::Result::eSuccess)
+        {
+            VTNA_LOG_ERROR("[FVulkanDevice::SavePipelineCache] failed to get pipeline cache data");
+            return false;
+        }
+
+        std::filesystem::path path(m_Desc.PipelineCacheFile.c_str());
+        std::error_code ec;
+        if (path.has_parent_path())
+        {
+            std::filesystem::create_directories(path.parent_path(), ec);
+        }
+
+        // 先写临时文件再替换，避免写到一半退出导致下次读到损坏的数据
+        std::filesystem::path tempPath = path;
+        tempPath += ".tmp";
+
+        std::ofstream os(tempPath, std::ios::binary | std::ios::trunc);
+        if (os.fail())
+        {
+            VTNA_LOG_ERROR("[FVulkanDevice::SavePipelineCache] failed to open {}", tempPath.string());
+            return false;
+        }
+        os.write((const char*)data.data(), dataSize);
+        os.close();
+
+        std::filesystem::rename(tempPath, path, ec);
+        if (ec)
+        {
+            VTNA_LOG_ERROR("[FVulkanDevice::SavePipelineCache] failed to write {}", m_Desc.PipelineCacheFile);
+            return false;
+        }
+
+        m_bPipelineCacheDirty = false;
+        VTNA_LOG_INFO("Pipeline cache saved : {} bytes, {} hits, {} misses, {:.2f} ms spent creating pipelines",
+            dataSize, m_PipelineCacheStats.HitCount, m_PipelineCacheStats.MissCount, m_PipelineCacheStats.CreateTimeMS);
+        return true;
+    }
+
+    void FVulkanDevice::RecordPipelineCreation(const vk::PipelineCreationFeedback& feedback)
+    {
+        if (!(feedback.flags & vk::PipelineCreationFeedbackFlagBits::eValid))
+        {
+            return;
+        }
+
+        if (feedback.flags & vk::PipelineCreationFeedbackFlagBits::eApplicationPipelineCacheHit)
+        {
+            m_PipelineCacheStats.HitCount++;
+        }
+        else
+        {
+            m_PipelineCacheStats.MissCount++;
+            m_bPipelineCacheDirty = true;
+        }
+        m_PipelineCacheStats.CreateTimeMS += feedback.duration / 1000000.0;
+    }
+
+    void FVulkanDevice::CreatePipelineCache()
+    {
+        eastl::vector<uint8_t> data;
+        if (!m_Desc.PipelineCacheFile.empty())
+        {
+            std::ifstream is(m_Desc.PipelineCacheFile.c_str(), std::ios::binary);
+            if (!is.fail())
+            {
+                is.seekg(0, std::ios::end);
+                data.resize((size_t)is.tellg());
+                is.seekg(0, std::ios::beg);
+                is.read((char*)data.data(), data.size());
+                is.close();
+            }
+
+            if (!data.empty() && !ValidatePipelineCacheData(data))
+            {
+                VTNA_LOG_INFO("Discarding stale pipeline cache : {}", m_Desc.PipelineCacheFile);
+                data.clear();
+            }
+        }
+
+        vk::PipelineCacheCreateInfo cacheCI {};
+        cacheCI.setInitialDataSize(data.size());
+        cacheCI.setPInitialData(data.data());
+        if (m_Device.createPipelineCache(&cacheCI, nullptr, &m_PipelineCache) != vk::Result::eSuccess)
+        {
+            // 驱动拒绝旧数据时，退回空的 cache
+            cacheCI.setInitialDataSize(0);
+            cacheCI.setPInitialData(nullptr);
+            data.clear();
+            m_PipelineCache = m_Device.createPipelineCache(cacheCI);
+        }
+
+        m_PipelineCacheStats.LoadedSize = (uint32_t)data.size();
+    }
+
+    bool FVulkanDevice::ValidatePipelineCacheData(const eastl::vector<uint8_t>& data) const
+    {
+        if (data.size() < sizeof(VkPipelineCacheHeaderVersionOne))
+        {
+            return false;
+        }
+
+        VkPipelineCacheHeaderVersionOne header;
+        memcpy(&header, data.data(), sizeof(header));
+
+        auto properties = m_PhysicalDevice.getProperties();
+        return header.headerSize >= sizeof(VkPipelineCacheHeaderVersionOne) &&
+            header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+            header.vendorID == properties.vendorID &&
+            header.deviceID == properties.deviceID &&
+            memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID.data(), VK_UUID_SIZE) == 0;
+    }
+
     void FVulkanDevice::CreateInstance()
     {
         auto supportExtens = vk::enumerateInstanceExtensionProperties();
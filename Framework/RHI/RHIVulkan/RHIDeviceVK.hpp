@@ -7,6 +7,7 @@
 #include "Utilities/Hash.hpp"
 
 #include <EASTL/hash_map.h>
+#include <mutex>
 
 namespace eastl
 {
@@ -35,8 +36,10 @@ namespace RHI
 
         virtual FRHISwapchain* CreateSwapchain(const FRHISwapchainDesc& desc, const eastl::string& name) override;
         virtual FRHICommandList* CreateCommandList(ERHICommandQueueType queueType, const eastl::string& name) override;
+        virtual FRHICommandList* CreateSecondaryCommandList(ERHICommandQueueType queueType, const eastl::string& name) override;
         virtual FRHIFence* CreateFence(const eastl::string& name) override;
         virtual FRHIHeap* CreateHeap(const FRHIHeapDesc& desc, const eastl::string& name) override;
+        virtual FRHIQueryPool* CreateQueryPool(const FRHIQueryPoolDesc& desc, const eastl::string& name) override;
         virtual FRHIBuffer* CreateBuffer(const FRHIBufferDesc& desc, const eastl::string& name) override;
         virtual FRHITexture* CreateTexture(const FRHITextureDesc& desc, const eastl::string& name) override;
         virtual FRHIShader* CreateShader(const FRHIShaderDesc& desc, eastl::span<uint8_t> data, const eastl::string& name) override;
@@ -50,9 +53,13 @@ namespace RHI
 
         virtual uint32_t GetAllocationSize(const FRHIBufferDesc& desc) override;
         virtual uint32_t GetAllocationSize(const FRHITextureDesc& desc) override;
+        virtual uint64_t GetTimestampFrequency() const override { return m_TimestampFrequency; }
+        virtual bool IsComputeTimestampSupported() const override { return m_bComputeTimestampSupported; }
 
         virtual bool DumpMemoryStats(const eastl::string& file) override;
 
+        virtual bool SavePipelineCache() override;
+
         vk::Instance GetInstance() const { return m_Instance; }
         vk::detail::DispatchLoaderDynamic GetDynamicLoader() const { return m_DynamicLoader; }
         vk::PhysicalDevice GetPhysicalDevice() const { return m_PhysicalDevice; }
@@ -65,6 +72,8 @@ namespace RHI
         vk::Queue GetComputeQueue() const { return m_ComputeQueue; }
         vk::Queue GetCopyQueue() const { return m_CopyQueue; }
         vk::PipelineLayout GetPipelineLayout() const { return m_PipelineLayout; }
+        vk::PipelineCache GetPipelineCache() const { return m_PipelineCache; }
+        void RecordPipelineCreation(const vk::PipelineCreationFeedback& feedback);
         class FVulkanDescriptorAllocator* GetResourceDescriptorAllocator() const { return m_ResourceDesAllocator; }
         class FVulkanDescriptorAllocator* GetSamplerDescriptorAllocator() const { return m_SamplerDesAllocator; }
         class FVulkanConstantBufferAllocator* GetConstantBufferAllocator() const;
@@ -85,11 +94,16 @@ namespace RHI
         void CancelDefaultLayoutTransition(FRHITexture* texture);
         void FlushLayoutTransition(ERHICommandQueueType queueType);
 
+        // 拆分 barrier 的事件按 id 复用，每个在途帧一组，录制线程可以同时调用
+        vk::Event GetSplitBarrierEvent(uint64_t id);
+
     private:
         void CreateInstance();
         void CreateDevice();
         vk::Result CreateVmaAllocator();
         void CreatePipelineLayout();
+        void CreatePipelineCache();
+        bool ValidatePipelineCacheData(const eastl::vector<uint8_t>& data) const;
         void FindQueueFamilyIndex();
 
     private:
@@ -102,6 +116,10 @@ namespace RHI
         vk::DescriptorSetLayout m_DescSetLayout[3] = {};
         vk::PipelineLayout m_PipelineLayout = {};
         vk::PhysicalDeviceDescriptorBufferPropertiesEXT m_DescBufferProps = {};
+        uint64_t m_TimestampFrequency = 1000000000;
+        bool m_bComputeTimestampSupported = false;
+        vk::PipelineCache m_PipelineCache = VK_NULL_HANDLE;
+        bool m_bPipelineCacheDirty = false;
 
         uint32_t m_GraphicsQueueIndex = -1;
         uint32_t m_ComputeQueueIndex = -1;
@@ -122,6 +140,9 @@ namespace RHI
         eastl::vector<eastl::pair<FRHITexture*, ERHIAccessFlags>> m_PendingCopyTransitions;
 
         eastl::hash_map<FRHITextureDesc, uint32_t> m_TextureSizeMap;
+
+        std::mutex m_SplitBarrierEventMutex;
+        eastl::hash_map<uint64_t, vk::Event> m_SplitBarrierEvents[RHI_MAX_INFLIGHT_FRAMES];
     };
 
     template<typename T>
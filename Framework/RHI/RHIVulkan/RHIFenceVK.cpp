@@ -61,4 +61,10 @@ namespace RHI
         auto device = ((FVulkanDevice*)m_pDevice)->GetDevice();
         device.signalSemaphore(signalInfo);
     }
+
+    uint64_t FVulkanFence::GetCompletedValue() const
+    {
+        auto device = ((FVulkanDevice*)m_pDevice)->GetDevice();
+        return device.getSemaphoreCounterValue(m_Semaphore);
+    }
 }
\ No newline at end of file
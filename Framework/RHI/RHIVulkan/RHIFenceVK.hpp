@@ -18,6 +18,7 @@ namespace RHI
         virtual void* GetNativeHandle() const override { return m_Semaphore; }
         virtual void Wait(uint64_t value) override;
         virtual void Signal(uint64_t value) override;
+        virtual uint64_t GetCompletedValue() const override;
 
     private:
         vk::Semaphore m_Semaphore;
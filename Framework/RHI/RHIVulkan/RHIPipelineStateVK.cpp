@@ -64,8 +64,13 @@ namespace RHI
         vk::Format colorFormats[RHI_MAX_COLOR_ATTACHMENT_COUNT];
         vk::PipelineRenderingCreateInfo renderingCI = ToVKPipelineRenderingCreateInfo(m_Desc, colorFormats);
 
+        vk::PipelineCreationFeedback feedback {};
+        vk::PipelineCreationFeedbackCreateInfo feedbackCI {};
+        feedbackCI.setPNext(&renderingCI);
+        feedbackCI.setPPipelineCreationFeedback(&feedback);
+
         vk::GraphicsPipelineCreateInfo pipelineCI {};
-        pipelineCI.setPNext(&renderingCI);
+        pipelineCI.setPNext(&feedbackCI);
         pipelineCI.setFlags(vk::PipelineCreateFlagBits::eDescriptorBufferEXT);
         pipelineCI.setStageCount(m_Desc.PS ? 2 : 1);
         pipelineCI.setPStages(shaderStages);
@@ -81,12 +86,13 @@ namespace RHI
 
         auto deviceHandle = device->GetDevice();
         auto dynamicLoader = device->GetDynamicLoader();
-        auto result = deviceHandle.createGraphicsPipelines(nullptr, 1, &pipelineCI, nullptr, &m_Pipeline, dynamicLoader);
+        auto result = deviceHandle.createGraphicsPipelines(device->GetPipelineCache(), 1, &pipelineCI, nullptr, &m_Pipeline, dynamicLoader);
         if (result != vk::Result::eSuccess)
         {
             VTNA_LOG_ERROR("[RHIGraphicsPipelineStateVK] Failed to create {}", m_Name);
             return false;
         }
+        device->RecordPipelineCreation(feedback);
         SetDebugName(deviceHandle, vk::ObjectType::ePipeline, (uint64_t)(VkPipeline)m_Pipeline, m_Name.c_str(), dynamicLoader);
         return true;
     }
@@ -156,8 +162,13 @@ namespace RHI
         vk::Format colorFormats[RHI_MAX_COLOR_ATTACHMENT_COUNT];
         vk::PipelineRenderingCreateInfo renderingCI = ToVKPipelineRenderingCreateInfo(m_Desc, colorFormats);
 
+        vk::PipelineCreationFeedback feedback {};
+        vk::PipelineCreationFeedbackCreateInfo feedbackCI {};
+        feedbackCI.setPNext(&renderingCI);
+        feedbackCI.setPPipelineCreationFeedback(&feedback);
+
         vk::GraphicsPipelineCreateInfo pipelineCI {};
-        pipelineCI.setPNext(&renderingCI);
+        pipelineCI.setPNext(&feedbackCI);
         pipelineCI.setFlags(vk::PipelineCreateFlagBits::eDescriptorBufferEXT);
         pipelineCI.setStageCount(shaderStageCount);
         pipelineCI.setPStages(shaderStages);
@@ -171,12 +182,13 @@ namespace RHI
 
         auto deviceHandle = device->GetDevice();
         auto dynamicLoader = device->GetDynamicLoader();
-        auto result = deviceHandle.createGraphicsPipelines(nullptr, 1, &pipelineCI, nullptr, &m_Pipeline, dynamicLoader);
+        auto result = deviceHandle.createGraphicsPipelines(device->GetPipelineCache(), 1, &pipelineCI, nullptr, &m_Pipeline, dynamicLoader);
         if (result != vk::Result::eSuccess)
         {
             VTNA_LOG_ERROR("[RHIGraphicsPipelineStateVK] Failed to create {}", m_Name);
             return false;
         }
+        device->RecordPipelineCreation(feedback);
         SetDebugName(deviceHandle, vk::ObjectType::ePipeline, (uint64_t)(VkPipeline)m_Pipeline, m_Name.c_str(), dynamicLoader);
         return true;
     }
@@ -199,7 +211,12 @@ namespace RHI
         auto device = static_cast<FVulkanDevice*>(m_pDevice);
         device->Delete(m_Pipeline);
 
+        vk::PipelineCreationFeedback feedback {};
+        vk::PipelineCreationFeedbackCreateInfo feedbackCI {};
+        feedbackCI.setPPipelineCreationFeedback(&feedback);
+
         vk::ComputePipelineCreateInfo pipelineCI {};
+        pipelineCI.setPNext(&feedbackCI);
         pipelineCI.setFlags(vk::PipelineCreateFlagBits::eDescriptorBufferEXT);
         pipelineCI.stage.setStage(vk::ShaderStageFlagBits::eCompute);
         pipelineCI.stage.setModule((VkShaderModule)m_Desc.CS->GetNativeHandle());
@@ -208,12 +225,13 @@ namespace RHI
 
         auto deviceHandle = device->GetDevice();
         auto dynamicLoader = device->GetDynamicLoader();
-        auto result = deviceHandle.createComputePipelines(nullptr, 1, &pipelineCI, nullptr, &m_Pipeline, dynamicLoader);
+        auto result = deviceHandle.createComputePipelines(device->GetPipelineCache(), 1, &pipelineCI, nullptr, &m_Pipeline, dynamicLoader);
         if (result != vk::Result::eSuccess)
         {
             VTNA_LOG_ERROR("[RHIComputePipelineStateVK] Failed to create {}", m_Name);
             return false;
         }
+        device->RecordPipelineCreation(feedback);
         SetDebugName(deviceHandle, vk::ObjectType::ePipeline, (uint64_t)(VkPipeline)m_Pipeline, m_Name.c_str(), dynamicLoader);
         return true;
     }
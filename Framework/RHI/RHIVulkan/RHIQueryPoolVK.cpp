@@ -0,0 +1,38 @@
+#include "RHIQueryPoolVK.hpp"
+#include "RHIDeviceVK.hpp"
+#include "Utilities/Log.hpp"
+
+namespace RHI
+{
+    FVulkanQueryPool::FVulkanQueryPool(FVulkanDevice *device, const FRHIQueryPoolDesc &desc, const eastl::string &name)
+    {
+        m_pDevice = device;
+        m_Desc = desc;
+        m_Name = name;
+    }
+
+    FVulkanQueryPool::~FVulkanQueryPool()
+    {
+        ((FVulkanDevice*)m_pDevice)->Delete(m_QueryPool);
+    }
+
+    bool FVulkanQueryPool::Create()
+    {
+        auto device = ((FVulkanDevice*)m_pDevice)->GetDevice();
+        auto dynamicLoader = ((FVulkanDevice*)m_pDevice)->GetDynamicLoader();
+
+        vk::QueryPoolCreateInfo queryPoolCI {};
+        queryPoolCI.queryType = vk::QueryType::eTimestamp;
+        queryPoolCI.queryCount = m_Desc.QueryCount;
+
+        m_QueryPool = device.createQueryPool(queryPoolCI);
+        if (!m_QueryPool)
+        {
+            VTNA_LOG_ERROR("[RHIQueryPoolVK] Failed to create {}", m_Name);
+            return false;
+        }
+        SetDebugName(device, vk::ObjectType::eQueryPool, m_QueryPool, m_Name.c_str(), dynamicLoader);
+
+        return true;
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "RHICommonVK.hpp"
+#include "RHI/RHIQueryPool.hpp"
+
+namespace RHI
+{
+    class FVulkanDevice;
+
+    class FVulkanQueryPool : public FRHIQueryPool
+    {
+    public:
+        FVulkanQueryPool(FVulkanDevice* device, const FRHIQueryPoolDesc& desc, const eastl::string& name);
+        ~FVulkanQueryPool();
+
+        bool Create();
+
+        virtual void* GetNativeHandle() const override { return m_QueryPool; }
+
+    private:
+        vk::QueryPool m_QueryPool;
+    };
+}
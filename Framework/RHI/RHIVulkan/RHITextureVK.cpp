@@ -56,7 +56,22 @@ namespace RHI
             {
                 allocCI.flags |= VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
             }
-            res = (vk::Result)vmaCreateImage(allocator, (VkImageCreateInfo*)&imageCI, &allocCI, (VkImage*)&m_Image, &m_Allocation, nullptr);
+
+            if (m_Desc.Usage & RHITextureUsageTransientAttachment)
+            {
+                // 桌面 GPU 通常没有 lazily allocated 内存，失败时退回普通显存
+                VmaAllocationCreateInfo lazyAllocCI = allocCI;
+                lazyAllocCI.usage = VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED;
+                res = (vk::Result)vmaCreateImage(allocator, (VkImageCreateInfo*)&imageCI, &lazyAllocCI, (VkImage*)&m_Image, &m_Allocation, nullptr);
+                if (res != vk::Result::eSuccess)
+                {
+                    res = (vk::Result)vmaCreateImage(allocator, (VkImageCreateInfo*)&imageCI, &allocCI, (VkImage*)&m_Image, &m_Allocation, nullptr);
+                }
+            }
+            else
+            {
+                res = (vk::Result)vmaCreateImage(allocator, (VkImageCreateInfo*)&imageCI, &allocCI, (VkImage*)&m_Image, &m_Allocation, nullptr);
+            }
         }
 
         if (res != vk::Result::eSuccess)
@@ -123,8 +138,9 @@ namespace RHI
 
     uint32_t FVulkanTexture::GetRowPitch(uint32_t mipLevel) const
     {
-        uint32_t minWidth = GetFormatBlockWidth(m_Desc.Format);
-        uint32_t width = eastl::max(minWidth, m_Desc.Width >> mipLevel);
+        // 块压缩格式按整块对齐，宽度不是 4 的倍数的 mip 也要包含最后一个块
+        uint32_t blockWidth = GetFormatBlockWidth(m_Desc.Format);
+        uint32_t width = (eastl::max(m_Desc.Width >> mipLevel, 1u) + blockWidth - 1) / blockWidth * blockWidth;
 
         return GetFormatRowPitch(m_Desc.Format, width) * GetFormatBlockHeight(m_Desc.Format);
     }
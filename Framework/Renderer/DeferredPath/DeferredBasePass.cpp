@@ -2,7 +2,7 @@
 #include "Renderer/RendererBase.hpp"
 #include "Renderer/RenderModules/HiZBuffer.hpp"
 
-#include <EASTL/map.h>
+#include <EASTL/hash_map.h>
 
 namespace Renderer
 {
@@ -22,11 +22,26 @@ namespace Renderer
         RG::FRGHandle SecondPhaseObjectListCounterBuffer;
     };
 
-    struct FBuildMeshletListData
+    struct FCompactInstancesData
     {
         RG::FRGHandle CullingResultBuffer;
-        RG::FRGHandle MeshletListBuffer;
         RG::FRGHandle MeshletListCounterBuffer;
+        RG::FRGHandle VisibleInstanceListBuffer;
+        RG::FRGHandle VisibleInstanceCounterBuffer;
+    };
+
+    struct FBuildExpandMeshletsCommandData
+    {
+        RG::FRGHandle VisibleInstanceCounterBuffer;
+        RG::FRGHandle CommandBuffer;
+    };
+
+    struct FExpandMeshletsData
+    {
+        RG::FRGHandle CommandBuffer;
+        RG::FRGHandle VisibleInstanceListBuffer;
+        RG::FRGHandle VisibleInstanceCounterBuffer;
+        RG::FRGHandle MeshletListBuffer;
     };
 
     struct FBuildIndirectCommandData
@@ -35,9 +50,16 @@ namespace Renderer
         RG::FRGHandle IndirectCommandBuffer;
     };
 
+    struct FBuildDrawIndexedCommandData
+    {
+        RG::FRGHandle CullingResultBuffer;
+        RG::FRGHandle DrawCommandBuffer;
+    };
+
     struct FBasePassData
     {
         RG::FRGHandle IndirectCommandBuffer;
+        RG::FRGHandle DrawCommandBuffer;
 
         RG::FRGHandle InHZBTexture;
         RG::FRGHandle MeshletListBuffer;
@@ -66,20 +88,23 @@ namespace Renderer
         computeDesc.CS = pRenderer->GetShader("InstanceCulling.hlsl", "InstanceCulling", RHI::ERHIShaderType::CS);
         m_InstanceCulling2ndPhasePSO = pRenderer->GetPipelineState(computeDesc, "2nd Phase Instance Culling PSO");
 
-        computeDesc.CS = pRenderer->GetShader("InstanceCulling.hlsl", "BuildMeshletList", RHI::ERHIShaderType::CS);
-        m_BuildMeshletListPSO = pRenderer->GetPipelineState(computeDesc, "Build Meshlet List PSO");
+        computeDesc.CS = pRenderer->GetShader("InstanceCulling.hlsl", "CompactVisibleInstances", RHI::ERHIShaderType::CS);
+        m_CompactVisibleInstancesPSO = pRenderer->GetPipelineState(computeDesc, "Compact Visible Instances PSO");
+
+        computeDesc.CS = pRenderer->GetShader("InstanceCulling.hlsl", "BuildExpandMeshletsCmd", RHI::ERHIShaderType::CS);
+        m_BuildExpandMeshletsCmdPSO = pRenderer->GetPipelineState(computeDesc, "Build Expand Meshlets Command PSO");
+
+        computeDesc.CS = pRenderer->GetShader("InstanceCulling.hlsl", "ExpandMeshlets", RHI::ERHIShaderType::CS);
+        m_ExpandMeshletsPSO = pRenderer->GetPipelineState(computeDesc, "Expand Meshlets PSO");
 
         computeDesc.CS = pRenderer->GetShader("InstanceCulling.hlsl", "BuildInstanceCullingCmd", RHI::ERHIShaderType::CS);
         m_BuildInstanceCullingCmdPSO = pRenderer->GetPipelineState(computeDesc, "Build Indirect Instance Culling Command PSO");
 
         computeDesc.CS = pRenderer->GetShader("InstanceCulling.hlsl", "BuildIndirectCmd", RHI::ERHIShaderType::CS);
         m_BuildIndirectCmdPSO = pRenderer->GetPipelineState(computeDesc, "Build Indirect Command PSO");
-    }
 
-    FRenderBatch &FDeferredBasePass::AddBatch()
-    {
-        FLinearAllocator* allocator = m_pRenderer->GetConstantAllocator();
-        return m_Instance.emplace_back(*allocator);
+        computeDesc.CS = pRenderer->GetShader("InstanceCulling.hlsl", "BuildDrawIndexedCmd", RHI::ERHIShaderType::CS);
+        m_BuildDrawIndexedCmdPSO = pRenderer->GetPipelineState(computeDesc, "Build Draw Indexed Command PSO");
     }
 
     void FDeferredBasePass::Render1stPhase(RG::FRenderGraph *pRenderGraph)
@@ -89,7 +114,7 @@ namespace Renderer
         MergeBatches();
 
         uint32_t maxDispatchNum = RoundUpTo((uint32_t)m_IndirectBatches.size(), 65536 / sizeof(uint32_t));
-        uint32_t maxInstanceNum = RoundUpTo(m_pRenderer->GetInstanceCount(), 65536 / sizeof(uint8_t));
+        uint32_t maxInstanceNum = RoundUpTo(m_pRenderer->GetRenderFramePacket().InstanceCount, 65536 / sizeof(uint8_t));
         uint32_t maxMeshletNum = RoundUpTo(m_TotalMeshletCount, 65536 / sizeof(uint2));
 
         FHiZBuffer *pHZB = m_pRenderer->GetHiZBuffer();
@@ -123,6 +148,9 @@ namespace Renderer
         auto instanceCullingPass = pRenderGraph->AddPass<FInstanceCullingData>("Instance Culling", RG::RenderPassType::Compute, 
             [&](FInstanceCullingData &data, RG::FRGBuilder &builder)
             {
+                // stats 通过 SceneCB 中的 bindless UAV 写入，调度器看不到这个依赖
+                builder.DisableAsyncCompute();
+
                 RHI::FRHIBufferDesc bufferDesc;
                 bufferDesc.Stride = 1;
                 bufferDesc.Size = bufferDesc.Stride * maxInstanceNum;
@@ -152,27 +180,11 @@ namespace Renderer
                     pRenderGraph->GetBuffer(data.SecondPhaseObjectListCounterBuffer));
             });
         
-        auto buildMeshletListPass = pRenderGraph->AddPass<FBuildMeshletListData>("Build Meshlet List", RG::RenderPassType::Compute,
-            [&](FBuildMeshletListData &data, RG::FRGBuilder &builder)
-            {
-                RHI::FRHIBufferDesc bufferDesc;
-                bufferDesc.Stride = sizeof(uint2);
-                bufferDesc.Size = bufferDesc.Stride * maxMeshletNum;
-                bufferDesc.Usage = RHI::RHIBufferUsageStructuredBuffer;
-                data.MeshletListBuffer = builder.Create<RG::FRGBuffer>(bufferDesc, "FirstPhaseMeshletListBuffer");
+        RG::FRGHandle meshletListBuffer;
+        RG::FRGHandle meshletListCounterBuffer = clearCounterPass->FirstPhaseMeshletListCounterBuffer;
+        ExpandMeshletList(pRenderGraph, instanceCullingPass->CullingResultBuffer, maxInstanceNum, maxMeshletNum, meshletListBuffer, meshletListCounterBuffer);
+        RG::FRGHandle drawCommandBuffer = BuildDrawIndexedCommand(pRenderGraph, instanceCullingPass->CullingResultBuffer, "FirstPhaseDrawIndexedCommand");
 
-                data.CullingResultBuffer = builder.Read(instanceCullingPass->CullingResultBuffer);
-                data.MeshletListBuffer = builder.Write(data.MeshletListBuffer);
-                data.MeshletListCounterBuffer = builder.Write(clearCounterPass->FirstPhaseMeshletListCounterBuffer);
-            },
-            [=](const FBuildMeshletListData &data, RHI::FRHICommandList* pCmdList)
-            {
-                BuildMeshletList(pCmdList, 
-                    pRenderGraph->GetBuffer(data.CullingResultBuffer), 
-                    pRenderGraph->GetBuffer(data.MeshletListBuffer), 
-                    pRenderGraph->GetBuffer(data.MeshletListCounterBuffer));
-            });
-        
         auto buildIndirectCommandPass = pRenderGraph->AddPass<FBuildIndirectCommandData>("Build Indirect Command", RG::RenderPassType::Compute,
             [&](FBuildIndirectCommandData &data, RG::FRGBuilder &builder)
             {
@@ -183,7 +195,7 @@ namespace Renderer
                 data.IndirectCommandBuffer = builder.Create<RG::FRGBuffer>(bufferDesc, "FirstPhaseIndirectCommand");
                 data.IndirectCommandBuffer = builder.Write(data.IndirectCommandBuffer);
 
-                data.MeshletListCounterBuffer = builder.Read(buildMeshletListPass->MeshletListCounterBuffer);
+                data.MeshletListCounterBuffer = builder.Read(meshletListCounterBuffer);
             },
             [=](const FBuildIndirectCommandData &data, RHI::FRHICommandList* pCmdList)
             {
@@ -222,8 +234,9 @@ namespace Renderer
                 }
 
                 data.IndirectCommandBuffer = builder.ReadIndirectArg(buildIndirectCommandPass->IndirectCommandBuffer);
-                data.MeshletListBuffer = builder.Read(buildMeshletListPass->MeshletListBuffer, 0, RG::RGBuilderFlag::ShaderStageNonPS);
-                data.MeshletListCounterBuffer = builder.Read(buildMeshletListPass->MeshletListCounterBuffer, 0, RG::RGBuilderFlag::ShaderStageNonPS);
+                data.DrawCommandBuffer = builder.ReadIndirectArg(drawCommandBuffer);
+                data.MeshletListBuffer = builder.Read(meshletListBuffer, 0, RG::RGBuilderFlag::ShaderStageNonPS);
+                data.MeshletListCounterBuffer = builder.Read(meshletListCounterBuffer, 0, RG::RGBuilderFlag::ShaderStageNonPS);
 
                 RHI::FRHIBufferDesc bufferDesc;
                 bufferDesc.Stride = sizeof(uint2);
@@ -239,7 +252,8 @@ namespace Renderer
                 FlushBatches1stPhase(pCmdList, 
                     pRenderGraph->GetBuffer(data.IndirectCommandBuffer), 
                     pRenderGraph->GetBuffer(data.MeshletListBuffer), 
-                    pRenderGraph->GetBuffer(data.MeshletListCounterBuffer));
+                    pRenderGraph->GetBuffer(data.MeshletListCounterBuffer),
+                    pRenderGraph->GetBuffer(data.DrawCommandBuffer));
             });
 
         m_DiffuseRT = basePass->OutDiffuseRT;
@@ -261,7 +275,7 @@ namespace Renderer
         FHiZBuffer *pHZB = m_pRenderer->GetHiZBuffer();
 
         uint32_t maxDispatchNum = RoundUpTo((uint32_t)m_IndirectBatches.size(), 65536 / sizeof(uint32_t));
-        uint32_t maxInstanceNum = RoundUpTo(m_pRenderer->GetInstanceCount(), 65536 / sizeof(uint8_t));
+        uint32_t maxInstanceNum = RoundUpTo(m_pRenderer->GetRenderFramePacket().InstanceCount, 65536 / sizeof(uint8_t));
 
         struct FBuildCullingCommandData
         {
@@ -296,6 +310,8 @@ namespace Renderer
         auto instanceCullingPass = pRenderGraph->AddPass<FInstanceCullingData>("Instance Culling", RG::RenderPassType::Compute,
             [&](FInstanceCullingData& data, RG::FRGBuilder& builder)
             {
+                builder.DisableAsyncCompute();
+
                 RHI::FRHIBufferDesc bufferDesc;
                 bufferDesc.Stride = 1;
                 bufferDesc.Size = bufferDesc.Stride * maxInstanceNum;
@@ -322,20 +338,10 @@ namespace Renderer
                     pRenderGraph->GetBuffer(data.SecondPhaseObjectListCounterBuffer));
             });
         
-        auto buildMeshletListPass = pRenderGraph->AddPass<FBuildMeshletListData>("Build Meshlet List", RG::RenderPassType::Compute,
-            [&](FBuildMeshletListData& data, RG::FRGBuilder& builder)
-            {
-                data.CullingResultBuffer = builder.Read(instanceCullingPass->CullingResultBuffer);
-                data.MeshletListBuffer = builder.Write(m_2ndPhaseMeshletListBuffer);
-                data.MeshletListCounterBuffer = builder.Write(m_2ndPhaseMeshletListCounterBuffer);
-            },
-            [=](const FBuildMeshletListData& data, RHI::FRHICommandList* pCmdList)
-            {
-                BuildMeshletList(pCmdList, 
-                    pRenderGraph->GetBuffer(data.CullingResultBuffer), 
-                    pRenderGraph->GetBuffer(data.MeshletListBuffer), 
-                    pRenderGraph->GetBuffer(data.MeshletListCounterBuffer));
-            });
+        RG::FRGHandle meshletListBuffer = m_2ndPhaseMeshletListBuffer;
+        RG::FRGHandle meshletListCounterBuffer = m_2ndPhaseMeshletListCounterBuffer;
+        ExpandMeshletList(pRenderGraph, instanceCullingPass->CullingResultBuffer, maxInstanceNum, 0, meshletListBuffer, meshletListCounterBuffer);
+        RG::FRGHandle drawCommandBuffer = BuildDrawIndexedCommand(pRenderGraph, instanceCullingPass->CullingResultBuffer, "SecondPhaseDrawIndexedCommand");
 
         auto buildIndirectCommandPass = pRenderGraph->AddPass<FBuildIndirectCommandData>("Build Indirect Command", RG::RenderPassType::Compute,
             [&](FBuildIndirectCommandData& data, RG::FRGBuilder& builder)
@@ -347,7 +353,7 @@ namespace Renderer
                 data.IndirectCommandBuffer = builder.Create<RG::FRGBuffer>(bufferDesc, "SecondPhaseIndirectCommand");
                 data.IndirectCommandBuffer = builder.Write(data.IndirectCommandBuffer);
 
-                data.MeshletListCounterBuffer = builder.Read(buildMeshletListPass->MeshletListCounterBuffer);
+                data.MeshletListCounterBuffer = builder.Read(meshletListCounterBuffer);
             },
             [=](const FBuildIndirectCommandData& data, RHI::FRHICommandList* pCmdList)
             {
@@ -369,16 +375,18 @@ namespace Renderer
                     data.InHZBTexture = builder.Read(pHZB->GetCullingHZBMip2ndPhase(i), i, RG::RGBuilderFlag::ShaderStageNonPS);
                 }
 
-                data.MeshletListBuffer = builder.Read(buildMeshletListPass->MeshletListBuffer, 0, RG::RGBuilderFlag::ShaderStageNonPS);
-                data.MeshletListCounterBuffer = builder.Read(buildMeshletListPass->MeshletListCounterBuffer, 0, RG::RGBuilderFlag::ShaderStageNonPS);
+                data.MeshletListBuffer = builder.Read(meshletListBuffer, 0, RG::RGBuilderFlag::ShaderStageNonPS);
+                data.MeshletListCounterBuffer = builder.Read(meshletListCounterBuffer, 0, RG::RGBuilderFlag::ShaderStageNonPS);
                 data.IndirectCommandBuffer = builder.ReadIndirectArg(buildIndirectCommandPass->IndirectCommandBuffer);
+                data.DrawCommandBuffer = builder.ReadIndirectArg(drawCommandBuffer);
             },
             [=](const FBasePassData& data, RHI::FRHICommandList* pCmdList)
             {
                 FlushBatches2ndPhase(pCmdList, 
                     pRenderGraph->GetBuffer(data.IndirectCommandBuffer), 
                     pRenderGraph->GetBuffer(data.MeshletListBuffer), 
-                    pRenderGraph->GetBuffer(data.MeshletListCounterBuffer));
+                    pRenderGraph->GetBuffer(data.MeshletListCounterBuffer),
+                    pRenderGraph->GetBuffer(data.DrawCommandBuffer));
             });
 
         m_DiffuseRT = basePass->OutDiffuseRT;
@@ -389,74 +397,90 @@ namespace Renderer
 
     void FDeferredBasePass::MergeBatches()
     {
-        m_TotalInstanceCount = (uint32_t)m_Instance.size();
-
-        eastl::vector<uint32_t> instanceIndices(m_TotalInstanceCount);
-        for (uint32_t i = 0; i < m_TotalInstanceCount; ++i)
-        {
-            instanceIndices[i] = m_Instance[i].InstanceIndex;
-        }
-        m_InstanceIndexAddress = m_pRenderer->AllocateSceneConstantBuffer(instanceIndices.data(), sizeof(uint32_t) * m_TotalInstanceCount);
+        FFramePacket& packet = m_pRenderer->GetRenderFramePacket();
+        const eastl::vector<FRenderBatch>& instances = packet.BasePassBatches;
 
+        m_TotalInstanceCount = (uint32_t)instances.size();
         m_TotalMeshletCount = 0;
         m_IndirectBatches.clear();
         m_NonGPUDrivenBatches.clear();
+        m_IndirectDrawBatches.clear();
 
-        struct FMergedBatch
-        {
-            eastl::vector<FRenderBatch*> Batches;
-            uint32_t MeshletCount;
-        };
-        eastl::map<RHI::FRHIPipelineState*, FMergedBatch> mergedBatches;
+        // 只按 PSO 分桶统计 instance 和 meshlet 数量，meshlet 列表由 GPU 根据剔除结果展开
+        eastl::hash_map<RHI::FRHIPipelineState*, uint32_t> bucketIndices;
+        eastl::vector<uint32_t> instanceBuckets(m_TotalInstanceCount, UINT32_MAX);
 
-        for (size_t i = 0; i < m_Instance.size(); ++i)
+        for (uint32_t i = 0; i < m_TotalInstanceCount; ++i)
         {
-            const FRenderBatch& batch = m_Instance[i];
+            const FRenderBatch& batch = instances[i];
             if (batch.PSO->GetType() == RHI::ERHIPipelineType::MeshShading)
             {
                 m_TotalMeshletCount += batch.MeshletCount;
 
-                auto iter = mergedBatches.find(batch.PSO);
-                if (iter != mergedBatches.end())
-                {
-                    iter->second.MeshletCount += batch.MeshletCount;
-                    iter->second.Batches.push_back(&m_Instance[i]);
-                }
-                else
+                auto iter = bucketIndices.find(batch.PSO);
+                if (iter == bucketIndices.end())
                 {
-                    FMergedBatch mergeBatch;
-                    mergeBatch.Batches.push_back(&m_Instance[i]);
-                    mergeBatch.MeshletCount = batch.MeshletCount;
-                    mergedBatches.insert(eastl::make_pair(batch.PSO, mergeBatch));
+                    iter = bucketIndices.insert(eastl::make_pair(batch.PSO, (uint32_t)m_IndirectBatches.size())).first;
+                    m_IndirectBatches.push_back({batch.PSO, 0, 0, 0, 0});
                 }
+
+                FIndirectBatch& indirectBatch = m_IndirectBatches[iter->second];
+                indirectBatch.InstanceCount++;
+                indirectBatch.MeshletCount += batch.MeshletCount;
+                instanceBuckets[i] = iter->second;
+            }
+            else if (batch.IndexBuffer != nullptr)
+            {
+                m_IndirectDrawBatches.push_back(batch);
             }
             else
             {
-                m_NonGPUDrivenBatches.push_back(batch);     // TODO: also instance-culling & merging for VS batches
+                m_NonGPUDrivenBatches.push_back(batch);
             }
         }
 
-        uint32_t meshletListOffset = 0;
-        for (auto iter = mergedBatches.begin(); iter != mergedBatches.end(); ++iter)
+        eastl::vector<uint2> drawBatchTable;
+        drawBatchTable.reserve(m_IndirectDrawBatches.size());
+        for (size_t i = 0; i < m_IndirectDrawBatches.size(); ++i)
         {
-            const FMergedBatch& batch = iter->second;
+            drawBatchTable.emplace_back(m_IndirectDrawBatches[i].InstanceIndex, m_IndirectDrawBatches[i].IndexCount);
+        }
+        m_DrawBatchTableAddress = m_pRenderer->AllocateSceneConstantBuffer(packet, drawBatchTable.data(), sizeof(uint2) * (uint32_t)drawBatchTable.size());
 
-            eastl::vector<uint2> meshletList;
-            meshletList.reserve(batch.MeshletCount);
+        eastl::vector<uint4> bucketTable;
+        bucketTable.reserve(m_IndirectBatches.size());
 
-            for (size_t i = 0; i < batch.Batches.size(); ++i)
-            {
-                uint32_t instanceIndex = batch.Batches[i]->InstanceIndex;
-                for (uint32_t j = 0; j < batch.Batches[i]->MeshletCount; ++j)
-                {
-                    meshletList.emplace_back(instanceIndex, j);
-                }
-            }
-            uint32_t meshletListAddress = m_pRenderer->AllocateSceneConstantBuffer(meshletList.data(), sizeof(uint2) * (uint32_t)meshletList.size());
-            m_IndirectBatches.push_back({iter->first, meshletListAddress, batch.MeshletCount, meshletListOffset});
+        uint32_t instanceOffset = 0;
+        uint32_t meshletListOffset = 0;
+        for (size_t i = 0; i < m_IndirectBatches.size(); ++i)
+        {
+            FIndirectBatch& batch = m_IndirectBatches[i];
+            batch.InstanceOffset = instanceOffset;
+            batch.MeshletListBufferOffset = meshletListOffset;
+            bucketTable.emplace_back(instanceOffset, batch.InstanceCount, meshletListOffset, 0);
+
+            instanceOffset += batch.InstanceCount;
             meshletListOffset += batch.MeshletCount;
         }
-        m_Instance.clear();
+        m_BucketInstanceCount = instanceOffset;
+
+        // 同一个桶的 instance 连续存放，非 GPU Driven 的排在最后，依然参与 instance culling
+        eastl::vector<uint32_t> bucketCursors(m_IndirectBatches.size());
+        for (size_t i = 0; i < m_IndirectBatches.size(); ++i)
+        {
+            bucketCursors[i] = m_IndirectBatches[i].InstanceOffset;
+        }
+
+        eastl::vector<uint32_t> instanceIndices(m_TotalInstanceCount);
+        uint32_t nonGPUDrivenCursor = m_BucketInstanceCount;
+        for (uint32_t i = 0; i < m_TotalInstanceCount; ++i)
+        {
+            uint32_t bucket = instanceBuckets[i];
+            uint32_t position = bucket != UINT32_MAX ? bucketCursors[bucket]++ : nonGPUDrivenCursor++;
+            instanceIndices[position] = instances[i].InstanceIndex;
+        }
+        m_InstanceIndexAddress = m_pRenderer->AllocateSceneConstantBuffer(packet, instanceIndices.data(), sizeof(uint32_t) * m_TotalInstanceCount);
+        m_BucketTableAddress = m_pRenderer->AllocateSceneConstantBuffer(packet, bucketTable.data(), sizeof(uint4) * (uint32_t)bucketTable.size());
     }
 
     void FDeferredBasePass::ResetCounter(RHI::FRHICommandList* pCmdList, RG::FRGBuffer* firstPhaseMeshletCounter, RG::FRGBuffer* secondPhaseObjectCounter, RG::FRGBuffer* secondPhaseMeshletCounter)
@@ -507,7 +531,7 @@ namespace Renderer
         pCmdList->DispatchIndirect(pIndirectCommandBuffer->GetBuffer(), 0);
     }
 
-    void FDeferredBasePass::FlushBatches1stPhase(RHI::FRHICommandList *pCmdList, RG::FRGBuffer *pIndirectCommandBuffer, RG::FRGBuffer *pMeshletListSRV, RG::FRGBuffer *pMeshletListCounterSRV)
+    void FDeferredBasePass::FlushBatches1stPhase(RHI::FRHICommandList *pCmdList, RG::FRGBuffer *pIndirectCommandBuffer, RG::FRGBuffer *pMeshletListSRV, RG::FRGBuffer *pMeshletListCounterSRV, RG::FRGBuffer *pDrawCommandBuffer)
     {
         for (size_t i = 0; i < m_IndirectBatches.size(); ++i)
         {
@@ -519,9 +543,14 @@ namespace Renderer
 
             pCmdList->DispatchMeshIndirect(pIndirectCommandBuffer->GetBuffer(), sizeof(uint3) * (uint32_t)i);
         }
+
+        for (size_t i = 0; i < m_IndirectDrawBatches.size(); ++i)
+        {
+            DrawBatchIndirect(pCmdList, m_IndirectDrawBatches[i], pDrawCommandBuffer->GetBuffer(), sizeof(RHI::FRHIDrawIndexedCommand) * (uint32_t)i);
+        }
     }
 
-    void FDeferredBasePass::FlushBatches2ndPhase(RHI::FRHICommandList *pCmdList, RG::FRGBuffer *pIndirectCommandBuffer, RG::FRGBuffer *pMeshletListSRV, RG::FRGBuffer *pMeshletListCounterSRV)
+    void FDeferredBasePass::FlushBatches2ndPhase(RHI::FRHICommandList *pCmdList, RG::FRGBuffer *pIndirectCommandBuffer, RG::FRGBuffer *pMeshletListSRV, RG::FRGBuffer *pMeshletListCounterSRV, RG::FRGBuffer *pDrawCommandBuffer)
     {
         for (size_t i = 0; i < m_IndirectBatches.size(); ++i)
         {
@@ -534,29 +563,164 @@ namespace Renderer
             pCmdList->DispatchMeshIndirect(pIndirectCommandBuffer->GetBuffer(), sizeof(uint3) * (uint32_t)i);
         }
 
+        for (size_t i = 0; i < m_IndirectDrawBatches.size(); ++i)
+        {
+            DrawBatchIndirect(pCmdList, m_IndirectDrawBatches[i], pDrawCommandBuffer->GetBuffer(), sizeof(RHI::FRHIDrawIndexedCommand) * (uint32_t)i);
+        }
+
         for (size_t i = 0; i < m_NonGPUDrivenBatches.size(); ++i)
         {
             DrawBatch(pCmdList, m_NonGPUDrivenBatches[i]);
         }
     }
 
-    void FDeferredBasePass::BuildMeshletList(RHI::FRHICommandList *pCmdList, RG::FRGBuffer *cullingResultSRV, RG::FRGBuffer *meshletListBufferUAV, RG::FRGBuffer *meshletListCounterBufferUAV)
+    void FDeferredBasePass::ExpandMeshletList(RG::FRenderGraph *pRenderGraph, RG::FRGHandle cullingResult, uint32_t maxInstanceNum, uint32_t maxMeshletNum, RG::FRGHandle &meshletList, RG::FRGHandle &meshletListCounter)
     {
-        pCmdList->SetPipelineState(m_BuildMeshletListPSO);
+        auto compactInstancesPass = pRenderGraph->AddPass<FCompactInstancesData>("Compact Visible Instances", RG::RenderPassType::Compute,
+            [&](FCompactInstancesData& data, RG::FRGBuilder& builder)
+            {
+                RHI::FRHIBufferDesc bufferDesc;
+                bufferDesc.Stride = sizeof(uint4);
+                bufferDesc.Size = bufferDesc.Stride * maxInstanceNum;
+                bufferDesc.Usage = RHI::RHIBufferUsageStructuredBuffer;
+                data.VisibleInstanceListBuffer = builder.Create<RG::FRGBuffer>(bufferDesc, "VisibleInstanceListBuffer");
+                data.VisibleInstanceListBuffer = builder.Write(data.VisibleInstanceListBuffer);
 
-        for (size_t i = 0; i < m_IndirectBatches.size(); ++i)
-        {
-            uint32_t consts[7] = {
-                (uint32_t)i,
-                cullingResultSRV->GetSRV()->GetHeapIndex(),
-                m_IndirectBatches[i].OriginMeshletListAddress,
-                m_IndirectBatches[i].OriginMeshletCount,
-                m_IndirectBatches[i].MeshletListBufferOffset,
-                meshletListBufferUAV->GetUAV()->GetHeapIndex(),
-                meshletListCounterBufferUAV->GetUAV()->GetHeapIndex()};
-            pCmdList->SetComputeConstants(0, consts, sizeof(consts));
-            pCmdList->Dispatch(DivideRoundingUp(m_IndirectBatches[i].OriginMeshletCount, 64), 1, 1);
-        }
+                bufferDesc.Stride = 4;
+                bufferDesc.Size = bufferDesc.Stride;
+                bufferDesc.Format = RHI::ERHIFormat::R32UI;
+                bufferDesc.Usage = RHI::RHIBufferUsageTypedBuffer;
+                data.VisibleInstanceCounterBuffer = builder.Create<RG::FRGBuffer>(bufferDesc, "VisibleInstanceCounterBuffer");
+                data.VisibleInstanceCounterBuffer = builder.Write(data.VisibleInstanceCounterBuffer);
+
+                data.CullingResultBuffer = builder.Read(cullingResult);
+                data.MeshletListCounterBuffer = builder.Write(meshletListCounter);
+            },
+            [=](const FCompactInstancesData& data, RHI::FRHICommandList* pCmdList)
+            {
+                CompactVisibleInstances(pCmdList,
+                    pRenderGraph->GetBuffer(data.CullingResultBuffer),
+                    pRenderGraph->GetBuffer(data.VisibleInstanceListBuffer),
+                    pRenderGraph->GetBuffer(data.VisibleInstanceCounterBuffer),
+                    pRenderGraph->GetBuffer(data.MeshletListCounterBuffer));
+            });
+
+        auto buildCommandPass = pRenderGraph->AddPass<FBuildExpandMeshletsCommandData>("Build Expand Meshlets Command", RG::RenderPassType::Compute,
+            [&](FBuildExpandMeshletsCommandData& data, RG::FRGBuilder& builder)
+            {
+                RHI::FRHIBufferDesc bufferDesc;
+                bufferDesc.Stride = sizeof(uint3);
+                bufferDesc.Size = bufferDesc.Stride;
+                bufferDesc.Usage = RHI::RHIBufferUsageStructuredBuffer;
+                data.CommandBuffer = builder.Create<RG::FRGBuffer>(bufferDesc, "ExpandMeshletsCommandBuffer");
+                data.CommandBuffer = builder.Write(data.CommandBuffer);
+
+                data.VisibleInstanceCounterBuffer = builder.Read(compactInstancesPass->VisibleInstanceCounterBuffer);
+            },
+            [=](const FBuildExpandMeshletsCommandData& data, RHI::FRHICommandList* pCmdList)
+            {
+                RG::FRGBuffer* commandBuffer = pRenderGraph->GetBuffer(data.CommandBuffer);
+                RG::FRGBuffer* visibleInstanceCounterBuffer = pRenderGraph->GetBuffer(data.VisibleInstanceCounterBuffer);
+
+                pCmdList->SetPipelineState(m_BuildExpandMeshletsCmdPSO);
+
+                uint32_t consts[2] = {commandBuffer->GetUAV()->GetHeapIndex(), visibleInstanceCounterBuffer->GetSRV()->GetHeapIndex()};
+                pCmdList->SetComputeConstants(0, consts, sizeof(consts));
+                pCmdList->Dispatch(1, 1, 1);
+            });
+
+        auto expandMeshletsPass = pRenderGraph->AddPass<FExpandMeshletsData>("Expand Meshlets", RG::RenderPassType::Compute,
+            [&](FExpandMeshletsData& data, RG::FRGBuilder& builder)
+            {
+                if (!meshletList.IsValid())
+                {
+                    RHI::FRHIBufferDesc bufferDesc;
+                    bufferDesc.Stride = sizeof(uint2);
+                    bufferDesc.Size = bufferDesc.Stride * maxMeshletNum;
+                    bufferDesc.Usage = RHI::RHIBufferUsageStructuredBuffer;
+                    meshletList = builder.Create<RG::FRGBuffer>(bufferDesc, "FirstPhaseMeshletListBuffer");
+                }
+
+                data.CommandBuffer = builder.ReadIndirectArg(buildCommandPass->CommandBuffer);
+                data.VisibleInstanceListBuffer = builder.Read(compactInstancesPass->VisibleInstanceListBuffer);
+                data.VisibleInstanceCounterBuffer = builder.Read(compactInstancesPass->VisibleInstanceCounterBuffer);
+                data.MeshletListBuffer = builder.Write(meshletList);
+            },
+            [=](const FExpandMeshletsData& data, RHI::FRHICommandList* pCmdList)
+            {
+                RG::FRGBuffer* visibleInstanceListBuffer = pRenderGraph->GetBuffer(data.VisibleInstanceListBuffer);
+                RG::FRGBuffer* visibleInstanceCounterBuffer = pRenderGraph->GetBuffer(data.VisibleInstanceCounterBuffer);
+                RG::FRGBuffer* meshletListBuffer = pRenderGraph->GetBuffer(data.MeshletListBuffer);
+
+                pCmdList->SetPipelineState(m_ExpandMeshletsPSO);
+
+                uint32_t consts[3] = {
+                    visibleInstanceListBuffer->GetSRV()->GetHeapIndex(),
+                    visibleInstanceCounterBuffer->GetSRV()->GetHeapIndex(),
+                    meshletListBuffer->GetUAV()->GetHeapIndex()};
+                pCmdList->SetComputeConstants(0, consts, sizeof(consts));
+                pCmdList->DispatchIndirect(pRenderGraph->GetBuffer(data.CommandBuffer)->GetBuffer(), 0);
+            });
+
+        meshletList = expandMeshletsPass->MeshletListBuffer;
+        meshletListCounter = compactInstancesPass->MeshletListCounterBuffer;
+    }
+
+    void FDeferredBasePass::CompactVisibleInstances(RHI::FRHICommandList *pCmdList, RG::FRGBuffer *cullingResultSRV, RG::FRGBuffer *visibleInstanceListUAV, RG::FRGBuffer *visibleInstanceCounterUAV, RG::FRGBuffer *meshletListCounterUAV)
+    {
+        uint32_t clearValue[4] = {0, 0, 0, 0};
+        pCmdList->ClearUAV(visibleInstanceCounterUAV->GetBuffer(), visibleInstanceCounterUAV->GetUAV(), clearValue);
+        pCmdList->BufferBarrier(visibleInstanceCounterUAV->GetBuffer(), RHI::RHIAccessClearUAV, RHI::RHIAccessComputeUAV);
+
+        pCmdList->SetPipelineState(m_CompactVisibleInstancesPSO);
+
+        uint32_t consts[8] = {
+            m_InstanceIndexAddress,
+            m_BucketInstanceCount,
+            m_BucketTableAddress,
+            (uint32_t)m_IndirectBatches.size(),
+            cullingResultSRV->GetSRV()->GetHeapIndex(),
+            visibleInstanceListUAV->GetUAV()->GetHeapIndex(),
+            visibleInstanceCounterUAV->GetUAV()->GetHeapIndex(),
+            meshletListCounterUAV->GetUAV()->GetHeapIndex()};
+        pCmdList->SetComputeConstants(0, consts, sizeof(consts));
+
+        uint32_t groupCount = eastl::max(DivideRoundingUp(m_BucketInstanceCount, 64u), 1u);   // Avoid empty dispatch warning
+        pCmdList->Dispatch(groupCount, 1, 1);
+    }
+
+    RG::FRGHandle FDeferredBasePass::BuildDrawIndexedCommand(RG::FRenderGraph *pRenderGraph, RG::FRGHandle cullingResult, const eastl::string &name)
+    {
+        uint32_t maxDrawNum = RoundUpTo((uint32_t)m_IndirectDrawBatches.size(), 65536 / sizeof(RHI::FRHIDrawIndexedCommand));
+
+        auto buildDrawCommandPass = pRenderGraph->AddPass<FBuildDrawIndexedCommandData>("Build Draw Indexed Command", RG::RenderPassType::Compute,
+            [&](FBuildDrawIndexedCommandData& data, RG::FRGBuilder& builder)
+            {
+                RHI::FRHIBufferDesc bufferDesc;
+                bufferDesc.Stride = sizeof(RHI::FRHIDrawIndexedCommand);
+                bufferDesc.Size = bufferDesc.Stride * maxDrawNum;
+                bufferDesc.Usage = RHI::RHIBufferUsageStructuredBuffer;
+                data.DrawCommandBuffer = builder.Create<RG::FRGBuffer>(bufferDesc, name);
+                data.DrawCommandBuffer = builder.Write(data.DrawCommandBuffer);
+
+                data.CullingResultBuffer = builder.Read(cullingResult);
+            },
+            [=](const FBuildDrawIndexedCommandData& data, RHI::FRHICommandList* pCmdList)
+            {
+                RG::FRGBuffer* cullingResultBuffer = pRenderGraph->GetBuffer(data.CullingResultBuffer);
+                RG::FRGBuffer* drawCommandBuffer = pRenderGraph->GetBuffer(data.DrawCommandBuffer);
+
+                pCmdList->SetPipelineState(m_BuildDrawIndexedCmdPSO);
+
+                uint32_t batchCount = (uint32_t)m_IndirectDrawBatches.size();
+                uint32_t consts[4] = {m_DrawBatchTableAddress, batchCount, cullingResultBuffer->GetSRV()->GetHeapIndex(), drawCommandBuffer->GetUAV()->GetHeapIndex()};
+                pCmdList->SetComputeConstants(0, consts, sizeof(consts));
+
+                uint32_t groupCount = eastl::max(DivideRoundingUp(batchCount, 64u), 1u);    // Avoid empty dispatch warning
+                pCmdList->Dispatch(groupCount, 1, 1);
+            });
+
+        return buildDrawCommandPass->DrawCommandBuffer;
     }
 
     void FDeferredBasePass::BuildIndirectCommand(RHI::FRHICommandList *pCmdList, RG::FRGBuffer *pCounterBufferSRV, RG::FRGBuffer *pCommandBufferUAV)
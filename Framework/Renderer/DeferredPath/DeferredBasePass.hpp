@@ -11,8 +11,6 @@ namespace Renderer
     {
     public:
         FDeferredBasePass(FRendererBase* pRenderer);
-        
-        FRenderBatch& AddBatch();
 
         void Render1stPhase(RG::FRenderGraph* pRenderGraph);
         void Render2ndPhase(RG::FRenderGraph* pRenderGraph);
@@ -32,11 +30,14 @@ namespace Renderer
         void InstanceCulling1stPhase(RHI::FRHICommandList *pCmdList, RG::FRGBuffer *cullingResultUAV, RG::FRGBuffer *secondPhaseObjectListUAV, RG::FRGBuffer *secondPhaseObjectListCounterUAV);
         void InstanceCulling2ndPhase(RHI::FRHICommandList *pCmdList, RG::FRGBuffer *pIndirectCommandBuffer, RG::FRGBuffer *cullingResultUAV, RG::FRGBuffer *objectListBufferSRV, RG::FRGBuffer *objectListCounterBufferSRV);
 
-        void FlushBatches1stPhase(RHI::FRHICommandList *pCmdList, RG::FRGBuffer *pIndirectCommandBuffer, RG::FRGBuffer *pMeshletListSRV, RG::FRGBuffer *pMeshletListCounterSRV);
-        void FlushBatches2ndPhase(RHI::FRHICommandList *pCmdList, RG::FRGBuffer *pIndirectCommandBuffer, RG::FRGBuffer *pMeshletListSRV, RG::FRGBuffer *pMeshletListCounterSRV);
+        void FlushBatches1stPhase(RHI::FRHICommandList *pCmdList, RG::FRGBuffer *pIndirectCommandBuffer, RG::FRGBuffer *pMeshletListSRV, RG::FRGBuffer *pMeshletListCounterSRV, RG::FRGBuffer *pDrawCommandBuffer);
+        void FlushBatches2ndPhase(RHI::FRHICommandList *pCmdList, RG::FRGBuffer *pIndirectCommandBuffer, RG::FRGBuffer *pMeshletListSRV, RG::FRGBuffer *pMeshletListCounterSRV, RG::FRGBuffer *pDrawCommandBuffer);
 
-        void BuildMeshletList(RHI::FRHICommandList *pCmdList, RG::FRGBuffer *cullingResultSRV, RG::FRGBuffer *meshletListBufferUAV, RG::FRGBuffer *meshletListCounterBufferUAV);
+        // meshletList 无效时在展开 pass 中创建；返回后两个 handle 指向写入后的版本
+        void ExpandMeshletList(RG::FRenderGraph *pRenderGraph, RG::FRGHandle cullingResult, uint32_t maxInstanceNum, uint32_t maxMeshletNum, RG::FRGHandle &meshletList, RG::FRGHandle &meshletListCounter);
+        void CompactVisibleInstances(RHI::FRHICommandList *pCmdList, RG::FRGBuffer *cullingResultSRV, RG::FRGBuffer *visibleInstanceListUAV, RG::FRGBuffer *visibleInstanceCounterUAV, RG::FRGBuffer *meshletListCounterUAV);
         void BuildIndirectCommand(RHI::FRHICommandList *pCmdList, RG::FRGBuffer *pCounterBufferSRV, RG::FRGBuffer *pCommandBufferUAV);
+        RG::FRGHandle BuildDrawIndexedCommand(RG::FRenderGraph *pRenderGraph, RG::FRGHandle cullingResult, const eastl::string &name);
 
     private:
         FRendererBase* m_pRenderer;
@@ -44,25 +45,32 @@ namespace Renderer
         RHI::FRHIPipelineState* m_InstanceCulling1stPhasePSO = nullptr;
         RHI::FRHIPipelineState* m_InstanceCulling2ndPhasePSO = nullptr;
 
-        RHI::FRHIPipelineState* m_BuildMeshletListPSO = nullptr;
+        RHI::FRHIPipelineState* m_CompactVisibleInstancesPSO = nullptr;
+        RHI::FRHIPipelineState* m_BuildExpandMeshletsCmdPSO = nullptr;
+        RHI::FRHIPipelineState* m_ExpandMeshletsPSO = nullptr;
         RHI::FRHIPipelineState* m_BuildInstanceCullingCmdPSO = nullptr;
         RHI::FRHIPipelineState* m_BuildIndirectCmdPSO = nullptr;
-
-        eastl::vector<FRenderBatch> m_Instance;
+        RHI::FRHIPipelineState* m_BuildDrawIndexedCmdPSO = nullptr;
 
         struct FIndirectBatch
         {
             RHI::FRHIPipelineState* PSO;
-            uint32_t OriginMeshletListAddress;
-            uint32_t OriginMeshletCount;
+            uint32_t InstanceOffset;
+            uint32_t InstanceCount;
+            uint32_t MeshletCount;
             uint32_t MeshletListBufferOffset;
         };
         eastl::vector<FIndirectBatch> m_IndirectBatches;
         eastl::vector<FRenderBatch> m_NonGPUDrivenBatches;
+        // 参与 instance culling 的 VS 批次（如蒙皮网格），按剔除结果 DrawIndexedIndirect
+        eastl::vector<FRenderBatch> m_IndirectDrawBatches;
+        uint32_t m_DrawBatchTableAddress = 0;
 
         uint32_t m_TotalInstanceCount = 0;
         uint32_t m_TotalMeshletCount = 0;
         uint32_t m_InstanceIndexAddress = 0;
+        uint32_t m_BucketInstanceCount = 0;
+        uint32_t m_BucketTableAddress = 0;
 
         RG::FRGHandle m_DiffuseRT;
         RG::FRGHandle m_NormalRT;
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "RenderBatch.hpp"
+#include "Utilities/Math.hpp"
+#include "Common/GlobalConstants.hlsli"
+
+#include <EASTL/vector.h>
+
+namespace Renderer
+{
+    static constexpr uint32_t FRAME_PACKET_COUNT = 2;
+
+    // GPUScene 的一条增量更新：一段 dword 数据要写到 instance buffer 的位置，数据本身连续存放在 SceneUpdateData
+    struct FGPUSceneUpdate
+    {
+        uint32_t DstAddress;
+        uint32_t SrcOffset;
+        uint32_t DwordCount;
+        uint32_t _Padding;
+    };
+
+    // 一个线程在模拟阶段提交的 batch 和 GPUScene 更新，按 enkiTS 线程号索引，避免多线程提交时加锁
+    // batch 的根常量仍然分配在所属 packet 的 CBAllocator 上
+    struct alignas(64) FThreadSubmission
+    {
+        eastl::vector<FRenderBatch> BasePassBatches;
+        eastl::vector<FComputeBatch> AnimationBatches;
+        eastl::vector<FRenderBatch> OutlinePassBatches;
+        eastl::vector<FRenderBatch> IDPassBatches;
+        eastl::vector<FRenderBatch> GUIBatches;
+
+        eastl::vector<FGPUSceneUpdate> SceneUpdates;
+        eastl::vector<uint32_t> SceneUpdateData;
+    };
+
+    // 模拟阶段交给渲染阶段的一帧数据，两份轮换使用：
+    // 模拟线程填写一份的同时渲染线程读取另一份，交接在渲染线程空闲时进行
+    struct FFramePacket
+    {
+        FFramePacket() : CBAllocator(1024 * 1024 * 8) {}
+
+        void Reset()
+        {
+            CBAllocator.Reset();
+
+            BasePassBatches.clear();
+            AnimationBatches.clear();
+            OutlinePassBatches.clear();
+            IDPassBatches.clear();
+            GUIBatches.clear();
+
+            SceneUpdates.clear();
+            SceneUpdateData.clear();
+            SceneConstantData.clear();
+
+            SceneConstants = {};
+            InstanceCount = 0;
+            bObjectIDRendering = false;
+        }
+
+        // 交接前在模拟线程上调用，按线程号顺序把各线程的提交追加到 packet
+        // 同一线程内保持提交顺序；同一地址的 GPUScene 更新只应来自一个线程
+        void MergeThreadSubmissions()
+        {
+            for (FThreadSubmission& submission : ThreadSubmissions)
+            {
+                AppendBatches(BasePassBatches, submission.BasePassBatches);
+                AppendBatches(AnimationBatches, submission.AnimationBatches);
+                AppendBatches(OutlinePassBatches, submission.OutlinePassBatches);
+                AppendBatches(IDPassBatches, submission.IDPassBatches);
+                AppendBatches(GUIBatches, submission.GUIBatches);
+
+                const uint32_t dataOffset = (uint32_t)SceneUpdateData.size();
+                for (FGPUSceneUpdate update : submission.SceneUpdates)
+                {
+                    update.SrcOffset += dataOffset;
+                    SceneUpdates.push_back(update);
+                }
+                SceneUpdateData.insert(SceneUpdateData.end(), submission.SceneUpdateData.begin(), submission.SceneUpdateData.end());
+
+                submission.SceneUpdates.clear();
+                submission.SceneUpdateData.clear();
+            }
+        }
+
+        // batch 的根常量数据
+        FLinearAllocator CBAllocator;
+
+        eastl::vector<FRenderBatch> BasePassBatches;
+        eastl::vector<FComputeBatch> AnimationBatches;
+        eastl::vector<FRenderBatch> OutlinePassBatches;
+        eastl::vector<FRenderBatch> IDPassBatches;
+        eastl::vector<FRenderBatch> GUIBatches;
+
+        eastl::vector<FGPUSceneUpdate> SceneUpdates;
+        eastl::vector<uint32_t> SceneUpdateData;
+
+        // scene constant buffer 的 CPU 副本，分配得到的地址就是偏移，渲染阶段整段拷贝到本帧的 GPU buffer
+        eastl::vector<uint32_t> SceneConstantData;
+
+        eastl::vector<FThreadSubmission> ThreadSubmissions;
+
+        // 交接时填入相机、光源、帧时间和调试开关，资源索引由 SetupGlobalConstants 补全
+        FSceneConstants SceneConstants {};
+        uint32_t InstanceCount = 0;
+        bool bObjectIDRendering = false;
+
+    private:
+        // batch 持有 allocator 的引用，不能赋值，只能逐个移动构造
+        template <typename T>
+        static void AppendBatches(eastl::vector<T>& dst, eastl::vector<T>& src)
+        {
+            dst.reserve(dst.size() + src.size());
+            for (T& batch : src)
+            {
+                dst.emplace_back(eastl::move(batch));
+            }
+            src.clear();
+        }
+    };
+}
@@ -2,6 +2,10 @@
 #include "RendererBase.hpp"
 
 #define MAX_CONSTANT_BUFFER_SIZE (1024 * 1024 * 8)
+#define MAX_INSTANCE_COUNT (128 * 1024)
+#define INSTANCE_BUFFER_SIZE (1024 * 1024 * 64)
+#define MIN_UPDATE_BUFFER_SIZE (1024 * 256)
+#define MAX_UPDATE_DISPATCH_GROUPS (65535)
 #define ALLOCATION_ALIGNMENT (4)
 
 namespace Renderer
@@ -22,6 +26,16 @@ namespace Renderer
         {
             m_pSceneConstantBuffers[i].reset(pRenderer->CreateRawBuffer(nullptr, MAX_CONSTANT_BUFFER_SIZE, "GPUScene::ConstantBuffer", RHI::ERHIMemoryType::CPUToGPU, false));
         }
+
+        // instance 数组固定放在 instance buffer 开头，剩余空间给材质常量等持久化数据
+        m_pSceneInstanceBuffer.reset(pRenderer->CreateRawBuffer(nullptr, INSTANCE_BUFFER_SIZE, "GPUScene::InstanceBuffer", RHI::ERHIMemoryType::GPUOnly, true));
+        m_pSceneInstanceBufferAllocator = eastl::make_unique<OffsetAllocator::Allocator>(INSTANCE_BUFFER_SIZE);
+        m_InstanceArrayAllocation = m_pSceneInstanceBufferAllocator->allocate(sizeof(FInstanceData) * MAX_INSTANCE_COUNT);
+        assert(m_InstanceArrayAllocation.offset == 0);
+
+        RHI::FRHIComputePipelineStateDesc psoDesc;
+        psoDesc.CS = pRenderer->GetShader("GPUSceneUpdate.hlsl", "CSMain", RHI::ERHIShaderType::CS);
+        m_pUpdatePSO = pRenderer->GetPipelineState(psoDesc, "GPUScene::UpdatePSO");
     }
 
     FGPUScene::~FGPUScene()
@@ -30,6 +44,7 @@ namespace Renderer
 
     OffsetAllocator::Allocation FGPUScene::AllocateStaticBuffer(uint32_t size)
     {
+        std::lock_guard<std::mutex> lock(m_AllocatorMutex);
         return m_pSceneStaticBufferAllocator->allocate(RoundUpPow2(size, ALLOCATION_ALIGNMENT));
     }
     
@@ -39,11 +54,13 @@ namespace Renderer
         {
             return;
         }
+        std::lock_guard<std::mutex> lock(m_AllocatorMutex);
         m_pSceneStaticBufferAllocator->free(allocation);
     }
 
     OffsetAllocator::Allocation FGPUScene::AllocateAnimationBuffer(uint32_t size)
     {
+        std::lock_guard<std::mutex> lock(m_AllocatorMutex);
         return m_pSceneAnimationBufferAllocator->allocate(RoundUpPow2(size, ALLOCATION_ALIGNMENT));
     }
 
@@ -53,28 +70,164 @@ namespace Renderer
         {
             return;
         }
+        std::lock_guard<std::mutex> lock(m_AllocatorMutex);
         m_pSceneAnimationBufferAllocator->free(allocation);
     }
 
-    uint32_t FGPUScene::AllocateConstantBuffer(uint32_t size)
+    uint32_t FGPUScene::AllocateConstantBuffer(FFramePacket& packet, const void* data, uint32_t size)
     {
-        assert(m_ConstantBufferOffset + size <= MAX_CONSTANT_BUFFER_SIZE);
-        uint32_t address = m_ConstantBufferOffset;
-        m_ConstantBufferOffset += RoundUpPow2(size, ALLOCATION_ALIGNMENT);
+        static_assert(ALLOCATION_ALIGNMENT == sizeof(uint32_t));
+        std::lock_guard<std::mutex> lock(m_ConstantBufferMutex);
+        uint32_t address = sizeof(uint32_t) * (uint32_t)packet.SceneConstantData.size();
+        assert(address + size <= MAX_CONSTANT_BUFFER_SIZE);
+
+        packet.SceneConstantData.resize(packet.SceneConstantData.size() + DivideRoundingUp(size, sizeof(uint32_t)), 0);
+        if (data)
+        {
+            memcpy((char*)packet.SceneConstantData.data() + address, data, size);
+        }
         return address;
     }
 
-    uint32_t FGPUScene::AddInstance(const FInstanceData &instanceData)
+    uint32_t FGPUScene::AllocateInstance()
+    {
+        std::lock_guard<std::mutex> lock(m_AllocatorMutex);
+        if (!m_FreeInstanceSlots.empty())
+        {
+            uint32_t instanceIndex = m_FreeInstanceSlots.back();
+            m_FreeInstanceSlots.pop_back();
+            return instanceIndex;
+        }
+
+        assert(m_InstanceSlotCount < MAX_INSTANCE_COUNT);
+        return m_InstanceSlotCount++;
+    }
+
+    void FGPUScene::FreeInstance(uint32_t instanceIndex)
+    {
+        std::lock_guard<std::mutex> lock(m_AllocatorMutex);
+        if (instanceIndex >= m_InstanceSlotCount)
+        {
+            return;
+        }
+        m_FreeInstanceSlots.push_back(instanceIndex);
+    }
+
+    void FGPUScene::UpdateInstance(uint32_t instanceIndex, const FInstanceData &instanceData)
+    {
+        assert(instanceIndex < m_InstanceSlotCount);
+        AddUpdate(m_InstanceArrayAllocation.offset + sizeof(FInstanceData) * instanceIndex, &instanceData, sizeof(FInstanceData));
+    }
+
+    OffsetAllocator::Allocation FGPUScene::AllocateInstanceBuffer(uint32_t size)
+    {
+        std::lock_guard<std::mutex> lock(m_AllocatorMutex);
+        return m_pSceneInstanceBufferAllocator->allocate(RoundUpPow2(size, ALLOCATION_ALIGNMENT));
+    }
+
+    void FGPUScene::FreeInstanceBuffer(OffsetAllocator::Allocation allocation)
+    {
+        if (allocation.offset >= m_pSceneInstanceBuffer->GetBuffer()->GetDesc().Size)
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(m_AllocatorMutex);
+        m_pSceneInstanceBufferAllocator->free(allocation);
+    }
+
+    void FGPUScene::UpdateInstanceBuffer(uint32_t address, const void *data, uint32_t size)
+    {
+        assert(address >= m_InstanceArrayAllocation.size);
+        AddUpdate(address, data, size);
+    }
+
+    void FGPUScene::AddUpdate(uint32_t dstAddress, const void *data, uint32_t size)
+    {
+        assert(dstAddress % sizeof(uint32_t) == 0);
+        assert(dstAddress + size <= m_pSceneInstanceBuffer->GetBuffer()->GetDesc().Size);
+
+        FThreadSubmission& submission = m_pRenderer->GetThreadSubmission();
+
+        FGPUSceneUpdate update;
+        update.DstAddress = dstAddress;
+        update.SrcOffset = (uint32_t)submission.SceneUpdateData.size();
+        update.DwordCount = DivideRoundingUp(size, sizeof(uint32_t));
+        update._Padding = 0;
+        submission.SceneUpdates.push_back(update);
+
+        submission.SceneUpdateData.resize(submission.SceneUpdateData.size() + update.DwordCount, 0);
+        memcpy(submission.SceneUpdateData.data() + update.SrcOffset, data, size);
+    }
+
+    void FGPUScene::Update(FFramePacket& packet)
     {
-        m_InstanceData.push_back(instanceData);
-        uint32_t instanceID = (uint32_t)m_InstanceData.size() - 1;
-        return instanceID;
+        uint32_t frameIdx = m_pRenderer->GetFrameID() % RHI::RHI_MAX_INFLIGHT_FRAMES;
+
+        if (!packet.SceneConstantData.empty())
+        {
+            memcpy(m_pSceneConstantBuffers[frameIdx]->GetBuffer()->GetCPUAddress(), packet.SceneConstantData.data(), sizeof(uint32_t) * packet.SceneConstantData.size());
+        }
+
+        m_UpdateCommandCount = (uint32_t)packet.SceneUpdates.size();
+        if (m_UpdateCommandCount == 0)
+        {
+            return;
+        }
+
+        // upload buffer 布局：[FGPUSceneUpdate * count][dword 数据]，SrcOffset 改写为相对 buffer 起始的字节地址
+        const uint32_t commandSize = sizeof(FGPUSceneUpdate) * m_UpdateCommandCount;
+        const uint32_t dataSize = sizeof(uint32_t) * (uint32_t)packet.SceneUpdateData.size();
+        const uint32_t requiredSize = commandSize + dataSize;
+
+        eastl::unique_ptr<RenderResources::FRawBuffer>& pUpdateBuffer = m_pUpdateBuffers[frameIdx];
+        if (pUpdateBuffer == nullptr || pUpdateBuffer->GetBuffer()->GetDesc().Size < requiredSize)
+        {
+            uint32_t size = eastl::max((uint32_t)MIN_UPDATE_BUFFER_SIZE, RoundUpPow2(requiredSize, 1024 * 64));
+            pUpdateBuffer.reset(m_pRenderer->CreateRawBuffer(nullptr, size, "GPUScene::UpdateBuffer", RHI::ERHIMemoryType::CPUToGPU, false));
+        }
+
+        char* pDst = (char*)pUpdateBuffer->GetBuffer()->GetCPUAddress();
+        for (uint32_t i = 0; i < m_UpdateCommandCount; i++)
+        {
+            packet.SceneUpdates[i].SrcOffset = commandSize + sizeof(uint32_t) * packet.SceneUpdates[i].SrcOffset;
+        }
+        memcpy(pDst, packet.SceneUpdates.data(), commandSize);
+        memcpy(pDst + commandSize, packet.SceneUpdateData.data(), dataSize);
     }
 
-    void FGPUScene::Update()
+    void FGPUScene::FlushUpdates(RHI::FRHICommandList *pCmdList)
     {
-        uint32_t instanceCount = (uint32_t)m_InstanceData.size();
-        m_InstanceDataAddress = m_pRenderer->AllocateSceneConstantBuffer(m_InstanceData.data(), sizeof(FInstanceData) * instanceCount);
+        if (m_UpdateCommandCount == 0)
+        {
+            return;
+        }
+
+        GPU_EVENT_DEBUG(pCmdList, "GPUScene::FlushUpdates");
+
+        uint32_t frameIdx = m_pRenderer->GetFrameID() % RHI::RHI_MAX_INFLIGHT_FRAMES;
+        RenderResources::FRawBuffer* pUpdateBuffer = m_pUpdateBuffers[frameIdx].get();
+
+        pCmdList->BufferBarrier(m_pSceneInstanceBuffer->GetBuffer(), RHI::RHIAccessMaskSRV, RHI::RHIAccessComputeUAV);
+        pCmdList->SetPipelineState(m_pUpdatePSO);
+
+        // 每个线程组处理一条更新记录
+        for (uint32_t first = 0; first < m_UpdateCommandCount; first += MAX_UPDATE_DISPATCH_GROUPS)
+        {
+            uint32_t groupCount = eastl::min(m_UpdateCommandCount - first, (uint32_t)MAX_UPDATE_DISPATCH_GROUPS);
+            uint32_t rootConsts[4] =
+            {
+                pUpdateBuffer->GetSRV()->GetHeapIndex(),
+                m_pSceneInstanceBuffer->GetUAV()->GetHeapIndex(),
+                first,
+                m_UpdateCommandCount,
+            };
+            pCmdList->SetComputeConstants(0, rootConsts, sizeof(rootConsts));
+            pCmdList->Dispatch(groupCount, 1, 1);
+        }
+
+        pCmdList->BufferBarrier(m_pSceneInstanceBuffer->GetBuffer(), RHI::RHIAccessComputeUAV, RHI::RHIAccessMaskSRV);
+
+        m_UpdateCommandCount = 0;
     }
 
     void FGPUScene::BeginAnimationUpdate(RHI::FRHICommandList *pCmdList)
@@ -87,12 +240,6 @@ namespace Renderer
         pCmdList->BufferBarrier(m_pSceneAnimationBuffer->GetBuffer(), RHI::RHIAccessComputeUAV, RHI::RHIAccessVertexShaderSRV);
     }
 
-    void FGPUScene::ResetFrameData()
-    {
-        m_InstanceData.clear();
-        m_ConstantBufferOffset = 0;
-    }
-
     RHI::FRHIBuffer *FGPUScene::GetSceneConstantBuffer() const
     {
         uint32_t frameIdx = m_pRenderer->GetFrameID() % RHI::RHI_MAX_INFLIGHT_FRAMES;
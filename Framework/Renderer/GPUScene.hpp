@@ -1,10 +1,14 @@
 #pragma once
 
 #include "Renderer/RenderResources/RawBuffer.hpp"
+#include "Renderer/FramePacket.hpp"
 #include "Utilities/Math.hpp"
 #include <OffsetAllocator/OffsetAllocator.hpp>
 #include "Common/GPUScene.hlsli"
 
+#include <mutex>
+#include <atomic>
+
 namespace Renderer
 {
     class FRendererBase;
@@ -21,13 +25,24 @@ namespace Renderer
         OffsetAllocator::Allocation AllocateAnimationBuffer(uint32_t size);
         void FreeAnimationBuffer(OffsetAllocator::Allocation allocation);
 
-        uint32_t AllocateConstantBuffer(uint32_t size);
+        // 写入 packet 的 CPU 副本，返回在 scene constant buffer 中的地址
+        // 下面的分配和更新接口都可以在 world tick 的 worker 线程上调用
+        uint32_t AllocateConstantBuffer(FFramePacket& packet, const void* data, uint32_t size);
+
+        // 持久化 instance slot：组件创建时分配一次，只在数据变化时 UpdateInstance
+        uint32_t AllocateInstance();
+        void FreeInstance(uint32_t instanceIndex);
+        void UpdateInstance(uint32_t instanceIndex, const FInstanceData& instanceData);
+        uint32_t GetInstanceCount() const { return m_InstanceSlotCount; }
 
-        uint32_t AddInstance(const FInstanceData& instanceData);
-        uint32_t GetInstanceCount() const { return (uint32_t)m_InstanceData.size(); }
+        // instance buffer 中除 instance 数组以外的持久化数据（材质常量等）
+        OffsetAllocator::Allocation AllocateInstanceBuffer(uint32_t size);
+        void FreeInstanceBuffer(OffsetAllocator::Allocation allocation);
+        void UpdateInstanceBuffer(uint32_t address, const void* data, uint32_t size);
 
-        void Update();
-        void ResetFrameData();
+        // 在本帧 slot 的 fence 等待之后调用，把 packet 中的增量更新和常量拷贝到 GPU 可见的 buffer
+        void Update(FFramePacket& packet);
+        void FlushUpdates(RHI::FRHICommandList* pCmdList);
 
         void BeginAnimationUpdate(RHI::FRHICommandList* pCmdList);
         void EndAnimationUpdate(RHI::FRHICommandList* pCmdList);
@@ -42,13 +57,30 @@ namespace Renderer
         RHI::FRHIBuffer* GetSceneConstantBuffer() const;
         RHI::FRHIDescriptor* GetSceneConstantBufferSRV() const;
 
-        uint32_t GetInstanceDataAddress() const { return m_InstanceDataAddress; }
+        RHI::FRHIBuffer* GetSceneInstanceBuffer() const { return m_pSceneInstanceBuffer->GetBuffer(); }
+        RHI::FRHIDescriptor* GetSceneInstanceBufferSRV() const { return m_pSceneInstanceBuffer->GetSRV(); }
+
+    private:
+        void AddUpdate(uint32_t dstAddress, const void* data, uint32_t size);
 
     private:
         FRendererBase* m_pRenderer = nullptr;
 
-        eastl::vector<FInstanceData> m_InstanceData;
-        uint32_t m_InstanceDataAddress = 0;
+        // 保护各个 OffsetAllocator 和 instance slot 的分配
+        std::mutex m_AllocatorMutex;
+        std::mutex m_ConstantBufferMutex;
+
+        eastl::unique_ptr<RenderResources::FRawBuffer> m_pSceneInstanceBuffer;
+        eastl::unique_ptr<OffsetAllocator::Allocator> m_pSceneInstanceBufferAllocator;
+        OffsetAllocator::Allocation m_InstanceArrayAllocation;
+
+        eastl::vector<uint32_t> m_FreeInstanceSlots;
+        // 只在持锁时增长，UpdateInstance/GetInstanceCount 不持锁读取
+        std::atomic<uint32_t> m_InstanceSlotCount = 0;
+
+        eastl::unique_ptr<RenderResources::FRawBuffer> m_pUpdateBuffers[RHI::RHI_MAX_INFLIGHT_FRAMES];
+        uint32_t m_UpdateCommandCount = 0;
+        RHI::FRHIPipelineState* m_pUpdatePSO = nullptr;
 
         eastl::unique_ptr<RenderResources::FRawBuffer> m_pSceneStaticBuffer;
         eastl::unique_ptr<OffsetAllocator::Allocator> m_pSceneStaticBufferAllocator;
@@ -57,6 +89,5 @@ namespace Renderer
         eastl::unique_ptr<OffsetAllocator::Allocator> m_pSceneAnimationBufferAllocator;
 
         eastl::unique_ptr<RenderResources::FRawBuffer> m_pSceneConstantBuffers[RHI::RHI_MAX_INFLIGHT_FRAMES];
-        uint32_t m_ConstantBufferOffset = 0;
     };
 }
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "GenerateMips.hpp"
+#include "RendererBase.hpp"
+#include "Core/VultanaEngine.hpp"
+
+namespace Renderer
+{
+    static inline eastl::string GetTypeDefine(RHI::ERHIFormat format)
+    {
+        switch (format)
+        {
+        case RHI::ERHIFormat::R32F:
+        case RHI::ERHIFormat::R16F:
+        case RHI::ERHIFormat::R16UNORM:
+        case RHI::ERHIFormat::R8UNORM:
+            return "MIP_TYPE_FLOAT";
+        case RHI::ERHIFormat::RG32F:
+        case RHI::ERHIFormat::RG16F:
+        case RHI::ERHIFormat::RG16UNORM:
+        case RHI::ERHIFormat::RG8UNORM:
+            return "MIP_TYPE_FLOAT2";
+        case RHI::ERHIFormat::RGBA32F:
+        case RHI::ERHIFormat::RGBA16F:
+        case RHI::ERHIFormat::RGBA16UNORM:
+        case RHI::ERHIFormat::RGBA8UNORM:
+            return "MIP_TYPE_FLOAT4";
+        default:
+            assert(false);
+            return "";
+        }
+    }
+
+    void GenerateMips(RHI::FRHICommandList *pCmdList, RenderResources::FTexture2D *texture, bool normalMap)
+    {
+        const RHI::FRHITextureDesc& desc = texture->GetTexture()->GetDesc();
+        assert(desc.Usage & RHI::RHITextureUsageUnorderedAccess);
+        if (desc.MipLevels <= 1)
+        {
+            return;
+        }
+
+        auto pRenderer = Core::FVultanaEngine::GetEngineInstance()->GetRenderer();
+
+        eastl::vector<eastl::string> defines;
+        defines.push_back(GetTypeDefine(desc.Format));
+        if (normalMap)
+        {
+            defines.push_back("NORMAL_MAP=1");
+        }
+
+        RHI::FRHIComputePipelineStateDesc psoDesc;
+        psoDesc.CS = pRenderer->GetShader("GenerateMips.hlsl", "CSMain", RHI::ERHIShaderType::CS, defines);
+
+        eastl::vector<RHI::FRHIDescriptor*> mipUAVs(desc.MipLevels);
+        for (uint32_t mip = 0; mip < desc.MipLevels; mip++)
+        {
+            mipUAVs[mip] = texture->GetUAV(mip);
+        }
+
+        GenerateMips(pCmdList, pRenderer->GetPipelineState(psoDesc, "GenerateMipsPSO"), texture->GetTexture(), mipUAVs.data());
+    }
+
+    void GenerateMips(RHI::FRHICommandList *pCmdList, RHI::FRHIPipelineState *pso, RHI::FRHITexture *texture, RHI::FRHIDescriptor *const *mipUAVs)
+    {
+        const RHI::FRHITextureDesc& desc = texture->GetDesc();
+        if (desc.MipLevels <= 1)
+        {
+            return;
+        }
+
+        GPU_EVENT_DEBUG(pCmdList, "GenerateMips");
+
+        pCmdList->SetPipelineState(pso);
+
+        for (uint32_t mip = 1; mip < desc.MipLevels; mip++)
+        {
+            uint32_t srcWidth = eastl::max(desc.Width >> (mip - 1), 1u);
+            uint32_t srcHeight = eastl::max(desc.Height >> (mip - 1), 1u);
+            uint32_t dstWidth = eastl::max(desc.Width >> mip, 1u);
+            uint32_t dstHeight = eastl::max(desc.Height >> mip, 1u);
+
+            uint32_t constants[6] = { mipUAVs[mip - 1]->GetHeapIndex(), mipUAVs[mip]->GetHeapIndex(), srcWidth, srcHeight, dstWidth, dstHeight };
+            pCmdList->SetComputeConstants(0, constants, sizeof(constants));
+            pCmdList->Dispatch(DivideRoundingUp(dstWidth, 8), DivideRoundingUp(dstHeight, 8), 1);
+
+            // 下一级读取本级的结果
+            pCmdList->TextureBarrier(texture, CalcSubresource(desc, mip, 0), RHI::RHIAccessComputeUAV, RHI::RHIAccessComputeUAV);
+        }
+    }
+}
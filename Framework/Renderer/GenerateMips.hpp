@@ -0,0 +1,13 @@
+#pragma once
+
+#include "RenderResources/Texture2D.hpp"
+
+namespace Renderer
+{
+    // 运行时创建的纹理在 GPU 上逐级生成 mip，纹理需带 RHITextureUsageUnorderedAccess 且不能是 sRGB 格式
+    // 调用前后所有 mip 都处于 RHIAccessComputeUAV 状态
+    void GenerateMips(RHI::FRHICommandList* pCmdList, RenderResources::FTexture2D* texture, bool normalMap = false);
+
+    // 只录制逐级的 dispatch，pso 按纹理格式由调用方准备，mipUAVs 依次是每一级 mip 的 UAV
+    void GenerateMips(RHI::FRHICommandList* pCmdList, RHI::FRHIPipelineState* pso, RHI::FRHITexture* texture, RHI::FRHIDescriptor* const* mipUAVs);
+}
@@ -52,6 +52,7 @@ namespace Renderer
 
     RHI::FRHIPipelineState *FPipelineStateCache::GetPipelineState(const RHI::FRHIGraphicsPipelineStateDesc &desc, const eastl::string &name)
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         auto iter = m_CachedGraphicsPSO.find(desc);
         if (iter != m_CachedGraphicsPSO.end())
         {
@@ -68,6 +69,7 @@ namespace Renderer
 
     RHI::FRHIPipelineState* FPipelineStateCache::GetPipelineState(const RHI::FRHIMeshShadingPipelineStateDesc& desc, const eastl::string& name)
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         auto iter = m_CachedMeshletPSO.find(desc);
         if (iter != m_CachedMeshletPSO.end())
         {
@@ -84,6 +86,7 @@ namespace Renderer
 
     RHI::FRHIPipelineState *FPipelineStateCache::GetPipelineState(const RHI::FRHIComputePipelineStateDesc &desc, const eastl::string &name)
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         auto iter = m_CachedComputePSO.find(desc);
         if (iter != m_CachedComputePSO.end())
         {
@@ -101,6 +104,7 @@ namespace Renderer
 
     void FPipelineStateCache::RecreatePSO(RHI::FRHIShader *shader)
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         for (auto iter = m_CachedGraphicsPSO.begin(); iter != m_CachedGraphicsPSO.end(); iter++)
         {
             const RHI::FRHIGraphicsPipelineStateDesc& desc = iter->first;
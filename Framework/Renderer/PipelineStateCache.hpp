@@ -6,16 +6,7 @@
 
 #include <EASTL/hash_map.h>
 #include <EASTL/unique_ptr.h>
-
-inline uint64_t HashCombine64(uint64_t hash0, uint64_t hash1)
-{
-    const uint64_t kMul = 0x9ddfea08eb382d69ULL;
-    uint64_t a = (hash1 ^ hash0) * kMul;
-    a ^= (a >> 47);
-    uint64_t b = (hash0 ^ a) * kMul;
-    b ^= (b >> 47);
-    return b * kMul;
-}
+#include <mutex>
 
 namespace eastl
 {
@@ -82,6 +73,8 @@ namespace Renderer
     
     private:
         FRendererBase* m_pRenderer = nullptr;
+        // pass 并行录制时会在 worker 线程上查找/创建 PSO
+        std::mutex m_Mutex;
         eastl::hash_map<RHI::FRHIGraphicsPipelineStateDesc, eastl::unique_ptr<RHI::FRHIPipelineState>> m_CachedGraphicsPSO;
         eastl::hash_map<RHI::FRHIMeshShadingPipelineStateDesc, eastl::unique_ptr<RHI::FRHIPipelineState>> m_CachedMeshletPSO;
         eastl::hash_map<RHI::FRHIComputePipelineStateDesc, eastl::unique_ptr<RHI::FRHIPipelineState>> m_CachedComputePSO;
@@ -122,6 +122,26 @@ namespace Renderer
         }
     }
 
+    // IndexCount 由 GPU 写入的 FRHIDrawIndexedCommand 提供，InstanceCount 为 0 时即被剔除
+    inline void DrawBatchIndirect(RHI::FRHICommandList* pCmdList, const FRenderBatch& batch, RHI::FRHIBuffer* pArgsBuffer, uint32_t argsOffset)
+    {
+        GPU_EVENT_DEBUG(pCmdList, batch.Label);
+
+        pCmdList->SetPipelineState(batch.PSO);
+
+        for (int i = 0; i < MAX_RENDER_BATCH_CB_COUNT; i++)
+        {
+            if (batch.Cb[i].Data != nullptr)
+            {
+                pCmdList->SetGraphicsConstants(i, batch.Cb[i].Data, batch.Cb[i].DataSize);
+            }
+        }
+
+        assert(batch.IndexBuffer != nullptr);
+        pCmdList->SetIndexBuffer(batch.IndexBuffer, batch.IndexOffset, batch.IndexFormat);
+        pCmdList->DrawIndexedIndirect(pArgsBuffer, argsOffset);
+    }
+
     struct FComputeBatch
     {
         FComputeBatch(FLinearAllocator& cbAllocator) : m_CBAllocator(cbAllocator)
@@ -51,7 +51,7 @@ namespace Renderer
 
     void FRendererBase::ObjectIDPass(RG::FRGHandle &depth)
     {
-        if (!m_bEnableObjectIDRendering) return;
+        if (!GetRenderFramePacket().bObjectIDRendering) return;
         
         struct FIDPassData
         {
@@ -68,15 +68,15 @@ namespace Renderer
             desc.Format = RHI::ERHIFormat::R32UI;
             
             data.IDTexture = builder.Create<RG::FRGTexture>(desc, "ObjectIDTexture");
-            data.IDTexture = builder.WriteColor(0, data.IDTexture, 0, RHI::ERHIRenderPassLoadOp::Clear, float4(1000000, 0, 0, 0));
+            data.IDTexture = builder.WriteColor(0, data.IDTexture, 0, RHI::ERHIRenderPassLoadOp::Clear, float4((float)OBJECT_ID_CLEAR_VALUE, 0, 0, 0));
             data.SceneDepthTexture = builder.ReadDepth(depth, 0);
         },
         [&](const FIDPassData& data, RHI::FRHICommandList* pCmdList)
         {
-            Scene::FWorld* pWorld = Core::FVultanaEngine::GetEngineInstance()->GetWorld();
-            for (size_t i = 0; i < m_IDPassBatches.size(); i++)
+            const eastl::vector<FRenderBatch>& batches = GetRenderFramePacket().IDPassBatches;
+            for (size_t i = 0; i < batches.size(); i++)
             {
-                DrawBatch(pCmdList, m_IDPassBatches[i]);
+                DrawBatch(pCmdList, batches[i]);
             }
         });
 
@@ -95,18 +95,40 @@ namespace Renderer
         },
         [&](const FCopyIDPassData& data, RHI::FRHICommandList* pCmdList)
         {
-            RG::FRGTexture* srcTexture = m_pRenderGraph->GetTexture(data.SrcTexture);
+            RHI::FRHITexture* srcTexture = m_pRenderGraph->GetTexture(data.SrcTexture)->GetTexture();
+            const RHI::FRHITextureDesc& srcDesc = srcTexture->GetDesc();
 
-            m_ObjectIDRowPitch = srcTexture->GetTexture()->GetRowPitch();
-            uint32_t size = m_ObjectIDRowPitch * srcTexture->GetTexture()->GetDesc().Height;
-            if (m_pObjectIDBuffer == nullptr || m_pObjectIDBuffer->GetDesc().Size < size)
+            uint32_t frameIndex = m_pDevice->GetFrameID() % RHI::RHI_MAX_INFLIGHT_FRAMES;
+            FObjectIDReadback& readback = m_ObjectIDReadbacks[frameIndex];
+            assert(readback.Requests.empty());
+
+            const uint32_t regionBytes = OBJECT_ID_PICK_REGION_SIZE * OBJECT_ID_PICK_REGION_SIZE * sizeof(uint32_t);
+            if (readback.Buffer == nullptr)
             {
                 RHI::FRHIBufferDesc desc;
-                desc.Size = size;
+                desc.Size = regionBytes * MAX_MOUSE_HIT_TESTS_PER_FRAME;
                 desc.MemoryType = RHI::ERHIMemoryType::GPUToCPU;
-                m_pObjectIDBuffer.reset(m_pDevice->CreateBuffer(desc, "RendererBase::ObjectIDBuffer"));
+                readback.Buffer.reset(m_pDevice->CreateBuffer(desc, "RendererBase::ObjectIDReadbackBuffer"));
+            }
+
+            // 只拷贝光标周围的小块区域，结果在该帧 fence 完成后再读取，不阻塞 CPU
+            uint32_t count = eastl::min((uint32_t)m_PendingMouseHitTests.size(), MAX_MOUSE_HIT_TESTS_PER_FRAME);
+            for (uint32_t i = 0; i < count; i++)
+            {
+                FMouseHitTestRequest request = m_PendingMouseHitTests[i];
+                request.X = eastl::min(request.X, srcDesc.Width - 1);
+                request.Y = eastl::min(request.Y, srcDesc.Height - 1);
+                request.RegionWidth = eastl::min(OBJECT_ID_PICK_REGION_SIZE, srcDesc.Width);
+                request.RegionHeight = eastl::min(OBJECT_ID_PICK_REGION_SIZE, srcDesc.Height);
+                request.RegionX = eastl::min((uint32_t)eastl::max((int32_t)request.X - (int32_t)OBJECT_ID_PICK_REGION_SIZE / 2, 0), srcDesc.Width - request.RegionWidth);
+                request.RegionY = eastl::min((uint32_t)eastl::max((int32_t)request.Y - (int32_t)OBJECT_ID_PICK_REGION_SIZE / 2, 0), srcDesc.Height - request.RegionHeight);
+
+                pCmdList->CopyTextureRegionToBuffer(srcTexture, readback.Buffer.get(), 0, 0, regionBytes * i,
+                    request.RegionX, request.RegionY, request.RegionWidth, request.RegionHeight);
+
+                readback.Requests.push_back(request);
             }
-            pCmdList->CopyTextureToBuffer(srcTexture->GetTexture(), m_pObjectIDBuffer.get(), 0, 0, 0);
+            m_PendingMouseHitTests.erase(m_PendingMouseHitTests.begin(), m_PendingMouseHitTests.begin() + count);
         });
     }
 
@@ -126,9 +148,10 @@ namespace Renderer
         },
         [&](const FOutlinePassData& data, RHI::FRHICommandList* pCmdList)
         {
-            for (size_t i = 0; i < m_OutlinePassBatches.size(); i++)
+            const eastl::vector<FRenderBatch>& batches = GetRenderFramePacket().OutlinePassBatches;
+            for (size_t i = 0; i < batches.size(); i++)
             {
-                DrawBatch(pCmdList, m_OutlinePassBatches[i]);
+                DrawBatch(pCmdList, batches[i]);
             }
         });
 
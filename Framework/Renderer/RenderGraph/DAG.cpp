@@ -41,9 +41,10 @@ namespace RG
 
     FDAGEdge* FDirectedAcyclicGraph::GetEdge(DAGNodeID from, DAGNodeID to) const
     {
-        for (size_t i = 0; i < m_Edges.size(); ++i)
+        FDAGEdgeRange edges = GetOutgoingEdges(m_Nodes[from]);
+        for (FDAGEdge* edge : edges)
         {
-            if (m_Edges[i]->m_FromNode == from && m_Edges[i]->m_ToNode == to) { return m_Edges[i]; }
+            if (edge->m_ToNode == to) { return edge; }
         }
         return nullptr;
     }
@@ -52,59 +53,83 @@ namespace RG
     {
         assert(node->GetID() == m_Nodes.size());
         m_Nodes.push_back(node);
+        m_bAdjacencyDirty = true;
     }
 
     void FDirectedAcyclicGraph::RegisterEdge(FDAGEdge * edge)
     {
         m_Edges.push_back(edge);
+        m_bAdjacencyDirty = true;
     }
 
     void FDirectedAcyclicGraph::Clear()
     {
         m_Edges.clear();
         m_Nodes.clear();
+
+        m_IncomingOffsets.clear();
+        m_OutgoingOffsets.clear();
+        m_IncomingEdges.clear();
+        m_OutgoingEdges.clear();
+        m_bAdjacencyDirty = true;
     }
 
     void FDirectedAcyclicGraph::Cull()
     {
-        // 遍历图中的边，更新节点的引用计数
-        for (size_t i = 0; i < m_Edges.size(); ++i)
+        BuildAdjacency();
+
+        // 节点的引用计数即出边数量
+        for (size_t i = 0; i < m_Nodes.size(); ++i)
         {
-            FDAGEdge* edge = m_Edges[i];
-            FDAGNode* node = m_Nodes[edge->m_FromNode];
-            node->m_RefCount++;
+            m_Nodes[i]->m_RefCount += m_OutgoingOffsets[i + 1] - m_OutgoingOffsets[i];
         }
 
         // 遍历图中的节点，如果引用计数为0，入栈准备删除
-        eastl::vector<FDAGNode*> nodesStack;
+        m_CullStack.clear();
         for (size_t i = 0; i < m_Nodes.size(); ++i)
         {
             if (m_Nodes[i]->GetRefCount() == 0)
             {
-                nodesStack.push_back(m_Nodes[i]);
+                m_CullStack.push_back(m_Nodes[i]);
             }
         }
 
-        while (!nodesStack.empty())
+        while (!m_CullStack.empty())
         {
-            FDAGNode* node = nodesStack.back();
-            nodesStack.pop_back();
+            FDAGNode* node = m_CullStack.back();
+            m_CullStack.pop_back();
 
-            eastl::vector<FDAGEdge*> incomingEdges;
-            // 获取当前node的所有入边
-            GetIncomingEdges(node, incomingEdges);
-
-            for (size_t i = 0; i < incomingEdges.size(); ++i)
+            // 当前node的所有入边
+            FDAGEdgeRange incomingEdges = GetIncomingEdges(node);
+            for (FDAGEdge* edge : incomingEdges)
             {
-                FDAGNode* linkedNode = GetNode(incomingEdges[i]->m_FromNode);
+                FDAGNode* linkedNode = GetNode(edge->m_FromNode);
                 if (--linkedNode->m_RefCount == 0)
                 {
-                    nodesStack.push_back(linkedNode);
+                    m_CullStack.push_back(linkedNode);
                 }
             }
         }
     }
 
+    void FDirectedAcyclicGraph::GetRefCounts(eastl::vector<uint32_t>& refCounts) const
+    {
+        refCounts.resize(m_Nodes.size());
+        for (size_t i = 0; i < m_Nodes.size(); ++i)
+        {
+            refCounts[i] = m_Nodes[i]->m_RefCount;
+        }
+    }
+
+    void FDirectedAcyclicGraph::SetRefCounts(const eastl::vector<uint32_t>& refCounts)
+    {
+        assert(refCounts.size() == m_Nodes.size());
+        for (size_t i = 0; i < m_Nodes.size(); ++i)
+        {
+            m_Nodes[i]->m_RefCount = refCounts[i];
+        }
+    }
+
     bool FDirectedAcyclicGraph::IsEdgeValid(const FDAGEdge *edge) const
     {
         return !GetNode(edge->m_FromNode)->IsCulled() && !GetNode(edge->m_ToNode)->IsCulled();
@@ -112,28 +137,84 @@ namespace RG
 
     void FDirectedAcyclicGraph::GetIncomingEdges(const FDAGNode *node, eastl::vector<FDAGEdge *> &edges) const
     {
-        edges.clear();
-
-        for (size_t i = 0; i < m_Edges.size(); ++i)
-        {
-            if (m_Edges[i]->m_ToNode == node->GetID())
-            {
-                edges.push_back(m_Edges[i]);
-            }
-        }
+        FDAGEdgeRange range = GetIncomingEdges(node);
+        edges.assign(range.begin(), range.end());
     }
 
     void FDirectedAcyclicGraph::GetOutgoingEdges(const FDAGNode *node, eastl::vector<FDAGEdge *> &edges) const
     {
-        edges.clear();
+        FDAGEdgeRange range = GetOutgoingEdges(node);
+        edges.assign(range.begin(), range.end());
+    }
+
+    FDAGEdgeRange FDirectedAcyclicGraph::GetIncomingEdges(const FDAGNode *node) const
+    {
+        BuildAdjacency();
+
+        DAGNodeID id = node->GetID();
+        assert(id < m_Nodes.size());
 
-        for (size_t i = 0; i < m_Edges.size(); ++i)
+        FDAGEdge* const* data = m_IncomingEdges.data();
+        return { data + m_IncomingOffsets[id], data + m_IncomingOffsets[id + 1] };
+    }
+
+    FDAGEdgeRange FDirectedAcyclicGraph::GetOutgoingEdges(const FDAGNode *node) const
+    {
+        BuildAdjacency();
+
+        DAGNodeID id = node->GetID();
+        assert(id < m_Nodes.size());
+
+        FDAGEdge* const* data = m_OutgoingEdges.data();
+        return { data + m_OutgoingOffsets[id], data + m_OutgoingOffsets[id + 1] };
+    }
+
+    void FDirectedAcyclicGraph::BuildAdjacency() const
+    {
+        if (!m_bAdjacencyDirty)
         {
-            if (m_Edges[i]->m_FromNode == node->GetID())
-            {
-                edges.push_back(m_Edges[i]);
-            }
+            return;
+        }
+
+        const size_t nodeCount = m_Nodes.size();
+        const size_t edgeCount = m_Edges.size();
+
+        // 计数排序：先统计每个节点的入度/出度，前缀和得到偏移，再按注册顺序回填，保证邻接边顺序与注册顺序一致
+        m_IncomingOffsets.assign(nodeCount + 1, 0);
+        m_OutgoingOffsets.assign(nodeCount + 1, 0);
+
+        for (size_t i = 0; i < edgeCount; ++i)
+        {
+            m_IncomingOffsets[m_Edges[i]->m_ToNode + 1]++;
+            m_OutgoingOffsets[m_Edges[i]->m_FromNode + 1]++;
+        }
+
+        for (size_t i = 0; i < nodeCount; ++i)
+        {
+            m_IncomingOffsets[i + 1] += m_IncomingOffsets[i];
+            m_OutgoingOffsets[i + 1] += m_OutgoingOffsets[i];
         }
+
+        m_IncomingEdges.resize(edgeCount);
+        m_OutgoingEdges.resize(edgeCount);
+
+        // 借用 offsets 作为写游标，回填后再右移一位还原
+        for (size_t i = 0; i < edgeCount; ++i)
+        {
+            FDAGEdge* edge = m_Edges[i];
+            m_IncomingEdges[m_IncomingOffsets[edge->m_ToNode]++] = edge;
+            m_OutgoingEdges[m_OutgoingOffsets[edge->m_FromNode]++] = edge;
+        }
+
+        for (size_t i = nodeCount; i > 0; --i)
+        {
+            m_IncomingOffsets[i] = m_IncomingOffsets[i - 1];
+            m_OutgoingOffsets[i] = m_OutgoingOffsets[i - 1];
+        }
+        m_IncomingOffsets[0] = 0;
+        m_OutgoingOffsets[0] = 0;
+
+        m_bAdjacencyDirty = false;
     }
 
     eastl::string FDirectedAcyclicGraph::ExportGraphViz()
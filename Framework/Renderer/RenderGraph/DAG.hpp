@@ -55,6 +55,19 @@ namespace RG
         static const uint32_t TARGET = 0x80000000u;
     };
 
+    // 节点邻接边的只读视图，指向图内部的 CSR 数组，下一次 RegisterNode/RegisterEdge/Clear 之后失效
+    struct FDAGEdgeRange
+    {
+        FDAGEdge* const* First = nullptr;
+        FDAGEdge* const* Last = nullptr;
+
+        FDAGEdge* const* begin() const { return First; }
+        FDAGEdge* const* end() const { return Last; }
+        size_t size() const { return (size_t)(Last - First); }
+        bool empty() const { return First == Last; }
+        FDAGEdge* operator[](size_t index) const { return First[index]; }
+    };
+
     class FDirectedAcyclicGraph
     {
     public:
@@ -69,13 +82,36 @@ namespace RG
         void Cull();
         bool IsEdgeValid(const FDAGEdge* edge) const;
 
+        // Cull 的结果即每个节点的引用计数，结构相同的图可以直接恢复而不重新 Cull
+        void GetRefCounts(eastl::vector<uint32_t>& refCounts) const;
+        void SetRefCounts(const eastl::vector<uint32_t>& refCounts);
+
         void GetIncomingEdges(const FDAGNode* node, eastl::vector<FDAGEdge*>& edges) const;
         void GetOutgoingEdges(const FDAGNode* node, eastl::vector<FDAGEdge*>& edges) const;
 
+        FDAGEdgeRange GetIncomingEdges(const FDAGNode* node) const;
+        FDAGEdgeRange GetOutgoingEdges(const FDAGNode* node) const;
+
+        size_t GetNodeCount() const { return m_Nodes.size(); }
+        size_t GetEdgeCount() const { return m_Edges.size(); }
+
         eastl::string ExportGraphViz();
 
+    private:
+        void BuildAdjacency() const;
+
     private:
         eastl::vector<FDAGNode*> m_Nodes;
         eastl::vector<FDAGEdge*> m_Edges;
+
+        // CSR 邻接表：节点 i 的入边为 m_IncomingEdges[m_IncomingOffsets[i], m_IncomingOffsets[i + 1])，出边同理。
+        // 边注册后惰性重建，Clear 只清空不释放，稳定帧之后不再产生堆分配
+        mutable eastl::vector<uint32_t> m_IncomingOffsets;
+        mutable eastl::vector<uint32_t> m_OutgoingOffsets;
+        mutable eastl::vector<FDAGEdge*> m_IncomingEdges;
+        mutable eastl::vector<FDAGEdge*> m_OutgoingEdges;
+        mutable bool m_bAdjacencyDirty = true;
+
+        eastl::vector<FDAGNode*> m_CullStack;
     };
 }
\ No newline at end of file
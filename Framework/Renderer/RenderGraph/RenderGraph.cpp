@@ -1,12 +1,54 @@
 #include "RenderGraph.hpp"
 #include "Core/VultanaEngine.hpp"
+#include "Utilities/Log.hpp"
+
+#include <EASTL/algorithm.h>
+#include <EASTL/sort.h>
+#include <EASTL/hash_map.h>
+#include <enkiTS/TaskScheduler.h>
 
 namespace RG
 {
-    FRenderGraph::FRenderGraph::FRenderGraph(Renderer::FRendererBase *pRenderer)
-        : m_ResourceAllocator(pRenderer->GetDevice())
+    // 太短的段不值得单独开一个二级命令列表
+    static const uint32_t RG_MIN_PASSES_PER_CHUNK = 4;
+    // 在几种图结构之间来回切换（例如开关某个功能）时都能命中
+    static const uint32_t RG_MAX_COMPILED_GRAPHS = 4;
+    // 与异步段并行的图形 pass 太少时，省下的时间抵不上一对跨队列同步
+    static const uint32_t RG_ASYNC_COMPUTE_MIN_OVERLAP = 2;
+    // 前后两次访问之间至少隔这么多 pass 才拆分 barrier，相邻的 pass 拆开没有可重叠的工作
+    static const uint32_t RG_SPLIT_BARRIER_MIN_DISTANCE = 2;
+    // 计算队列无法处理这些状态的 barrier
+    static const RHI::ERHIAccessFlags RG_GRAPHICS_QUEUE_ACCESS = RHI::RHIAccessPresent | RHI::RHIAccessRTV | RHI::RHIAccessMaskDSV | RHI::RHIAccessShadingRate | RHI::RHIAccessIndexBuffer;
+
+    static uint64_t HashEdge(const FDAGNode* pass, const FDAGNode* resourceNode, RHI::ERHIAccessFlags usage, uint32_t subresource)
+    {
+        return HashCombine64(((uint64_t)pass->GetID() << 32) | resourceNode->GetID(), ((uint64_t)usage << 32) | subresource);
+    }
+
+    struct FRecordChunkTask : public enki::ITaskSet
+    {
+        const FRenderGraph* Graph = nullptr;
+        Renderer::FRendererBase* pRenderer = nullptr;
+        eastl::vector<const FRenderGraph::FPassChunk*> Chunks;
+        eastl::vector<RHI::FRHICommandList*> CmdLists;
+
+        void ExecuteRange(enki::TaskSetPartition range, uint32_t threadNum) override
+        {
+            for (uint32_t i = range.start; i < range.end; i++)
+            {
+                Graph->RecordChunk(pRenderer, *Chunks[i], CmdLists[i]);
+            }
+        }
+    };
+
+    FRenderGraph::FRenderGraph(Renderer::FRendererBase *pRenderer)
+        : FRenderGraph(pRenderer->GetDevice())
+    {
+    }
+
+    FRenderGraph::FRenderGraph(RHI::FRHIDevice *pDevice)
+        : m_ResourceAllocator(pDevice), m_Profiler(pDevice)
     {
-        RHI::FRHIDevice *pDevice = pRenderer->GetDevice();
         m_pGraphicsQueueFence.reset(pDevice->CreateFence("RenderGraph::GraphicsQueueFence"));
         m_pComputeQueueFence.reset(pDevice->CreateFence("RenderGraph::ComputeQueueFence"));
     }
@@ -41,12 +83,114 @@ namespace RG
         m_ResourceAllocator.Reset();
 
         m_OutputResources.clear();
+
+        m_Chunks.clear();
+        m_GraphicsChunkCount = 0;
+
+        m_StructureHash = 0;
     }
 
     void FRenderGraph::Compile()
+    {
+        m_CompileCount++;
+        HashStructure(EStructureToken::Schedule, m_bAutoAsyncCompute ? 1 : 0);
+
+        FCompiledGraph* compiled = FindCompiledGraph();
+        const bool bCached = compiled != nullptr;
+
+        if (bCached)
+        {
+            // 结构与缓存一致：Cull、队列同步和资源生命周期都与上次相同，直接恢复
+            m_Graph.SetRefCounts(compiled->RefCounts);
+
+            for (size_t i = 0; i < m_Passes.size(); i++)
+            {
+                FRenderGraphPassBase* pass = m_Passes[i];
+                const FCompiledPass& compiledPass = compiled->Passes[i];
+                pass->m_Type = compiledPass.Type;
+                pass->m_bAutoAsyncCompute = compiledPass.bAutoAsyncCompute;
+                pass->m_WaitGraphicsPass = compiledPass.WaitGraphicsPass;
+                pass->m_SignalGraphicsPass = compiledPass.SignalGraphicsPass;
+                pass->m_WaitValue = compiledPass.WaitValue;
+                pass->m_SignalValue = compiledPass.SignalValue;
+            }
+
+            for (size_t i = 0; i < m_Resources.size(); i++)
+            {
+                m_Resources[i]->LoadCompiledState(compiled->Resources[i]);
+            }
+            m_CompileStats.CacheHits++;
+        }
+        else
+        {
+            ResolveGraph();
+
+            compiled = &AcquireCompiledGraph();
+            BuildRealizeOrder(compiled->RealizeOrder);
+            m_CompileStats.CacheMisses++;
+        }
+        compiled->LastUsedCompile = m_CompileCount;
+
+        for (size_t i = 0; i < compiled->RealizeOrder.size(); i++)
+        {
+            m_Resources[compiled->RealizeOrder[i]]->Realize();
+        }
+        m_ResourceAllocator.UpdateStats();
+
+        // barrier 依赖资源的实际布局和初始状态，与缓存一致时才能复用
+        const bool bBarriersCached = bCached && IsRealizeMatching(*compiled);
+        if (bBarriersCached)
+        {
+            LoadCompiledBarriers(*compiled);
+        }
+        else
+        {
+            for (size_t i = 0; i < m_Passes.size(); i++)
+            {
+                FRenderGraphPassBase* pass = m_Passes[i];
+                if (!pass->IsCulled())
+                {
+                    pass->ResolveBarriers(m_Graph);
+                }
+            }
+            SplitBarriers();
+
+            if (bCached)
+            {
+                m_CompileStats.BarrierRebuilds++;
+            }
+        }
+
+        // attachment 记录的是本帧的边对象，每帧都要重新取
+        for (size_t i = 0; i < m_Passes.size(); i++)
+        {
+            FRenderGraphPassBase* pass = m_Passes[i];
+            if (!pass->IsCulled())
+            {
+                pass->ResolveAttachments(m_Graph);
+            }
+        }
+
+        if (!bBarriersCached)
+        {
+            SaveCompiledGraph(*compiled);
+        }
+
+        if (m_bParallelRecording)
+        {
+            BuildChunks();
+        }
+    }
+
+    void FRenderGraph::ResolveGraph()
     {
         m_Graph.Cull();
 
+        if (m_bAutoAsyncCompute)
+        {
+            ScheduleAsyncCompute();
+        }
+
         FRenderGraphAsyncResolveContext context;
 
         for (size_t i = 0; i < m_Passes.size(); i++)
@@ -58,7 +202,6 @@ namespace RG
             }
         }
 
-        eastl::vector<FDAGEdge*> edges;
         for (size_t i = 0; i < m_ResourceNodes.size(); i++)
         {
             FRenderGraphResourceNode* node = m_ResourceNodes[i];
@@ -69,7 +212,7 @@ namespace RG
 
             FRenderGraphResource* resource = node->GetResource();
 
-            m_Graph.GetOutgoingEdges(node, edges);
+            FDAGEdgeRange edges = m_Graph.GetOutgoingEdges(node);
             for (size_t j = 0; j < edges.size(); j++)
             {
                 FRenderGraphEdge* edge = static_cast<FRenderGraphEdge*>(edges[j]);
@@ -80,7 +223,7 @@ namespace RG
                 }
             }
 
-            m_Graph.GetIncomingEdges(node, edges);
+            edges = m_Graph.GetIncomingEdges(node);
             for (size_t j = 0; j < edges.size(); j++)
             {
                 FRenderGraphEdge* edge = static_cast<FRenderGraphEdge*>(edges[j]);
@@ -92,25 +235,499 @@ namespace RG
             }
         }
 
+        for (size_t i = 0; i < m_Resources.size(); i++)
+        {
+            if (m_Resources[i]->IsUsed())
+            {
+                m_Resources[i]->PostResolve();
+            }
+        }
+    }
+
+    void FRenderGraph::ScheduleAsyncCompute()
+    {
+        // 每个资源最早的使用者，瞬态资源的别名 barrier 和初始化留在那个 pass 上
+        struct FResourceUse
+        {
+            DAGNodeID FirstPass = UINT32_MAX;
+            RHI::ERHIAccessFlags Usage = 0;
+        };
+        eastl::hash_map<const FRenderGraphResource*, FResourceUse> resourceUses;
+
+        for (size_t i = 0; i < m_ResourceNodes.size(); i++)
+        {
+            FRenderGraphResourceNode* node = m_ResourceNodes[i];
+            if (node->IsCulled())
+            {
+                continue;
+            }
+
+            FResourceUse& use = resourceUses[node->GetResource()];
+            FDAGEdgeRange edges[2] = { m_Graph.GetIncomingEdges(node), m_Graph.GetOutgoingEdges(node) };
+            for (const FDAGEdgeRange& range : edges)
+            {
+                for (size_t j = 0; j < range.size(); j++)
+                {
+                    FRenderGraphEdge* edge = static_cast<FRenderGraphEdge*>(range[j]);
+                    DAGNodeID passID = edge->GetFromNode() == node->GetID() ? edge->GetToNode() : edge->GetFromNode();
+                    if (!m_Graph.GetNode(passID)->IsCulled())
+                    {
+                        use.FirstPass = eastl::min(use.FirstPass, passID);
+                        use.Usage |= edge->GetUsage();
+                    }
+                }
+            }
+        }
+
+        // 能否放到计算队列：只看本 pass 的边和它们之前的状态，firstUserBound 返回瞬态输入要求的最早使用者
+        auto IsCandidate = [&](const FRenderGraphPassBase* pass, DAGNodeID& firstUserBound)
+        {
+            if (pass->GetType() != RenderPassType::Compute || !pass->IsAsyncComputeAllowed() || pass->IsTarget())
+            {
+                return false;
+            }
+
+            firstUserBound = 0;
+
+            FDAGEdgeRange edges = m_Graph.GetIncomingEdges(pass);
+            for (size_t i = 0; i < edges.size(); i++)
+            {
+                FRenderGraphEdge* edge = static_cast<FRenderGraphEdge*>(edges[i]);
+                if (edge->GetUsage() & (RG_GRAPHICS_QUEUE_ACCESS | RHI::RHIAccessMaskVS | RHI::RHIAccessMaskPS))
+                {
+                    return false;
+                }
+
+                FRenderGraphResourceNode* node = static_cast<FRenderGraphResourceNode*>(m_Graph.GetNode(edge->GetFromNode()));
+                FRenderGraphResource* resource = node->GetResource();
+                FDAGEdgeRange resIncoming = m_Graph.GetIncomingEdges(node);
+                FDAGEdgeRange resOutgoing = m_Graph.GetOutgoingEdges(node);
+
+                // 与 ResolveBarriers 相同的规则找出 barrier 的前一个状态
+                bool bHasOldState = false;
+                RHI::ERHIAccessFlags oldState = 0;
+                for (int j = (int)resOutgoing.size() - 1; j >= 0; --j)
+                {
+                    FRenderGraphEdge* reader = static_cast<FRenderGraphEdge*>(resOutgoing[j]);
+                    if (reader->GetSubresource() == edge->GetSubresource() && reader->GetToNode() < pass->GetID() && !m_Graph.GetNode(reader->GetToNode())->IsCulled())
+                    {
+                        oldState = reader->GetUsage();
+                        bHasOldState = true;
+                        break;
+                    }
+                }
+
+                if (!bHasOldState && !resIncoming.empty())
+                {
+                    oldState = static_cast<FRenderGraphEdge*>(resIncoming[0])->GetUsage();
+                    bHasOldState = true;
+                }
+
+                if (!bHasOldState && resource->IsImported())
+                {
+                    oldState = resource->GetInitialState();
+                    bHasOldState = true;
+                }
+
+                if (bHasOldState)
+                {
+                    if (oldState & RG_GRAPHICS_QUEUE_ACCESS)
+                    {
+                        return false;
+                    }
+                }
+                else
+                {
+                    // 瞬态资源在 Realize 之后才知道初始状态，只接受不会处于 RT/DS 布局、且由更早的 pass 首次使用的资源
+                    const FResourceUse& use = resourceUses[resource];
+                    if (resource->HasAttachmentUsage() || (use.Usage & RG_GRAPHICS_QUEUE_ACCESS) || use.FirstPass >= pass->GetID())
+                    {
+                        return false;
+                    }
+                    firstUserBound = eastl::max(firstUserBound, use.FirstPass);
+                }
+            }
+            return true;
+        };
+
+        // 连续的候选 pass 合成一段，整段只需一次等待和一次 signal
+        struct FAsyncRun
+        {
+            eastl::vector<FRenderGraphPassBase*> Passes;
+            DAGNodeID FirstUserBound = 0;
+        };
+
+        auto TrySchedule = [&](const FAsyncRun& run)
+        {
+            if (run.Passes.empty())
+            {
+                return;
+            }
+
+            const DAGNodeID runBegin = run.Passes.front()->GetID();
+            const DAGNodeID runEnd = run.Passes.back()->GetID();
+            auto IsGraphicsQueuePass = [&](DAGNodeID id)
+            {
+                const FRenderGraphPassBase* pass = static_cast<const FRenderGraphPassBase*>(m_Graph.GetNode(id));
+                return !pass->IsCulled() && pass->GetType() != RenderPassType::AsyncCompute && (id < runBegin || id > runEnd);
+            };
+
+            DAGNodeID waitPass = 0;
+            bool bHasWait = false;
+            DAGNodeID signalPass = UINT32_MAX;
+
+            for (const FRenderGraphPassBase* pass : run.Passes)
+            {
+                FDAGEdgeRange edges = m_Graph.GetIncomingEdges(pass);
+                for (size_t i = 0; i < edges.size(); i++)
+                {
+                    FDAGEdgeRange resIncoming = m_Graph.GetIncomingEdges(m_Graph.GetNode(edges[i]->GetFromNode()));
+                    if (!resIncoming.empty() && IsGraphicsQueuePass(resIncoming[0]->GetFromNode()))
+                    {
+                        waitPass = eastl::max(waitPass, resIncoming[0]->GetFromNode());
+                        bHasWait = true;
+                    }
+                }
+
+                edges = m_Graph.GetOutgoingEdges(pass);
+                for (size_t i = 0; i < edges.size(); i++)
+                {
+                    FDAGEdgeRange resOutgoing = m_Graph.GetOutgoingEdges(m_Graph.GetNode(edges[i]->GetToNode()));
+                    for (size_t j = 0; j < resOutgoing.size(); j++)
+                    {
+                        if (IsGraphicsQueuePass(resOutgoing[j]->GetToNode()))
+                        {
+                            signalPass = eastl::min(signalPass, resOutgoing[j]->GetToNode());
+                        }
+                    }
+                }
+            }
+
+            // 没有图形队列上的前驱时，无法保证在本帧的上传和更新之后执行
+            if (!bHasWait || signalPass == UINT32_MAX || run.FirstUserBound > waitPass)
+            {
+                return;
+            }
+
+            // 图形队列上同时读取同一版本的 pass 必须在等待点之前或 signal 点之后
+            for (const FRenderGraphPassBase* pass : run.Passes)
+            {
+                FDAGEdgeRange edges = m_Graph.GetIncomingEdges(pass);
+                for (size_t i = 0; i < edges.size(); i++)
+                {
+                    FDAGEdgeRange resOutgoing = m_Graph.GetOutgoingEdges(m_Graph.GetNode(edges[i]->GetFromNode()));
+                    for (size_t j = 0; j < resOutgoing.size(); j++)
+                    {
+                        DAGNodeID readerID = resOutgoing[j]->GetToNode();
+                        if (IsGraphicsQueuePass(readerID) && readerID > waitPass && readerID < signalPass)
+                        {
+                            return;
+                        }
+                    }
+                }
+            }
+
+            uint32_t overlap = 0;
+            for (const FRenderGraphPassBase* pass : m_Passes)
+            {
+                if (pass->GetID() > waitPass && pass->GetID() < signalPass && IsGraphicsQueuePass(pass->GetID()))
+                {
+                    overlap++;
+                }
+            }
+
+            if (overlap < RG_ASYNC_COMPUTE_MIN_OVERLAP)
+            {
+                return;
+            }
+
+            for (FRenderGraphPassBase* pass : run.Passes)
+            {
+                pass->m_Type = RenderPassType::AsyncCompute;
+                pass->m_bAutoAsyncCompute = true;
+            }
+        };
+
+        FAsyncRun run;
+        for (size_t i = 0; i < m_Passes.size(); i++)
+        {
+            FRenderGraphPassBase* pass = m_Passes[i];
+            // 手动指定的异步 pass 不打断当前段，之后会和它合成同一组
+            if (pass->IsCulled() || pass->GetType() == RenderPassType::AsyncCompute)
+            {
+                continue;
+            }
+
+            DAGNodeID firstUserBound;
+            if (IsCandidate(pass, firstUserBound))
+            {
+                run.Passes.push_back(pass);
+                run.FirstUserBound = eastl::max(run.FirstUserBound, firstUserBound);
+            }
+            else
+            {
+                TrySchedule(run);
+                run.Passes.clear();
+                run.FirstUserBound = 0;
+            }
+        }
+        TrySchedule(run);
+    }
+
+    void FRenderGraph::SplitBarriers()
+    {
+        // m_Passes 按 ID 递增，记录每个 pass 之前有多少个在图形队列上执行的 pass
+        eastl::vector<uint32_t> queuePosition(m_Passes.size());
+        uint32_t position = 0;
+        for (size_t i = 0; i < m_Passes.size(); i++)
+        {
+            queuePosition[i] = position;
+            if (!m_Passes[i]->IsCulled() && m_Passes[i]->GetType() != RenderPassType::AsyncCompute)
+            {
+                position++;
+            }
+        }
+
+        auto FindPass = [&](DAGNodeID id)
+        {
+            auto iter = eastl::lower_bound(m_Passes.begin(), m_Passes.end(), id, [](const FRenderGraphPassBase* pass, DAGNodeID id) { return pass->GetID() < id; });
+            assert(iter != m_Passes.end() && (*iter)->GetID() == id);
+            return (size_t)(iter - m_Passes.begin());
+        };
+
+        for (size_t i = 0; i < m_Passes.size(); i++)
+        {
+            FRenderGraphPassBase* pass = m_Passes[i];
+            if (pass->IsCulled() || pass->GetType() == RenderPassType::AsyncCompute || pass->m_ResourceBarriers.empty())
+            {
+                continue;
+            }
+
+            // 事件只能在同一队列上等待，两端都必须在图形队列上
+            bool bHasSplit = false;
+            for (FRenderGraphPassBase::FResourceBarrier& barrier : pass->m_ResourceBarriers)
+            {
+                if (barrier.PrevPass == UINT32_MAX)
+                {
+                    continue;
+                }
+
+                size_t prevIndex = FindPass(barrier.PrevPass);
+                if (m_Passes[prevIndex]->GetType() != RenderPassType::AsyncCompute &&
+                    queuePosition[i] - queuePosition[prevIndex] > RG_SPLIT_BARRIER_MIN_DISTANCE)
+                {
+                    barrier.bSplit = true;
+                    bHasSplit = true;
+                }
+            }
+
+            if (!bHasSplit)
+            {
+                continue;
+            }
+
+            // 拆分的排在前面并按开始的 pass 分组，两端按同样的顺序提交
+            eastl::stable_sort(pass->m_ResourceBarriers.begin(), pass->m_ResourceBarriers.end(),
+                [](const FRenderGraphPassBase::FResourceBarrier& a, const FRenderGraphPassBase::FResourceBarrier& b)
+                {
+                    return (a.bSplit ? a.PrevPass : UINT32_MAX) < (b.bSplit ? b.PrevPass : UINT32_MAX);
+                });
+
+            for (const FRenderGraphPassBase::FResourceBarrier& barrier : pass->m_ResourceBarriers)
+            {
+                if (barrier.bSplit)
+                {
+                    m_Passes[FindPass(barrier.PrevPass)]->m_SplitBeginBarriers.push_back({ barrier.Resource, barrier.Subresource, barrier.OldState, barrier.NewState, pass->GetID() });
+                }
+            }
+        }
+    }
+
+    void FRenderGraph::BuildRealizeOrder(eastl::vector<uint32_t> &realizeOrder) const
+    {
+        // greedy-by-size：先放大的资源，小资源再去填它们之间的空隙
+        struct FRealizeOrder
+        {
+            uint32_t Size;
+            uint32_t Resource;
+        };
+        eastl::vector<FRealizeOrder> order;
+        for (size_t i = 0; i < m_Resources.size(); i++)
+        {
+            if (m_Resources[i]->IsUsed())
+            {
+                order.push_back({ m_Resources[i]->GetAllocationSize(), (uint32_t)i });
+            }
+        }
+        eastl::stable_sort(order.begin(), order.end(), [](const FRealizeOrder& a, const FRealizeOrder& b) { return a.Size > b.Size; });
+
+        realizeOrder.resize(order.size());
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            realizeOrder[i] = order[i].Resource;
+        }
+    }
+
+    FRenderGraph::FCompiledGraph *FRenderGraph::FindCompiledGraph()
+    {
+        for (size_t i = 0; i < m_CompiledGraphs.size(); i++)
+        {
+            FCompiledGraph& compiled = m_CompiledGraphs[i];
+            if (compiled.Hash == m_StructureHash &&
+                compiled.RefCounts.size() == m_Graph.GetNodeCount() &&
+                compiled.Passes.size() == m_Passes.size() &&
+                compiled.Resources.size() == m_Resources.size())
+            {
+                return &compiled;
+            }
+        }
+        return nullptr;
+    }
+
+    FRenderGraph::FCompiledGraph &FRenderGraph::AcquireCompiledGraph()
+    {
+        FCompiledGraph* compiled = nullptr;
+        if (m_CompiledGraphs.size() < RG_MAX_COMPILED_GRAPHS)
+        {
+            compiled = &m_CompiledGraphs.emplace_back();
+        }
+        else
+        {
+            compiled = eastl::min_element(m_CompiledGraphs.begin(), m_CompiledGraphs.end(),
+                [](const FCompiledGraph& a, const FCompiledGraph& b) { return a.LastUsedCompile < b.LastUsedCompile; });
+        }
+
+        compiled->Hash = m_StructureHash;
+        return *compiled;
+    }
+
+    bool FRenderGraph::IsRealizeMatching(const FCompiledGraph &compiled) const
+    {
         for (size_t i = 0; i < m_Resources.size(); i++)
         {
             FRenderGraphResource* resource = m_Resources[i];
-            if (resource->IsUsed())
+            const FRGCompiledResource& state = compiled.Resources[i];
+
+            // 导入和导出的资源不参与别名，每帧绑定的对象可以不同
+            if (resource->IsUsed() && resource->IsOverlapping() && resource->GetResource() != state.Resource)
             {
-                resource->Realize();
+                return false;
+            }
+            if (resource->GetInitialState() != state.InitialState)
+            {
+                return false;
             }
         }
+        return true;
+    }
 
+    void FRenderGraph::LoadCompiledBarriers(const FCompiledGraph &compiled)
+    {
         for (size_t i = 0; i < m_Passes.size(); i++)
         {
             FRenderGraphPassBase* pass = m_Passes[i];
-            if (!pass->IsCulled())
+            const FCompiledPass& compiledPass = compiled.Passes[i];
+
+            pass->m_ResourceBarriers.resize(compiledPass.BarrierCount);
+            for (uint32_t j = 0; j < compiledPass.BarrierCount; j++)
             {
-                pass->ResolveBarriers(m_Graph);
+                const FCompiledBarrier& barrier = compiled.Barriers[compiledPass.FirstBarrier + j];
+                pass->m_ResourceBarriers[j] = { m_Resources[barrier.Resource], barrier.Subresource, barrier.OldState, barrier.NewState, barrier.PrevPass, barrier.bSplit };
+            }
+
+            pass->m_SplitBeginBarriers.resize(compiledPass.SplitBarrierCount);
+            for (uint32_t j = 0; j < compiledPass.SplitBarrierCount; j++)
+            {
+                const FCompiledSplitBarrier& barrier = compiled.SplitBarriers[compiledPass.FirstSplitBarrier + j];
+                pass->m_SplitBeginBarriers[j] = { m_Resources[barrier.Resource], barrier.Subresource, barrier.OldState, barrier.NewState, barrier.EndPass };
+            }
+
+            pass->m_AliasDiscardBarriers.resize(compiledPass.AliasBarrierCount);
+            for (uint32_t j = 0; j < compiledPass.AliasBarrierCount; j++)
+            {
+                const FCompiledAliasBarrier& barrier = compiled.AliasBarriers[compiledPass.FirstAliasBarrier + j];
+                RHI::FRHIResource* aliasedRes = m_Resources[barrier.Resource]->GetResource();
+                pass->m_AliasDiscardBarriers[j] = { aliasedRes, barrier.AccessBefore, barrier.AccessAfter };
+                m_ResourceAllocator.MarkAliasDiscarded(aliasedRes);
             }
         }
     }
 
+    void FRenderGraph::SaveCompiledGraph(FCompiledGraph &compiled)
+    {
+        m_Graph.GetRefCounts(compiled.RefCounts);
+
+        eastl::hash_map<const FRenderGraphResource*, uint32_t> resourceIndices;
+        eastl::hash_map<const RHI::FRHIResource*, uint32_t> aliasedIndices;
+
+        compiled.Resources.resize(m_Resources.size());
+        for (size_t i = 0; i < m_Resources.size(); i++)
+        {
+            FRenderGraphResource* resource = m_Resources[i];
+            resource->SaveCompiledState(compiled.Resources[i]);
+
+            resourceIndices[resource] = (uint32_t)i;
+            if (resource->IsUsed() && resource->IsOverlapping())
+            {
+                aliasedIndices[resource->GetResource()] = (uint32_t)i;
+            }
+        }
+
+        compiled.Passes.resize(m_Passes.size());
+        compiled.Barriers.clear();
+        compiled.AliasBarriers.clear();
+        compiled.SplitBarriers.clear();
+        for (size_t i = 0; i < m_Passes.size(); i++)
+        {
+            const FRenderGraphPassBase* pass = m_Passes[i];
+
+            FCompiledPass& compiledPass = compiled.Passes[i];
+            compiledPass.Type = pass->m_Type;
+            compiledPass.bAutoAsyncCompute = pass->m_bAutoAsyncCompute;
+            compiledPass.WaitGraphicsPass = pass->m_WaitGraphicsPass;
+            compiledPass.SignalGraphicsPass = pass->m_SignalGraphicsPass;
+            compiledPass.WaitValue = pass->m_WaitValue;
+            compiledPass.SignalValue = pass->m_SignalValue;
+            compiledPass.FirstBarrier = (uint32_t)compiled.Barriers.size();
+            compiledPass.BarrierCount = (uint32_t)pass->m_ResourceBarriers.size();
+            compiledPass.FirstAliasBarrier = (uint32_t)compiled.AliasBarriers.size();
+            compiledPass.AliasBarrierCount = (uint32_t)pass->m_AliasDiscardBarriers.size();
+            compiledPass.FirstSplitBarrier = (uint32_t)compiled.SplitBarriers.size();
+            compiledPass.SplitBarrierCount = (uint32_t)pass->m_SplitBeginBarriers.size();
+
+            for (const FRenderGraphPassBase::FResourceBarrier& barrier : pass->m_ResourceBarriers)
+            {
+                compiled.Barriers.push_back({ resourceIndices[barrier.Resource], barrier.Subresource, barrier.OldState, barrier.NewState, barrier.PrevPass, barrier.bSplit });
+            }
+
+            for (const FRenderGraphPassBase::FSplitBarrier& barrier : pass->m_SplitBeginBarriers)
+            {
+                compiled.SplitBarriers.push_back({ resourceIndices[barrier.Resource], barrier.Subresource, barrier.OldState, barrier.NewState, barrier.EndPass });
+            }
+
+            // 被别名的一定是本帧 Realize 过的瞬态资源
+            for (const FRenderGraphPassBase::FAliasDiscardBarrier& barrier : pass->m_AliasDiscardBarriers)
+            {
+                assert(aliasedIndices.find(barrier.Resource) != aliasedIndices.end());
+                compiled.AliasBarriers.push_back({ aliasedIndices[barrier.Resource], barrier.AccessBefore, barrier.AccessAfter });
+            }
+        }
+    }
+
+    uint64_t FRenderGraph::HashDesc(const RHI::FRHITextureDesc &desc)
+    {
+        // desc 有尾部填充，逐个字段取值而不是直接哈希内存
+        const uint32_t fields[] = { 0, desc.Width, desc.Height, desc.Depth, desc.MipLevels, desc.ArraySize, (uint32_t)desc.Type,
+            (uint32_t)desc.Format, (uint32_t)desc.MemoryType, (uint32_t)desc.AllocationType, desc.Usage };
+        return Utility::FHashUtils::CityHash(fields, sizeof(fields));
+    }
+
+    uint64_t FRenderGraph::HashDesc(const RHI::FRHIBufferDesc &desc)
+    {
+        const uint32_t fields[] = { 1, desc.Stride, desc.Size, (uint32_t)desc.Format, (uint32_t)desc.MemoryType, (uint32_t)desc.AllocationType, desc.Usage };
+        return Utility::FHashUtils::CityHash(fields, sizeof(fields));
+    }
+
     void FRenderGraph::Execute(Renderer::FRendererBase *pRenderer, RHI::FRHICommandList *pGraphicsCmdList, RHI::FRHICommandList *pComputeCmdList)
     {
         GPU_EVENT_DEBUG(pGraphicsCmdList, "RenderGraph::Execute");
@@ -124,14 +741,35 @@ namespace RG
         context.InitialGraphicsFenceValue = m_GraphicsQueueFenceValue;
         context.InitialComputeFenceValue = m_ComputeQueueFenceValue;
 
-        for (size_t i = 0; i < m_Passes.size(); i++)
+        pGraphicsCmdList->ResetBarrierStats();
+        pComputeCmdList->ResetBarrierStats();
+
+        eastl::vector<eastl::pair<eastl::string, RHI::ERHICommandQueueType>> profileScopes;
+        if (m_Profiler.IsEnabled())
         {
-            FRenderGraphPassBase* pass = m_Passes[i];
-            pass->Execute(*this, context);
+            BuildProfileScopes(profileScopes);
+        }
+        m_Profiler.BeginFrame(pGraphicsCmdList, pComputeCmdList, profileScopes);
+
+        uint32_t secondaryCmdListCount = 0;
+        if (m_bParallelRecording && m_GraphicsChunkCount > 0 && PrepareSecondaryCmdLists(pRenderer, m_GraphicsChunkCount))
+        {
+            ExecuteParallel(context);
+            secondaryCmdListCount = m_GraphicsChunkCount;
+        }
+        else
+        {
+            for (size_t i = 0; i < m_Passes.size(); i++)
+            {
+                FRenderGraphPassBase* pass = m_Passes[i];
+                pass->Execute(*this, context);
+            }
         }
         m_GraphicsQueueFenceValue = context.LastSignalGraphicsFenceValue;
         m_ComputeQueueFenceValue = context.LastSignalComputeFenceValue;
 
+        m_Profiler.EndFrame(pGraphicsCmdList);
+
         for (size_t i = 0; i < m_OutputResources.size(); i++)
         {
             const FPresentTarget& target = m_OutputResources[i];
@@ -142,6 +780,228 @@ namespace RG
             }
         }
         m_OutputResources.clear();
+
+        eastl::vector<RHI::FRHICommandList*> cmdLists = { pGraphicsCmdList, pComputeCmdList };
+        for (uint32_t i = 0; i < secondaryCmdListCount; i++)
+        {
+            cmdLists.push_back(m_SecondaryCmdLists[pRenderer->GetDevice()->GetFrameID() % RHI::RHI_MAX_INFLIGHT_FRAMES][i].get());
+        }
+
+        m_BarrierStats = {};
+        for (RHI::FRHICommandList* pCmdList : cmdLists)
+        {
+            const RHI::FRHIBarrierStats& stats = pCmdList->GetBarrierStats();
+            m_BarrierStats.BarrierCommands += stats.BarrierCommands;
+            m_BarrierStats.Barriers += stats.Barriers;
+            m_BarrierStats.SplitBarriers += stats.SplitBarriers;
+        }
+    }
+
+    void FRenderGraph::BuildProfileScopes(eastl::vector<eastl::pair<eastl::string, RHI::ERHICommandQueueType>> &scopes)
+    {
+        // 最后一次 signal 之后的异步 pass 不会在本帧提交，图形队列也没有等待它们，不计时
+        eastl::vector<bool> profiled(m_Passes.size(), false);
+        const bool bComputeSupported = m_Profiler.IsQueueSupported(RHI::ERHICommandQueueType::Compute);
+        bool bComputeSubmitted = false;
+        for (size_t i = m_Passes.size(); i-- > 0;)
+        {
+            const FRenderGraphPassBase* pass = m_Passes[i];
+            if (pass->GetType() == RenderPassType::AsyncCompute)
+            {
+                bComputeSubmitted = bComputeSubmitted || pass->HasSignal();
+                profiled[i] = bComputeSupported && bComputeSubmitted;
+            }
+            else
+            {
+                profiled[i] = true;
+            }
+        }
+
+        for (size_t i = 0; i < m_Passes.size(); i++)
+        {
+            FRenderGraphPassBase* pass = m_Passes[i];
+            if (profiled[i] && !pass->IsCulled())
+            {
+                pass->m_ProfileScope = (uint32_t)scopes.size();
+                scopes.push_back({ pass->m_Name, pass->GetType() == RenderPassType::AsyncCompute ? RHI::ERHICommandQueueType::Compute : RHI::ERHICommandQueueType::Graphics });
+            }
+        }
+    }
+
+    void FRenderGraph::BuildChunks()
+    {
+        m_Chunks.clear();
+        m_GraphicsChunkCount = 0;
+
+        uint32_t graphicsPassCount = 0;
+        for (size_t i = 0; i < m_Passes.size(); i++)
+        {
+            if (!m_Passes[i]->IsCulled() && m_Passes[i]->GetType() != RenderPassType::AsyncCompute)
+            {
+                graphicsPassCount++;
+            }
+        }
+
+        uint32_t threadCount = Core::FVultanaEngine::GetEngineInstance()->GetTaskScheduler()->GetNumTaskThreads();
+        uint32_t targetPassCount = eastl::max(RG_MIN_PASSES_PER_CHUNK, (graphicsPassCount + threadCount - 1) / threadCount);
+
+        eastl::vector<eastl::string> eventStack;
+        uint32_t chunkPassCount = 0;
+        bool bSplitAfter = false;
+
+        for (uint32_t i = 0; i < (uint32_t)m_Passes.size(); i++)
+        {
+            const FRenderGraphPassBase* pass = m_Passes[i];
+            bool bAsyncCompute = pass->GetType() == RenderPassType::AsyncCompute;
+
+            // 跨队列的 wait/signal 需要在主命令列表上提交，只能落在段的开头和结尾
+            bool bSplit = m_Chunks.empty() || bSplitAfter || m_Chunks.back().bAsyncCompute != bAsyncCompute ||
+                (!bAsyncCompute && (pass->HasWait() || chunkPassCount >= targetPassCount));
+            if (bSplit)
+            {
+                FPassChunk chunk;
+                chunk.FirstPass = i;
+                chunk.bAsyncCompute = bAsyncCompute;
+                chunk.OpenEvents = eventStack;
+                m_Chunks.push_back(chunk);
+
+                chunkPassCount = 0;
+                if (!bAsyncCompute)
+                {
+                    m_GraphicsChunkCount++;
+                }
+            }
+
+            m_Chunks.back().PassCount++;
+            if (!pass->IsCulled())
+            {
+                chunkPassCount++;
+            }
+            bSplitAfter = !bAsyncCompute && pass->HasSignal();
+
+            const eastl::vector<eastl::string>& eventNames = pass->GetEventNames();
+            eventStack.insert(eventStack.end(), eventNames.begin(), eventNames.end());
+            for (uint32_t j = 0; j < pass->GetEndEventNum() && !eventStack.empty(); j++)
+            {
+                eventStack.pop_back();
+            }
+        }
+    }
+
+    bool FRenderGraph::PrepareSecondaryCmdLists(Renderer::FRendererBase *pRenderer, uint32_t count)
+    {
+        RHI::FRHIDevice* pDevice = pRenderer->GetDevice();
+        eastl::vector<eastl::unique_ptr<RHI::FRHICommandList>>& cmdLists = m_SecondaryCmdLists[pDevice->GetFrameID() % RHI::RHI_MAX_INFLIGHT_FRAMES];
+
+        while (cmdLists.size() < count)
+        {
+            eastl::string name = "RenderGraph::SecondaryCmdList " + eastl::to_string(cmdLists.size());
+            RHI::FRHICommandList* pCmdList = pDevice->CreateSecondaryCommandList(RHI::ERHICommandQueueType::Graphics, name);
+            if (pCmdList == nullptr)
+            {
+                VTNA_LOG_ERROR("[RenderGraph] Failed to create secondary command list, fall back to serial recording");
+                m_bParallelRecording = false;
+                return false;
+            }
+            cmdLists.emplace_back(pCmdList);
+        }
+
+        // BeginFrame 已经等待过这一帧的 fence，可以安全地重置
+        for (uint32_t i = 0; i < count; i++)
+        {
+            cmdLists[i]->ResetAllocator();
+        }
+        return true;
+    }
+
+    void FRenderGraph::ExecuteParallel(FRenderGraphPassExecuteContext &context)
+    {
+        eastl::vector<eastl::unique_ptr<RHI::FRHICommandList>>& cmdLists = m_SecondaryCmdLists[context.pRenderer->GetDevice()->GetFrameID() % RHI::RHI_MAX_INFLIGHT_FRAMES];
+
+        FRecordChunkTask task;
+        task.Graph = this;
+        task.pRenderer = context.pRenderer;
+        for (size_t i = 0; i < m_Chunks.size(); i++)
+        {
+            if (!m_Chunks[i].bAsyncCompute)
+            {
+                task.CmdLists.push_back(cmdLists[task.Chunks.size()].get());
+                task.Chunks.push_back(&m_Chunks[i]);
+            }
+        }
+        task.m_SetSize = (uint32_t)task.Chunks.size();
+        task.m_MinRange = 1;
+        // GetShader 等待编译时只帮忙执行高优先级任务，录制任务用中优先级，不会在等待中嵌套录制其他段
+        task.m_Priority = enki::TASK_PRIORITY_MED;
+
+        enki::TaskScheduler* ts = Core::FVultanaEngine::GetEngineInstance()->GetTaskScheduler();
+        ts->AddTaskSetToPipe(&task);
+        ts->WaitforTask(&task);
+
+        // 按原顺序提交，barrier 已在 Compile 时解析到各个 pass 中，段之间不需要额外同步
+        uint32_t graphicsChunkIndex = 0;
+        for (size_t i = 0; i < m_Chunks.size(); i++)
+        {
+            const FPassChunk& chunk = m_Chunks[i];
+            FRenderGraphPassBase* firstPass = m_Passes[chunk.FirstPass];
+            FRenderGraphPassBase* lastPass = m_Passes[chunk.FirstPass + chunk.PassCount - 1];
+
+            if (chunk.bAsyncCompute)
+            {
+                // 异步计算的 pass 很少，直接在主线程上录制到 compute 命令列表
+                for (uint32_t j = chunk.FirstPass; j < chunk.FirstPass + chunk.PassCount; j++)
+                {
+                    m_Passes[j]->ExecuteWait(context);
+                    m_Passes[j]->Record(*this, context.ComputeCmdList);
+                    m_Passes[j]->ExecuteSignal(context);
+                }
+            }
+            else
+            {
+                firstPass->ExecuteWait(context);
+                context.GraphicsCmdList->ExecuteCommandList(task.CmdLists[graphicsChunkIndex++]);
+                lastPass->ExecuteSignal(context);
+            }
+        }
+    }
+
+    void FRenderGraph::RecordChunk(Renderer::FRendererBase *pRenderer, const FPassChunk &chunk, RHI::FRHICommandList *pCmdList) const
+    {
+        pCmdList->Begin();
+        pCmdList->ResetBarrierStats();
+        pRenderer->SetupGlobalConstants(pCmdList);
+
+        for (size_t i = 0; i < chunk.OpenEvents.size(); i++)
+        {
+            pCmdList->BeginEvent(chunk.OpenEvents[i]);
+        }
+        uint32_t eventDepth = (uint32_t)chunk.OpenEvents.size();
+
+        for (uint32_t i = chunk.FirstPass; i < chunk.FirstPass + chunk.PassCount; i++)
+        {
+            FRenderGraphPassBase* pass = m_Passes[i];
+            assert(i == chunk.FirstPass || !pass->HasWait());
+            assert(i == chunk.FirstPass + chunk.PassCount - 1 || !pass->HasSignal());
+
+            pass->BeginEvents(pCmdList);
+            eventDepth += (uint32_t)pass->GetEventNames().size();
+
+            pass->Record(*this, pCmdList);
+
+            uint32_t endEventNum = eastl::min(pass->GetEndEventNum(), eventDepth);
+            for (uint32_t j = 0; j < endEventNum; j++)
+            {
+                pCmdList->EndEvent();
+            }
+            eventDepth -= endEventNum;
+        }
+
+        // 没有结束的 event 由下一段重新打开
+        for (uint32_t i = 0; i < eventDepth; i++)
+        {
+            pCmdList->EndEvent();
+        }
+        pCmdList->End();
     }
 
     void FRenderGraph::Present(const FRGHandle &handle, RHI::ERHIAccessFlags finalState)
@@ -153,6 +1013,7 @@ namespace RG
 
         FRenderGraphResourceNode* node = m_ResourceNodes[handle.Node];
         node->MakeTarget();
+        HashStructure(EStructureToken::Present, handle.Node);
 
         FPresentTarget target = {};
         target.Resource = resource;
@@ -164,6 +1025,8 @@ namespace RG
     {
         auto resource = Allocate<FRGTexture>(m_ResourceAllocator, texture, state);
         auto node = AllocatePOD<FRenderGraphResourceNode>(m_Graph, resource, 0);
+        // 导入的对象本身是每帧的绑定，只有类型和初始状态影响编译结果
+        HashStructure(EStructureToken::Import, (uint64_t)state << 1);
 
         FRGHandle handle;
         handle.Index = (uint16_t)m_Resources.size();
@@ -179,6 +1042,7 @@ namespace RG
     {
         auto resource = Allocate<FRGBuffer>(m_ResourceAllocator, buffer, state);
         auto node = AllocatePOD<FRenderGraphResourceNode>(m_Graph, resource, 0);
+        HashStructure(EStructureToken::Import, ((uint64_t)state << 1) | 1);
 
         FRGHandle handle;
         handle.Index = (uint16_t)m_Resources.size();
@@ -214,7 +1078,42 @@ namespace RG
 
     eastl::string FRenderGraph::Export()
     {
-        return m_Graph.ExportGraphViz();
+        eastl::string graphViz = m_Graph.ExportGraphViz();
+
+        // 跨队列同步画成虚线：图形 pass -> 异步段的等待，异步段的 signal -> 图形 pass
+        auto SyncEdge = [](DAGNodeID from, DAGNodeID to, const char* label)
+        {
+            eastl::string edge = "  N" + eastl::to_string(from) + " -> N" + eastl::to_string(to);
+            edge.append(" [color=mediumorchid3, style=dashed, label=\"");
+            edge.append(label);
+            edge.append("\"]\n");
+            return edge;
+        };
+
+        eastl::string syncEdges;
+        for (size_t i = 0; i < m_Passes.size(); i++)
+        {
+            const FRenderGraphPassBase* pass = m_Passes[i];
+            if (pass->IsCulled() || pass->GetType() != RenderPassType::AsyncCompute)
+            {
+                continue;
+            }
+            if (pass->HasWait())
+            {
+                syncEdges.append(SyncEdge(pass->GetWaitGraphicsPass(), pass->GetID(), "wait"));
+            }
+            if (pass->HasSignal())
+            {
+                syncEdges.append(SyncEdge(pass->GetID(), pass->GetSignalGraphicsPass(), "signal"));
+            }
+        }
+
+        size_t end = graphViz.rfind('}');
+        if (end != eastl::string::npos)
+        {
+            graphViz.insert(end, syncEdges);
+        }
+        return graphViz;
     }
 
     FRGHandle FRenderGraph::Read(FRenderGraphPassBase *pass, const FRGHandle &input, RHI::ERHIAccessFlags usage, uint32_t subresource)
@@ -222,6 +1121,7 @@ namespace RG
         assert(input.IsValid());
         FRenderGraphResourceNode* inputNode = m_ResourceNodes[input.Node];
         AllocatePOD<FRenderGraphEdge>(m_Graph, inputNode, pass, usage, subresource);
+        HashStructure(EStructureToken::Read, HashEdge(pass, inputNode, usage, subresource));
 
         return input;
     }
@@ -233,6 +1133,7 @@ namespace RG
 
         FRenderGraphResourceNode* inputNode = m_ResourceNodes[input.Node];
         AllocatePOD<FRenderGraphEdge>(m_Graph, inputNode, pass, usage, subresource);
+        HashStructure(EStructureToken::Write, HashEdge(pass, inputNode, usage, subresource));
 
         FRenderGraphResourceNode* outputNode = AllocatePOD<FRenderGraphResourceNode>(m_Graph, resource, inputNode->GetVersion() + 1);
         AllocatePOD<FRenderGraphEdge>(m_Graph, pass, outputNode, usage, subresource);
@@ -255,6 +1156,7 @@ namespace RG
 
         FRenderGraphResourceNode* inputNode = m_ResourceNodes[input.Node];
         AllocatePOD<FRGEdgeColorAttachment>(m_Graph, inputNode, pass, usage, subresource, colorIndex, loadOp, clearColor);
+        HashStructure(EStructureToken::WriteColor, HashCombine64(HashEdge(pass, inputNode, usage, subresource), colorIndex));
 
         FRenderGraphResourceNode* outputNode = AllocatePOD<FRenderGraphResourceNode>(m_Graph, resource, inputNode->GetVersion() + 1);
         AllocatePOD<FRGEdgeColorAttachment>(m_Graph, pass, outputNode, usage, subresource, colorIndex, loadOp, clearColor);
@@ -277,6 +1179,7 @@ namespace RG
 
         FRenderGraphResourceNode* inputNode = m_ResourceNodes[input.Node];
         AllocatePOD<FRGEdgeDepthAttachment>(m_Graph, inputNode, pass, usage, subresource, depthLoadOp, stencilLoadOp, clearDepth, clearStencil);
+        HashStructure(EStructureToken::WriteDepth, HashEdge(pass, inputNode, usage, subresource));
 
         FRenderGraphResourceNode* outputNode = AllocatePOD<FRenderGraphResourceNode>(m_Graph, resource, inputNode->GetVersion() + 1);
         AllocatePOD<FRGEdgeDepthAttachment>(m_Graph, pass, outputNode, usage, subresource, depthLoadOp, stencilLoadOp, clearDepth, clearStencil);
@@ -299,6 +1202,7 @@ namespace RG
 
         FRenderGraphResourceNode* inputNode = m_ResourceNodes[input.Node];
         AllocatePOD<FRGEdgeDepthAttachment>(m_Graph, inputNode, pass, usage, subresource, RHI::ERHIRenderPassLoadOp::Load, RHI::ERHIRenderPassLoadOp::Load, 0.0f, 0);
+        HashStructure(EStructureToken::ReadDepth, HashEdge(pass, inputNode, usage, subresource));
 
         FRenderGraphResourceNode* outputNode = AllocatePOD<FRenderGraphResourceNode>(m_Graph, resource, inputNode->GetVersion() + 1);
         AllocatePOD<FRGEdgeDepthAttachment>(m_Graph, pass, outputNode, usage, subresource, RHI::ERHIRenderPassLoadOp::Load, RHI::ERHIRenderPassLoadOp::Load, 0.0f, 0);
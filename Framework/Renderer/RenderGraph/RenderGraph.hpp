@@ -4,7 +4,9 @@
 #include "RenderGraphHandle.hpp"
 #include "RenderGraphResource.hpp"
 #include "RenderGraphResourceAllocator.hpp"
+#include "RenderGraphProfiler.hpp"
 #include "Utilities/Math.hpp"
+#include "Utilities/Hash.hpp"
 #include "Utilities/LinearAllocator.hpp"
 
 #include <EASTL/unique_ptr.h>
@@ -18,11 +20,21 @@ namespace RG
 {
     class FRenderGraphResourceNode;
 
+    struct FRenderGraphCompileStats
+    {
+        uint64_t CacheHits = 0;
+        uint64_t CacheMisses = 0;
+        // 命中缓存但资源布局或初始状态与缓存不一致，barrier 需要重新解析
+        uint64_t BarrierRebuilds = 0;
+    };
+
     class FRenderGraph
     {
         friend class FRGBuilder;
     public:
         FRenderGraph(Renderer::FRendererBase* pRenderer);
+        // 编译只依赖设备，测试可以直接用空设备构造
+        FRenderGraph(RHI::FRHIDevice* pDevice);
 
         template<typename Data, typename Setup, typename Execute>
         TRenderGraphPass<Data>& AddPass(const eastl::string& name, RenderPassType type, const Setup& setup, const Execute& execute);
@@ -32,8 +44,17 @@ namespace RG
 
         void Clear();
         void Compile();
+        // pRenderer 为空时提交后不重新设置全局常量，只用于测试中的串行录制
         void Execute(Renderer::FRendererBase* pRenderer, RHI::FRHICommandList* pGraphicsCmdList, RHI::FRHICommandList* pComputeCmdList);
 
+        // 开启后 Compile 把 pass 序列切成若干段，Execute 时在 enkiTS worker 上录制到二级命令列表
+        void SetParallelRecording(bool enable) { m_bParallelRecording = enable; }
+        bool IsParallelRecording() const { return m_bParallelRecording; }
+
+        // 开启后 Compile 把与图形队列关键路径有足够重叠的计算 pass 移到异步计算队列，结果见 Export
+        void SetAutoAsyncCompute(bool enable) { m_bAutoAsyncCompute = enable; }
+        bool IsAutoAsyncCompute() const { return m_bAutoAsyncCompute; }
+
         void Present(const FRGHandle& handle, RHI::ERHIAccessFlags finalState);
 
         FRGHandle Import(RHI::FRHITexture* texture, RHI::ERHIAccessFlags state);
@@ -43,6 +64,14 @@ namespace RG
         FRGBuffer* GetBuffer(const FRGHandle& handle);
 
         const FDirectedAcyclicGraph& GetDAG() const { return m_Graph; }
+        const FRenderGraphTransientStats& GetTransientStats() const { return m_ResourceAllocator.GetStats(); }
+        const FRenderGraphCompileStats& GetCompileStats() const { return m_CompileStats; }
+        // 上一次 Execute 在各个命令列表上录制的 barrier 命令
+        const RHI::FRHIBarrierStats& GetBarrierStats() const { return m_BarrierStats; }
+        FRenderGraphProfiler& GetProfiler() { return m_Profiler; }
+        const FRenderGraphProfiler& GetProfiler() const { return m_Profiler; }
+        // 本帧已声明的 pass、资源与边的结构哈希，不包含每帧变化的资源绑定
+        uint64_t GetStructureHash() const { return m_StructureHash; }
         eastl::string Export();
     
     private:
@@ -62,6 +91,107 @@ namespace RG
         FRGHandle WriteDepth(FRenderGraphPassBase* pass, const FRGHandle& input, uint32_t subresource, RHI::ERHIRenderPassLoadOp depthLoadOp, RHI::ERHIRenderPassLoadOp stencilLoadOp, float clearDepth, uint32_t clearStencil);
         FRGHandle ReadDepth(FRenderGraphPassBase* pass, const FRGHandle& input, uint32_t subresource);
 
+        enum class EStructureToken : uint64_t
+        {
+            Pass,
+            Create,
+            Import,
+            Read,
+            Write,
+            WriteColor,
+            WriteDepth,
+            ReadDepth,
+            Present,
+            Schedule,
+        };
+        void HashStructure(EStructureToken token, uint64_t value) { m_StructureHash = HashCombine64(HashCombine64(m_StructureHash, (uint64_t)token), value); }
+        static uint64_t HashDesc(const RHI::FRHITextureDesc& desc);
+        static uint64_t HashDesc(const RHI::FRHIBufferDesc& desc);
+
+        struct FCompiledPass
+        {
+            RenderPassType Type;
+            bool bAutoAsyncCompute;
+            DAGNodeID WaitGraphicsPass;
+            DAGNodeID SignalGraphicsPass;
+            uint64_t WaitValue;
+            uint64_t SignalValue;
+            uint32_t FirstBarrier;
+            uint32_t BarrierCount;
+            uint32_t FirstAliasBarrier;
+            uint32_t AliasBarrierCount;
+            uint32_t FirstSplitBarrier;
+            uint32_t SplitBarrierCount;
+        };
+
+        // 资源以在 m_Resources 中的序号记录，恢复时换成本帧的对象
+        struct FCompiledBarrier
+        {
+            uint32_t Resource;
+            uint32_t Subresource;
+            RHI::ERHIAccessFlags OldState;
+            RHI::ERHIAccessFlags NewState;
+            DAGNodeID PrevPass;
+            bool bSplit;
+        };
+
+        struct FCompiledSplitBarrier
+        {
+            uint32_t Resource;
+            uint32_t Subresource;
+            RHI::ERHIAccessFlags OldState;
+            RHI::ERHIAccessFlags NewState;
+            DAGNodeID EndPass;
+        };
+
+        struct FCompiledAliasBarrier
+        {
+            uint32_t Resource;
+            RHI::ERHIAccessFlags AccessBefore;
+            RHI::ERHIAccessFlags AccessAfter;
+        };
+
+        // 一次 Compile 的完整结果，结构哈希相同的图直接恢复，只重新 Realize 本帧的资源
+        struct FCompiledGraph
+        {
+            uint64_t Hash = 0;
+            uint64_t LastUsedCompile = 0;
+            eastl::vector<uint32_t> RefCounts;
+            eastl::vector<FCompiledPass> Passes;
+            eastl::vector<FRGCompiledResource> Resources;
+            eastl::vector<uint32_t> RealizeOrder;
+            eastl::vector<FCompiledBarrier> Barriers;
+            eastl::vector<FCompiledAliasBarrier> AliasBarriers;
+            eastl::vector<FCompiledSplitBarrier> SplitBarriers;
+        };
+
+        FCompiledGraph* FindCompiledGraph();
+        FCompiledGraph& AcquireCompiledGraph();
+        void ResolveGraph();
+        void ScheduleAsyncCompute();
+        void SplitBarriers();
+        void BuildRealizeOrder(eastl::vector<uint32_t>& realizeOrder) const;
+        bool IsRealizeMatching(const FCompiledGraph& compiled) const;
+        void LoadCompiledBarriers(const FCompiledGraph& compiled);
+        void SaveCompiledGraph(FCompiledGraph& compiled);
+
+        struct FPassChunk
+        {
+            uint32_t FirstPass = 0;
+            uint32_t PassCount = 0;
+            bool bAsyncCompute = false;
+            // 段开始时仍未结束的 event，录制时重新打开，保证每个命令列表内 event 成对
+            eastl::vector<eastl::string> OpenEvents;
+        };
+
+        void BuildProfileScopes(eastl::vector<eastl::pair<eastl::string, RHI::ERHICommandQueueType>>& scopes);
+        void BuildChunks();
+        bool PrepareSecondaryCmdLists(Renderer::FRendererBase* pRenderer, uint32_t count);
+        void ExecuteParallel(FRenderGraphPassExecuteContext& context);
+        void RecordChunk(Renderer::FRendererBase* pRenderer, const FPassChunk& chunk, RHI::FRHICommandList* pCmdList) const;
+
+        friend struct FRecordChunkTask;
+
     private:
         FLinearAllocator m_Allocator {512 * 1024};
         FRenderGraphResourceAllocator m_ResourceAllocator;
@@ -91,6 +221,20 @@ namespace RG
             RHI::ERHIAccessFlags State;
         };
         eastl::vector<FPresentTarget> m_OutputResources;
+
+        uint64_t m_StructureHash = 0;
+        uint64_t m_CompileCount = 0;
+        eastl::vector<FCompiledGraph> m_CompiledGraphs;
+        FRenderGraphCompileStats m_CompileStats;
+        RHI::FRHIBarrierStats m_BarrierStats;
+        FRenderGraphProfiler m_Profiler;
+
+        bool m_bAutoAsyncCompute = true;
+
+        bool m_bParallelRecording = false;
+        eastl::vector<FPassChunk> m_Chunks;
+        uint32_t m_GraphicsChunkCount = 0;
+        eastl::vector<eastl::unique_ptr<RHI::FRHICommandList>> m_SecondaryCmdLists[RHI::RHI_MAX_INFLIGHT_FRAMES];
     };
 
     class FRenderGraphEvent
@@ -44,8 +44,7 @@ namespace RG
             str.append(eastl::to_string(m_Version));
             if (m_Version > 0)
             {
-                eastl::vector<FDAGEdge*> incomingEdges;
-                m_Graph.GetIncomingEdges(this, incomingEdges);
+                FDAGEdgeRange incomingEdges = m_Graph.GetIncomingEdges(this);
                 assert(incomingEdges.size() == 1);
                 uint32_t subresource = ((FRenderGraphEdge*)incomingEdges[0])->GetSubresource();
                 str.append("\nsubresource:");
@@ -78,11 +77,17 @@ namespace RG
 
         uint32_t GetColorIndex() const { return m_ColorIndex; }
         RHI::ERHIRenderPassLoadOp GetLoadOp() const { return m_LoadOp; }
+        RHI::ERHIRenderPassStoreOp GetStoreOp() const { return m_StoreOp; }
         const float* GetClearColor() const { return m_ClearColor; }
+
+        // Compile 根据前后 pass 推导
+        void SetLoadOp(RHI::ERHIRenderPassLoadOp loadOp) { m_LoadOp = loadOp; }
+        void SetStoreOp(RHI::ERHIRenderPassStoreOp storeOp) { m_StoreOp = storeOp; }
     
     private:
         uint32_t m_ColorIndex;
         RHI::ERHIRenderPassLoadOp m_LoadOp;
+        RHI::ERHIRenderPassStoreOp m_StoreOp = RHI::ERHIRenderPassStoreOp::Store;
         float m_ClearColor[4] = {};
     };
 
@@ -101,13 +106,20 @@ namespace RG
 
         RHI::ERHIRenderPassLoadOp GetDepthLoadOp() const { return m_DepthLoadOp; }
         RHI::ERHIRenderPassLoadOp GetStencilLoadOp() const { return m_StencilLoadOp; }
+        RHI::ERHIRenderPassStoreOp GetDepthStoreOp() const { return m_DepthStoreOp; }
+        RHI::ERHIRenderPassStoreOp GetStencilStoreOp() const { return m_StencilStoreOp; }
         float GetClearDepth() const { return m_ClearDepth; }
         uint32_t GetClearStencil() const { return m_ClearStencil; }
         bool IsReadOnly() const { return m_bReadOnly; }
+
+        void SetLoadOp(RHI::ERHIRenderPassLoadOp depthLoadOp, RHI::ERHIRenderPassLoadOp stencilLoadOp) { m_DepthLoadOp = depthLoadOp; m_StencilLoadOp = stencilLoadOp; }
+        void SetStoreOp(RHI::ERHIRenderPassStoreOp depthStoreOp, RHI::ERHIRenderPassStoreOp stencilStoreOp) { m_DepthStoreOp = depthStoreOp; m_StencilStoreOp = stencilStoreOp; }
     
     private:
         RHI::ERHIRenderPassLoadOp m_DepthLoadOp;
         RHI::ERHIRenderPassLoadOp m_StencilLoadOp;
+        RHI::ERHIRenderPassStoreOp m_DepthStoreOp = RHI::ERHIRenderPassStoreOp::Store;
+        RHI::ERHIRenderPassStoreOp m_StencilStoreOp = RHI::ERHIRenderPassStoreOp::Store;
         float m_ClearDepth;
         uint32_t m_ClearStencil;
         bool m_bReadOnly;
@@ -132,6 +144,9 @@ namespace RG
         FRGBuilder builder(this, pass);
         setup(pass->GetData(), builder);
 
+        // pass 的边在 setup 中已经计入，这里补上类型、SkipCulling 和 DisableAsyncCompute
+        HashStructure(EStructureToken::Pass, ((uint64_t)type << 2) | (pass->IsAsyncComputeAllowed() ? 2 : 0) | (pass->IsTarget() ? 1 : 0));
+
         m_Passes.push_back(pass);
 
         return *pass;
@@ -163,6 +178,7 @@ namespace RG
     {
         auto resource = Allocate<Resource>(m_ResourceAllocator, name, desc);
         auto node = AllocatePOD<FRenderGraphResourceNode>(m_Graph, resource, 0);
+        HashStructure(EStructureToken::Create, HashDesc(desc));
 
         FRGHandle handle;
         handle.Index = (uint16_t)m_Resources.size();
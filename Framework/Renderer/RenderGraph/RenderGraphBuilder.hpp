@@ -22,6 +22,8 @@ namespace RG
         }
 
         void SkipCulling() { m_pPass->MakeTarget(); }
+        // pass 依赖图外的状态（例如渲染器持有的资源）时，不参与自动异步计算调度
+        void DisableAsyncCompute() { m_pPass->DisableAsyncCompute(); }
 
         template<typename Resource>
         FRGHandle Create(const typename Resource::Desc& desc, const eastl::string& name)
@@ -6,6 +6,91 @@
 
 namespace RG
 {
+    // VS/PS 的 SRV/UAV 与 CS 的布局相同，换成计算队列能接受的阶段
+    static RHI::ERHIAccessFlags ToComputeQueueAccess(RHI::ERHIAccessFlags access)
+    {
+        if (access & RHI::RHIAccessMaskSRV)
+        {
+            access = (access & ~RHI::RHIAccessMaskSRV) | RHI::RHIAccessComputeSRV;
+        }
+        if (access & RHI::RHIAccessMaskUAV)
+        {
+            access = (access & ~RHI::RHIAccessMaskUAV) | RHI::RHIAccessComputeUAV;
+        }
+        return access;
+    }
+
+    // 没有未被裁剪的 pass 写过的版本，内容未定义（导入的资源除外）
+    static bool IsContentUndefined(const FDirectedAcyclicGraph& graph, const FRenderGraphResourceNode* node)
+    {
+        if (node->GetResource()->IsImported())
+        {
+            return false;
+        }
+
+        FDAGEdgeRange edges = graph.GetIncomingEdges(node);
+        for (size_t i = 0; i < edges.size(); i++)
+        {
+            if (!graph.GetNode(edges[i]->GetFromNode())->IsCulled())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 读者以 Clear/DontCare 重新写入 attachment 时不需要之前的内容
+    static bool IsOverwritingAttachment(const FRenderGraphEdge* edge, bool bHasStencil)
+    {
+        if (edge->GetUsage() == RHI::RHIAccessRTV)
+        {
+            return static_cast<const FRGEdgeColorAttachment*>(edge)->GetLoadOp() != RHI::ERHIRenderPassLoadOp::Load;
+        }
+        if (edge->GetUsage() == RHI::RHIAccessDSV)
+        {
+            const FRGEdgeDepthAttachment* depthRT = static_cast<const FRGEdgeDepthAttachment*>(edge);
+            return depthRT->GetDepthLoadOp() != RHI::ERHIRenderPassLoadOp::Load &&
+                (!bHasStencil || depthRT->GetStencilLoadOp() != RHI::ERHIRenderPassLoadOp::Load);
+        }
+        return false;
+    }
+
+    // 之后没有 pass 读取这个版本，也不会被图外使用时不需要写回
+    static bool IsContentDead(const FDirectedAcyclicGraph& graph, const FRenderGraphResourceNode* node, RHI::FRHITexture* texture)
+    {
+        // 导入的资源（如历史帧）在图内没有读者时版本节点也会被裁剪，先于裁剪判断
+        const FRenderGraphResource* resource = node->GetResource();
+        if (resource->IsImported() || resource->IsExported())
+        {
+            return false;
+        }
+
+        if (node->IsCulled())
+        {
+            return true;
+        }
+
+        // 多个子资源时，后面的 pass 可能通过更新的版本读取其它子资源
+        const RHI::FRHITextureDesc& desc = texture->GetDesc();
+        const bool bSingleSubresource = desc.MipLevels == 1 && desc.ArraySize == 1;
+        const bool bHasStencil = RHI::IsStencilFormat(desc.Format);
+
+        FDAGEdgeRange edges = graph.GetOutgoingEdges(node);
+        for (size_t i = 0; i < edges.size(); i++)
+        {
+            const FRenderGraphEdge* edge = static_cast<const FRenderGraphEdge*>(edges[i]);
+            if (graph.GetNode(edge->GetToNode())->IsCulled())
+            {
+                continue;
+            }
+            if (!bSingleSubresource || !IsOverwritingAttachment(edge, bHasStencil))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
     FRenderGraphPassBase::FRenderGraphPassBase(const eastl::string &name, RenderPassType type, FDirectedAcyclicGraph &graph)
         : FDAGNode(graph)
     {
@@ -15,11 +100,7 @@ namespace RG
 
     void FRenderGraphPassBase::ResolveBarriers(const FDirectedAcyclicGraph &graph)
     {
-        eastl::vector<FDAGEdge*> edges;
-        eastl::vector<FDAGEdge*> resIncoming;
-        eastl::vector<FDAGEdge*> resOutgoing;
-
-        graph.GetIncomingEdges(this, edges);
+        FDAGEdgeRange edges = graph.GetIncomingEdges(this);
         for (size_t i = 0; i < edges.size(); i++)
         {
             FRenderGraphEdge *edge = static_cast<FRenderGraphEdge *>(edges[i]);
@@ -28,13 +109,14 @@ namespace RG
             FRenderGraphResourceNode* resourceNode = static_cast<FRenderGraphResourceNode*>(graph.GetNode(edge->GetFromNode()));
             FRenderGraphResource* resource = resourceNode->GetResource();
 
-            graph.GetIncomingEdges(resourceNode, resIncoming);
-            graph.GetOutgoingEdges(resourceNode, resOutgoing);
+            FDAGEdgeRange resIncoming = graph.GetIncomingEdges(resourceNode);
+            FDAGEdgeRange resOutgoing = graph.GetOutgoingEdges(resourceNode);
             assert(resIncoming.size() <= 1);
             assert(resOutgoing.size() >= 1);
 
             RHI::ERHIAccessFlags oldState = RHI::RHIAccessPresent;
             RHI::ERHIAccessFlags newState = edge->GetUsage();
+            DAGNodeID prevPass = UINT32_MAX;
 
             if (resOutgoing.size() > 1)
             {
@@ -45,6 +127,7 @@ namespace RG
                     if (subresource == edge->GetSubresource() && passID < this->GetID() && !graph.GetNode(passID)->IsCulled())
                     {
                         oldState = ((FRenderGraphEdge*)resOutgoing[i])->GetUsage();
+                        prevPass = passID;
                         break;
                     }
                 }
@@ -60,18 +143,27 @@ namespace RG
                 else
                 {
                     oldState = ((FRenderGraphEdge*)resIncoming[0])->GetUsage();
+                    prevPass = resIncoming[0]->GetFromNode();
                 }
             }
+
+            if (m_Type == RenderPassType::AsyncCompute)
+            {
+                // 之前图形队列上的访问已经由 fence 等待完成，barrier 只需处理布局
+                oldState = ToComputeQueueAccess(oldState);
+            }
             
             bool isAliased = false;
-            RHI::ERHIAccessFlags aliasState;
+            RHI::ERHIAccessFlags aliasState = 0;
 
             if (resource->IsOverlapping() && resource->GetFirstPassID() == this->GetID())
             {
-                RHI::FRHIResource* aliasedRes = resource->GetAliasedPrevResource(aliasState);
-                if (aliasedRes)
+                eastl::vector<FRGAliasedResource> aliasedResources;
+                resource->GetAliasedPrevResources(aliasedResources);
+                for (const FRGAliasedResource& aliasedRes : aliasedResources)
                 {
-                    m_AliasDiscardBarriers.push_back({ aliasedRes, aliasState, newState | RHI::RHIAccessDiscard });
+                    m_AliasDiscardBarriers.push_back({ aliasedRes.Resource, aliasedRes.LastUsedState, newState | RHI::RHIAccessDiscard });
+                    aliasState |= aliasedRes.LastUsedState;
                     isAliased = true;
                 }
             }
@@ -82,6 +174,7 @@ namespace RG
                 barrier.Subresource = edge->GetSubresource();
                 barrier.OldState = oldState;
                 barrier.NewState = newState;
+                barrier.PrevPass = isAliased ? UINT32_MAX : prevPass;
 
                 if (isAliased)
                 {
@@ -90,8 +183,11 @@ namespace RG
                 m_ResourceBarriers.push_back(barrier);
             }
         }
+    }
 
-        graph.GetOutgoingEdges(this, edges);
+    void FRenderGraphPassBase::ResolveAttachments(const FDirectedAcyclicGraph &graph)
+    {
+        FDAGEdgeRange edges = graph.GetOutgoingEdges(this);
         for (size_t i = 0; i < edges.size(); i++)
         {
             FRenderGraphEdge* edge = static_cast<FRenderGraphEdge*>(edges[i]);
@@ -111,17 +207,89 @@ namespace RG
                 m_pDepthRT = static_cast<FRGEdgeDepthAttachment*>(edge);
             }
         }
+
+        InferAttachmentOps(graph);
+    }
+
+    void FRenderGraphPassBase::InferAttachmentOps(const FDirectedAcyclicGraph &graph)
+    {
+        for (int i = 0; i < RHI::RHI_MAX_COLOR_ATTACHMENT_COUNT; i++)
+        {
+            FRGEdgeColorAttachment* colorRT = m_pColorRT[i];
+            if (colorRT == nullptr)
+            {
+                continue;
+            }
+
+            const FRenderGraphResourceNode* inputNode = GetAttachmentInputNode(graph, colorRT);
+            const FRenderGraphResourceNode* outputNode = static_cast<FRenderGraphResourceNode*>(graph.GetNode(colorRT->GetToNode()));
+            RHI::FRHITexture* texture = static_cast<FRGTexture*>(outputNode->GetResource())->GetTexture();
+
+            if (colorRT->GetLoadOp() == RHI::ERHIRenderPassLoadOp::Load && inputNode != nullptr && IsContentUndefined(graph, inputNode))
+            {
+                colorRT->SetLoadOp(RHI::ERHIRenderPassLoadOp::DontCare);
+            }
+            colorRT->SetStoreOp(IsContentDead(graph, outputNode, texture) ? RHI::ERHIRenderPassStoreOp::DontCare : RHI::ERHIRenderPassStoreOp::Store);
+        }
+
+        if (m_pDepthRT != nullptr)
+        {
+            const FRenderGraphResourceNode* inputNode = GetAttachmentInputNode(graph, m_pDepthRT);
+            const FRenderGraphResourceNode* outputNode = static_cast<FRenderGraphResourceNode*>(graph.GetNode(m_pDepthRT->GetToNode()));
+            RHI::FRHITexture* texture = static_cast<FRGTexture*>(outputNode->GetResource())->GetTexture();
+
+            RHI::ERHIRenderPassLoadOp depthLoadOp = m_pDepthRT->GetDepthLoadOp();
+            RHI::ERHIRenderPassLoadOp stencilLoadOp = m_pDepthRT->GetStencilLoadOp();
+            if (inputNode != nullptr && IsContentUndefined(graph, inputNode))
+            {
+                if (depthLoadOp == RHI::ERHIRenderPassLoadOp::Load) depthLoadOp = RHI::ERHIRenderPassLoadOp::DontCare;
+                if (stencilLoadOp == RHI::ERHIRenderPassLoadOp::Load) stencilLoadOp = RHI::ERHIRenderPassLoadOp::DontCare;
+            }
+
+            RHI::ERHIRenderPassStoreOp storeOp = IsContentDead(graph, outputNode, texture) ? RHI::ERHIRenderPassStoreOp::DontCare : RHI::ERHIRenderPassStoreOp::Store;
+            RHI::ERHIRenderPassStoreOp stencilStoreOp = storeOp;
+
+            // 没有模板的格式（如 GBuffer 的 D32F）不读写模板
+            if (!RHI::IsStencilFormat(texture->GetDesc().Format))
+            {
+                stencilLoadOp = RHI::ERHIRenderPassLoadOp::DontCare;
+                stencilStoreOp = RHI::ERHIRenderPassStoreOp::DontCare;
+            }
+
+            m_pDepthRT->SetLoadOp(depthLoadOp, stencilLoadOp);
+            m_pDepthRT->SetStoreOp(storeOp, stencilStoreOp);
+        }
+    }
+
+    const FRenderGraphResourceNode *FRenderGraphPassBase::GetAttachmentInputNode(const FDirectedAcyclicGraph &graph, const FRenderGraphEdge *outputEdge) const
+    {
+        // WriteColor/WriteDepth 同时建立 输入版本 -> pass 的同类边
+        FDAGEdgeRange edges = graph.GetIncomingEdges(this);
+        for (size_t i = 0; i < edges.size(); i++)
+        {
+            const FRenderGraphEdge* edge = static_cast<const FRenderGraphEdge*>(edges[i]);
+            if (edge->GetUsage() != outputEdge->GetUsage() || edge->GetSubresource() != outputEdge->GetSubresource())
+            {
+                continue;
+            }
+
+            const FRenderGraphResourceNode* node = static_cast<const FRenderGraphResourceNode*>(graph.GetNode(edge->GetFromNode()));
+            const FRenderGraphResourceNode* outputNode = static_cast<const FRenderGraphResourceNode*>(graph.GetNode(outputEdge->GetToNode()));
+            if (node->GetResource() == outputNode->GetResource())
+            {
+                return node;
+            }
+        }
+        return nullptr;
     }
 
     void FRenderGraphPassBase::ResolveAsyncComputeBarrier(const FDirectedAcyclicGraph &graph, FRenderGraphAsyncResolveContext &context)
     {
         if (m_Type == RenderPassType::AsyncCompute)
         {
-            eastl::vector<FDAGEdge*> edges;
-            eastl::vector<FDAGEdge*> resIncoming;
-            eastl::vector<FDAGEdge*> resOutgoing;
+            context.ComputeQueuePasses.push_back(GetID());
 
-            graph.GetIncomingEdges(this, edges);
+            FDAGEdgeRange edges = graph.GetIncomingEdges(this);
             for (size_t i = 0; i < edges.size(); i++)
             {
                 FRenderGraphEdge* edge = static_cast<FRenderGraphEdge*>(edges[i]);
@@ -129,7 +297,7 @@ namespace RG
 
                 FRenderGraphResourceNode* resourceNode = static_cast<FRenderGraphResourceNode*>(graph.GetNode(edge->GetFromNode()));
 
-                graph.GetIncomingEdges(resourceNode, resIncoming);
+                FDAGEdgeRange resIncoming = graph.GetIncomingEdges(resourceNode);
                 assert(resIncoming.size() <= 1);
 
                 if (!resIncoming.empty())
@@ -142,7 +310,7 @@ namespace RG
                 }
             }
 
-            graph.GetOutgoingEdges(this, edges);
+            edges = graph.GetOutgoingEdges(this);
             for (size_t i = 0; i < edges.size(); i++)
             {
                 FRenderGraphEdge* edge = static_cast<FRenderGraphEdge*>(edges[i]);
@@ -150,7 +318,7 @@ namespace RG
 
                 FRenderGraphResourceNode* resourceNode = static_cast<FRenderGraphResourceNode*>(graph.GetNode(edge->GetToNode()));
 
-                graph.GetOutgoingEdges(resourceNode, resOutgoing);
+                FDAGEdgeRange resOutgoing = graph.GetOutgoingEdges(resourceNode);
 
                 for (size_t j = 0; j < resOutgoing.size(); j++)
                 {
@@ -213,70 +381,147 @@ namespace RG
         }
     }
 
+    eastl::string FRenderGraphPassBase::GetGraphVizName() const
+    {
+        eastl::string name = m_Name;
+        if (m_Type == RenderPassType::AsyncCompute)
+        {
+            name.append(m_bAutoAsyncCompute ? "\nqueue:async compute (auto)" : "\nqueue:async compute");
+        }
+        if (HasWait())
+        {
+            name.append("\nwait:");
+            name.append(eastl::to_string(m_WaitValue));
+        }
+        if (HasSignal())
+        {
+            name.append("\nsignal:");
+            name.append(eastl::to_string(m_SignalValue));
+        }
+        return name;
+    }
+
+    const char* FRenderGraphPassBase::GetGraphVizColor() const
+    {
+        if (m_Type == RenderPassType::AsyncCompute)
+        {
+            return !IsCulled() ? "mediumorchid1" : "mediumorchid4";
+        }
+        return !IsCulled() ? "darkgoldenrod1" : "darkgoldenrod4";
+    }
+
     void FRenderGraphPassBase::Execute(const FRenderGraph &graph, FRenderGraphPassExecuteContext &context)
     {
         RHI::FRHICommandList* pCmdList = m_Type == RenderPassType::AsyncCompute ? context.ComputeCmdList : context.GraphicsCmdList;
 
-        if (m_WaitValue != -1)
+        ExecuteWait(context);
+
+        BeginEvents(context.GraphicsCmdList);
+        Record(graph, pCmdList);
+        EndEvents(context.GraphicsCmdList);
+
+        ExecuteSignal(context);
+    }
+
+    void FRenderGraphPassBase::ExecuteWait(FRenderGraphPassExecuteContext &context)
+    {
+        if (m_WaitValue == -1)
+        {
+            return;
+        }
+
+        RHI::FRHICommandList* pCmdList = m_Type == RenderPassType::AsyncCompute ? context.ComputeCmdList : context.GraphicsCmdList;
+
+        pCmdList->End();
+        pCmdList->Submit();
+        
+        pCmdList->Begin();
+        if (context.pRenderer != nullptr)
         {
-            pCmdList->End();
-            pCmdList->Submit();
-            
-            pCmdList->Begin();
             context.pRenderer->SetupGlobalConstants(pCmdList);
+        }
 
-            if (m_Type == RenderPassType::AsyncCompute)
-            {
-                pCmdList->Wait(context.GraphicsFence, context.InitialGraphicsFenceValue + m_WaitValue);
-            }
-            else
-            {
-                pCmdList->Wait(context.ComputeFence, context.InitialComputeFenceValue + m_WaitValue);
-            }
+        if (m_Type == RenderPassType::AsyncCompute)
+        {
+            pCmdList->Wait(context.GraphicsFence, context.InitialGraphicsFenceValue + m_WaitValue);
+        }
+        else
+        {
+            pCmdList->Wait(context.ComputeFence, context.InitialComputeFenceValue + m_WaitValue);
         }
+    }
 
-        for (size_t i = 0; i < m_EventNames.size(); i++)
+    void FRenderGraphPassBase::ExecuteSignal(FRenderGraphPassExecuteContext &context)
+    {
+        if (m_SignalValue == -1)
+        {
+            return;
+        }
+
+        RHI::FRHICommandList* pCmdList = m_Type == RenderPassType::AsyncCompute ? context.ComputeCmdList : context.GraphicsCmdList;
+
+        pCmdList->End();
+        if (m_Type == RenderPassType::AsyncCompute)
         {
-            context.GraphicsCmdList->BeginEvent(m_EventNames[i]);
-            // TODO : Profiler
+            pCmdList->Signal(context.ComputeFence, context.InitialComputeFenceValue + m_SignalValue);
+            context.LastSignalComputeFenceValue = context.InitialComputeFenceValue + m_SignalValue;
         }
+        else
+        {
+            pCmdList->Signal(context.GraphicsFence, context.InitialGraphicsFenceValue + m_SignalValue);
+            context.LastSignalGraphicsFenceValue = context.InitialGraphicsFenceValue + m_SignalValue;
+        }
+        pCmdList->Submit();
+
+        pCmdList->Begin();
+        if (context.pRenderer != nullptr)
+        {
+            context.pRenderer->SetupGlobalConstants(pCmdList);
+        }
+    }
+
+    void FRenderGraphPassBase::Record(const FRenderGraph &graph, RHI::FRHICommandList *pCmdList)
+    {
         if (!IsCulled())
         {
             GPU_EVENT_DEBUG(pCmdList, m_Name);
 
+            if (m_ProfileScope != UINT32_MAX)
+            {
+                graph.GetProfiler().BeginScope(m_ProfileScope, pCmdList);
+            }
+
             Begin(graph, pCmdList);
             ExecuteImpl(pCmdList);
             End(pCmdList);
+
+            if (m_ProfileScope != UINT32_MAX)
+            {
+                graph.GetProfiler().EndScope(m_ProfileScope, pCmdList);
+            }
         }
+    }
 
-        for (uint32_t i = 0; i < m_EndEventNum; i++)
+    void FRenderGraphPassBase::BeginEvents(RHI::FRHICommandList *pCmdList) const
+    {
+        for (size_t i = 0; i < m_EventNames.size(); i++)
         {
-            context.GraphicsCmdList->EndEvent();
-            // TODO : Profiler
+            pCmdList->BeginEvent(m_EventNames[i]);
         }
+    }
 
-        if (m_SignalValue != -1)
+    void FRenderGraphPassBase::EndEvents(RHI::FRHICommandList *pCmdList) const
+    {
+        for (uint32_t i = 0; i < m_EndEventNum; i++)
         {
-            pCmdList->End();
-            if (m_Type == RenderPassType::AsyncCompute)
-            {
-                pCmdList->Signal(context.ComputeFence, context.InitialComputeFenceValue + m_SignalValue);
-                context.LastSignalComputeFenceValue = context.InitialComputeFenceValue + m_SignalValue;
-            }
-            else
-            {
-                pCmdList->Signal(context.GraphicsFence, context.InitialGraphicsFenceValue + m_SignalValue);
-                context.LastSignalGraphicsFenceValue = context.InitialGraphicsFenceValue + m_SignalValue;
-            }
-            pCmdList->Submit();
-
-            pCmdList->Begin();
-            context.pRenderer->SetupGlobalConstants(pCmdList);
+            pCmdList->EndEvent();
         }
     }
 
     void FRenderGraphPassBase::Begin(const FRenderGraph &graph, RHI::FRHICommandList *pCmdList)
     {
+        EndSplitBarriers(pCmdList);
+
         for (size_t i = 0; i < m_AliasDiscardBarriers.size(); i++)
         {
             const FAliasDiscardBarrier& barrier = m_AliasDiscardBarriers[i];
@@ -294,8 +539,13 @@ namespace RG
         for (size_t i = 0; i < m_ResourceBarriers.size(); i++)
         {
             const FResourceBarrier& barrier = m_ResourceBarriers[i];
-            barrier.Resource->Barrier(pCmdList, barrier.Subresource, barrier.OldState, barrier.NewState);
+            if (!barrier.bSplit)
+            {
+                barrier.Resource->Barrier(pCmdList, barrier.Subresource, barrier.OldState, barrier.NewState);
+            }
         }
+        // 本 pass 的所有转换合成一次提交，不与 pass 内部自己的 barrier 混在一起
+        pCmdList->FlushBarriers();
 
         if (HasRHIRenderPass())
         {
@@ -315,7 +565,7 @@ namespace RG
                     rpDesc.Color[i].MipSlice = mip;
                     rpDesc.Color[i].ArraySlice = slice;
                     rpDesc.Color[i].LoadOp = m_pColorRT[i]->GetLoadOp();
-                    rpDesc.Color[i].StoreOp = node->IsCulled() ? RHI::ERHIRenderPassStoreOp::DontCare : RHI::ERHIRenderPassStoreOp::Store;
+                    rpDesc.Color[i].StoreOp = m_pColorRT[i]->GetStoreOp();
                     memcpy(rpDesc.Color[i].ClearColor, m_pColorRT[i]->GetClearColor(), sizeof(float) * 4);
                 }
             }
@@ -331,8 +581,8 @@ namespace RG
                 rpDesc.Depth.Texture = static_cast<FRGTexture*>(node->GetResource())->GetTexture();
                 rpDesc.Depth.DepthLoadOp = m_pDepthRT->GetDepthLoadOp();
                 rpDesc.Depth.StencilLoadOp = m_pDepthRT->GetStencilLoadOp();
-                rpDesc.Depth.DepthStoreOp = node->IsCulled() ? RHI::ERHIRenderPassStoreOp::DontCare : RHI::ERHIRenderPassStoreOp::Store;
-                rpDesc.Depth.StencilStoreOp = node->IsCulled() ? RHI::ERHIRenderPassStoreOp::DontCare : RHI::ERHIRenderPassStoreOp::Store;
+                rpDesc.Depth.DepthStoreOp = m_pDepthRT->GetDepthStoreOp();
+                rpDesc.Depth.StencilStoreOp = m_pDepthRT->GetStencilStoreOp();
                 rpDesc.Depth.ClearDepth = m_pDepthRT->GetClearDepth();
                 rpDesc.Depth.ClearStencil = m_pDepthRT->GetClearStencil();
                 rpDesc.Depth.MipSlice = mip;
@@ -349,6 +599,62 @@ namespace RG
         {
             pCmdList->EndRenderPass();
         }
+
+        BeginSplitBarriers(pCmdList);
+    }
+
+    static uint64_t GetSplitBarrierID(DAGNodeID beginPass, DAGNodeID endPass)
+    {
+        return ((uint64_t)beginPass << 32) | endPass;
+    }
+
+    void FRenderGraphPassBase::BeginSplitBarriers(RHI::FRHICommandList *pCmdList) const
+    {
+        if (m_SplitBeginBarriers.empty())
+        {
+            return;
+        }
+
+        // 不能把 pass 内部残留的 barrier 带进拆分 barrier
+        pCmdList->FlushBarriers();
+
+        for (size_t i = 0; i < m_SplitBeginBarriers.size(); i++)
+        {
+            const FSplitBarrier& barrier = m_SplitBeginBarriers[i];
+            barrier.Resource->Barrier(pCmdList, barrier.Subresource, barrier.OldState, barrier.NewState);
+
+            if (i + 1 == m_SplitBeginBarriers.size() || m_SplitBeginBarriers[i + 1].EndPass != barrier.EndPass)
+            {
+                pCmdList->BeginSplitBarriers(GetSplitBarrierID(GetID(), barrier.EndPass));
+            }
+        }
+    }
+
+    void FRenderGraphPassBase::EndSplitBarriers(RHI::FRHICommandList *pCmdList) const
+    {
+        // 拆分 barrier 排在 m_ResourceBarriers 最前面，按 PrevPass 分组，组内顺序与开始时一致
+        size_t count = 0;
+        while (count < m_ResourceBarriers.size() && m_ResourceBarriers[count].bSplit)
+        {
+            count++;
+        }
+        if (count == 0)
+        {
+            return;
+        }
+
+        pCmdList->FlushBarriers();
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const FResourceBarrier& barrier = m_ResourceBarriers[i];
+            barrier.Resource->Barrier(pCmdList, barrier.Subresource, barrier.OldState, barrier.NewState);
+
+            if (i + 1 == count || m_ResourceBarriers[i + 1].PrevPass != barrier.PrevPass)
+            {
+                pCmdList->EndSplitBarriers(GetSplitBarrierID(barrier.PrevPass, GetID()));
+            }
+        }
     }
 
     bool FRenderGraphPassBase::HasRHIRenderPass() const
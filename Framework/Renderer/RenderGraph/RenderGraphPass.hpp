@@ -14,6 +14,8 @@ namespace RG
 {
     class FRenderGraph;
     class FRenderGraphResource;
+    class FRenderGraphResourceNode;
+    class FRenderGraphEdge;
     class FRGEdgeColorAttachment;
     class FRGEdgeDepthAttachment;
 
@@ -51,34 +53,63 @@ namespace RG
 
     class FRenderGraphPassBase : public FDAGNode
     {
+        // Compile 命中缓存时由 FRenderGraph 直接恢复同步值和 barrier 列表
+        friend class FRenderGraph;
+
     public:
         FRenderGraphPassBase(const eastl::string& name, RenderPassType type, FDirectedAcyclicGraph& graph);
         
         void ResolveBarriers(const FDirectedAcyclicGraph& graph);
+        // 记录本帧的 color/depth attachment 边并推导 load/store op，不论 Compile 是否命中缓存都要调用
+        void ResolveAttachments(const FDirectedAcyclicGraph& graph);
         void ResolveAsyncComputeBarrier(const FDirectedAcyclicGraph& graph, FRenderGraphAsyncResolveContext& context);
         void Execute(const FRenderGraph& graph, FRenderGraphPassExecuteContext& context);
 
+        // 以下拆分自 Execute，供并行录制使用：Wait/Signal 只能在主线程调用，Record 可在 worker 上录制到二级命令列表
+        void ExecuteWait(FRenderGraphPassExecuteContext& context);
+        void ExecuteSignal(FRenderGraphPassExecuteContext& context);
+        void Record(const FRenderGraph& graph, RHI::FRHICommandList* pCmdList);
+        void BeginEvents(RHI::FRHICommandList* pCmdList) const;
+        void EndEvents(RHI::FRHICommandList* pCmdList) const;
+
         void BeginEvent(const eastl::string& name) { m_EventNames.push_back(name); }
         void EndEvent() { m_EndEventNum++; }
 
         RenderPassType GetType() const { return m_Type; }
+        // 由 Compile 自动调度到异步计算队列
+        bool IsAutoAsyncCompute() const { return m_bAutoAsyncCompute; }
+        bool IsAsyncComputeAllowed() const { return m_bAllowAsyncCompute; }
+        void DisableAsyncCompute() { m_bAllowAsyncCompute = false; }
         DAGNodeID GetWaitGraphicsPass() const { return m_WaitGraphicsPass; }
         DAGNodeID GetSignalGraphicsPass() const { return m_SignalGraphicsPass; }
+        bool HasWait() const { return m_WaitValue != -1; }
+        bool HasSignal() const { return m_SignalValue != -1; }
+        uint64_t GetWaitValue() const { return m_WaitValue; }
+        uint64_t GetSignalValue() const { return m_SignalValue; }
+        const eastl::vector<eastl::string>& GetEventNames() const { return m_EventNames; }
+        uint32_t GetEndEventNum() const { return m_EndEventNum; }
 
-        virtual eastl::string GetGraphVizName() const override { return m_Name; }
-        virtual const char* GetGraphVizColor() const override { return !IsCulled() ? "darkgoldenrod1" : "darkgoldenrod4"; }
+        virtual eastl::string GetGraphVizName() const override;
+        virtual const char* GetGraphVizColor() const override;
 
     private:
         void Begin(const FRenderGraph& graph, RHI::FRHICommandList* pCmdList);
         void End(RHI::FRHICommandList* pCmdList);
 
         bool HasRHIRenderPass() const;
+        // 首个写入者不 Load，之后没有读者时不 Store
+        void InferAttachmentOps(const FDirectedAcyclicGraph& graph);
+        const FRenderGraphResourceNode* GetAttachmentInputNode(const FDirectedAcyclicGraph& graph, const FRenderGraphEdge* outputEdge) const;
+        void BeginSplitBarriers(RHI::FRHICommandList* pCmdList) const;
+        void EndSplitBarriers(RHI::FRHICommandList* pCmdList) const;
 
         virtual void ExecuteImpl(RHI::FRHICommandList* pCmdList) = 0;
     
     protected:
         eastl::string m_Name;
         RenderPassType m_Type;
+        bool m_bAllowAsyncCompute = true;
+        bool m_bAutoAsyncCompute = false;
 
         eastl::vector<eastl::string> m_EventNames;
         uint32_t m_EndEventNum = 0;
@@ -89,9 +120,24 @@ namespace RG
             uint32_t Subresource;
             RHI::ERHIAccessFlags OldState;
             RHI::ERHIAccessFlags NewState;
+            // OldState 来自哪个 pass，来自初始状态或别名时为 UINT32_MAX
+            DAGNodeID PrevPass = UINT32_MAX;
+            // 前半段已在 PrevPass 结束时提交，这里只等待
+            bool bSplit = false;
         };
         eastl::vector<FResourceBarrier> m_ResourceBarriers;
 
+        // 拆分 barrier 的前半段，本 pass 结束时按 EndPass 分组提交
+        struct FSplitBarrier
+        {
+            FRenderGraphResource* Resource;
+            uint32_t Subresource;
+            RHI::ERHIAccessFlags OldState;
+            RHI::ERHIAccessFlags NewState;
+            DAGNodeID EndPass;
+        };
+        eastl::vector<FSplitBarrier> m_SplitBeginBarriers;
+
         struct FAliasDiscardBarrier
         {
             RHI::FRHIResource* Resource;
@@ -108,6 +154,9 @@ namespace RG
 
         uint64_t m_SignalValue = -1;
         uint64_t m_WaitValue = -1;
+
+        // 本帧在 profiler 中的计时序号，未开启或不计时为 UINT32_MAX
+        uint32_t m_ProfileScope = UINT32_MAX;
     };
 
     template<class T>
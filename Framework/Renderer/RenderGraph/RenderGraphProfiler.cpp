@@ -0,0 +1,253 @@
+#include "RenderGraphProfiler.hpp"
+#include "Utilities/Log.hpp"
+
+#include <fstream>
+
+namespace RG
+{
+    // 60 fps 下约 4 秒
+    static const uint32_t RG_PROFILER_HISTORY_FRAMES = 240;
+    static const uint32_t RG_PROFILER_MIN_SCOPES = 64;
+    // 每个 scope 两个查询，每个查询解析为时间戳和可用性
+    static const uint32_t RG_PROFILER_RESULTS_PER_SCOPE = 4;
+
+    static bool IsScopeAvailable(const uint64_t* pResults)
+    {
+        return pResults[1] != 0 && pResults[3] != 0 && pResults[2] >= pResults[0];
+    }
+
+    FRenderGraphProfiler::FRenderGraphProfiler(RHI::FRHIDevice *pDevice)
+        : m_pDevice(pDevice)
+    {
+    }
+
+    void FRenderGraphProfiler::BeginFrame(RHI::FRHICommandList *pGraphicsCmdList, RHI::FRHICommandList *pComputeCmdList, const eastl::vector<eastl::pair<eastl::string, RHI::ERHICommandQueueType>> &scopes)
+    {
+        const uint64_t frameID = m_pDevice->GetFrameID();
+        FFrameSlot& slot = m_Slots[frameID % RHI::RHI_MAX_INFLIGHT_FRAMES];
+
+        // BeginFrame 已经等待过这一帧的 fence，上一轮的结果已经写完
+        Readback(slot);
+        m_pCurrentSlot = nullptr;
+
+        if (!m_bEnabled || scopes.empty() || !EnsureCapacity(slot, (uint32_t)scopes.size()))
+        {
+            return;
+        }
+
+        slot.FrameID = frameID;
+        slot.Scopes.clear();
+        slot.GraphicsScopeCount = 0;
+        slot.ComputeScopeCount = 0;
+        for (size_t i = 0; i < scopes.size(); i++)
+        {
+            FScope scope;
+            scope.Name = scopes[i].first;
+            scope.Queue = scopes[i].second;
+            scope.Index = scope.Queue == RHI::ERHICommandQueueType::Compute ? slot.ComputeScopeCount++ : slot.GraphicsScopeCount++;
+            slot.Scopes.push_back(scope);
+        }
+
+        // 查询只能在写入它的队列上重置
+        if (slot.GraphicsScopeCount > 0)
+        {
+            pGraphicsCmdList->ResetQueries(slot.GraphicsPool.get(), 0, slot.GraphicsScopeCount * 2);
+        }
+        if (slot.ComputeScopeCount > 0)
+        {
+            pComputeCmdList->ResetQueries(slot.ComputePool.get(), 0, slot.ComputeScopeCount * 2);
+        }
+        m_pCurrentSlot = &slot;
+    }
+
+    void FRenderGraphProfiler::BeginScope(uint32_t scope, RHI::FRHICommandList *pCmdList) const
+    {
+        if (m_pCurrentSlot != nullptr)
+        {
+            const FScope& s = m_pCurrentSlot->Scopes[scope];
+            pCmdList->WriteTimestamp(GetQueryPool(s), s.Index * 2);
+        }
+    }
+
+    void FRenderGraphProfiler::EndScope(uint32_t scope, RHI::FRHICommandList *pCmdList) const
+    {
+        if (m_pCurrentSlot != nullptr)
+        {
+            const FScope& s = m_pCurrentSlot->Scopes[scope];
+            pCmdList->WriteTimestamp(GetQueryPool(s), s.Index * 2 + 1);
+        }
+    }
+
+    void FRenderGraphProfiler::EndFrame(RHI::FRHICommandList *pGraphicsCmdList)
+    {
+        if (m_pCurrentSlot == nullptr)
+        {
+            return;
+        }
+
+        FFrameSlot& slot = *m_pCurrentSlot;
+        if (slot.GraphicsScopeCount > 0)
+        {
+            pGraphicsCmdList->ResolveQueries(slot.GraphicsPool.get(), 0, slot.GraphicsScopeCount * 2, slot.ReadbackBuffer.get(), 0);
+        }
+        if (slot.ComputeScopeCount > 0)
+        {
+            pGraphicsCmdList->ResolveQueries(slot.ComputePool.get(), 0, slot.ComputeScopeCount * 2, slot.ReadbackBuffer.get(), slot.Capacity * RG_PROFILER_RESULTS_PER_SCOPE * sizeof(uint64_t));
+        }
+        slot.bPending = true;
+        m_pCurrentSlot = nullptr;
+    }
+
+    eastl::vector<FRenderGraphFrameTiming> FRenderGraphProfiler::GetHistory() const
+    {
+        std::lock_guard<std::mutex> lock(m_HistoryMutex);
+        return eastl::vector<FRenderGraphFrameTiming>(m_History.begin(), m_History.end());
+    }
+
+    bool FRenderGraphProfiler::GetLatestFrame(FRenderGraphFrameTiming &frame) const
+    {
+        std::lock_guard<std::mutex> lock(m_HistoryMutex);
+        if (m_History.empty())
+        {
+            return false;
+        }
+        frame = m_History.back();
+        return true;
+    }
+
+    void FRenderGraphProfiler::ClearHistory()
+    {
+        std::lock_guard<std::mutex> lock(m_HistoryMutex);
+        m_History.clear();
+    }
+
+    bool FRenderGraphProfiler::ExportCSV(const eastl::string &path) const
+    {
+        eastl::vector<FRenderGraphFrameTiming> history = GetHistory();
+
+        std::ofstream file(path.c_str());
+        if (!file.is_open())
+        {
+            VTNA_LOG_ERROR("[RenderGraphProfiler] Failed to open {}", path.c_str());
+            return false;
+        }
+
+        file << "Frame,Pass,Queue,BeginMs,EndMs,DurationMs\n";
+        for (const FRenderGraphFrameTiming& frame : history)
+        {
+            for (const FRenderGraphPassTiming& pass : frame.Passes)
+            {
+                file << frame.FrameID << ",\"" << pass.Name.c_str() << "\","
+                     << (pass.Queue == RHI::ERHICommandQueueType::Compute ? "Compute" : "Graphics") << ","
+                     << pass.BeginMs << "," << pass.EndMs << "," << pass.GetDurationMs() << "\n";
+            }
+        }
+        return true;
+    }
+
+    bool FRenderGraphProfiler::EnsureCapacity(FFrameSlot &slot, uint32_t scopeCount)
+    {
+        if (scopeCount <= slot.Capacity)
+        {
+            return true;
+        }
+
+        // 旧的 pool 交给延迟删除，这个槽位的命令已经执行完
+        uint32_t capacity = eastl::max(eastl::max(scopeCount, slot.Capacity * 2), RG_PROFILER_MIN_SCOPES);
+        slot.Capacity = 0;
+
+        RHI::FRHIQueryPoolDesc poolDesc;
+        poolDesc.Type = RHI::ERHIQueryType::Timestamp;
+        poolDesc.QueryCount = capacity * 2;
+        slot.GraphicsPool.reset(m_pDevice->CreateQueryPool(poolDesc, "RenderGraphProfiler::GraphicsQueryPool"));
+        slot.ComputePool.reset(m_pDevice->CreateQueryPool(poolDesc, "RenderGraphProfiler::ComputeQueryPool"));
+
+        // 前半段存图形队列的结果，后半段存计算队列的结果
+        RHI::FRHIBufferDesc bufferDesc;
+        bufferDesc.Stride = sizeof(uint64_t);
+        bufferDesc.Size = capacity * RG_PROFILER_RESULTS_PER_SCOPE * 2 * sizeof(uint64_t);
+        bufferDesc.MemoryType = RHI::ERHIMemoryType::GPUToCPU;
+        slot.ReadbackBuffer.reset(m_pDevice->CreateBuffer(bufferDesc, "RenderGraphProfiler::ReadbackBuffer"));
+
+        if (slot.GraphicsPool == nullptr || slot.ComputePool == nullptr || slot.ReadbackBuffer == nullptr)
+        {
+            VTNA_LOG_ERROR("[RenderGraphProfiler] Failed to create query resources for {} scopes", capacity);
+            slot.GraphicsPool.reset();
+            slot.ComputePool.reset();
+            slot.ReadbackBuffer.reset();
+            return false;
+        }
+
+        slot.Capacity = capacity;
+        return true;
+    }
+
+    void FRenderGraphProfiler::Readback(FFrameSlot &slot)
+    {
+        if (!slot.bPending)
+        {
+            return;
+        }
+        slot.bPending = false;
+
+        const uint64_t* pData = (const uint64_t*)slot.ReadbackBuffer->GetCPUAddress();
+        if (pData == nullptr)
+        {
+            return;
+        }
+
+        // 各 pass 的时间相对于本帧最早的时间戳
+        const double msPerTick = 1000.0 / (double)m_pDevice->GetTimestampFrequency();
+        const uint64_t* pComputeData = pData + slot.Capacity * RG_PROFILER_RESULTS_PER_SCOPE;
+
+        uint64_t frameBegin = UINT64_MAX;
+        uint64_t frameEnd = 0;
+        for (const FScope& scope : slot.Scopes)
+        {
+            const uint64_t* pResults = (scope.Queue == RHI::ERHICommandQueueType::Compute ? pComputeData : pData) + scope.Index * RG_PROFILER_RESULTS_PER_SCOPE;
+            if (IsScopeAvailable(pResults))
+            {
+                frameBegin = eastl::min(frameBegin, pResults[0]);
+                frameEnd = eastl::max(frameEnd, pResults[2]);
+            }
+        }
+        if (frameBegin == UINT64_MAX)
+        {
+            return;
+        }
+
+        FRenderGraphFrameTiming frame;
+        frame.FrameID = slot.FrameID;
+        frame.TotalMs = (double)(frameEnd - frameBegin) * msPerTick;
+        frame.Passes.reserve(slot.Scopes.size());
+
+        for (const FScope& scope : slot.Scopes)
+        {
+            const uint64_t* pResults = (scope.Queue == RHI::ERHICommandQueueType::Compute ? pComputeData : pData) + scope.Index * RG_PROFILER_RESULTS_PER_SCOPE;
+            // 开始或结束的查询没有写入，丢弃这样的 pass
+            if (!IsScopeAvailable(pResults))
+            {
+                continue;
+            }
+
+            FRenderGraphPassTiming timing;
+            timing.Name = scope.Name;
+            timing.Queue = scope.Queue;
+            timing.BeginMs = (double)(pResults[0] - frameBegin) * msPerTick;
+            timing.EndMs = (double)(pResults[2] - frameBegin) * msPerTick;
+            frame.Passes.push_back(timing);
+        }
+
+        std::lock_guard<std::mutex> lock(m_HistoryMutex);
+        m_History.push_back(frame);
+        while (m_History.size() > RG_PROFILER_HISTORY_FRAMES)
+        {
+            m_History.pop_front();
+        }
+    }
+
+    RHI::FRHIQueryPool *FRenderGraphProfiler::GetQueryPool(const FScope &scope) const
+    {
+        return scope.Queue == RHI::ERHICommandQueueType::Compute ? m_pCurrentSlot->ComputePool.get() : m_pCurrentSlot->GraphicsPool.get();
+    }
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "RHI/RHI.hpp"
+
+#include <EASTL/deque.h>
+#include <EASTL/unique_ptr.h>
+#include <atomic>
+#include <mutex>
+
+namespace RG
+{
+    struct FRenderGraphPassTiming
+    {
+        eastl::string Name;
+        RHI::ERHICommandQueueType Queue = RHI::ERHICommandQueueType::Graphics;
+        // 相对于本帧最早的时间戳
+        double BeginMs = 0.0;
+        double EndMs = 0.0;
+
+        double GetDurationMs() const { return EndMs - BeginMs; }
+    };
+
+    struct FRenderGraphFrameTiming
+    {
+        uint64_t FrameID = 0;
+        double TotalMs = 0.0;
+        eastl::vector<FRenderGraphPassTiming> Passes;
+    };
+
+    // 每个 pass 前后写入时间戳，结果在同一个在途帧槽位再次使用时读回，不会阻塞 CPU
+    class FRenderGraphProfiler
+    {
+    public:
+        FRenderGraphProfiler(RHI::FRHIDevice* pDevice);
+
+        void SetEnabled(bool enable) { m_bEnabled = enable; }
+        bool IsEnabled() const { return m_bEnabled; }
+        bool IsQueueSupported(RHI::ERHICommandQueueType queue) const { return queue != RHI::ERHICommandQueueType::Compute || m_pDevice->IsComputeTimestampSupported(); }
+
+        // 读回该槽位上一轮的结果，并在各队列的命令列表上重置本帧的查询
+        void BeginFrame(RHI::FRHICommandList* pGraphicsCmdList, RHI::FRHICommandList* pComputeCmdList, const eastl::vector<eastl::pair<eastl::string, RHI::ERHICommandQueueType>>& scopes);
+        void BeginScope(uint32_t scope, RHI::FRHICommandList* pCmdList) const;
+        void EndScope(uint32_t scope, RHI::FRHICommandList* pCmdList) const;
+        // 计算队列的结果也在图形队列上解析，此时图形队列已经等待过计算队列
+        void EndFrame(RHI::FRHICommandList* pGraphicsCmdList);
+
+        // 返回拷贝，编辑器在模拟线程上读取
+        eastl::vector<FRenderGraphFrameTiming> GetHistory() const;
+        bool GetLatestFrame(FRenderGraphFrameTiming& frame) const;
+        void ClearHistory();
+        bool ExportCSV(const eastl::string& path) const;
+
+    private:
+        struct FScope
+        {
+            eastl::string Name;
+            RHI::ERHICommandQueueType Queue;
+            // 在所属队列的 query pool 中的序号，开始和结束各占一个查询
+            uint32_t Index;
+        };
+
+        struct FFrameSlot
+        {
+            eastl::unique_ptr<RHI::FRHIQueryPool> GraphicsPool;
+            eastl::unique_ptr<RHI::FRHIQueryPool> ComputePool;
+            eastl::unique_ptr<RHI::FRHIBuffer> ReadbackBuffer;
+            uint32_t Capacity = 0;
+
+            uint64_t FrameID = 0;
+            bool bPending = false;
+            eastl::vector<FScope> Scopes;
+            uint32_t GraphicsScopeCount = 0;
+            uint32_t ComputeScopeCount = 0;
+        };
+
+        bool EnsureCapacity(FFrameSlot& slot, uint32_t scopeCount);
+        void Readback(FFrameSlot& slot);
+        RHI::FRHIQueryPool* GetQueryPool(const FScope& scope) const;
+
+    private:
+        RHI::FRHIDevice* m_pDevice = nullptr;
+        std::atomic<bool> m_bEnabled { false };
+
+        FFrameSlot m_Slots[RHI::RHI_MAX_INFLIGHT_FRAMES];
+        FFrameSlot* m_pCurrentSlot = nullptr;
+
+        mutable std::mutex m_HistoryMutex;
+        eastl::deque<FRenderGraphFrameTiming> m_History;
+    };
+}
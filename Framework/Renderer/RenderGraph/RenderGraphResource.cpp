@@ -19,6 +19,22 @@ namespace RG
         }
     }
 
+    void FRenderGraphResource::SaveCompiledState(FRGCompiledResource &state)
+    {
+        state.FirstPass = m_FirstPass;
+        state.LastPass = m_LastPass;
+        state.LastState = m_LastState;
+        state.Resource = GetResource();
+        state.InitialState = GetInitialState();
+    }
+
+    void FRenderGraphResource::LoadCompiledState(const FRGCompiledResource &state)
+    {
+        m_FirstPass = state.FirstPass;
+        m_LastPass = state.LastPass;
+        m_LastState = state.LastState;
+    }
+
     FRGTexture::FRGTexture(FRenderGraphResourceAllocator &allocator, const eastl::string &name, const Desc &desc)
         : FRenderGraphResource(name)
         , m_Allocator(allocator)
@@ -40,7 +56,7 @@ namespace RG
     {
         if (!m_bImported)
         {
-            if (m_bExported)
+            if (m_bExported || IsTransientAttachment())
             {
                 m_Allocator.FreeNonOverlappingTexture(m_pTexture, m_LastState);
             }
@@ -88,6 +104,7 @@ namespace RG
         FRenderGraphResource::Resolve(edge, pass);
 
         RHI::ERHIAccessFlags usage = edge->GetUsage();
+        m_ResolvedAccess |= usage;
         if (usage & RHI::RHIAccessRTV)
         {
             m_Desc.Usage |= RHI::RHITextureUsageRenderTarget;
@@ -102,11 +119,21 @@ namespace RG
         }
     }
 
+    void FRGTexture::PostResolve()
+    {
+        // 只在一个 pass 内作为 attachment 使用，内容不会离开这个 pass
+        const RHI::ERHIAccessFlags attachmentAccess = RHI::RHIAccessRTV | RHI::RHIAccessDSV | RHI::RHIAccessDSVReadOnly;
+        if (!m_bImported && !m_bExported && m_FirstPass == m_LastPass && m_ResolvedAccess != 0 && (m_ResolvedAccess & ~attachmentAccess) == 0)
+        {
+            m_Desc.Usage |= RHI::RHITextureUsageTransientAttachment;
+        }
+    }
+
     void FRGTexture::Realize()
     {
         if (!m_bImported)
         {
-            if (m_bExported)
+            if (m_bExported || IsTransientAttachment())
             {
                 m_pTexture = m_Allocator.AllocateNonOverlappingTexture(m_Desc, m_Name, m_InitialState);
             }
@@ -117,9 +144,30 @@ namespace RG
         }
     }
 
-    RHI::FRHIResource *FRGTexture::GetAliasedPrevResource(RHI::ERHIAccessFlags &lastUsedState)
+    void FRGTexture::SaveCompiledState(FRGCompiledResource &state)
+    {
+        FRenderGraphResource::SaveCompiledState(state);
+        state.Usage = m_Desc.Usage;
+    }
+
+    void FRGTexture::LoadCompiledState(const FRGCompiledResource &state)
     {
-        return m_Allocator.GetAliasedPreviousResource(m_pTexture, m_FirstPass, lastUsedState);
+        FRenderGraphResource::LoadCompiledState(state);
+        m_Desc.Usage = state.Usage;
+    }
+
+    uint32_t FRGTexture::GetAllocationSize() const
+    {
+        if (m_bImported || m_bExported || IsTransientAttachment())
+        {
+            return 0;
+        }
+        return m_Allocator.GetAllocationSize(m_Desc);
+    }
+
+    void FRGTexture::GetAliasedPrevResources(eastl::vector<FRGAliasedResource> &aliasedResources)
+    {
+        m_Allocator.GetAliasedPreviousResources(m_pTexture, m_FirstPass, aliasedResources);
     }
 
     void FRGTexture::Barrier(RHI::FRHICommandList *pCmdList, uint32_t subresource, RHI::ERHIAccessFlags accessBefore, RHI::ERHIAccessFlags accessAfter)
@@ -224,9 +272,26 @@ namespace RG
         }
     }
 
-    RHI::FRHIResource *FRGBuffer::GetAliasedPrevResource(RHI::ERHIAccessFlags &lastUsedState)
+    void FRGBuffer::SaveCompiledState(FRGCompiledResource &state)
+    {
+        FRenderGraphResource::SaveCompiledState(state);
+        state.Usage = m_Desc.Usage;
+    }
+
+    void FRGBuffer::LoadCompiledState(const FRGCompiledResource &state)
+    {
+        FRenderGraphResource::LoadCompiledState(state);
+        m_Desc.Usage = state.Usage;
+    }
+
+    uint32_t FRGBuffer::GetAllocationSize() const
+    {
+        return m_bImported ? 0 : m_Allocator.GetAllocationSize(m_Desc);
+    }
+
+    void FRGBuffer::GetAliasedPrevResources(eastl::vector<FRGAliasedResource> &aliasedResources)
     {
-        return m_Allocator.GetAliasedPreviousResource(m_pBuffer, m_FirstPass, lastUsedState);
+        m_Allocator.GetAliasedPreviousResources(m_pBuffer, m_FirstPass, aliasedResources);
     }
 
     void FRGBuffer::Barrier(RHI::FRHICommandList *pCmdList, uint32_t subresource, RHI::ERHIAccessFlags accessBefore, RHI::ERHIAccessFlags accessAfter)
@@ -1,13 +1,25 @@
 #pragma once
 
 #include "DAG.hpp"
+#include "RenderGraphResourceAllocator.hpp"
 #include "RHI/RHI.hpp"
 
 namespace RG
 {
     class FRenderGraphEdge;
     class FRenderGraphPassBase;
-    class FRenderGraphResourceAllocator;
+
+    // Resolve/Realize 得到的资源信息，图结构不变时由 FRenderGraph 缓存并在下一帧恢复
+    struct FRGCompiledResource
+    {
+        DAGNodeID FirstPass = UINT32_MAX;
+        DAGNodeID LastPass = 0;
+        RHI::ERHIAccessFlags LastState = RHI::RHIAccessDiscard;
+        // Resolve 根据边的用法补到 desc 上的 usage
+        uint32_t Usage = 0;
+        RHI::FRHIResource* Resource = nullptr;
+        RHI::ERHIAccessFlags InitialState = RHI::RHIAccessDiscard;
+    };
 
     class FRenderGraphResource
     {
@@ -18,9 +30,18 @@ namespace RG
         virtual ~FRenderGraphResource() {}
 
         virtual void Resolve(FRenderGraphEdge* edge, FRenderGraphPassBase* pass);
+        // 所有边都 Resolve 之后调用，生命周期和用法已经完整，BuildRealizeOrder 依赖它的结果
+        virtual void PostResolve() {}
         virtual void Realize() = 0;
+        virtual void SaveCompiledState(FRGCompiledResource& state);
+        // 代替 Resolve，之后照常 Realize
+        virtual void LoadCompiledState(const FRGCompiledResource& state);
         virtual RHI::FRHIResource* GetResource() = 0;
         virtual RHI::ERHIAccessFlags GetInitialState() = 0;
+        // 需要放进瞬态 heap 的大小，导入的资源为 0
+        virtual uint32_t GetAllocationSize() const = 0;
+        // 声明为 RT/DS 的瞬态资源，初始状态可能是计算队列不支持的布局
+        virtual bool HasAttachmentUsage() const { return false; }
 
         const eastl::string& GetName() const { return m_Name; }
         DAGNodeID GetFirstPassID() const { return m_FirstPass; }
@@ -34,9 +55,10 @@ namespace RG
         RHI::ERHIAccessFlags GetFinalState() const { return m_LastState; }
         virtual void SetFinalState(RHI::ERHIAccessFlags state) { m_LastState = state; }
 
-        bool IsOverlapping() const { return !IsImported() && !IsExported(); }
+        // 放在瞬态 heap 中、可能与其它资源别名
+        virtual bool IsOverlapping() const { return !IsImported() && !IsExported(); }
 
-        virtual RHI::FRHIResource* GetAliasedPrevResource(RHI::ERHIAccessFlags& lastUsedState) = 0;
+        virtual void GetAliasedPrevResources(eastl::vector<FRGAliasedResource>& aliasedResources) = 0;
         virtual void Barrier(RHI::FRHICommandList* pCmdList, uint32_t subresource, RHI::ERHIAccessFlags accessBefore, RHI::ERHIAccessFlags accessAfter) = 0;
     
     protected:
@@ -65,16 +87,27 @@ namespace RG
         RHI::FRHIDescriptor* GetUAV(uint32_t mipLevel, uint32_t slice);
 
         virtual void Resolve(FRenderGraphEdge* edge, FRenderGraphPassBase* pass) override;
+        virtual void PostResolve() override;
         virtual void Realize() override;
+        virtual void SaveCompiledState(FRGCompiledResource& state) override;
+        virtual void LoadCompiledState(const FRGCompiledResource& state) override;
         virtual RHI::FRHIResource* GetResource() override { return m_pTexture; }
         virtual RHI::ERHIAccessFlags GetInitialState() override { return m_InitialState; }
-        virtual RHI::FRHIResource* GetAliasedPrevResource(RHI::ERHIAccessFlags& lastUsedState) override;
+        virtual uint32_t GetAllocationSize() const override;
+        virtual bool HasAttachmentUsage() const override { return m_Desc.Usage & (RHI::RHITextureUsageRenderTarget | RHI::RHITextureUsageDepthStencil); }
+        // lazily allocated 的 attachment 单独分配，不进瞬态 heap
+        virtual bool IsOverlapping() const override { return FRenderGraphResource::IsOverlapping() && !IsTransientAttachment(); }
+        virtual void GetAliasedPrevResources(eastl::vector<FRGAliasedResource>& aliasedResources) override;
         virtual void Barrier(RHI::FRHICommandList* pCmdList, uint32_t subresource, RHI::ERHIAccessFlags accessBefore, RHI::ERHIAccessFlags accessAfter) override;
 
+        bool IsTransientAttachment() const { return m_Desc.Usage & RHI::RHITextureUsageTransientAttachment; }
+
     private:
         Desc m_Desc;
         RHI::FRHITexture* m_pTexture = nullptr;
         RHI::ERHIAccessFlags m_InitialState = RHI::RHIAccessDiscard;
+        // Resolve 见到的所有用法，只用于 PostResolve 判断是否为 transient attachment
+        RHI::ERHIAccessFlags m_ResolvedAccess = 0;
         FRenderGraphResourceAllocator& m_Allocator;
     };
 
@@ -93,9 +126,12 @@ namespace RG
 
         virtual void Resolve(FRenderGraphEdge* edge, FRenderGraphPassBase* pass) override;
         virtual void Realize() override;
+        virtual void SaveCompiledState(FRGCompiledResource& state) override;
+        virtual void LoadCompiledState(const FRGCompiledResource& state) override;
         virtual RHI::FRHIResource* GetResource() override { return m_pBuffer; }
         virtual RHI::ERHIAccessFlags GetInitialState() override { return m_InitialState; }
-        virtual RHI::FRHIResource* GetAliasedPrevResource(RHI::ERHIAccessFlags& lastUsedState) override;
+        virtual uint32_t GetAllocationSize() const override;
+        virtual void GetAliasedPrevResources(eastl::vector<FRGAliasedResource>& aliasedResources) override;
         virtual void Barrier(RHI::FRHICommandList* pCmdList, uint32_t subresource, RHI::ERHIAccessFlags accessBefore, RHI::ERHIAccessFlags accessAfter) override;
 
     private:
@@ -2,10 +2,19 @@
 #include "Utilities/Math.hpp"
 #include "Utilities/Log.hpp"
 
+#include <EASTL/algorithm.h>
+#include <EASTL/sort.h>
 #include <cassert>
 
 namespace RG
 {
+    // 保守取 64KB，覆盖各平台纹理的 placement 对齐要求
+    static const uint32_t RG_TEXTURE_ALIGNMENT = 64 * 1024;
+    static const uint32_t RG_BUFFER_ALIGNMENT = 4 * 1024;
+    // heap 按页分配，让多个资源可以打包进同一个 heap
+    static const uint32_t RG_TEXTURE_HEAP_SIZE = 64 * 1024 * 1024;
+    static const uint32_t RG_BUFFER_HEAP_SIZE = 16 * 1024 * 1024;
+
     FRenderGraphResourceAllocator::FRenderGraphResourceAllocator(RHI::FRHIDevice *device)
     {
         m_pDevice = device;
@@ -101,87 +110,105 @@ namespace RG
     RHI::FRHITexture *FRenderGraphResourceAllocator::AllocateTexture(uint32_t firstPass, uint32_t lastPass, RHI::ERHIAccessFlags lastState, const RHI::FRHITextureDesc &desc, const eastl::string &name, RHI::ERHIAccessFlags &initialState)
     {
         FLifeTimeRange lifeTime = {firstPass, lastPass};
-        uint32_t textureSize = m_pDevice->GetAllocationSize(desc);
+        uint32_t textureSize = GetAllocationSize(desc);
+
+        // 优先复用上一帧放在同一位置的资源，图不变时每帧得到相同的布局
         for (size_t i = 0; i < m_AllocatedHeaps.size(); i++)
         {
             FHeap& heap = m_AllocatedHeaps[i];
-            if (heap.Heap->GetDesc().Size < textureSize || heap.IsOverlapping(lifeTime)) continue;
+            if (heap.Type != EHeapType::Texture || heap.Heap->GetDesc().MemoryType != desc.MemoryType) continue;
 
             for (size_t j = 0; j < heap.Resources.size(); j++)
             {
                 FAliasedResource& aliasedRes = heap.Resources[j];
-                if (aliasedRes.Resource->IsTexture() && !aliasedRes.LifeTime.IsUsed() && ((RHI::FRHITexture*)aliasedRes.Resource)->GetDesc() == desc)
+                if (aliasedRes.Resource->IsTexture() && !aliasedRes.LifeTime.IsUsed() && ((RHI::FRHITexture*)aliasedRes.Resource)->GetDesc() == desc &&
+                    !heap.IsConflicting(aliasedRes.Offset, aliasedRes.Size, lifeTime))
                 {
                     aliasedRes.LifeTime = lifeTime;
                     initialState = aliasedRes.LastUsedState;
                     aliasedRes.LastUsedState = lastState;
+                    heap.DiscardUnused(aliasedRes.Offset, aliasedRes.Size);
                     return (RHI::FRHITexture*)aliasedRes.Resource;
                 }
             }
-            RHI::FRHITextureDesc newDesc = desc;
-            newDesc.Heap = heap.Heap;
-
-            FAliasedResource aliasedTexture;
-            aliasedTexture.Resource = m_pDevice->CreateTexture(newDesc, "RGTexture_" + name);
-            aliasedTexture.LifeTime = lifeTime;
-            aliasedTexture.LastUsedState = lastState;
-            heap.Resources.push_back(aliasedTexture);
-            
-            if (RHI::IsDepthFormat(desc.Format))
-            {
-                initialState = RHI::RHIAccessDSV;
-            }
-            else if (desc.Usage & RHI::RHITextureUsageRenderTarget)
-            {
-                initialState = RHI::RHIAccessRTV;
-            }
-            else if (desc.Usage & RHI::RHITextureUsageUnorderedAccess)
-            {
-                initialState = RHI::RHIAccessMaskUAV;
-            }
-            assert(aliasedTexture.Resource != nullptr);
-            return (RHI::FRHITexture*)aliasedTexture.Resource;
         }
-        AllocateHeap(textureSize);
-        return AllocateTexture(firstPass, lastPass, lastState, desc, name, initialState);
+
+        uint32_t offset = 0;
+        FHeap* heap = FindHeap(EHeapType::Texture, desc.MemoryType, textureSize, lifeTime, offset);
+
+        RHI::FRHITextureDesc newDesc = desc;
+        newDesc.Heap = heap->Heap;
+        newDesc.HeapOffset = offset;
+
+        FAliasedResource aliasedTexture;
+        aliasedTexture.Resource = m_pDevice->CreateTexture(newDesc, "RGTexture_" + name);
+        aliasedTexture.LifeTime = lifeTime;
+        aliasedTexture.Offset = offset;
+        aliasedTexture.Size = textureSize;
+        aliasedTexture.LastUsedState = lastState;
+        heap->DiscardUnused(offset, textureSize);
+        heap->Resources.push_back(aliasedTexture);
+
+        if (RHI::IsDepthFormat(desc.Format))
+        {
+            initialState = RHI::RHIAccessDSV;
+        }
+        else if (desc.Usage & RHI::RHITextureUsageRenderTarget)
+        {
+            initialState = RHI::RHIAccessRTV;
+        }
+        else if (desc.Usage & RHI::RHITextureUsageUnorderedAccess)
+        {
+            initialState = RHI::RHIAccessMaskUAV;
+        }
+        assert(aliasedTexture.Resource != nullptr);
+        return (RHI::FRHITexture*)aliasedTexture.Resource;
     }
 
     RHI::FRHIBuffer *FRenderGraphResourceAllocator::AllocateBuffer(uint32_t firstPass, uint32_t lastPass, RHI::ERHIAccessFlags lastState, const RHI::FRHIBufferDesc &desc, const eastl::string &name, RHI::ERHIAccessFlags &initialState)
     {
         FLifeTimeRange lifeTime = {firstPass, lastPass};
-        uint32_t bufferSize = desc.Size;
+        uint32_t bufferSize = GetAllocationSize(desc);
 
         for (size_t i = 0; i < m_AllocatedHeaps.size(); i++)
         {
             FHeap& heap = m_AllocatedHeaps[i];
-            if (heap.Heap->GetDesc().Size < bufferSize || heap.IsOverlapping(lifeTime)) continue;
+            if (heap.Type != EHeapType::Buffer || heap.Heap->GetDesc().MemoryType != desc.MemoryType) continue;
 
             for (size_t j = 0; j < heap.Resources.size(); j++)
             {
                 FAliasedResource& aliasedRes = heap.Resources[j];
-                if (aliasedRes.Resource->IsBuffer() && !aliasedRes.LifeTime.IsUsed() && ((RHI::FRHIBuffer*)aliasedRes.Resource)->GetDesc() == desc)
+                if (aliasedRes.Resource->IsBuffer() && !aliasedRes.LifeTime.IsUsed() && ((RHI::FRHIBuffer*)aliasedRes.Resource)->GetDesc() == desc &&
+                    !heap.IsConflicting(aliasedRes.Offset, aliasedRes.Size, lifeTime))
                 {
                     aliasedRes.LifeTime = lifeTime;
                     initialState = aliasedRes.LastUsedState;
                     aliasedRes.LastUsedState = lastState;
+                    heap.DiscardUnused(aliasedRes.Offset, aliasedRes.Size);
                     return (RHI::FRHIBuffer*)aliasedRes.Resource;
                 }
             }
-            RHI::FRHIBufferDesc newDesc = desc;
-            newDesc.Heap = heap.Heap;
-
-            FAliasedResource aliasedBuffer;
-            aliasedBuffer.Resource = m_pDevice->CreateBuffer(newDesc, "RGBuffer_" + name);
-            aliasedBuffer.LifeTime = lifeTime;
-            aliasedBuffer.LastUsedState = lastState;
-            heap.Resources.push_back(aliasedBuffer);
-
-            initialState = RHI::RHIAccessDiscard;
-            assert(aliasedBuffer.Resource != nullptr);
-            return (RHI::FRHIBuffer*)aliasedBuffer.Resource;
         }
-        AllocateHeap(bufferSize);
-        return AllocateBuffer(firstPass, lastPass, lastState, desc, name, initialState);
+
+        uint32_t offset = 0;
+        FHeap* heap = FindHeap(EHeapType::Buffer, desc.MemoryType, bufferSize, lifeTime, offset);
+
+        RHI::FRHIBufferDesc newDesc = desc;
+        newDesc.Heap = heap->Heap;
+        newDesc.HeapOffset = offset;
+
+        FAliasedResource aliasedBuffer;
+        aliasedBuffer.Resource = m_pDevice->CreateBuffer(newDesc, "RGBuffer_" + name);
+        aliasedBuffer.LifeTime = lifeTime;
+        aliasedBuffer.Offset = offset;
+        aliasedBuffer.Size = bufferSize;
+        aliasedBuffer.LastUsedState = lastState;
+        heap->DiscardUnused(offset, bufferSize);
+        heap->Resources.push_back(aliasedBuffer);
+
+        initialState = RHI::RHIAccessDiscard;
+        assert(aliasedBuffer.Resource != nullptr);
+        return (RHI::FRHIBuffer*)aliasedBuffer.Resource;
     }
 
     void FRenderGraphResourceAllocator::Free(RHI::FRHIResource *resource, RHI::ERHIAccessFlags state, bool bIsSetState)
@@ -210,40 +237,58 @@ namespace RG
         }
     }
 
-    RHI::FRHIResource *FRenderGraphResourceAllocator::GetAliasedPreviousResource(RHI::FRHIResource *resource, uint32_t firstPass, RHI::ERHIAccessFlags &lastUsedState)
+    void FRenderGraphResourceAllocator::GetAliasedPreviousResources(RHI::FRHIResource *resource, uint32_t firstPass, eastl::vector<FRGAliasedResource> &aliasedResources)
     {
         for (size_t i = 0; i < m_AllocatedHeaps.size(); i++)
         {
             FHeap& heap = m_AllocatedHeaps[i];
             if (!heap.Contains(resource)) continue;
 
-            FAliasedResource* aliasedRes = nullptr;
-            RHI::FRHIResource* prevResource = nullptr;
-            uint32_t prevResourceLastPass = 0;
+            const FAliasedResource* self = nullptr;
+            for (size_t j = 0; j < heap.Resources.size(); j++)
+            {
+                if (heap.Resources[j].Resource == resource)
+                {
+                    self = &heap.Resources[j];
+                    break;
+                }
+            }
 
             for (size_t j = 0; j < heap.Resources.size(); j++)
             {
                 FAliasedResource& res = heap.Resources[j];
-                if (res.Resource != resource && res.LifeTime.LastPass < firstPass && res.LifeTime.LastPass > prevResourceLastPass)
+                if (res.Resource != resource && res.LifeTime.IsUsed() && res.LifeTime.LastPass < firstPass && res.IsMemoryOverlapping(self->Offset, self->Size))
                 {
-                    aliasedRes = &res;
-                    prevResource = res.Resource;
-                    lastUsedState = res.LastUsedState;
-                    prevResourceLastPass = res.LifeTime.LastPass;
+                    aliasedResources.push_back({ res.Resource, res.LastUsedState });
+                    res.LastUsedState |= RHI::RHIAccessDiscard;
                 }
             }
-            if (aliasedRes != nullptr)
+            return;
+        }
+        assert(false);
+    }
+
+    void FRenderGraphResourceAllocator::MarkAliasDiscarded(RHI::FRHIResource *resource)
+    {
+        for (size_t i = 0; i < m_AllocatedHeaps.size(); i++)
+        {
+            FHeap& heap = m_AllocatedHeaps[i];
+            for (size_t j = 0; j < heap.Resources.size(); j++)
             {
-                aliasedRes->LastUsedState |= RHI::RHIAccessDiscard;
+                if (heap.Resources[j].Resource == resource)
+                {
+                    heap.Resources[j].LastUsedState |= RHI::RHIAccessDiscard;
+                    return;
+                }
             }
-            return prevResource;
         }
         assert(false);
-        return nullptr;
     }
 
     RHI::FRHIDescriptor *FRenderGraphResourceAllocator::GetDescriptor(RHI::FRHIResource *resource, const RHI::FRHIShaderResourceViewDesc &desc)
     {
+        // 资源的 SRV/UAV 在 pass 执行时才按需创建，并行录制时会被多个线程调用
+        std::lock_guard<std::mutex> lock(m_DescriptorMutex);
         for (size_t i = 0; i < m_AllocatedSRVs.size(); i++)
         {
             if (m_AllocatedSRVs[i].Resource == resource && m_AllocatedSRVs[i].Desc == desc)
@@ -258,6 +303,7 @@ namespace RG
 
     RHI::FRHIDescriptor *FRenderGraphResourceAllocator::GetDescriptor(RHI::FRHIResource *resource, const RHI::FRHIUnorderedAccessViewDesc &desc)
     {
+        std::lock_guard<std::mutex> lock(m_DescriptorMutex);
         for (size_t i = 0; i < m_AllocatedUAVs.size(); i++)
         {
             if (m_AllocatedUAVs[i].Resource == resource && m_AllocatedUAVs[i].Desc == desc)
@@ -317,15 +363,133 @@ namespace RG
         }
     }
 
-    void FRenderGraphResourceAllocator::AllocateHeap(uint32_t size)
+    uint32_t FRenderGraphResourceAllocator::GetAllocationSize(const RHI::FRHITextureDesc &desc) const
+    {
+        return RoundUpPow2(m_pDevice->GetAllocationSize(desc), RG_TEXTURE_ALIGNMENT);
+    }
+
+    uint32_t FRenderGraphResourceAllocator::GetAllocationSize(const RHI::FRHIBufferDesc &desc) const
+    {
+        return RoundUpPow2(eastl::max(desc.Size, m_pDevice->GetAllocationSize(desc)), RG_BUFFER_ALIGNMENT);
+    }
+
+    void FRenderGraphResourceAllocator::UpdateStats()
+    {
+        FRenderGraphTransientStats lastStats = m_Stats;
+        m_Stats = {};
+
+        eastl::vector<const FAliasedResource*> usedResources;
+        for (size_t i = 0; i < m_AllocatedHeaps.size(); i++)
+        {
+            const FHeap& heap = m_AllocatedHeaps[i];
+            uint64_t heapEnd = 0;
+            for (size_t j = 0; j < heap.Resources.size(); j++)
+            {
+                const FAliasedResource& res = heap.Resources[j];
+                if (res.LifeTime.IsUsed())
+                {
+                    usedResources.push_back(&res);
+                    heapEnd = eastl::max(heapEnd, (uint64_t)res.Offset + res.Size);
+                }
+            }
+            m_Stats.PackedSize += heapEnd;
+            m_Stats.HeapSize += heap.Heap->GetDesc().Size;
+        }
+
+        // 存活集合只在某个资源开始时增大，检查每个资源的 FirstPass 即可
+        for (size_t i = 0; i < usedResources.size(); i++)
+        {
+            uint32_t pass = usedResources[i]->LifeTime.FirstPass;
+            uint64_t liveSize = 0;
+            for (size_t j = 0; j < usedResources.size(); j++)
+            {
+                const FLifeTimeRange& lifeTime = usedResources[j]->LifeTime;
+                if (lifeTime.FirstPass <= pass && lifeTime.LastPass >= pass)
+                {
+                    liveSize += usedResources[j]->Size;
+                }
+            }
+            m_Stats.PeakLiveSize = eastl::max(m_Stats.PeakLiveSize, liveSize);
+            m_Stats.RequestedSize += usedResources[i]->Size;
+        }
+        m_Stats.ResourceCount = (uint32_t)usedResources.size();
+
+        if (m_Stats.PackedSize != lastStats.PackedSize || m_Stats.RequestedSize != lastStats.RequestedSize)
+        {
+            const float MB = 1024.0f * 1024.0f;
+            VTNA_LOG_INFO("[RenderGraph] {} transient resources: requested {:.1f} MB, peak live {:.1f} MB, packed {:.1f} MB, heaps {:.1f} MB",
+                m_Stats.ResourceCount, m_Stats.RequestedSize / MB, m_Stats.PeakLiveSize / MB, m_Stats.PackedSize / MB, m_Stats.HeapSize / MB);
+        }
+    }
+
+    bool FRenderGraphResourceAllocator::FHeap::FindOffset(uint32_t size, uint32_t alignment, const FLifeTimeRange &lifeTime, uint32_t &offset) const
     {
+        // 只有生命周期重叠的资源会占住内存，先在它们之间的空隙里做 best-fit，放不下再接到末尾
+        eastl::vector<const FAliasedResource*> liveResources;
+        for (size_t i = 0; i < Resources.size(); i++)
+        {
+            if (Resources[i].LifeTime.IsOverlapping(lifeTime))
+            {
+                liveResources.push_back(&Resources[i]);
+            }
+        }
+        eastl::sort(liveResources.begin(), liveResources.end(), [](const FAliasedResource* a, const FAliasedResource* b) { return a->Offset < b->Offset; });
+
+        bool bFound = false;
+        uint32_t bestGap = UINT32_MAX;
+        uint32_t gapStart = 0;
+        for (size_t i = 0; i < liveResources.size(); i++)
+        {
+            uint32_t gapEnd = liveResources[i]->Offset;
+            if (gapEnd > gapStart && gapEnd - gapStart >= size && gapEnd - gapStart < bestGap)
+            {
+                bestGap = gapEnd - gapStart;
+                offset = gapStart;
+                bFound = true;
+            }
+            gapStart = eastl::max(gapStart, RoundUpPow2(liveResources[i]->Offset + liveResources[i]->Size, alignment));
+        }
+
+        if (!bFound && (uint64_t)gapStart + size <= Heap->GetDesc().Size)
+        {
+            offset = gapStart;
+            bFound = true;
+        }
+        return bFound;
+    }
+
+    FRenderGraphResourceAllocator::FHeap *FRenderGraphResourceAllocator::FindHeap(EHeapType type, RHI::ERHIMemoryType memoryType, uint32_t size, const FLifeTimeRange &lifeTime, uint32_t &offset)
+    {
+        uint32_t alignment = type == EHeapType::Texture ? RG_TEXTURE_ALIGNMENT : RG_BUFFER_ALIGNMENT;
+        for (size_t i = 0; i < m_AllocatedHeaps.size(); i++)
+        {
+            FHeap& heap = m_AllocatedHeaps[i];
+            if (heap.Type != type || heap.Heap->GetDesc().MemoryType != memoryType || heap.Heap->GetDesc().Size < size) continue;
+
+            if (heap.FindOffset(size, alignment, lifeTime, offset))
+            {
+                return &heap;
+            }
+        }
+        offset = 0;
+        return AllocateHeap(type, memoryType, size);
+    }
+
+    FRenderGraphResourceAllocator::FHeap *FRenderGraphResourceAllocator::AllocateHeap(EHeapType type, RHI::ERHIMemoryType memoryType, uint32_t size)
+    {
+        uint32_t minSize = type == EHeapType::Texture ? RG_TEXTURE_HEAP_SIZE : RG_BUFFER_HEAP_SIZE;
+
         RHI::FRHIHeapDesc heapDesc;
-        heapDesc.Size = RoundUpPow2(size, 64u * 1024);
+        heapDesc.Size = RoundUpPow2(eastl::max(size, minSize), 64u * 1024);
+        heapDesc.MemoryType = memoryType;
 
-        eastl::string heapName = fmt::format("RG Heap {:.1} MB", heapDesc.Size / (1024.0f * 1024.0f)).c_str();
+        eastl::string heapName = fmt::format("RG {} Heap {:.1f} MB", type == EHeapType::Texture ? "Texture" : "Buffer", heapDesc.Size / (1024.0f * 1024.0f)).c_str();
 
         FHeap heap;
         heap.Heap = m_pDevice->CreateHeap(heapDesc, heapName);
+        heap.Type = type;
+        assert(heap.Heap != nullptr);
         m_AllocatedHeaps.push_back(heap);
+        return &m_AllocatedHeaps.back();
     }
 }
\ No newline at end of file
@@ -2,8 +2,29 @@
 
 #include "RHI/RHI.hpp"
 
+#include <mutex>
+
 namespace RG
 {
+    // 与新资源内存重叠、生命周期已经结束的资源
+    struct FRGAliasedResource
+    {
+        RHI::FRHIResource* Resource;
+        RHI::ERHIAccessFlags LastUsedState;
+    };
+
+    struct FRenderGraphTransientStats
+    {
+        uint32_t ResourceCount = 0;
+        // 不做别名时所需的总大小
+        uint64_t RequestedSize = 0;
+        // 单个 pass 内同时存活的资源大小之和的最大值，即理论下限
+        uint64_t PeakLiveSize = 0;
+        // 本帧在各 heap 中实际占用的范围
+        uint64_t PackedSize = 0;
+        uint64_t HeapSize = 0;
+    };
+
     class FRenderGraphResourceAllocator
     {
         struct FLifeTimeRange
@@ -24,24 +45,51 @@ namespace RG
         {
             RHI::FRHIResource* Resource = nullptr;
             FLifeTimeRange LifeTime;
+            uint32_t Offset = 0;
+            uint32_t Size = 0;
             uint64_t LastUsedFrame = 0;
             RHI::ERHIAccessFlags LastUsedState = RHI::RHIAccessDiscard;
+
+            bool IsMemoryOverlapping(uint32_t offset, uint32_t size) const
+            {
+                return Offset < offset + size && offset < Offset + Size;
+            }
+        };
+
+        // 纹理与 buffer 分开放，不用处理 linear/optimal 资源之间的 granularity 问题
+        enum class EHeapType
+        {
+            Texture,
+            Buffer,
         };
 
         struct FHeap
         {
             RHI::FRHIHeap* Heap = nullptr;
+            EHeapType Type = EHeapType::Texture;
             eastl::vector<FAliasedResource> Resources;
 
-            bool IsOverlapping(const FLifeTimeRange& lifeTime) const
+            // 生命周期与内存范围同时重叠才算冲突
+            bool IsConflicting(uint32_t offset, uint32_t size, const FLifeTimeRange& lifeTime) const
             {
                 for (const FAliasedResource& resource : Resources)
                 {
-                    if (resource.LifeTime.IsOverlapping(lifeTime)) return true;
+                    if (resource.LifeTime.IsOverlapping(lifeTime) && resource.IsMemoryOverlapping(offset, size)) return true;
                 }
                 return false;
             }
 
+            bool FindOffset(uint32_t size, uint32_t alignment, const FLifeTimeRange& lifeTime, uint32_t& offset) const;
+
+            // 本帧不使用的缓存资源也会被覆盖，下次复用时不能沿用之前的内容和状态
+            void DiscardUnused(uint32_t offset, uint32_t size)
+            {
+                for (FAliasedResource& resource : Resources)
+                {
+                    if (!resource.LifeTime.IsUsed() && resource.IsMemoryOverlapping(offset, size)) resource.LastUsedState |= RHI::RHIAccessDiscard;
+                }
+            }
+
             bool Contains(RHI::FRHIResource* resource) const
             {
                 for (const FAliasedResource& aliasedResource : Resources)
@@ -79,7 +127,16 @@ namespace RG
         RHI::FRHIBuffer* AllocateBuffer(uint32_t firstPass, uint32_t lastPass, RHI::ERHIAccessFlags lastState, const RHI::FRHIBufferDesc& desc, const eastl::string& name, RHI::ERHIAccessFlags& initialState);
         void Free(RHI::FRHIResource* resource, RHI::ERHIAccessFlags state, bool bIsSetState);
 
-        RHI::FRHIResource* GetAliasedPreviousResource(RHI::FRHIResource* resource, uint32_t firstPass, RHI::ERHIAccessFlags& lastUsedState);
+        uint32_t GetAllocationSize(const RHI::FRHITextureDesc& desc) const;
+        uint32_t GetAllocationSize(const RHI::FRHIBufferDesc& desc) const;
+        // 在所有瞬态资源 Realize 之后调用
+        void UpdateStats();
+        const FRenderGraphTransientStats& GetStats() const { return m_Stats; }
+
+        // 按字节偏移打包时新资源可能同时覆盖多个之前的资源，全部返回并标记为 discard
+        void GetAliasedPreviousResources(RHI::FRHIResource* resource, uint32_t firstPass, eastl::vector<FRGAliasedResource>& aliasedResources);
+        // Compile 复用缓存的 barrier 时不再调用 GetAliasedPreviousResources，由这里重放它对被别名资源状态的修改
+        void MarkAliasDiscarded(RHI::FRHIResource* resource);
 
         RHI::FRHIDescriptor* GetDescriptor(RHI::FRHIResource* resource, const RHI::FRHIShaderResourceViewDesc& desc);
         RHI::FRHIDescriptor* GetDescriptor(RHI::FRHIResource* resource, const RHI::FRHIUnorderedAccessViewDesc& desc);
@@ -87,7 +144,8 @@ namespace RG
     private:
         void CheckHeapUsage(FHeap& heap);
         void DeleteDescriptor(RHI::FRHIResource* resource);
-        void AllocateHeap(uint32_t size);
+        FHeap* FindHeap(EHeapType type, RHI::ERHIMemoryType memoryType, uint32_t size, const FLifeTimeRange& lifeTime, uint32_t& offset);
+        FHeap* AllocateHeap(EHeapType type, RHI::ERHIMemoryType memoryType, uint32_t size);
 
     private:
         RHI::FRHIDevice* m_pDevice = nullptr;
@@ -102,7 +160,10 @@ namespace RG
         };
         eastl::vector<FNonOverlappingTexture> m_FreeOverlappingTextures;
 
+        std::mutex m_DescriptorMutex;
         eastl::vector<FSRVDescriptor> m_AllocatedSRVs;
         eastl::vector<FUAVDescriptor> m_AllocatedUAVs;
+
+        FRenderGraphTransientStats m_Stats;
     };
 } // namespace RG
@@ -101,6 +101,9 @@ namespace Renderer
         rg->AddPass<FBuildHZBData>("Build HZB", RG::RenderPassType::Compute,
             [&](FBuildHZBData& data, RG::FRGBuilder& builder)
             {
+                // SPD 的全局计数器由渲染器持有，调度器看不到两次 Build HZB 之间的依赖
+                builder.DisableAsyncCompute();
+
                 data.HZB = builder.Read(dilationPass->DilatedDepth);
 
                 m_CullingHZBMips1stPhase[0] = data.HZB;
@@ -159,6 +162,8 @@ namespace Renderer
         rg->AddPass<FBuildHZBData>("Build HZB", RG::RenderPassType::Compute,
             [&](FBuildHZBData& data, RG::FRGBuilder& builder)
             {
+                builder.DisableAsyncCompute();
+
                 data.HZB = builder.Read(initPass->HZB);
 
                 m_CullingHZBMips2ndPhase[0] = data.HZB;
@@ -218,6 +223,8 @@ namespace Renderer
         rg->AddPass<FBuildHZBData>("Build Scene HZB", RG::RenderPassType::Compute,
             [&](FBuildHZBData& data, RG::FRGBuilder& builder)
             {
+                builder.DisableAsyncCompute();
+
                 data.HZB = builder.Read(initPass->HZB);
 
                 m_SceneHZBMips[0] = data.HZB;
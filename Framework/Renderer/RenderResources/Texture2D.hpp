@@ -4,6 +4,8 @@
 
 #include <EASTL/unique_ptr.h>
 
+#include <atomic>
+
 namespace Renderer
 {
     class FRendererBase;
@@ -21,6 +23,11 @@ namespace RenderResources
         RHI::FRHITexture* GetTexture() const { return m_pTexture.get(); }
         RHI::FRHIDescriptor* GetSRV() const { return m_pSRV.get(); }
         RHI::FRHIDescriptor* GetUAV(uint32_t mip = 0) const;
+
+        // 流式加载的纹理在上传的 fence 完成之前不可采样
+        // 由渲染线程设置，模拟线程读取，先判断标记再访问 m_pTexture
+        bool IsResident() const { return m_bResident.load(std::memory_order_acquire) && m_pTexture != nullptr; }
+        void SetResident(bool resident) { m_bResident.store(resident, std::memory_order_release); }
     
     protected:
         eastl::string m_Name;
@@ -28,5 +35,6 @@ namespace RenderResources
         eastl::unique_ptr<RHI::FRHITexture> m_pTexture;
         eastl::unique_ptr<RHI::FRHIDescriptor> m_pSRV;
         eastl::vector<eastl::unique_ptr<RHI::FRHIDescriptor>> m_UAVs;
+        std::atomic<bool> m_bResident = true;
     };
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include "PipelineStateCache.hpp"
 #include "ShaderCompiler.hpp"
 #include "ShaderCache.hpp"
+#include "GenerateMips.hpp"
+#include "TextureStreamer.hpp"
 #include "RHI/RHI.hpp"
 #include "Core/VultanaEngine.hpp"
 #include "Editor/ImGUIImplement.hpp"
@@ -15,6 +17,9 @@
 #include "RenderModules/GPUDrivenStats.hpp"
 #include "Common/GlobalConstants.hlsli"
 
+#include <rpmalloc/rpmalloc.h>
+#include <enkiTS/TaskScheduler.h>
+
 #include <optional>
 #include <algorithm>
 #include <fstream>
@@ -26,13 +31,20 @@ namespace Renderer
         m_pShaderCache = eastl::make_unique<FShaderCache>(this);
         m_pShaderCompiler = eastl::make_unique<FShaderCompiler>(this);
         m_pPipelineStateCache = eastl::make_unique<FPipelineStateCache>(this);
-        m_CBAllocator = eastl::make_unique<FLinearAllocator>(1024 * 1024 * 8);
         
+        // 包括渲染线程占用的外部线程槽
+        const uint32_t threadCount = Core::FVultanaEngine::GetEngineInstance()->GetTaskScheduler()->GetNumTaskThreads();
+        for (FFramePacket& packet : m_FramePackets)
+        {
+            packet.ThreadSubmissions.resize(threadCount);
+        }
+
         Core::FVultanaEngine::GetEngineInstance()->OnWindowResizeSignal.connect(&FRendererBase::OnWindowResize, this);
     }
 
     FRendererBase::~FRendererBase()
     {
+        StopRenderThread();
         WaitGPU();
 
         if (m_pRenderGraph)
@@ -52,6 +64,7 @@ namespace Renderer
 
         RHI::FRHIDeviceDesc deviceDesc {};
         deviceDesc.RenderBackend = backend;
+        deviceDesc.PipelineCacheFile = Core::FVultanaEngine::GetEngineInstance()->GetWorkingPath() + "Cache/PipelineCache.bin";
         m_pDevice.reset(RHI::CreateRHIDevice(deviceDesc));
         if (m_pDevice == nullptr)
         {
@@ -84,8 +97,9 @@ namespace Renderer
         {
             eastl::string name = fmt::format("RendererBase::UploadCmdList{}", i).c_str();
             m_pUploadCmdList[i].reset(m_pDevice->CreateCommandList(RHI::ERHICommandQueueType::Copy, name));
-            m_pStagingBufferAllocators[i] = eastl::make_unique<FStagingBufferAllocator>(this);
         }
+        m_pStagingBufferAllocator = eastl::make_unique<FStagingBufferAllocator>(m_pDevice.get(), m_pUploadFence.get());
+        m_pTextureStreamer = eastl::make_unique<FTextureStreamer>(this);
 
         CreateCommonResources();
 
@@ -102,16 +116,22 @@ namespace Renderer
 
     void FRendererBase::RenderFrame()
     {
-        m_pGPUScene->Update();
-
         BuildRenderGraph(m_OutputColorHandle, m_OutputDepthHandle);
 
+        m_pTextureStreamer->Tick();
+
         BeginFrame();
+        // 等到本帧 slot 的 fence 之后再覆盖 GPUScene 的 constant/update buffer
+        m_pGPUScene->Update(GetRenderFramePacket());
         UploadResource();
         Render();
         EndFrame();
 
-        MouseHitTest();
+        // 不等待 GPU：已经完成的帧直接回调，未完成的留到之后的帧
+        for (uint32_t i = 0; i < RHI::RHI_MAX_INFLIGHT_FRAMES; i++)
+        {
+            ResolveMouseHitTests(i);
+        }
     }
 
     void FRendererBase::WaitGPU()
@@ -122,11 +142,149 @@ namespace Renderer
         }
     }
 
+    void FRendererBase::SubmitFrame()
+    {
+        // 上一帧的渲染阶段结束后，render packet 和渲染线程独占的状态才能被改动
+        FlushRenderThread();
+
+        FFramePacket& packet = GetSimFramePacket();
+
+        Scene::FWorld* pWorld = Core::FVultanaEngine::GetEngineInstance()->GetWorld();
+        Scene::ILight* pMainLight = pWorld->GetMainLight();
+        pWorld->GetCamera()->SetupCameraCB(packet.SceneConstants.CameraCB);
+        packet.SceneConstants.LightColor = pMainLight->GetLightColor();
+        packet.SceneConstants.LightDirection = pMainLight->GetLightDirection();
+        packet.SceneConstants.LightRadius = pMainLight->GetLightRadius();
+        packet.SceneConstants.FrameTime = Core::FVultanaEngine::GetEngineInstance()->GetDeltaTime();
+        packet.SceneConstants.bEnableStats = m_bGPUDrivenStatsEnabled ? 1u : 0u;
+        packet.SceneConstants.bShowMeshlets = m_bShowMeshlets ? 1u : 0u;
+        packet.SceneConstants.MeshletLodErrorThreshold = m_MeshletLodErrorThreshold;
+        packet.InstanceCount = m_pGPUScene->GetInstanceCount();
+        packet.MergeThreadSubmissions();
+
+        m_PendingMouseHitTests.insert(m_PendingMouseHitTests.end(), m_NewMouseHitTests.begin(), m_NewMouseHitTests.end());
+        m_NewMouseHitTests.clear();
+        packet.bObjectIDRendering = !m_PendingMouseHitTests.empty();
+        // 这一帧处理不完的请求留到下一帧，模拟阶段需要继续提交 ID pass 的 batch
+        m_bEnableObjectIDRendering = m_PendingMouseHitTests.size() > MAX_MOUSE_HIT_TESTS_PER_FRAME;
+
+        m_SimPacketIndex = GetRenderPacketIndex();
+
+        if (m_RenderThread.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_RenderThreadMutex);
+                m_bRenderFramePending = true;
+            }
+            m_RenderThreadCV.notify_all();
+        }
+        else
+        {
+            RenderFrame();
+        }
+    }
+
+    FThreadSubmission& FRendererBase::GetThreadSubmission()
+    {
+        uint32_t threadNum = Core::FVultanaEngine::GetEngineInstance()->GetTaskScheduler()->GetThreadNum();
+        FFramePacket& packet = GetSimFramePacket();
+        assert(threadNum < packet.ThreadSubmissions.size() && "Submitting from a thread not registered in enkiTS");
+        return packet.ThreadSubmissions[threadNum];
+    }
+
+    void FRendererBase::FlushRenderThread()
+    {
+        std::unique_lock<std::mutex> lock(m_RenderThreadMutex);
+        m_RenderThreadCV.wait(lock, [this]() { return !m_bRenderFramePending; });
+    }
+
+    void FRendererBase::SetRenderThreadEnabled(bool enabled)
+    {
+        if (enabled == m_RenderThread.joinable())
+        {
+            return;
+        }
+
+        if (enabled)
+        {
+            m_bExitRenderThread = false;
+            m_RenderThread = std::thread(&FRendererBase::RenderThreadMain, this);
+        }
+        else
+        {
+            StopRenderThread();
+        }
+    }
+
+    void FRendererBase::StopRenderThread()
+    {
+        if (!m_RenderThread.joinable())
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_RenderThreadMutex);
+            m_bExitRenderThread = true;
+        }
+        m_RenderThreadCV.notify_all();
+        m_RenderThread.join();
+    }
+
+    void FRendererBase::RenderThreadMain()
+    {
+        rpmalloc_thread_initialize();
+        // Only in Windows
+        SetThreadDescription(GetCurrentThread(), L"RenderThread");
+
+        // render graph 的并行录制和 shader 编译需要在 enkiTS 中注册过的线程上等待任务
+        enki::TaskScheduler* pTaskScheduler = Core::FVultanaEngine::GetEngineInstance()->GetTaskScheduler();
+        const bool bRegistered = pTaskScheduler->RegisterExternalTaskThread();
+        assert(bRegistered && "No external task thread slot left for the render thread");
+
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_RenderThreadMutex);
+                m_RenderThreadCV.wait(lock, [this]() { return m_bRenderFramePending || m_bExitRenderThread; });
+                // 退出前先把已经提交的帧渲染完
+                if (!m_bRenderFramePending)
+                {
+                    break;
+                }
+            }
+
+            RenderFrame();
+
+            {
+                std::lock_guard<std::mutex> lock(m_RenderThreadMutex);
+                m_bRenderFramePending = false;
+            }
+            m_RenderThreadCV.notify_all();
+        }
+
+        if (bRegistered)
+        {
+            pTaskScheduler->DeRegisterExternalTaskThread();
+        }
+        rpmalloc_thread_finalize(1);
+    }
+
     RHI::FRHIShader *FRendererBase::GetShader(const eastl::string &file, const eastl::string &entryPoint, RHI::ERHIShaderType type, const eastl::vector<eastl::string> &defines, RHI::ERHIShaderCompileFlags flags)
     {
         return m_pShaderCache->GetShader(file, entryPoint, type, defines, flags);
     }
 
+    RHI::FRHIShader *FRendererBase::GetShaderAsync(const eastl::string &file, const eastl::string &entryPoint, RHI::ERHIShaderType type, const eastl::vector<eastl::string> &defines, RHI::ERHIShaderCompileFlags flags)
+    {
+        return m_pShaderCache->GetShaderAsync(file, entryPoint, type, defines, flags);
+    }
+
+    void FRendererBase::WaitForShaderCompilation()
+    {
+        m_pShaderCache->WaitForPendingShaders();
+    }
+
     RHI::FRHIPipelineState *FRendererBase::GetPipelineState(const RHI::FRHIGraphicsPipelineStateDesc &desc, const eastl::string &name)
     {
         return m_pPipelineStateCache->GetPipelineState(desc, name);
@@ -144,6 +302,8 @@ namespace Renderer
 
     void FRendererBase::ReloadShaders()
     {
+        // 重新编译会替换渲染线程正在使用的 PSO
+        FlushRenderThread();
         m_pShaderCache->ReloadShaders();
     }
 
@@ -268,18 +428,47 @@ namespace Renderer
 
     uint32_t FRendererBase::AllocateSceneConstantBuffer(const void *data, uint32_t size)
     {
-        uint32_t address = m_pGPUScene->AllocateConstantBuffer(size);
+        return m_pGPUScene->AllocateConstantBuffer(GetSimFramePacket(), data, size);
+    }
+
+    uint32_t FRendererBase::AllocateSceneConstantBuffer(FFramePacket &packet, const void *data, uint32_t size)
+    {
+        return m_pGPUScene->AllocateConstantBuffer(packet, data, size);
+    }
+
+    uint32_t FRendererBase::AllocateInstance()
+    {
+        return m_pGPUScene->AllocateInstance();
+    }
+
+    void FRendererBase::FreeInstance(uint32_t instanceIndex)
+    {
+        m_pGPUScene->FreeInstance(instanceIndex);
+    }
+
+    void FRendererBase::UpdateInstance(uint32_t instanceIndex, const FInstanceData &instanceData)
+    {
+        m_pGPUScene->UpdateInstance(instanceIndex, instanceData);
+    }
+
+    OffsetAllocator::Allocation FRendererBase::AllocateSceneInstanceBuffer(const void *data, uint32_t size)
+    {
+        OffsetAllocator::Allocation allocation = m_pGPUScene->AllocateInstanceBuffer(size);
         if (data)
         {
-            void* dst = (char*)m_pGPUScene->GetSceneConstantBuffer()->GetCPUAddress() + address;
-            memcpy(dst, data, size);
+            m_pGPUScene->UpdateInstanceBuffer(allocation.offset, data, size);
         }
-        return address;
+        return allocation;
+    }
+
+    void FRendererBase::UpdateSceneInstanceBuffer(OffsetAllocator::Allocation allocation, const void *data, uint32_t size)
+    {
+        m_pGPUScene->UpdateInstanceBuffer(allocation.offset, data, size);
     }
 
-    uint32_t FRendererBase::AddInstance(const FInstanceData &instanceData)
+    void FRendererBase::FreeSceneInstanceBuffer(OffsetAllocator::Allocation allocation)
     {
-        return m_pGPUScene->AddInstance(instanceData);
+        m_pGPUScene->FreeInstanceBuffer(allocation);
     }
 
     inline void imageCopy(char* srcData, char* dstData, uint32_t srcRowPitch, uint32_t dstRowPitch, uint32_t rowNum, uint32_t d)
@@ -287,6 +476,13 @@ namespace Renderer
         uint32_t srcSliceSize = srcRowPitch * rowNum;
         uint32_t dstSliceSize = dstRowPitch * rowNum;
 
+        // 行间距一致时整块拷贝
+        if (srcRowPitch == dstRowPitch)
+        {
+            memcpy(dstData, srcData, srcSliceSize * d);
+            return;
+        }
+
         for (uint32_t z = 0; z < d; z++)
         {
             char* srcSlice = srcData + z * srcSliceSize;
@@ -301,11 +497,14 @@ namespace Renderer
 
     void FRendererBase::UploadTexture(RHI::FRHITexture* pTexture, const void *pData)
     {
-        uint32_t frameIndex = m_pDevice->GetFrameID() % RHI::RHI_MAX_INFLIGHT_FRAMES;
-        FStagingBufferAllocator* pAllocator = m_pStagingBufferAllocators[frameIndex].get();
+        std::lock_guard<std::mutex> lock(m_UploadMutex);
 
         uint32_t requiredSize = pTexture->GetRequiredStagingBufferSize();
-        FStagingBuffer buffer = pAllocator->Allocate(requiredSize);
+        FStagingBuffer buffer = m_pStagingBufferAllocator->Allocate(requiredSize);
+        if (buffer.Buffer == nullptr)
+        {
+            return;
+        }
 
         const RHI::FRHITextureDesc& desc = pTexture->GetDesc();
 
@@ -321,8 +520,9 @@ namespace Renderer
         {
             for (uint32_t mip = 0; mip < desc.MipLevels; ++mip)
             {
-                uint32_t w = max(desc.Width >> mip, minWidth);
-                uint32_t h = max(desc.Height >> mip, minHeight);
+                // 块压缩格式不足整块的 mip 按整块计算行数和行距
+                uint32_t w = RoundUpPow2(max(desc.Width >> mip, 1u), minWidth);
+                uint32_t h = RoundUpPow2(max(desc.Height >> mip, 1u), minHeight);
                 uint32_t d = max(desc.Depth >> mip, 1u);
 
                 uint32_t srcRowPitch = GetFormatRowPitch(desc.Format, w) * GetFormatBlockHeight(desc.Format);
@@ -347,12 +547,23 @@ namespace Renderer
 
     }
 
+    void FRendererBase::RequestGenerateMips(RenderResources::FTexture2D *texture, bool normalMap)
+    {
+        assert(texture->GetTexture()->GetDesc().Usage & RHI::RHITextureUsageUnorderedAccess);
+
+        std::lock_guard<std::mutex> lock(m_UploadMutex);
+        m_PendingMipGeneration.push_back({ texture, normalMap });
+    }
+
     void FRendererBase::UploadBuffer(RHI::FRHIBuffer *pBuffer, const void *pData, uint32_t offset, uint32_t dataSize)
     {
-        uint32_t frameIndex = m_pDevice->GetFrameID() % RHI::RHI_MAX_INFLIGHT_FRAMES;
-        FStagingBufferAllocator* pAllocator = m_pStagingBufferAllocators[frameIndex].get();
+        std::lock_guard<std::mutex> lock(m_UploadMutex);
 
-        FStagingBuffer stagingBuffer = pAllocator->Allocate(dataSize);
+        FStagingBuffer stagingBuffer = m_pStagingBufferAllocator->Allocate(dataSize);
+        if (stagingBuffer.Buffer == nullptr)
+        {
+            return;
+        }
 
         char* dstData = (char*)stagingBuffer.Buffer->GetCPUAddress() + stagingBuffer.Offset;
         memcpy(dstData, pData, dataSize);
@@ -366,20 +577,13 @@ namespace Renderer
 
     void FRendererBase::SetupGlobalConstants(RHI::FRHICommandList *pCmdList)
     {
-        Scene::FWorld* pWorld = Core::FVultanaEngine::GetEngineInstance()->GetWorld();
-        Scene::FCamera* pCamera = pWorld->GetCamera();
-        Scene::ILight* pMainLight = pWorld->GetMainLight();
-
-        FSceneConstants sceneConstants {};
-        pCamera->SetupCameraCB(sceneConstants.CameraCB);
+        // 相机、光源等模拟阶段的数据在 SubmitFrame 时已经写入 packet
+        FSceneConstants sceneConstants = GetRenderFramePacket().SceneConstants;
         sceneConstants.SceneConstantBufferSRV = m_pGPUScene->GetSceneConstantBufferSRV()->GetHeapIndex();
         sceneConstants.SceneStaticBufferSRV = m_pGPUScene->GetSceneStaticBufferSRV()->GetHeapIndex();
         sceneConstants.SceneAnimationBufferSRV = m_pGPUScene->GetSceneAnimationBufferSRV()->GetHeapIndex();
         sceneConstants.SceneAnimationBufferUAV = m_pGPUScene->GetSceneAnimationBufferUAV()->GetHeapIndex();
-        sceneConstants.instanceDataAddress = m_pGPUScene->GetInstanceDataAddress();
-        sceneConstants.LightColor = pMainLight->GetLightColor();
-        sceneConstants.LightDirection = pMainLight->GetLightDirection();
-        sceneConstants.LightRadius = pMainLight->GetLightRadius();
+        sceneConstants.SceneInstanceBufferSRV = m_pGPUScene->GetSceneInstanceBufferSRV()->GetHeapIndex();
 
         sceneConstants.RenderSize = uint2(m_RenderWidth, m_RenderHeight);
         sceneConstants.RenderSizeInv = float2(1.0f / m_RenderWidth, 1.0f / m_RenderHeight);
@@ -420,11 +624,8 @@ namespace Renderer
         }
 
         // GPU Driven Stats
-        sceneConstants.bEnableStats = m_bGPUDrivenStatsEnabled ? 1u : 0u;
         sceneConstants.StatsBufferUAV = m_pGPUDrivenStats->GetStatsBufferUAV()->GetHeapIndex();
 
-        sceneConstants.bShowMeshlets = m_bShowMeshlets ? 1u : 0u;
-
         sceneConstants.PointRepeatSampler = m_pPointRepeatSampler->GetHeapIndex();
         sceneConstants.PointClampSampler = m_pPointClampSampler->GetHeapIndex();
         sceneConstants.BilinearRepeatSampler = m_pBilinearRepeatSampler->GetHeapIndex();
@@ -436,7 +637,6 @@ namespace Renderer
         sceneConstants.Aniso8xSampler = m_pAniso8xSampler->GetHeapIndex();
         sceneConstants.Aniso16xSampler = m_pAniso16xSampler->GetHeapIndex();
 
-        sceneConstants.FrameTime = Core::FVultanaEngine::GetEngineInstance()->GetDeltaTime();
         sceneConstants.FrameIndex = (uint32_t)GetFrameID();
 
         if (pCmdList->GetQueueType() == RHI::ERHICommandQueueType::Graphics)
@@ -447,15 +647,18 @@ namespace Renderer
         pCmdList->SetComputeConstants(2, &sceneConstants, sizeof(FSceneConstants));
     }
 
-    FRenderBatch &FRendererBase::AddBasePassBatch()
+    void FRendererBase::RequestMouseHitTest(uint32_t x, uint32_t y, const eastl::function<void(uint32_t objectID)>& callback)
     {
-        return m_pDeferredBasePass->AddBatch();
-    }
+        FMouseHitTestRequest request;
+        request.X = x;
+        request.Y = y;
+        request.RegionX = 0;
+        request.RegionY = 0;
+        request.RegionWidth = 0;
+        request.RegionHeight = 0;
+        request.Callback = callback;
+        m_NewMouseHitTests.push_back(request);
 
-    void FRendererBase::RequestMouseHitTest(uint32_t x, uint32_t y)
-    {
-        m_MouseX = x;
-        m_MouseY = y;
         m_bEnableObjectIDRendering = true;
     }
 
@@ -530,6 +733,7 @@ namespace Renderer
 
     void FRendererBase::OnWindowResize(void* wndHandle, uint32_t width, uint32_t height)
     {
+        FlushRenderThread();
         WaitGPU();
         
         if (m_pSwapchain->GetDesc()->WindowHandle == wndHandle)
@@ -547,6 +751,9 @@ namespace Renderer
         uint32_t frameIndex = m_pDevice->GetFrameID() % RHI::RHI_MAX_INFLIGHT_FRAMES;
         m_pFrameFence->Wait(m_FrameFenceValue[frameIndex]);
 
+        // 该 slot 的 readback buffer 即将被复用，确保之前的拾取结果已经回调
+        ResolveMouseHitTests(frameIndex);
+
         m_pDevice->BeginFrame();
 
         RHI::FRHICommandList* pCmdList = m_pCmdList[frameIndex].get();
@@ -560,6 +767,8 @@ namespace Renderer
 
     void FRendererBase::UploadResource()
     {
+        std::lock_guard<std::mutex> lock(m_UploadMutex);
+
         if (m_PendingTextureUpload.empty() && m_PendingBufferUpload.empty()) return;
 
         uint32_t frameIndex = m_pDevice->GetFrameID() % RHI::RHI_MAX_INFLIGHT_FRAMES;
@@ -586,6 +795,7 @@ namespace Renderer
         pUploadeCmdList->End();
         pUploadeCmdList->Signal(m_pUploadFence.get(), ++m_CurrentUploadFenceValue);
         pUploadeCmdList->Submit();
+        m_pStagingBufferAllocator->Retire(m_CurrentUploadFenceValue);
 
         RHI::FRHICommandList* pCmdList = m_pCmdList[frameIndex].get();
         pCmdList->Wait(m_pUploadFence.get(), m_CurrentUploadFenceValue);
@@ -622,7 +832,9 @@ namespace Renderer
         m_pGPUDrivenStats->Clear(pCmdList);
 
         SetupGlobalConstants(pCmdList);
+        m_pGPUScene->FlushUpdates(pCmdList);
         FlushComputePass(pCmdList);
+        FlushMipGeneration(pCmdList);
 
         m_pRenderGraph->Execute(this, pCmdList, pComputeCmdList);
 
@@ -646,32 +858,41 @@ namespace Renderer
         pCmdList->Signal(m_pFrameFence.get(), m_CurrentFrameFenceValue);
         pCmdList->Submit();
 
-        m_pStagingBufferAllocators[frameIndex]->Reset();
-        m_CBAllocator->Reset();
-        m_pGPUScene->ResetFrameData();
-
-        m_AnimationBatches.clear();
-        m_IDPassBatches.clear();
-        m_OutlinePassBatches.clear();
+        GetRenderFramePacket().Reset();
 
         m_pDevice->EndFrame();
     }
 
     void FRendererBase::FlushComputePass(RHI::FRHICommandList *pCmdList)
     {
-        if (!m_AnimationBatches.empty())
+        const eastl::vector<FComputeBatch>& animationBatches = GetRenderFramePacket().AnimationBatches;
+        if (!animationBatches.empty())
         {
             GPU_EVENT_DEBUG(pCmdList, "Animation Pass");
             
             m_pGPUScene->BeginAnimationUpdate(pCmdList);
-            for (size_t i = 0; i < m_AnimationBatches.size(); i++)
+            for (size_t i = 0; i < animationBatches.size(); i++)
             {
-                DispatchComputeBatch(pCmdList, m_AnimationBatches[i]);
+                DispatchComputeBatch(pCmdList, animationBatches[i]);
             }
             m_pGPUScene->EndAnimationUpdate(pCmdList);
         }
     }
 
+    void FRendererBase::FlushMipGeneration(RHI::FRHICommandList *pCmdList)
+    {
+        eastl::vector<FMipGeneration> pendingMipGeneration;
+        {
+            std::lock_guard<std::mutex> lock(m_UploadMutex);
+            pendingMipGeneration.swap(m_PendingMipGeneration);
+        }
+
+        for (size_t i = 0; i < pendingMipGeneration.size(); i++)
+        {
+            GenerateMips(pCmdList, pendingMipGeneration[i].Texture, pendingMipGeneration[i].bNormalMap);
+        }
+    }
+
     void FRendererBase::RenderBackBufferPass(RHI::FRHICommandList *pCmdList)
     {
         m_pSwapchain->AcquireNextBackBuffer();
@@ -707,9 +928,10 @@ namespace Renderer
             pCmdList->SetPipelineState(m_pCopyColorPSO);
             pCmdList->Draw(3);
 
-            for (size_t i = 0; i < m_GUIBatches.size(); i++)
+            const eastl::vector<FRenderBatch>& guiBatches = GetRenderFramePacket().GUIBatches;
+            for (size_t i = 0; i < guiBatches.size(); i++)
             {
-                DrawBatch(pCmdList, m_GUIBatches[i]);
+                DrawBatch(pCmdList, guiBatches[i]);
             }
 
             m_pGPUDrivenDebugLine->Draw(pCmdList);
@@ -721,21 +943,50 @@ namespace Renderer
         pCmdList->TextureBarrier(m_pSwapchain->GetBackBuffer(), 0, RHI::RHIAccessRTV, RHI::RHIAccessPresent);
     }
 
-    void FRendererBase::MouseHitTest()
+    void FRendererBase::ResolveMouseHitTests(uint32_t frameIndex)
     {
-        if (m_bEnableObjectIDRendering)
+        FObjectIDReadback& readback = m_ObjectIDReadbacks[frameIndex];
+        if (readback.Requests.empty() || m_pFrameFence->GetCompletedValue() < m_FrameFenceValue[frameIndex])
         {
-            WaitGPU();
-            
-            uint32_t x = m_MouseX;
-            uint32_t y = m_MouseY;
+            return;
+        }
 
-            if (m_pObjectIDBuffer == nullptr) return;
-            uint8_t* data = (uint8_t*)m_pObjectIDBuffer->GetCPUAddress();
-            uint32_t dataOffset = m_ObjectIDRowPitch * y + x * sizeof(uint32_t);
-            memcpy(&m_MouseHitObjectID, data + dataOffset, sizeof(uint32_t));
+        const uint32_t* data = (const uint32_t*)readback.Buffer->GetCPUAddress();
+        for (size_t i = 0; i < readback.Requests.size(); i++)
+        {
+            const FMouseHitTestRequest& request = readback.Requests[i];
+            const uint32_t* region = data + OBJECT_ID_PICK_REGION_SIZE * OBJECT_ID_PICK_REGION_SIZE * i;
 
-            m_bEnableObjectIDRendering = false;
+            // 光标处没有物体时，取小区域内离光标最近的物体，方便点中细小的几何体
+            uint32_t objectID = OBJECT_ID_CLEAR_VALUE;
+            uint32_t minDistance = UINT32_MAX;
+            for (uint32_t y = 0; y < request.RegionHeight; y++)
+            {
+                for (uint32_t x = 0; x < request.RegionWidth; x++)
+                {
+                    uint32_t id = region[request.RegionWidth * y + x];
+                    if (id == OBJECT_ID_CLEAR_VALUE)
+                    {
+                        continue;
+                    }
+
+                    int32_t dx = (int32_t)(request.RegionX + x) - (int32_t)request.X;
+                    int32_t dy = (int32_t)(request.RegionY + y) - (int32_t)request.Y;
+                    uint32_t distance = (uint32_t)(dx * dx + dy * dy);
+                    if (distance < minDistance)
+                    {
+                        minDistance = distance;
+                        objectID = id;
+                    }
+                }
+            }
+
+            m_MouseHitObjectID.store(objectID, std::memory_order_relaxed);
+            if (request.Callback)
+            {
+                request.Callback(objectID);
+            }
         }
+        readback.Requests.clear();
     }
 } // namespace Vultana::Renderer
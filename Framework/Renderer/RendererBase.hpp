@@ -8,6 +8,7 @@
 #include "RenderResources/TypedBuffer.hpp"
 #include "RenderModules/GPUDrivenStats.hpp"
 #include "GPUScene.hpp"
+#include "FramePacket.hpp"
 #include "RenderBatch.hpp"
 #include "StagingBufferAllocator.hpp"
 
@@ -15,10 +16,16 @@
 #include "Utilities/Utility.hpp"
 #include "Utilities/Math.hpp"
 
+#include <EASTL/functional.h>
+
 #include <iostream>
 #include <deque>
 #include <memory>
 #include <functional>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 namespace Window
 {
@@ -30,6 +37,7 @@ namespace Renderer
     class FPipelineStateCache;
     class FShaderCompiler;
     class FShaderCache;
+    class FTextureStreamer;
     class FHiZBuffer;
     class FGPUDrivenStats;
 
@@ -43,10 +51,25 @@ namespace Renderer
         virtual void RenderFrame();
         void WaitGPU();
 
+        // 模拟阶段结束时调用：等待上一帧的渲染阶段，交换 frame packet，再让渲染线程处理刚填好的那一份
+        // 关闭渲染线程时在当前线程直接 RenderFrame
+        void SubmitFrame();
+        // 等待渲染线程处理完已提交的帧，之后可以安全地修改渲染阶段读取的状态
+        void FlushRenderThread();
+        void SetRenderThreadEnabled(bool enabled);
+        bool IsRenderThreadEnabled() const { return m_RenderThread.joinable(); }
+
+        // 模拟线程写 sim packet，渲染线程读 render packet
+        uint32_t GetSimPacketIndex() const { return m_SimPacketIndex; }
+        uint32_t GetRenderPacketIndex() const { return (m_SimPacketIndex + 1) % FRAME_PACKET_COUNT; }
+        FFramePacket& GetSimFramePacket() { return m_FramePackets[GetSimPacketIndex()]; }
+        FFramePacket& GetRenderFramePacket() { return m_FramePackets[GetRenderPacketIndex()]; }
+
         uint64_t GetFrameID() const { return m_pDevice->GetFrameID(); }
         class FPipelineStateCache* GetPipelineStateCache() const { return m_pPipelineStateCache.get(); }
         class FShaderCompiler* GetShaderCompiler() const { return m_pShaderCompiler.get(); }
         class FShaderCache* GetShaderCache() const { return m_pShaderCache.get(); }
+        class FTextureStreamer* GetTextureStreamer() const { return m_pTextureStreamer.get(); }
         uint32_t GetDisplayWidth() const { return m_DisplayWidth; }
         uint32_t GetDisplayHeight() const { return m_DisplayHeight; }
         uint32_t GetRenderWidth() const { return m_RenderWidth; }
@@ -55,6 +78,9 @@ namespace Renderer
         RHI::FRHIDevice* GetDevice() const { return m_pDevice.get(); }
         RHI::FRHISwapchain* GetSwapchain() const { return m_pSwapchain.get(); }
         RHI::FRHIShader* GetShader(const eastl::string& file, const eastl::string& entryPoint, RHI::ERHIShaderType type, const eastl::vector<eastl::string>& defines = {}, RHI::ERHIShaderCompileFlags flags = 0);
+        // 后台编译未完成时返回 nullptr
+        RHI::FRHIShader* GetShaderAsync(const eastl::string& file, const eastl::string& entryPoint, RHI::ERHIShaderType type, const eastl::vector<eastl::string>& defines = {}, RHI::ERHIShaderCompileFlags flags = 0);
+        void WaitForShaderCompilation();
         RHI::FRHIPipelineState* GetPipelineState(const RHI::FRHIGraphicsPipelineStateDesc& desc, const eastl::string& name);
         RHI::FRHIPipelineState* GetPipelineState(const RHI::FRHIMeshShadingPipelineStateDesc& desc, const eastl::string& name);
         RHI::FRHIPipelineState* GetPipelineState(const RHI::FRHIComputePipelineStateDesc& desc, const eastl::string& name);
@@ -79,24 +105,42 @@ namespace Renderer
         void FreeSceneAnimationBuffer(OffsetAllocator::Allocation allocation);
         
         uint32_t AllocateSceneConstantBuffer(const void* data, uint32_t size);
-        uint32_t AddInstance(const FInstanceData& instanceData);
+        uint32_t AllocateSceneConstantBuffer(FFramePacket& packet, const void* data, uint32_t size);
+
+        uint32_t AllocateInstance();
+        void FreeInstance(uint32_t instanceIndex);
+        void UpdateInstance(uint32_t instanceIndex, const FInstanceData& instanceData);
+        // 模拟线程上的实时值，渲染阶段使用 packet 中的 InstanceCount
         uint32_t GetInstanceCount() const { return m_pGPUScene->GetInstanceCount(); }
 
+        OffsetAllocator::Allocation AllocateSceneInstanceBuffer(const void* data, uint32_t size);
+        void UpdateSceneInstanceBuffer(OffsetAllocator::Allocation allocation, const void* data, uint32_t size);
+        void FreeSceneInstanceBuffer(OffsetAllocator::Allocation allocation);
+
         void UploadTexture(RHI::FRHITexture* pTexture, const void* pData);
         void UploadBuffer(RHI::FRHIBuffer* pBuffer, const void* pData, uint32_t offset, uint32_t dataSize);
+        // mip 0 已由 GPU 写好的 UAV 纹理，本帧渲染开始时在图形队列上生成其余 mip，纹理要存活到本帧 Render
+        void RequestGenerateMips(RenderResources::FTexture2D* texture, bool normalMap = false);
+        RHI::FRHIFence* GetUploadFence() const { return m_pUploadFence.get(); }
+        // 本帧 UploadResource 提交时 signal 的值
+        uint64_t GetNextUploadFenceValue() const { return m_CurrentUploadFenceValue + 1; }
 
         void SetupGlobalConstants(RHI::FRHICommandList* pCmdList);
 
-        FLinearAllocator* GetConstantAllocator() { return m_CBAllocator.get(); }
-        FRenderBatch& AddBasePassBatch();
-        FComputeBatch& AddAnimationBatch() { return m_AnimationBatches.emplace_back(*m_CBAllocator); }
-        FRenderBatch& AddOutlinePassBatch() { return m_OutlinePassBatches.emplace_back(*m_CBAllocator); }
-        FRenderBatch& AddObjectIDPassBatch() { return m_IDPassBatches.emplace_back(*m_CBAllocator); }
-        FRenderBatch& AddGUIBatch() { return m_GUIBatches.emplace_back(*m_CBAllocator); }
-
-        void RequestMouseHitTest(uint32_t x, uint32_t y);
+        // 模拟阶段的提交可以来自任意 enkiTS 线程，各自写入当前线程的列表，SubmitFrame 时合并
+        FThreadSubmission& GetThreadSubmission();
+        FLinearAllocator* GetConstantAllocator() { return &GetSimFramePacket().CBAllocator; }
+        FRenderBatch& AddBasePassBatch() { return GetThreadSubmission().BasePassBatches.emplace_back(*GetConstantAllocator()); }
+        FComputeBatch& AddAnimationBatch() { return GetThreadSubmission().AnimationBatches.emplace_back(*GetConstantAllocator()); }
+        FRenderBatch& AddOutlinePassBatch() { return GetThreadSubmission().OutlinePassBatches.emplace_back(*GetConstantAllocator()); }
+        FRenderBatch& AddObjectIDPassBatch() { return GetThreadSubmission().IDPassBatches.emplace_back(*GetConstantAllocator()); }
+        FRenderBatch& AddGUIBatch() { return GetThreadSubmission().GUIBatches.emplace_back(*GetConstantAllocator()); }
+
+        // 异步拾取：结果在对应帧的 GPU fence 完成后回调，默认也会写入 GetMouseHitObjectID
+        // 开启渲染线程时回调在渲染线程上执行
+        void RequestMouseHitTest(uint32_t x, uint32_t y, const eastl::function<void(uint32_t objectID)>& callback = nullptr);
         bool IsEnableMouseHitTest() const { return m_bEnableObjectIDRendering; }
-        uint32_t GetMouseHitObjectID() const { return m_MouseHitObjectID; }
+        uint32_t GetMouseHitObjectID() const { return m_MouseHitObjectID.load(std::memory_order_relaxed); }
 
         class FDeferredBasePass* GetDeferredBasePass() { return m_pDeferredBasePass.get(); }
         class FHiZBuffer* GetHiZBuffer() { return m_pHZB.get(); }
@@ -107,6 +151,8 @@ namespace Renderer
         void SetGPUDrivenStatsEnabled(bool enabled) { m_bGPUDrivenStatsEnabled = enabled; }
         bool IsShowMeshletsEnabled() const { return m_bShowMeshlets; }
         void SetShowMeshletsEnabled(bool enabled) { m_bShowMeshlets = enabled; }
+        float GetMeshletLodErrorThreshold() const { return m_MeshletLodErrorThreshold; }
+        void SetMeshletLodErrorThreshold(float threshold) { m_MeshletLodErrorThreshold = threshold; }
 
     protected:
         virtual void CreateCommonResources();
@@ -122,13 +168,17 @@ namespace Renderer
         void CopyHistoryPass(RG::FRGHandle sceneDepth, /* RG::RGHandle sceneNormal, */ RG::FRGHandle sceneColor);
 
         void FlushComputePass(RHI::FRHICommandList* pCmdList);
+        void FlushMipGeneration(RHI::FRHICommandList* pCmdList);
         void ImportPrevFrameTextures();
         virtual void RenderBackBufferPass(RHI::FRHICommandList* pCmdList);
     
     private:
         void BuildRenderGraph(RG::FRGHandle& outputColor, RG::FRGHandle& outputDepth);
 
-        void MouseHitTest();
+        void ResolveMouseHitTests(uint32_t frameIndex);
+
+        void RenderThreadMain();
+        void StopRenderThread();
 
     private:
         eastl::unique_ptr<RHI::FRHIDevice> m_pDevice;
@@ -136,6 +186,7 @@ namespace Renderer
         eastl::unique_ptr<class FPipelineStateCache> m_pPipelineStateCache;
         eastl::unique_ptr<class FShaderCompiler> m_pShaderCompiler;
         eastl::unique_ptr<class FShaderCache> m_pShaderCache;
+        eastl::unique_ptr<class FTextureStreamer> m_pTextureStreamer;
         eastl::unique_ptr<FGPUScene> m_pGPUScene;
         eastl::unique_ptr<RG::FRenderGraph> m_pRenderGraph;
 
@@ -146,7 +197,14 @@ namespace Renderer
         float m_UpscaleRatio = 1.0f;
         float m_MipBias = 0.0f;
 
-        eastl::unique_ptr<FLinearAllocator> m_CBAllocator;
+        FFramePacket m_FramePackets[FRAME_PACKET_COUNT];
+        uint32_t m_SimPacketIndex = 0;
+
+        std::thread m_RenderThread;
+        std::mutex m_RenderThreadMutex;
+        std::condition_variable m_RenderThreadCV;
+        bool m_bRenderFramePending = false;
+        bool m_bExitRenderThread = false;
 
         uint64_t m_CurrentFrameFenceValue = 0;
         uint64_t m_FrameFenceValue[RHI::RHI_MAX_INFLIGHT_FRAMES] = {};
@@ -157,10 +215,12 @@ namespace Renderer
         eastl::unique_ptr<RHI::FRHIFence> m_pAsyncComputeFence;
         eastl::unique_ptr<RHI::FRHICommandList> m_pAsyncComputeCmdList[RHI::RHI_MAX_INFLIGHT_FRAMES];
 
+        // 上传可以从模拟线程发起（资源创建）也可以从渲染线程发起（纹理流式加载），提交在渲染线程
+        std::mutex m_UploadMutex;
         uint64_t m_CurrentUploadFenceValue = 0;
         eastl::unique_ptr<RHI::FRHIFence> m_pUploadFence;
         eastl::unique_ptr<RHI::FRHICommandList> m_pUploadCmdList[RHI::RHI_MAX_INFLIGHT_FRAMES];
-        eastl::unique_ptr<FStagingBufferAllocator> m_pStagingBufferAllocators[RHI::RHI_MAX_INFLIGHT_FRAMES];
+        eastl::unique_ptr<FStagingBufferAllocator> m_pStagingBufferAllocator;
 
         struct FTextureUpload
         {
@@ -180,6 +240,13 @@ namespace Renderer
         };
         eastl::vector<FBufferUpload> m_PendingBufferUpload;
 
+        struct FMipGeneration
+        {
+            RenderResources::FTexture2D* Texture;
+            bool bNormalMap;
+        };
+        eastl::vector<FMipGeneration> m_PendingMipGeneration;
+
         eastl::unique_ptr<RHI::FRHIDescriptor> m_pAniso2xSampler;
         eastl::unique_ptr<RHI::FRHIDescriptor> m_pAniso4xSampler;
         eastl::unique_ptr<RHI::FRHIDescriptor> m_pAniso8xSampler;
@@ -201,12 +268,36 @@ namespace Renderer
 
         eastl::unique_ptr<RenderResources::FTypedBuffer> m_pSPDCounterBuffer;
 
+        static constexpr uint32_t OBJECT_ID_CLEAR_VALUE = 1000000;
+        static constexpr uint32_t OBJECT_ID_PICK_REGION_SIZE = 5;
+        static constexpr uint32_t MAX_MOUSE_HIT_TESTS_PER_FRAME = 8;
+
+        struct FMouseHitTestRequest
+        {
+            uint32_t X;
+            uint32_t Y;
+            uint32_t RegionX;
+            uint32_t RegionY;
+            // 纹理小于 OBJECT_ID_PICK_REGION_SIZE 时裁剪到纹理大小
+            uint32_t RegionWidth;
+            uint32_t RegionHeight;
+            eastl::function<void(uint32_t objectID)> Callback;
+        };
+
+        // 每个 in-flight 帧一个 readback buffer，只拷贝光标附近的小块区域
+        struct FObjectIDReadback
+        {
+            eastl::unique_ptr<RHI::FRHIBuffer> Buffer;
+            eastl::vector<FMouseHitTestRequest> Requests;
+        };
+
+        // 模拟线程：新请求和下一帧是否需要提交 ID pass 的 batch
         bool m_bEnableObjectIDRendering = false;
-        uint32_t m_MouseX = 0;
-        uint32_t m_MouseY = 0;
-        uint32_t m_MouseHitObjectID = UINT32_MAX;
-        eastl::unique_ptr<RHI::FRHIBuffer> m_pObjectIDBuffer;
-        uint32_t m_ObjectIDRowPitch = 0;
+        eastl::vector<FMouseHitTestRequest> m_NewMouseHitTests;
+        // 渲染线程：交接时从 m_NewMouseHitTests 转入，ID pass 每帧最多处理 MAX_MOUSE_HIT_TESTS_PER_FRAME 个
+        eastl::vector<FMouseHitTestRequest> m_PendingMouseHitTests;
+        std::atomic<uint32_t> m_MouseHitObjectID = UINT32_MAX;
+        FObjectIDReadback m_ObjectIDReadbacks[RHI::RHI_MAX_INFLIGHT_FRAMES];
 
         RG::FRGHandle m_OutputColorHandle;
         RG::FRGHandle m_OutputDepthHandle;
@@ -222,6 +313,7 @@ namespace Renderer
         eastl::unique_ptr<class FGPUDrivenStats> m_pGPUDrivenStats;
         bool m_bGPUDrivenStatsEnabled = false;
         bool m_bShowMeshlets = false;
+        float m_MeshletLodErrorThreshold = 1.0f;   // 屏幕上允许的几何误差（像素）
 
         // Per-frame transient handles, cached in BuildRenderGraph and resolved in SetupGlobalConstants
         RG::FRGHandle m_CullingHZB1stPhaseHandle;
@@ -230,10 +322,5 @@ namespace Renderer
         RG::FRGHandle m_SecondPhaseMeshletListHandle;
         RG::FRGHandle m_SecondPhaseMeshletListCounterHandle;
 
-        eastl::vector<FComputeBatch> m_AnimationBatches;
-
-        eastl::vector<FRenderBatch> m_OutlinePassBatches;
-        eastl::vector<FRenderBatch> m_IDPassBatches;
-        eastl::vector<FRenderBatch> m_GUIBatches;
     };
 }
\ No newline at end of file
@@ -0,0 +1,241 @@
+#include "ShaderBinaryCache.hpp"
+
+#include "Utilities/Hash.hpp"
+#include "Utilities/Log.hpp"
+
+#include <EASTL/algorithm.h>
+#include <fmt/format.h>
+
+#include <fstream>
+#include <filesystem>
+#include <regex>
+
+namespace Renderer
+{
+    static const uint32_t SHADER_BINARY_MAGIC = 0x43425356; // "VSBC"
+    // 文件格式或 key 的组成方式变化时需要递增
+    static const uint32_t SHADER_BINARY_VERSION = 1;
+
+    struct FShaderBinaryHeader
+    {
+        uint32_t Magic;
+        uint32_t Version;
+        uint64_t Key;
+        uint64_t DataHash;
+        uint32_t DataSize;
+        uint32_t _Padding;
+    };
+
+    FShaderBinaryCache::FShaderBinaryCache(const eastl::string &cacheDirectory, const FFileLoader &fileLoader, const eastl::string &includeDirectory)
+    {
+        m_CacheDirectory = cacheDirectory;
+        m_FileLoader = fileLoader;
+        m_IncludeDirectory = includeDirectory;
+
+        std::error_code ec;
+        std::filesystem::create_directories(m_CacheDirectory.c_str(), ec);
+    }
+
+    bool FShaderBinaryCache::GetOrCompile(const FShaderBinaryKeyDesc &desc, const FCompiler &compiler, eastl::vector<uint8_t> &output)
+    {
+        uint64_t key = 0;
+        if (!ComputeKey(desc, key))
+        {
+            // 不把找不到的 include 当作空文件，否则该文件出现后仍会命中旧结果
+            m_BypassCount++;
+            return compiler(m_FileLoader(desc.File), output);
+        }
+
+        if (Load(key, output))
+        {
+            m_HitCount++;
+            return true;
+        }
+
+        m_MissCount++;
+        if (!compiler(m_FileLoader(desc.File), output))
+        {
+            return false;
+        }
+
+        Store(key, output);
+        return true;
+    }
+
+    bool FShaderBinaryCache::ComputeKey(const FShaderBinaryKeyDesc &desc, uint64_t &key)
+    {
+        // 只用文件内容而不是路径，工程目录移动后缓存依然有效
+        eastl::string source = m_FileLoader(desc.File);
+
+        eastl::string keyString = fmt::format("{:016x};", Utility::FHashUtils::CityHash(source.data(), source.size())).c_str();
+
+        eastl::vector<eastl::string> visited;
+        visited.push_back(std::filesystem::absolute(desc.File.c_str()).lexically_normal().string().c_str());
+        if (!HashIncludes(desc.File, desc.File, source, visited, keyString))
+        {
+            return false;
+        }
+
+        keyString += desc.EntryPoint + ";" + desc.Profile + ";" + desc.CompilerVersion + ";";
+        keyString += fmt::format("{};", desc.CompileFlags).c_str();
+        for (size_t i = 0; i < desc.Defines.size(); i++)
+        {
+            keyString += desc.Defines[i] + ";";
+        }
+
+        key = Utility::FHashUtils::CityHash(keyString.data(), keyString.size());
+        return true;
+    }
+
+    FShaderBinaryCacheStats FShaderBinaryCache::GetStats() const
+    {
+        FShaderBinaryCacheStats stats;
+        stats.HitCount = m_HitCount;
+        stats.MissCount = m_MissCount;
+        stats.CorruptedCount = m_CorruptedCount;
+        stats.BypassCount = m_BypassCount;
+        return stats;
+    }
+
+    eastl::string FShaderBinaryCache::GetCacheFilePath(uint64_t key) const
+    {
+        return m_CacheDirectory + fmt::format("{:016x}.bin", key).c_str();
+    }
+
+    bool FShaderBinaryCache::Load(uint64_t key, eastl::vector<uint8_t> &output)
+    {
+        eastl::string path = GetCacheFilePath(key);
+
+        std::ifstream is(path.c_str(), std::ios::binary);
+        if (is.fail())
+        {
+            return false;
+        }
+
+        is.seekg(0, std::ios::end);
+        size_t fileSize = (size_t)is.tellg();
+        is.seekg(0, std::ios::beg);
+
+        FShaderBinaryHeader header {};
+        bool valid = fileSize >= sizeof(FShaderBinaryHeader);
+        if (valid)
+        {
+            is.read((char*)&header, sizeof(header));
+            valid = header.Magic == SHADER_BINARY_MAGIC &&
+                header.Version == SHADER_BINARY_VERSION &&
+                header.Key == key &&
+                header.DataSize == fileSize - sizeof(FShaderBinaryHeader);
+        }
+        if (valid)
+        {
+            output.resize(header.DataSize);
+            is.read((char*)output.data(), header.DataSize);
+            valid = !is.fail() && Utility::FHashUtils::CityHash(output.data(), output.size()) == header.DataHash;
+        }
+        is.close();
+
+        if (!valid)
+        {
+            // 损坏或旧版本的文件直接删掉，随后由编译结果覆盖
+            VTNA_LOG_WARN("[ShaderBinaryCache] Discarding invalid cache file: {}", path);
+            std::error_code ec;
+            std::filesystem::remove(path.c_str(), ec);
+            output.clear();
+            m_CorruptedCount++;
+            return false;
+        }
+        return true;
+    }
+
+    bool FShaderBinaryCache::Store(uint64_t key, const eastl::vector<uint8_t> &data)
+    {
+        FShaderBinaryHeader header {};
+        header.Magic = SHADER_BINARY_MAGIC;
+        header.Version = SHADER_BINARY_VERSION;
+        header.Key = key;
+        header.DataHash = Utility::FHashUtils::CityHash(data.data(), data.size());
+        header.DataSize = (uint32_t)data.size();
+
+        // 先写临时文件再重命名，进程中途退出也不会留下半个文件
+        eastl::string path = GetCacheFilePath(key);
+        eastl::string tempPath = path + ".tmp";
+
+        std::ofstream os(tempPath.c_str(), std::ios::binary | std::ios::trunc);
+        if (os.fail())
+        {
+            VTNA_LOG_ERROR("[ShaderBinaryCache] Failed to write cache file: {}", tempPath);
+            return false;
+        }
+        os.write((const char*)&header, sizeof(header));
+        os.write((const char*)data.data(), data.size());
+        os.close();
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath.c_str(), path.c_str(), ec);
+        if (ec)
+        {
+            std::filesystem::remove(tempPath.c_str(), ec);
+            return false;
+        }
+        return true;
+    }
+
+    bool FShaderBinaryCache::HashIncludes(const eastl::string &mainFile, const eastl::string &file, const eastl::string &source, eastl::vector<eastl::string> &visited, eastl::string &keyString)
+    {
+        std::regex r("#include\\s*\"\\s*(\\S+)\\s*\"");
+        std::string text = source.c_str();
+
+        for (std::sregex_iterator iter(text.begin(), text.end(), r), end; iter != end; ++iter)
+        {
+            eastl::string header;
+            if (!ResolveInclude(mainFile, file, (*iter)[1].str().c_str(), header))
+            {
+                VTNA_LOG_WARN("[ShaderBinaryCache] Cannot resolve include \"{}\" in {}, skip cache", (*iter)[1].str(), file);
+                return false;
+            }
+
+            if (eastl::find(visited.begin(), visited.end(), header) != visited.end())
+            {
+                continue;
+            }
+            visited.push_back(header);
+
+            eastl::string headerSource = m_FileLoader(header);
+            keyString += fmt::format("{}:{:016x};", (*iter)[1].str(), Utility::FHashUtils::CityHash(headerSource.data(), headerSource.size())).c_str();
+
+            if (!HashIncludes(mainFile, header, headerSource, visited, keyString))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool FShaderBinaryCache::ResolveInclude(const eastl::string &mainFile, const eastl::string &includer, const eastl::string &include, eastl::string &path) const
+    {
+        // 与 DXC 的查找顺序一致：includer 所在目录、主文件所在目录、-I 目录
+        std::filesystem::path directories[] =
+        {
+            std::filesystem::path(includer.c_str()).parent_path(),
+            std::filesystem::path(mainFile.c_str()).parent_path(),
+            std::filesystem::path(m_IncludeDirectory.c_str()),
+        };
+
+        for (const std::filesystem::path& directory : directories)
+        {
+            if (directory.empty())
+            {
+                continue;
+            }
+
+            std::filesystem::path candidate = std::filesystem::absolute(directory / include.c_str()).lexically_normal();
+            std::error_code ec;
+            if (std::filesystem::is_regular_file(candidate, ec))
+            {
+                path = candidate.string().c_str();
+                return true;
+            }
+        }
+        return false;
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "RHI/RHICommon.hpp"
+
+#include <EASTL/functional.h>
+#include <atomic>
+
+namespace Renderer
+{
+    // 决定编译结果的所有输入，任意一项变化都会得到不同的 key
+    struct FShaderBinaryKeyDesc
+    {
+        eastl::string File;
+        eastl::string EntryPoint;
+        eastl::string Profile;
+        eastl::string CompilerVersion;
+        eastl::vector<eastl::string> Defines;
+        RHI::ERHIShaderCompileFlags CompileFlags = 0;
+    };
+
+    struct FShaderBinaryCacheStats
+    {
+        uint32_t HitCount = 0;
+        uint32_t MissCount = 0;
+        uint32_t CorruptedCount = 0;
+        // include 无法解析，直接编译且不写入缓存
+        uint32_t BypassCount = 0;
+    };
+
+    // 以内容哈希为 key 的 SPIR-V/DXIL 磁盘缓存，只有未命中时才调用编译器
+    // 不同 key 可以在多个线程上并发 GetOrCompile，FileLoader 需要自行保证线程安全
+    class FShaderBinaryCache
+    {
+    public:
+        using FFileLoader = eastl::function<eastl::string(const eastl::string& file)>;
+        using FCompiler = eastl::function<bool(const eastl::string& source, eastl::vector<uint8_t>& output)>;
+
+        // includeDirectory 与传给 DXC 的 -I 一致，为空时只在 includer 和主文件所在目录中查找
+        FShaderBinaryCache(const eastl::string& cacheDirectory, const FFileLoader& fileLoader, const eastl::string& includeDirectory = "");
+
+        bool GetOrCompile(const FShaderBinaryKeyDesc& desc, const FCompiler& compiler, eastl::vector<uint8_t>& output);
+
+        // 源文件 + 递归 include 的内容哈希，以及其余编译参数；有 include 找不到时返回 false
+        bool ComputeKey(const FShaderBinaryKeyDesc& desc, uint64_t& key);
+        eastl::string GetCacheFilePath(uint64_t key) const;
+
+        FShaderBinaryCacheStats GetStats() const;
+
+    private:
+        bool Load(uint64_t key, eastl::vector<uint8_t>& output);
+        bool Store(uint64_t key, const eastl::vector<uint8_t>& data);
+
+        bool HashIncludes(const eastl::string& mainFile, const eastl::string& file, const eastl::string& source, eastl::vector<eastl::string>& visited, eastl::string& keyString);
+        bool ResolveInclude(const eastl::string& mainFile, const eastl::string& includer, const eastl::string& include, eastl::string& path) const;
+
+    private:
+        eastl::string m_CacheDirectory;
+        FFileLoader m_FileLoader;
+        eastl::string m_IncludeDirectory;
+        std::atomic<uint32_t> m_HitCount = 0;
+        std::atomic<uint32_t> m_MissCount = 0;
+        std::atomic<uint32_t> m_CorruptedCount = 0;
+        std::atomic<uint32_t> m_BypassCount = 0;
+    };
+}
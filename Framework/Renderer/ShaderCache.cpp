@@ -2,10 +2,12 @@
 #include "RendererBase.hpp"
 #include "PipelineStateCache.hpp"
 #include "ShaderCompiler.hpp"
+#include "ShaderBinaryCache.hpp"
 
 #include "Core/VultanaEngine.hpp"
 #include "Utilities/Log.hpp"
 
+#include <enkiTS/TaskScheduler.h>
 #include <fstream>
 #include <filesystem>
 #include <regex>
@@ -57,22 +59,85 @@ namespace Renderer
         return content;
     }
 
+    struct FShaderCompileTask : public enki::ITaskSet
+    {
+        FShaderCache* Cache = nullptr;
+        RHI::FRHIShaderDesc Desc;
+        eastl::vector<uint8_t> Blob;
+        bool bSuccess = false;
+
+        void ExecuteRange(enki::TaskSetPartition range, uint32_t threadNum) override
+        {
+            bSuccess = Cache->CompileShader(Desc.File, Desc.EntryPoint, Desc.Type, Desc.Defines, Desc.CompileFlags, Blob);
+        }
+    };
+
     FShaderCache::FShaderCache(FRendererBase *renderer)
     {
         m_pRenderer = renderer;
+
+        Core::FVultanaEngine* engine = Core::FVultanaEngine::GetEngineInstance();
+        eastl::string cacheDirectory = engine->GetWorkingPath() + "Cache/Shaders/";
+        m_pBinaryCache = eastl::make_unique<FShaderBinaryCache>(cacheDirectory, [this](const eastl::string& file) { return GetCachedFileContent(file); }, engine->GetShaderPath());
     }
 
+    // 引擎 Shutdown 时已 WaitforAll，这里不会有仍在运行的编译任务
+    FShaderCache::~FShaderCache() = default;
+
     RHI::FRHIShader *FShaderCache::GetShader(const eastl::string &file, const eastl::string &entryPoint, RHI::ERHIShaderType type, const eastl::vector<eastl::string> &defines, RHI::ERHIShaderCompileFlags flags)
     {
-        eastl::string filePath = Core::FVultanaEngine::GetEngineInstance()->GetShaderPath() + file;
-        eastl::string absolutePath = std::filesystem::absolute(filePath.c_str()).string().c_str();
+        RHI::FRHIShaderDesc desc = GetShaderDesc(file, entryPoint, type, defines, flags);
+        eastl::shared_ptr<FShaderCompileTask> pendingTask;
+        {
+            std::lock_guard<std::mutex> lock(m_ShaderMutex);
 
-        RHI::FRHIShaderDesc desc;
-        desc.Type = type;
-        desc.File = absolutePath;
-        desc.EntryPoint = entryPoint;
-        desc.Defines = defines;
-        desc.CompileFlags = flags;
+            auto iter = m_CachedShaders.find(desc);
+            if (iter != m_CachedShaders.end())
+            {
+                return iter->second.get();
+            }
+
+            auto pendingIter = m_PendingShaders.find(desc);
+            if (pendingIter != m_PendingShaders.end())
+            {
+                pendingTask = pendingIter->second;
+            }
+        }
+
+        if (pendingTask != nullptr)
+        {
+            // 录制任务是中优先级，这里不会嵌套录制其他段；其余高优先级任务可能再次进入 shader 缓存，所以等待时不能持锁
+            Core::FVultanaEngine::GetEngineInstance()->GetTaskScheduler()->WaitforTask(pendingTask.get(), enki::TASK_PRIORITY_HIGH);
+
+            std::lock_guard<std::mutex> lock(m_ShaderMutex);
+            auto pendingIter = m_PendingShaders.find(desc);
+            if (pendingIter != m_PendingShaders.end() && pendingIter->second == pendingTask)
+            {
+                return FinishCompileTask(desc);
+            }
+
+            // 其他线程已经发布了结果
+            auto iter = m_CachedShaders.find(desc);
+            return iter != m_CachedShaders.end() ? iter->second.get() : nullptr;
+        }
+
+        // DXC 编译耗时较长，不阻塞其他线程的查找
+        eastl::unique_ptr<RHI::FRHIShader> shader(CreateShader(desc.File, entryPoint, type, defines, flags));
+        if (shader == nullptr)
+        {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(m_ShaderMutex);
+        // 编译期间其他线程可能已经发布了同一个 shader，此时丢弃这次的结果
+        auto result = m_CachedShaders.insert(eastl::make_pair(desc, eastl::move(shader)));
+        return result.first->second.get();
+    }
+
+    RHI::FRHIShader *FShaderCache::GetShaderAsync(const eastl::string &file, const eastl::string &entryPoint, RHI::ERHIShaderType type, const eastl::vector<eastl::string> &defines, RHI::ERHIShaderCompileFlags flags)
+    {
+        RHI::FRHIShaderDesc desc = GetShaderDesc(file, entryPoint, type, defines, flags);
+        std::lock_guard<std::mutex> lock(m_ShaderMutex);
 
         auto iter = m_CachedShaders.find(desc);
         if (iter != m_CachedShaders.end())
@@ -80,16 +145,61 @@ namespace Renderer
             return iter->second.get();
         }
 
-        RHI::FRHIShader* shader = CreateShader(absolutePath, entryPoint, type, defines, flags);
-        if (shader != nullptr)
+        // 编译失败的不再重复投递，等热重载修改源文件后再试
+        if (m_FailedShaders.find(desc) != m_FailedShaders.end())
         {
-            m_CachedShaders.insert(eastl::make_pair(desc, eastl::unique_ptr<RHI::FRHIShader>(shader)));
+            return nullptr;
+        }
+
+        auto pendingIter = m_PendingShaders.find(desc);
+        if (pendingIter != m_PendingShaders.end())
+        {
+            return pendingIter->second->GetIsComplete() ? FinishCompileTask(desc) : nullptr;
+        }
+
+        eastl::shared_ptr<FShaderCompileTask> task = eastl::make_shared<FShaderCompileTask>();
+        task->Cache = this;
+        task->Desc = desc;
+        m_PendingShaders.insert(eastl::make_pair(desc, task));
+
+        Core::FVultanaEngine::GetEngineInstance()->GetTaskScheduler()->AddTaskSetToPipe(task.get());
+        return nullptr;
+    }
+
+    void FShaderCache::WaitForPendingShaders()
+    {
+        enki::TaskScheduler* ts = Core::FVultanaEngine::GetEngineInstance()->GetTaskScheduler();
+
+        eastl::vector<eastl::shared_ptr<FShaderCompileTask>> tasks;
+        {
+            std::lock_guard<std::mutex> lock(m_ShaderMutex);
+            tasks.reserve(m_PendingShaders.size());
+            for (auto iter = m_PendingShaders.begin(); iter != m_PendingShaders.end(); ++iter)
+            {
+                tasks.push_back(iter->second);
+            }
+        }
+
+        for (size_t i = 0; i < tasks.size(); i++)
+        {
+            ts->WaitforTask(tasks[i].get());
+        }
+
+        std::lock_guard<std::mutex> lock(m_ShaderMutex);
+        for (size_t i = 0; i < tasks.size(); i++)
+        {
+            auto pendingIter = m_PendingShaders.find(tasks[i]->Desc);
+            if (pendingIter != m_PendingShaders.end() && pendingIter->second == tasks[i])
+            {
+                FinishCompileTask(tasks[i]->Desc);
+            }
         }
-        return shader;
     }
 
     eastl::string FShaderCache::GetCachedFileContent(const eastl::string &file)
     {
+        std::lock_guard<std::mutex> lock(m_FileMutex);
+
         auto iter = m_CachedFile.find(file);
         if (iter != m_CachedFile.end())
         {
@@ -102,8 +212,50 @@ namespace Renderer
         return source;
     }
 
+    RHI::FRHIShaderDesc FShaderCache::GetShaderDesc(const eastl::string &file, const eastl::string &entryPoint, RHI::ERHIShaderType type, const eastl::vector<eastl::string> &defines, RHI::ERHIShaderCompileFlags flags) const
+    {
+        eastl::string filePath = Core::FVultanaEngine::GetEngineInstance()->GetShaderPath() + file;
+
+        RHI::FRHIShaderDesc desc;
+        desc.Type = type;
+        desc.File = std::filesystem::absolute(filePath.c_str()).string().c_str();
+        desc.EntryPoint = entryPoint;
+        desc.Defines = defines;
+        desc.CompileFlags = flags;
+        return desc;
+    }
+
+    RHI::FRHIShader *FShaderCache::FinishCompileTask(const RHI::FRHIShaderDesc &desc)
+    {
+        auto pendingIter = m_PendingShaders.find(desc);
+        assert(pendingIter != m_PendingShaders.end() && pendingIter->second->GetIsComplete());
+
+        FShaderCompileTask* task = pendingIter->second.get();
+        RHI::FRHIShader* shader = nullptr;
+        if (task->bSuccess)
+        {
+            eastl::string name = desc.File + " : " + desc.EntryPoint;
+            shader = m_pRenderer->GetDevice()->CreateShader(desc, task->Blob, name);
+        }
+
+        m_PendingShaders.erase(pendingIter);
+
+        if (shader == nullptr)
+        {
+            m_FailedShaders.insert(desc);
+            return nullptr;
+        }
+
+        // 同步的 GetShader 可能已经编译并发布了同一个 shader
+        auto result = m_CachedShaders.insert(eastl::make_pair(desc, eastl::unique_ptr<RHI::FRHIShader>(shader)));
+        return result.first->second.get();
+    }
+
     void FShaderCache::ReloadShaders()
     {
+        // 编译任务会并发读写文件缓存，先等它们结束
+        WaitForPendingShaders();
+
         for (auto iter = m_CachedFile.begin(); iter != m_CachedFile.end(); iter++)
         {
             const eastl::string& path = iter->first;
@@ -114,6 +266,7 @@ namespace Renderer
             if (source != newSource)
             {
                 m_CachedFile[path] = newSource;
+                m_FailedShaders.clear();
 
                 eastl::vector<RHI::FRHIShader*> changedShaders = GetShaderList(path);
                 for (size_t i = 0; i < changedShaders.size(); i++)
@@ -124,12 +277,28 @@ namespace Renderer
         }
     }
 
-    RHI::FRHIShader *FShaderCache::CreateShader(const eastl::string &file, const eastl::string &entryPoint, RHI::ERHIShaderType type, const eastl::vector<eastl::string> &defines, RHI::ERHIShaderCompileFlags flags)
+    bool FShaderCache::CompileShader(const eastl::string &file, const eastl::string &entryPoint, RHI::ERHIShaderType type, const eastl::vector<eastl::string> &defines, RHI::ERHIShaderCompileFlags flags, eastl::vector<uint8_t> &output)
     {
-        eastl::string source = GetCachedFileContent(file);
+        FShaderCompiler* compiler = m_pRenderer->GetShaderCompiler();
+
+        FShaderBinaryKeyDesc keyDesc;
+        keyDesc.File = file;
+        keyDesc.EntryPoint = entryPoint;
+        keyDesc.Profile = compiler->GetTargetProfile(type);
+        keyDesc.CompilerVersion = compiler->GetVersion();
+        keyDesc.Defines = defines;
+        keyDesc.CompileFlags = flags;
 
+        return m_pBinaryCache->GetOrCompile(keyDesc, [&](const eastl::string& source, eastl::vector<uint8_t>& blob)
+        {
+            return compiler->Compile(source, file, entryPoint, type, defines, flags, blob);
+        }, output);
+    }
+
+    RHI::FRHIShader *FShaderCache::CreateShader(const eastl::string &file, const eastl::string &entryPoint, RHI::ERHIShaderType type, const eastl::vector<eastl::string> &defines, RHI::ERHIShaderCompileFlags flags)
+    {
         eastl::vector<uint8_t> shaderBlob;
-        if (!m_pRenderer->GetShaderCompiler()->Compile(source, file, entryPoint, type, defines, flags, shaderBlob))
+        if (!CompileShader(file, entryPoint, type, defines, flags, shaderBlob))
         {
             return nullptr;
         }
@@ -149,10 +318,8 @@ namespace Renderer
         const RHI::FRHIShaderDesc& desc = shader->GetDesc();
         VTNA_LOG_INFO("Recompiling shader: {}", desc.File);
 
-        eastl::string source = GetCachedFileContent(desc.File);
-
         eastl::vector<uint8_t> shaderBlob;
-        if (!m_pRenderer->GetShaderCompiler()->Compile(source, desc.File, desc.EntryPoint, desc.Type, desc.Defines, desc.CompileFlags, shaderBlob))
+        if (!CompileShader(desc.File, desc.EntryPoint, desc.Type, desc.Defines, desc.CompileFlags, shaderBlob))
         {
             return;
         }
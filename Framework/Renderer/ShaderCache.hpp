@@ -3,7 +3,10 @@
 #include "RHI/RHICommon.hpp"
 
 #include <EASTL/hash_map.h>
+#include <EASTL/hash_set.h>
 #include <EASTL/unique_ptr.h>
+#include <EASTL/shared_ptr.h>
+#include <mutex>
 
 namespace eastl
 {
@@ -25,18 +28,36 @@ namespace eastl
 namespace Renderer
 {
     class FRendererBase;
+    class FShaderBinaryCache;
+    struct FShaderCompileTask;
 
     class FShaderCache
     {
+        friend struct FShaderCompileTask;
+
     public:
         FShaderCache(FRendererBase* renderer);
+        ~FShaderCache();
 
+        // 同步获取，若该 shader 已在后台编译则等待其完成，可在 pass 录制的 worker 线程上调用
         RHI::FRHIShader* GetShader(const eastl::string& file, const eastl::string& entryPoint, RHI::ERHIShaderType type, const eastl::vector<eastl::string>& defines, RHI::ERHIShaderCompileFlags flags);
+        // 异步获取，未编译完成时返回 nullptr 并把编译任务投递到 enkiTS worker，调用方下一帧再轮询
+        RHI::FRHIShader* GetShaderAsync(const eastl::string& file, const eastl::string& entryPoint, RHI::ERHIShaderType type, const eastl::vector<eastl::string>& defines, RHI::ERHIShaderCompileFlags flags);
+        void WaitForPendingShaders();
+        uint32_t GetPendingShaderCount() const { return (uint32_t)m_PendingShaders.size(); }
+
+        // worker 线程上的 include handler 也会调用，内部加锁
         eastl::string GetCachedFileContent(const eastl::string& file);
 
         void ReloadShaders();
 
+        FShaderBinaryCache* GetBinaryCache() const { return m_pBinaryCache.get(); }
+
     private:
+        RHI::FRHIShaderDesc GetShaderDesc(const eastl::string& file, const eastl::string& entryPoint, RHI::ERHIShaderType type, const eastl::vector<eastl::string>& defines, RHI::ERHIShaderCompileFlags flags) const;
+        RHI::FRHIShader* FinishCompileTask(const RHI::FRHIShaderDesc& desc);
+
+        bool CompileShader(const eastl::string& file, const eastl::string& entryPoint, RHI::ERHIShaderType type, const eastl::vector<eastl::string>& defines, RHI::ERHIShaderCompileFlags flags, eastl::vector<uint8_t>& output);
         RHI::FRHIShader* CreateShader(const eastl::string& file, const eastl::string& entryPoint, RHI::ERHIShaderType type, const eastl::vector<eastl::string>& defines, RHI::ERHIShaderCompileFlags flags);
         void RecompileShader(RHI::FRHIShader* shader);
 
@@ -47,5 +68,13 @@ namespace Renderer
         FRendererBase* m_pRenderer = nullptr;
         eastl::hash_map<RHI::FRHIShaderDesc, eastl::unique_ptr<RHI::FRHIShader>> m_CachedShaders;
         eastl::hash_map<eastl::string, eastl::string> m_CachedFile;
+        std::mutex m_FileMutex;
+
+        // 只保护 shader 表，等待和编译期间都不持有：等待时当前线程可能执行其他同样会查找 shader 的任务
+        std::mutex m_ShaderMutex;
+        // 等待的线程持有一份引用，其他线程提前发布结果时任务不会被释放
+        eastl::hash_map<RHI::FRHIShaderDesc, eastl::shared_ptr<FShaderCompileTask>> m_PendingShaders;
+        eastl::hash_set<RHI::FRHIShaderDesc> m_FailedShaders;
+        eastl::unique_ptr<FShaderBinaryCache> m_pBinaryCache;
     };
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "Utilities/Log.hpp"
 #include "Utilities/String.hpp"
 
+#include <enkiTS/TaskScheduler.h>
 #include <filesystem>
 #include <atlbase.h>
 #include <dxcapi.h>
@@ -99,28 +100,78 @@ namespace Renderer
         {
             DxcCreateInstanceProc dxcCreateInstance = (DxcCreateInstanceProc)GetProcAddress(dxcModule, "DxcCreateInstance");
 
-            DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&m_pDxcUtils));
-            DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&m_pDxcCompiler));
+            // 线程号 0 是主线程，其余为 worker
+            uint32_t threadCount = Core::FVultanaEngine::GetEngineInstance()->GetTaskScheduler()->GetNumTaskThreads();
+            m_Contexts.resize(threadCount);
+            for (uint32_t i = 0; i < threadCount; i++)
+            {
+                FDxcContext& context = m_Contexts[i];
+                DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&context.Utils));
+                DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&context.Compiler));
+
+                context.IncludeHandler = new FDXCIncludeHandler(renderer->GetShaderCache(), context.Utils);
+                context.IncludeHandler->AddRef();
+            }
 
-            m_pDxcIncludeHandler = new FDXCIncludeHandler(renderer->GetShaderCache(), m_pDxcUtils);
-            m_pDxcIncludeHandler->AddRef();
+            CComPtr<IDxcVersionInfo> pVersionInfo;
+            if (SUCCEEDED(m_Contexts[0].Compiler->QueryInterface(IID_PPV_ARGS(&pVersionInfo))))
+            {
+                UINT32 major = 0, minor = 0;
+                pVersionInfo->GetVersion(&major, &minor);
+                m_Version = fmt::format("dxc {}.{}", major, minor).c_str();
+            }
+
+            CComPtr<IDxcVersionInfo2> pVersionInfo2;
+            if (SUCCEEDED(m_Contexts[0].Compiler->QueryInterface(IID_PPV_ARGS(&pVersionInfo2))))
+            {
+                UINT32 commitCount = 0;
+                char* commitHash = nullptr;
+                if (SUCCEEDED(pVersionInfo2->GetCommitInfo(&commitCount, &commitHash)))
+                {
+                    m_Version += fmt::format(" ({})", commitHash).c_str();
+                    CoTaskMemFree(commitHash);
+                }
+            }
         }
     }
 
     FShaderCompiler::~FShaderCompiler()
     {
-        if (m_pDxcIncludeHandler)
-        {
-            m_pDxcIncludeHandler->Release();
-        }
-        if (m_pDxcCompiler)
+        for (size_t i = 0; i < m_Contexts.size(); i++)
         {
-            m_pDxcCompiler->Release();
+            FDxcContext& context = m_Contexts[i];
+            if (context.IncludeHandler)
+            {
+                context.IncludeHandler->Release();
+            }
+            if (context.Compiler)
+            {
+                context.Compiler->Release();
+            }
+            if (context.Utils)
+            {
+                context.Utils->Release();
+            }
         }
-        if (m_pDxcUtils)
+    }
+
+    eastl::string FShaderCompiler::GetTargetProfile(RHI::ERHIShaderType type) const
+    {
+        eastl::string profile = StringUtils::WStringToString(GetShaderProfile(type)).c_str();
+
+        // 编译参数随后端/构建配置变化，也算在 profile 里
+        switch (m_pRenderer->GetDevice()->GetDesc().RenderBackend)
         {
-            m_pDxcUtils->Release();
+        case RHI::ERHIRenderBackend::Vulkan:
+            profile += " spirv vulkan1.3";
+            break;
+        default:
+            break;
         }
+    #ifdef _DEBUG
+        profile += " debug";
+    #endif
+        return profile;
     }
 
     bool FShaderCompiler::Compile(const eastl::string &source, const eastl::string &file, const eastl::string &entryPoint, RHI::ERHIShaderType type, const eastl::vector<eastl::string> &defines, RHI::ERHIShaderCompileFlags flags, eastl::vector<uint8_t> &output)
@@ -133,6 +184,7 @@ namespace Renderer
         eastl::wstring wFile = StringUtils::StringToWString(file);
         eastl::wstring wEntryPoint = StringUtils::StringToWString(entryPoint);
         eastl::wstring wProfile = GetShaderProfile(type);
+        eastl::wstring wIncludeDirectory = StringUtils::StringToWString(Core::FVultanaEngine::GetEngineInstance()->GetShaderPath());
 
         eastl::vector<eastl::wstring> wstrDefines;
         for (size_t i = 0; i < defines.size(); i++)
@@ -144,6 +196,8 @@ namespace Renderer
         arguments.push_back(wFile.c_str());
         arguments.push_back(L"-E");     arguments.push_back(wEntryPoint.c_str());
         arguments.push_back(L"-T");     arguments.push_back(wProfile.c_str());
+        // ShaderBinaryCache 按同样的目录解析 include
+        arguments.push_back(L"-I");     arguments.push_back(wIncludeDirectory.c_str());
         for (size_t i = 0; i < wstrDefines.size(); i++)
         {
             arguments.push_back(L"-D"); arguments.push_back(wstrDefines[i].c_str());
@@ -203,8 +257,12 @@ namespace Renderer
         #endif
         }
 
+        uint32_t threadIndex = Core::FVultanaEngine::GetEngineInstance()->GetTaskScheduler()->GetThreadNum();
+        assert(threadIndex < m_Contexts.size());
+        const FDxcContext& context = m_Contexts[threadIndex];
+
         CComPtr<IDxcResult> pResult;
-        m_pDxcCompiler->Compile(&sourceBuffer, arguments.data(), (UINT32)arguments.size(), m_pDxcIncludeHandler, IID_PPV_ARGS(&pResult));
+        context.Compiler->Compile(&sourceBuffer, arguments.data(), (UINT32)arguments.size(), context.IncludeHandler, IID_PPV_ARGS(&pResult));
         
         CComPtr<IDxcBlobUtf8> pError = nullptr;
         pResult->GetOutput(DXC_OUT_ERRORS, IID_PPV_ARGS(&pError), nullptr);
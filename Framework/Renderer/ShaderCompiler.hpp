@@ -12,6 +12,14 @@ namespace Renderer
 {
     class FRendererBase;
 
+    // DXC 的 compiler 实例不能跨线程共用，每个 enkiTS 线程各持有一份
+    struct FDxcContext
+    {
+        IDxcCompiler3* Compiler = nullptr;
+        IDxcUtils* Utils = nullptr;
+        IDxcIncludeHandler* IncludeHandler = nullptr;
+    };
+
     class FShaderCompiler
     {
     public:
@@ -27,10 +35,13 @@ namespace Renderer
             RHI::ERHIShaderCompileFlags flags, 
             eastl::vector<uint8_t>& output);
 
+        // 参与 shader 二进制缓存的 key，DXC 升级后旧缓存自动失效
+        const eastl::string& GetVersion() const { return m_Version; }
+        eastl::string GetTargetProfile(RHI::ERHIShaderType type) const;
+
     private:
         FRendererBase* m_pRenderer = nullptr;
-        IDxcCompiler3* m_pDxcCompiler = nullptr;
-        IDxcUtils* m_pDxcUtils = nullptr;
-        IDxcIncludeHandler* m_pDxcIncludeHandler = nullptr;
+        eastl::vector<FDxcContext> m_Contexts;
+        eastl::string m_Version;
     };
 }
\ No newline at end of file
@@ -1,64 +1,138 @@
 ﻿#include "StagingBufferAllocator.hpp"
-#include "RendererBase.hpp"
 
 #include "Utilities/Math.hpp"
+#include "Utilities/Log.hpp"
+
+#include <EASTL/algorithm.h>
 
 namespace Renderer
 {
-    FStagingBufferAllocator::FStagingBufferAllocator(FRendererBase *renderer)
+    static const uint32_t STAGING_BUFFER_ALIGNMENT = 512;
+
+    FStagingBufferAllocator::FStagingBufferAllocator(RHI::FRHIDevice* pDevice, RHI::FRHIFence* pFence, uint32_t size)
     {
-        m_pRenderer = renderer;
+        m_pDevice = pDevice;
+        m_pFence = pFence;
+        m_Size = RoundUpPow2(size, STAGING_BUFFER_ALIGNMENT);
+
+        RHI::FRHIBufferDesc desc;
+        desc.Size = m_Size;
+        desc.MemoryType = RHI::ERHIMemoryType::CPUOnly;
+        m_pBuffer.reset(m_pDevice->CreateBuffer(desc, "StagingBufferAllocator::m_pBuffer"));
+        if (m_pBuffer == nullptr)
+        {
+            VTNA_LOG_ERROR("[StagingBufferAllocator] failed to create the ring buffer, all uploads fall back to dedicated buffers");
+        }
     }
 
     FStagingBuffer FStagingBufferAllocator::Allocate(uint32_t size)
     {
         assert(size <= RHI::RHI_MAX_BUFFER_SIZE);
 
-        if (m_Buffers.empty())
-        {
-            CreateNewBuffer();
-        }
+        Reclaim();
 
-        if (m_AllocatedSize + size > RHI::RHI_MAX_BUFFER_SIZE)
+        uint32_t alignedSize = RoundUpPow2(eastl::max(size, 1u), STAGING_BUFFER_ALIGNMENT);
+        if (m_pBuffer && alignedSize <= m_Size / 2)
         {
-            CreateNewBuffer();
-            m_CurrentBuffer++;
-            m_AllocatedSize = 0;
+            uint32_t offset = 0;
+            bool bAllocated = TryAllocateFromRing(alignedSize, offset);
+
+            // 空间不足时按提交顺序等待，直到腾出足够的连续空间
+            while (!bAllocated && !m_InflightRanges.empty())
+            {
+                m_pFence->Wait(m_InflightRanges.front().FenceValue);
+                Reclaim();
+                bAllocated = TryAllocateFromRing(alignedSize, offset);
+            }
+
+            if (bAllocated)
+            {
+                FStagingBuffer buffer;
+                buffer.Buffer = m_pBuffer.get();
+                buffer.Offset = offset;
+                buffer.Size = size;
+                return buffer;
+            }
         }
 
-        FStagingBuffer buffer;
-        buffer.Buffer = m_Buffers[m_CurrentBuffer].get();
-        buffer.Size = size;
-        buffer.Offset = m_AllocatedSize;
+        return AllocateDedicated(size);
+    }
 
-        m_AllocatedSize += RoundUpPow2(size, 512);
-        m_LastAllocatedFrame = m_pRenderer->GetFrameID();
+    void FStagingBufferAllocator::Retire(uint64_t fenceValue)
+    {
+        if (m_Head != m_RetiredHead)
+        {
+            assert(m_InflightRanges.empty() || m_InflightRanges.back().FenceValue <= fenceValue);
+            m_InflightRanges.push_back({ fenceValue, m_Head });
+            m_RetiredHead = m_Head;
+        }
 
-        return buffer;
+        for (size_t i = 0; i < m_PendingDedicatedBuffers.size(); i++)
+        {
+            FDedicatedBuffer dedicated;
+            dedicated.Buffer = eastl::move(m_PendingDedicatedBuffers[i]);
+            dedicated.FenceValue = fenceValue;
+            m_RetiredDedicatedBuffers.push_back(eastl::move(dedicated));
+        }
+        m_PendingDedicatedBuffers.clear();
     }
 
-    void FStagingBufferAllocator::Reset()
+    bool FStagingBufferAllocator::TryAllocateFromRing(uint32_t alignedSize, uint32_t& offset)
     {
-        m_CurrentBuffer = 0;
-        m_AllocatedSize = 0;
+        uint64_t head = m_Head;
 
-        if (!m_Buffers.empty())
+        // 分配不能跨过 buffer 末尾，剩余的尾部直接跳过，随下一次回收一起释放
+        uint64_t headOffset = head % m_Size;
+        if (headOffset + alignedSize > m_Size)
         {
-            // 超时销毁
-            if (m_pRenderer->GetFrameID() - m_LastAllocatedFrame > 100)
-            {
-                m_Buffers.clear();
-            }
+            head += m_Size - headOffset;
         }
+
+        if (head + alignedSize - m_Tail > m_Size)
+        {
+            return false;
+        }
+
+        offset = (uint32_t)(head % m_Size);
+        m_Head = head + alignedSize;
+        return true;
     }
 
-    void FStagingBufferAllocator::CreateNewBuffer()
+    FStagingBuffer FStagingBufferAllocator::AllocateDedicated(uint32_t size)
     {
         RHI::FRHIBufferDesc desc;
-        desc.Size = RHI::RHI_MAX_BUFFER_SIZE;
+        desc.Size = size;
         desc.MemoryType = RHI::ERHIMemoryType::CPUOnly;
 
-        RHI::FRHIBuffer* buffer = m_pRenderer->GetDevice()->CreateBuffer(desc, "StagingBufferAllocator:m_pBuffer");
-        m_Buffers.push_back(eastl::unique_ptr<RHI::FRHIBuffer>(buffer));
+        RHI::FRHIBuffer* pBuffer = m_pDevice->CreateBuffer(desc, "StagingBufferAllocator::DedicatedBuffer");
+        if (pBuffer == nullptr)
+        {
+            VTNA_LOG_ERROR("[StagingBufferAllocator] failed to create a dedicated staging buffer of {} bytes", size);
+            return FStagingBuffer { nullptr, 0, 0 };
+        }
+        m_PendingDedicatedBuffers.push_back(eastl::unique_ptr<RHI::FRHIBuffer>(pBuffer));
+
+        FStagingBuffer buffer;
+        buffer.Buffer = pBuffer;
+        buffer.Offset = 0;
+        buffer.Size = size;
+        return buffer;
+    }
+
+    void FStagingBufferAllocator::Reclaim()
+    {
+        uint64_t completedValue = m_pFence->GetCompletedValue();
+
+        while (!m_InflightRanges.empty() && m_InflightRanges.front().FenceValue <= completedValue)
+        {
+            m_Tail = m_InflightRanges.front().End;
+            m_InflightRanges.pop_front();
+        }
+
+        auto iter = eastl::remove_if(m_RetiredDedicatedBuffers.begin(), m_RetiredDedicatedBuffers.end(), [completedValue](const FDedicatedBuffer& dedicated)
+        {
+            return dedicated.FenceValue <= completedValue;
+        });
+        m_RetiredDedicatedBuffers.erase(iter, m_RetiredDedicatedBuffers.end());
     }
-}
\ No newline at end of file
+}
@@ -3,11 +3,10 @@
 #include "RHI/RHI.hpp"
 
 #include <EASTL/unique_ptr.h>
+#include <EASTL/deque.h>
 
 namespace Renderer
 {
-    class FRendererBase;
-
     struct FStagingBuffer
     {
         RHI::FRHIBuffer* Buffer;
@@ -15,22 +14,49 @@ namespace Renderer
         uint32_t Size;
     };
 
+    // 常驻的环形上传缓冲，每次提交后用 fence 值标记已分配的区间，GPU 完成后再回收
+    // 超过容量一半的上传，或环形缓冲被当前未提交的分配占满时，退回到独立的 buffer
     class FStagingBufferAllocator
     {
     public:
-        FStagingBufferAllocator(FRendererBase* renderer);
-        
+        FStagingBufferAllocator(RHI::FRHIDevice* pDevice, RHI::FRHIFence* pFence, uint32_t size = RHI::RHI_MAX_BUFFER_SIZE);
+
         FStagingBuffer Allocate(uint32_t size);
-        void Reset();
+        // 上一次 Retire 之后的所有分配在 pFence 到达 fenceValue 后可以复用
+        void Retire(uint64_t fenceValue);
+
+        RHI::FRHIBuffer* GetRingBuffer() const { return m_pBuffer.get(); }
+        uint32_t GetDedicatedBufferCount() const { return (uint32_t)(m_PendingDedicatedBuffers.size() + m_RetiredDedicatedBuffers.size()); }
 
     private:
-        void CreateNewBuffer();
+        bool TryAllocateFromRing(uint32_t alignedSize, uint32_t& offset);
+        FStagingBuffer AllocateDedicated(uint32_t size);
+        void Reclaim();
 
     private:
-        FRendererBase* m_pRenderer = nullptr;
-        eastl::vector<eastl::unique_ptr<RHI::FRHIBuffer>> m_Buffers;
-        uint32_t m_CurrentBuffer = 0;
-        uint32_t m_AllocatedSize = 0;
-        uint64_t m_LastAllocatedFrame = 0;
+        RHI::FRHIDevice* m_pDevice = nullptr;
+        RHI::FRHIFence* m_pFence = nullptr;
+
+        eastl::unique_ptr<RHI::FRHIBuffer> m_pBuffer;
+        uint32_t m_Size = 0;
+        // 单调递增的位置，取模后得到 buffer 内偏移
+        uint64_t m_Head = 0;
+        uint64_t m_Tail = 0;
+        uint64_t m_RetiredHead = 0;
+
+        struct FInflightRange
+        {
+            uint64_t FenceValue;
+            uint64_t End;
+        };
+        eastl::deque<FInflightRange> m_InflightRanges;
+
+        struct FDedicatedBuffer
+        {
+            eastl::unique_ptr<RHI::FRHIBuffer> Buffer;
+            uint64_t FenceValue;
+        };
+        eastl::vector<eastl::unique_ptr<RHI::FRHIBuffer>> m_PendingDedicatedBuffers;
+        eastl::vector<FDedicatedBuffer> m_RetiredDedicatedBuffers;
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,169 @@
+#include "TextureStreamer.hpp"
+#include "RendererBase.hpp"
+
+#include "AssetManager/TextureLoader.hpp"
+#include "Core/VultanaEngine.hpp"
+#include "Utilities/Log.hpp"
+
+#include <enkiTS/TaskScheduler.h>
+
+namespace Renderer
+{
+    struct FTextureDecodeTask : public enki::ITaskSet
+    {
+        // 请求被取消后置空
+        RenderResources::FTexture2D* Texture = nullptr;
+        eastl::string File;
+        bool bSRGB = true;
+        Assets::ETextureRole Role = Assets::ETextureRole::Generic;
+
+        eastl::unique_ptr<Assets::FTextureLoader> Loader;
+        bool bSuccess = false;
+        uint64_t UploadFenceValue = 0;
+
+        void ExecuteRange(enki::TaskSetPartition range, uint32_t threadNum) override
+        {
+            bSuccess = Loader->Load(File, bSRGB, Role);
+        }
+    };
+
+    FTextureStreamer::FTextureStreamer(FRendererBase *pRenderer)
+    {
+        m_pRenderer = pRenderer;
+        CreatePlaceholders();
+    }
+
+    // 引擎 Shutdown 时已 WaitforAll，这里不会有仍在运行的解码任务
+    FTextureStreamer::~FTextureStreamer() = default;
+
+    RenderResources::FTexture2D *FTextureStreamer::RequestTexture2D(const eastl::string &file, bool srgb, Assets::ETextureRole role)
+    {
+        RenderResources::FTexture2D* texture = new RenderResources::FTexture2D(file);
+        // 在交给调用方之前标记，渲染线程 Create 之后到上传完成之间不会被当作驻留
+        texture->SetResident(false);
+
+        FTextureDecodeTask* task = new FTextureDecodeTask;
+        task->Texture = texture;
+        task->File = file;
+        task->bSRGB = srgb;
+        task->Role = role;
+        task->Loader = eastl::make_unique<Assets::FTextureLoader>();
+        {
+            // 投递之前任务处于完成状态，必须和入队一起持锁，否则 Tick 会把它当作解码失败丢弃
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_DecodingTasks.emplace_back(task);
+            Core::FVultanaEngine::GetEngineInstance()->GetTaskScheduler()->AddTaskSetToPipe(task);
+        }
+        return texture;
+    }
+
+    void FTextureStreamer::CancelRequest(RenderResources::FTexture2D *pTexture)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        eastl::vector<eastl::unique_ptr<FTextureDecodeTask>>* queues[3] = { &m_DecodingTasks, &m_DecodedTasks, &m_UploadingTasks };
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            for (size_t j = 0; j < queues[i]->size(); j++)
+            {
+                if ((*queues[i])[j]->Texture == pTexture)
+                {
+                    (*queues[i])[j]->Texture = nullptr;
+                    return;
+                }
+            }
+        }
+    }
+
+    void FTextureStreamer::Tick()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        RHI::FRHIFence* pUploadFence = m_pRenderer->GetUploadFence();
+        uint64_t completedValue = pUploadFence->GetCompletedValue();
+
+        // 上传完成后才切换到真正的纹理，之前的帧可能仍在采样占位纹理
+        for (size_t i = 0; i < m_UploadingTasks.size();)
+        {
+            FTextureDecodeTask* task = m_UploadingTasks[i].get();
+            if (task->Texture == nullptr || task->UploadFenceValue <= completedValue)
+            {
+                if (task->Texture)
+                {
+                    task->Texture->SetResident(true);
+                }
+                m_UploadingTasks.erase(m_UploadingTasks.begin() + i);
+            }
+            else
+            {
+                i++;
+            }
+        }
+
+        for (size_t i = 0; i < m_DecodingTasks.size();)
+        {
+            FTextureDecodeTask* task = m_DecodingTasks[i].get();
+            if (!task->GetIsComplete())
+            {
+                i++;
+                continue;
+            }
+
+            if (task->Texture && task->bSuccess)
+            {
+                m_DecodedTasks.push_back(eastl::move(m_DecodingTasks[i]));
+            }
+            else if (task->Texture)
+            {
+                VTNA_LOG_ERROR("[TextureStreamer] failed to load {}, keeps the placeholder", task->File);
+            }
+            m_DecodingTasks.erase(m_DecodingTasks.begin() + i);
+        }
+
+        // 每帧至少上传一张，超过预算的大纹理也能前进
+        uint32_t uploadedBytes = 0;
+        size_t uploadedCount = 0;
+        for (; uploadedCount < m_DecodedTasks.size() && (uploadedCount == 0 || uploadedBytes < m_UploadBudget); uploadedCount++)
+        {
+            eastl::unique_ptr<FTextureDecodeTask>& task = m_DecodedTasks[uploadedCount];
+            if (task->Texture == nullptr)
+            {
+                continue;
+            }
+
+            Assets::FTextureLoader& loader = *task->Loader;
+            if (!task->Texture->Create(loader.GetWidth(), loader.GetHeight(), loader.GetMipLevels(), loader.GetFormat(), 0))
+            {
+                VTNA_LOG_ERROR("[TextureStreamer] failed to create {}", task->File);
+                continue;
+            }
+
+            m_pRenderer->UploadTexture(task->Texture->GetTexture(), loader.GetData());
+            task->UploadFenceValue = m_pRenderer->GetNextUploadFenceValue();
+            uploadedBytes += loader.GetDataSize();
+            // 数据已经拷贝到 staging buffer
+            task->Loader.reset();
+
+            m_UploadingTasks.push_back(eastl::move(task));
+        }
+        m_DecodedTasks.erase(m_DecodedTasks.begin(), m_DecodedTasks.begin() + uploadedCount);
+    }
+
+    void FTextureStreamer::CreatePlaceholders()
+    {
+        const char* names[] = { "TextureStreamer::WhitePlaceholder", "TextureStreamer::BlackPlaceholder", "TextureStreamer::FlatNormalPlaceholder" };
+        const uint32_t colors[] = { 0xFFFFFFFF, 0xFF000000, 0xFFFF8080 };
+        static_assert(sizeof(colors) / sizeof(colors[0]) == (uint32_t)ETexturePlaceholder::Count);
+
+        for (uint32_t i = 0; i < (uint32_t)ETexturePlaceholder::Count; i++)
+        {
+            m_pPlaceholders[i].reset(m_pRenderer->CreateTexture2D(1, 1, 1, RHI::ERHIFormat::RGBA8UNORM, 0, names[i]));
+            if (m_pPlaceholders[i] == nullptr)
+            {
+                VTNA_LOG_ERROR("[TextureStreamer] failed to create {}", names[i]);
+                continue;
+            }
+            m_pRenderer->UploadTexture(m_pPlaceholders[i]->GetTexture(), &colors[i]);
+        }
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "RenderResources/Texture2D.hpp"
+#include "AssetManager/TextureCompressor.hpp"
+
+#include <EASTL/unique_ptr.h>
+#include <EASTL/vector.h>
+
+#include <mutex>
+
+namespace Renderer
+{
+    class FRendererBase;
+    struct FTextureDecodeTask;
+
+    enum class ETexturePlaceholder
+    {
+        White,
+        Black,
+        FlatNormal,
+        Count,
+    };
+
+    // 纹理流式加载：文件读取和解码在 enkiTS worker 上完成，渲染线程每帧按字节预算创建并上传
+    // 上传的 fence 完成前纹理不是驻留状态，材质绑定占位纹理
+    class FTextureStreamer
+    {
+    public:
+        FTextureStreamer(FRendererBase* pRenderer);
+        ~FTextureStreamer();
+
+        // 立即返回尚未驻留的纹理，GPU 资源在解码完成后才创建
+        RenderResources::FTexture2D* RequestTexture2D(const eastl::string& file, bool srgb, Assets::ETextureRole role = Assets::ETextureRole::Generic);
+        // 纹理在加载完成前被释放时调用，正在运行的解码任务结束后丢弃结果
+        void CancelRequest(RenderResources::FTexture2D* pTexture);
+
+        // 每帧在 UploadResource 之前调用
+        void Tick();
+
+        RenderResources::FTexture2D* GetPlaceholder(ETexturePlaceholder placeholder) const { return m_pPlaceholders[(uint32_t)placeholder].get(); }
+
+        void SetUploadBudget(uint32_t bytesPerFrame) { m_UploadBudget = bytesPerFrame; }
+        uint32_t GetUploadBudget() const { return m_UploadBudget; }
+        uint32_t GetPendingRequestCount() const { return (uint32_t)(m_DecodingTasks.size() + m_DecodedTasks.size() + m_UploadingTasks.size()); }
+
+    private:
+        void CreatePlaceholders();
+
+    private:
+        FRendererBase* m_pRenderer = nullptr;
+        uint32_t m_UploadBudget = 32 * 1024 * 1024;
+
+        eastl::unique_ptr<RenderResources::FTexture2D> m_pPlaceholders[(uint32_t)ETexturePlaceholder::Count];
+
+        // 请求和取消来自模拟线程，Tick 在渲染线程
+        std::mutex m_Mutex;
+
+        // 按请求顺序排队，先请求的纹理先上传
+        eastl::vector<eastl::unique_ptr<FTextureDecodeTask>> m_DecodingTasks;
+        eastl::vector<eastl::unique_ptr<FTextureDecodeTask>> m_DecodedTasks;
+        eastl::vector<eastl::unique_ptr<FTextureDecodeTask>> m_UploadingTasks;
+    };
+}
@@ -18,4 +18,18 @@ namespace Scene
             ImGui::DragFloat3("Scale", (float*)&m_Scale, 0.01f, 0.0f, 1e8, "%.3f");
         });
     }
+
+    bool IVisibleObject::ConsumeTransformChanged()
+    {
+        if (m_bTransformInitialized && m_Position == m_PrevPosition && m_Rotation == m_PrevRotation && m_Scale == m_PrevScale)
+        {
+            return false;
+        }
+
+        m_PrevPosition = m_Position;
+        m_PrevRotation = m_Rotation;
+        m_PrevScale = m_Scale;
+        m_bTransformInitialized = true;
+        return true;
+    }
 }
@@ -15,7 +15,10 @@ namespace Scene
         virtual bool Create() = 0;
         virtual void Tick(float deltaTime) = 0;
         virtual void Render(Renderer::FRendererBase* pRenderer) {};
-        virtual bool FrustumCull(const float4* plane, uint32_t planeCount) const { return true; }
+        // 提前投递渲染会用到的 shader 编译，编译完成后再次调用会创建 PSO
+        virtual void RequestPSOs() {}
+        // 世界空间包围球，FWorld 每帧 Tick 之后收集到 SoA 中统一剔除；默认半径无限大，总是可见
+        virtual void GetBoundingSphere(float3& center, float& radius) const { center = m_Position; radius = FLT_MAX; }
         virtual void OnGUI();
 
         virtual float3 GetPosition() const { return m_Position; }
@@ -32,6 +35,10 @@ namespace Scene
 
         void SetID(uint32_t id) { m_ID = id; }
 
+    protected:
+        // 变换相对上次调用是否发生变化。OnGUI 会直接改写 m_Position/m_Scale，所以用比较而不是在 setter 里标脏
+        bool ConsumeTransformChanged();
+
     protected:
         uint32_t m_ID = 0;
         eastl::string m_Name;
@@ -39,5 +46,11 @@ namespace Scene
         float3 m_Position = float3(0.0f);
         quaternion m_Rotation = { 0.0f, 0.0f, 0.0f, 1.0f };
         float3 m_Scale = float3(1.0f);
+
+    private:
+        float3 m_PrevPosition = float3(0.0f);
+        quaternion m_PrevRotation = { 0.0f, 0.0f, 0.0f, 1.0f };
+        float3 m_PrevScale = float3(1.0f);
+        bool m_bTransformInitialized = false;
     };
 }
\ No newline at end of file
@@ -42,6 +42,12 @@ namespace Scene
         pRenderer->FreeSceneAnimationBuffer(AnimNormalBuffer);
         pRenderer->FreeSceneAnimationBuffer(AnimTangentBuffer);
         // pRenderer->FreeSceneAnimationBuffer(PrevAnimPositionBuffer);
+
+        if (InstanceIndex != INVALID_INSTANCE_INDEX)
+        {
+            pRenderer->FreeInstance(InstanceIndex);
+        }
+        pRenderer->FreeSceneInstanceBuffer(MaterialBuffer);
     }
 
     FSkeletalMesh::FSkeletalMesh(const eastl::string &name)
@@ -107,9 +113,24 @@ namespace Scene
         }
     }
 
-    bool FSkeletalMesh::FrustumCull(const float4 *planes, uint32_t planeCount) const
+    void FSkeletalMesh::RequestPSOs()
     {
-        return ::FrustumCull(planes, planeCount, m_Position, m_Radius);
+        for (size_t i = 0; i < m_Nodes.size(); i++)
+        {
+            for (size_t j = 0; j < m_Nodes[i]->Meshes.size(); j++)
+            {
+                Assets::FMeshMaterial* material = m_Nodes[i]->Meshes[j]->Material.get();
+                material->GetPSO();
+                material->GetIDPSO();
+                material->GetOutlinePSO();
+            }
+        }
+    }
+
+    void FSkeletalMesh::GetBoundingSphere(float3 &center, float &radius) const
+    {
+        center = m_Position;
+        radius = m_Radius;
     }
 
     void FSkeletalMesh::OnGUI()
@@ -170,43 +191,66 @@ namespace Scene
             auto mesh = node->Meshes[i].get();
             // eastl::swap(mesh->PrevAnimPositionBuffer, mesh->AnimPositionBuffer);
 
-            mesh->Material->UpdateConstants();
+            if (mesh->Material->IsConstantsDirty())
+            {
+                mesh->Material->UpdateConstants();
+                if (mesh->MaterialBuffer.metadata == OffsetAllocator::Allocation::NO_SPACE)
+                {
+                    mesh->MaterialBuffer = m_pRenderer->AllocateSceneInstanceBuffer(mesh->Material->GetMaterialConstants(), sizeof(FModelMaterialConstants));
+                }
+                else
+                {
+                    m_pRenderer->UpdateSceneInstanceBuffer(mesh->MaterialBuffer, mesh->Material->GetMaterialConstants(), sizeof(FModelMaterialConstants));
+                }
+            }
+
+            FInstanceData instanceData = mesh->InstanceData;
 
-            mesh->InstanceData.IndexBufferAddress = mesh->IndexBuffer.offset;
-            mesh->InstanceData.IndexStride = mesh->IndexBufferFormat == RHI::ERHIFormat::R32UI ? 4 : 2;
-            mesh->InstanceData.TriangleCount = mesh->IndexCount / 3;
+            instanceData.IndexBufferAddress = mesh->IndexBuffer.offset;
+            instanceData.IndexStride = mesh->IndexBufferFormat == RHI::ERHIFormat::R32UI ? 4 : 2;
+            instanceData.TriangleCount = mesh->IndexCount / 3;
 
-            mesh->InstanceData.TexCoordBufferAddress = mesh->TexCoordBuffer.offset;
+            instanceData.TexCoordBufferAddress = mesh->TexCoordBuffer.offset;
 
             bool isSkinnedMesh = mesh->Material->IsVertexSkinned();
             if (isSkinnedMesh)
             {
-                mesh->InstanceData.PositionBufferAddress = mesh->AnimPositionBuffer.offset;
-                mesh->InstanceData.NormalBufferAddress = mesh->AnimNormalBuffer.offset;
-                mesh->InstanceData.TangentBufferAddress = mesh->AnimTangentBuffer.offset;
+                instanceData.PositionBufferAddress = mesh->AnimPositionBuffer.offset;
+                instanceData.NormalBufferAddress = mesh->AnimNormalBuffer.offset;
+                instanceData.TangentBufferAddress = mesh->AnimTangentBuffer.offset;
             }
             else
             {
-                mesh->InstanceData.PositionBufferAddress = mesh->StaticPositionBuffer.offset;
-                mesh->InstanceData.NormalBufferAddress = mesh->StaticNormalBuffer.offset;
-                mesh->InstanceData.TangentBufferAddress = mesh->StaticTangentBuffer.offset;
+                instanceData.PositionBufferAddress = mesh->StaticPositionBuffer.offset;
+                instanceData.NormalBufferAddress = mesh->StaticNormalBuffer.offset;
+                instanceData.TangentBufferAddress = mesh->StaticTangentBuffer.offset;
             }
-            mesh->InstanceData.bVertexAnimation = isSkinnedMesh;
-            mesh->InstanceData.MaterialDataAddress = m_pRenderer->AllocateSceneConstantBuffer((void*)mesh->Material->GetMaterialConstants(), sizeof(FModelMaterialConstants));
-            mesh->InstanceData.ObjectID = m_ID;
+            instanceData.bVertexAnimation = isSkinnedMesh;
+            instanceData.MaterialDataAddress = mesh->MaterialBuffer.offset;
+            instanceData.ObjectID = m_ID;
 
             auto node = GetNode(mesh->NodeID);
             float4x4 mtxNodeWorld = mul(m_MtxWorld, node->GlobalTransform);
 
-            mesh->InstanceData.Scale = max(max(abs(m_Scale.x), abs(m_Scale.y)), abs(m_Scale.z)) * m_BoundScaleFactor;
-            mesh->InstanceData.Center = mul(m_MtxWorld, float4(mesh->Center, 1.0)).xyz();
-            mesh->InstanceData.Radius = mesh->Radius * mesh->InstanceData.Scale;
-            m_Radius = max(m_Radius, mesh->InstanceData.Radius);
+            instanceData.Scale = max(max(abs(m_Scale.x), abs(m_Scale.y)), abs(m_Scale.z)) * m_BoundScaleFactor;
+            instanceData.Center = mul(m_MtxWorld, float4(mesh->Center, 1.0)).xyz();
+            instanceData.Radius = mesh->Radius * instanceData.Scale;
+            m_Radius = max(m_Radius, instanceData.Radius);
 
-            mesh->InstanceData.MtxWorld = isSkinnedMesh ? m_MtxWorld : mtxNodeWorld;
-            mesh->InstanceData.MtxWorldInverseTranspose = transpose(inverse(mesh->InstanceData.MtxWorld));
+            instanceData.MtxWorld = isSkinnedMesh ? m_MtxWorld : mtxNodeWorld;
+            instanceData.MtxWorldInverseTranspose = transpose(inverse(instanceData.MtxWorld));
 
-            mesh->InstanceIndex = m_pRenderer->AddInstance(mesh->InstanceData);
+            // 动画节点每帧都可能变化，只有数据真正改变时才写入 instance slot
+            bool isNewInstance = mesh->InstanceIndex == INVALID_INSTANCE_INDEX;
+            if (isNewInstance)
+            {
+                mesh->InstanceIndex = m_pRenderer->AllocateInstance();
+            }
+            if (isNewInstance || memcmp(&instanceData, &mesh->InstanceData, sizeof(FInstanceData)) != 0)
+            {
+                mesh->InstanceData = instanceData;
+                m_pRenderer->UpdateInstance(mesh->InstanceIndex, mesh->InstanceData);
+            }
         }
         for (size_t i = 0; i < node->Children.size(); i++)
         {
@@ -221,19 +265,31 @@ namespace Scene
             Renderer::FComputeBatch& batch = m_pRenderer->AddAnimationBatch();
             UpdateVertexSkinning(batch, mesh);
         }
-        Renderer::FRenderBatch& batch = m_pRenderer->AddBasePassBatch();
-        Draw(batch, mesh, mesh->Material->GetPSO());
+        RHI::FRHIPipelineState* pPSO = mesh->Material->GetPSO();
+        if (pPSO)
+        {
+            Renderer::FRenderBatch& batch = m_pRenderer->AddBasePassBatch();
+            Draw(batch, mesh, pPSO);
+        }
 
         if (m_pRenderer->IsEnableMouseHitTest())
         {
-            Renderer::FRenderBatch& idBatch = m_pRenderer->AddObjectIDPassBatch();
-            Draw(idBatch, mesh, mesh->Material->GetIDPSO());
+            RHI::FRHIPipelineState* pIDPSO = mesh->Material->GetIDPSO();
+            if (pIDPSO)
+            {
+                Renderer::FRenderBatch& idBatch = m_pRenderer->AddObjectIDPassBatch();
+                Draw(idBatch, mesh, pIDPSO);
+            }
         }
 
         if (m_ID == m_pRenderer->GetMouseHitObjectID())
         {
-            Renderer::FRenderBatch& outlineBatch = m_pRenderer->AddOutlinePassBatch();
-            Draw(outlineBatch, mesh, mesh->Material->GetOutlinePSO());
+            RHI::FRHIPipelineState* pOutlinePSO = mesh->Material->GetOutlinePSO();
+            if (pOutlinePSO)
+            {
+                Renderer::FRenderBatch& outlineBatch = m_pRenderer->AddOutlinePassBatch();
+                Draw(outlineBatch, mesh, pOutlinePSO);
+            }
         }
     }
 
@@ -271,6 +327,7 @@ namespace Scene
         batch.Label = mesh->Name.c_str();
         batch.SetPipelineState(pPSO);
         batch.SetConstantBuffer(0, rootConstants, sizeof(rootConstants));
+        batch.InstanceIndex = mesh->InstanceIndex;
 
         batch.SetIndexBuffer(m_pRenderer->GetSceneStaticBuffer(), mesh->IndexBuffer.offset, mesh->IndexBufferFormat);
         batch.DrawIndexed(mesh->IndexCount);
@@ -59,7 +59,8 @@ namespace Scene
         uint32_t VertexCount = 0;
 
         FInstanceData InstanceData = {};
-        uint32_t InstanceIndex = 0;
+        uint32_t InstanceIndex = INVALID_INSTANCE_INDEX;
+        OffsetAllocator::Allocation MaterialBuffer;
 
         float3 Center;
         float Radius;
@@ -92,7 +93,8 @@ namespace Scene
         virtual bool Create() override;
         virtual void Tick(float deltaTime) override;
         virtual void Render(Renderer::FRendererBase* pRenderer) override;
-        virtual bool FrustumCull(const float4* planes, uint32_t planeCount) const override;
+        virtual void RequestPSOs() override;
+        virtual void GetBoundingSphere(float3& center, float& radius) const override;
         virtual void OnGUI() override;
 
         FSkeletalMeshNode* GetNode(uint32_t nodeID) const;
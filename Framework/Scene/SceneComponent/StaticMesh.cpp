@@ -24,6 +24,15 @@ namespace Scene
         resourceCache->ReleaseSceneBuffer(m_MeshletIndicesBuffer);
 
         resourceCache->ReleaseSceneBuffer(m_IndexBuffer);
+
+        if (m_pRenderer)
+        {
+            if (m_InstanceIndex != INVALID_INSTANCE_INDEX)
+            {
+                m_pRenderer->FreeInstance(m_InstanceIndex);
+            }
+            m_pRenderer->FreeSceneInstanceBuffer(m_MaterialBuffer);
+        }
     }
 
     bool FStaticMesh::Create()
@@ -33,30 +42,75 @@ namespace Scene
 
     void FStaticMesh::Tick(float deltaTime)
     {
-        UpdateConstants();
-        m_InstanceIndex = m_pRenderer->AddInstance(m_InstanceData);
+        if (m_InstanceIndex == INVALID_INSTANCE_INDEX)
+        {
+            m_InstanceIndex = m_pRenderer->AllocateInstance();
+            m_bInstanceDirty = true;
+        }
+
+        if (m_pMaterial->IsConstantsDirty())
+        {
+            m_pMaterial->UpdateConstants();
+            if (m_MaterialBuffer.metadata == OffsetAllocator::Allocation::NO_SPACE)
+            {
+                m_MaterialBuffer = m_pRenderer->AllocateSceneInstanceBuffer(m_pMaterial->GetMaterialConstants(), sizeof(FModelMaterialConstants));
+                m_bInstanceDirty = true;
+            }
+            else
+            {
+                m_pRenderer->UpdateSceneInstanceBuffer(m_MaterialBuffer, m_pMaterial->GetMaterialConstants(), sizeof(FModelMaterialConstants));
+            }
+        }
+
+        // 静态物体的 instance 数据只在变换变化时重新计算和上传
+        if (ConsumeTransformChanged() || m_bInstanceDirty)
+        {
+            UpdateConstants();
+            m_pRenderer->UpdateInstance(m_InstanceIndex, m_InstanceData);
+            m_bInstanceDirty = false;
+        }
     }
 
     void FStaticMesh::Render(Renderer::FRendererBase *pRenderer)
     {
-        Renderer::FRenderBatch& batch = pRenderer->AddBasePassBatch();
+        // PSO 为空说明 shader 还在后台编译
+        RHI::FRHIPipelineState* pMeshletPSO = m_pMaterial->GetMeshletPSO();
+        if (pMeshletPSO)
+        {
+            Renderer::FRenderBatch& batch = pRenderer->AddBasePassBatch();
 
-        // Draw(batch, m_pMaterial->GetPSO());
-        Dispatch(batch, m_pMaterial->GetMeshletPSO());
+            // Draw(batch, m_pMaterial->GetPSO());
+            Dispatch(batch, pMeshletPSO);
+        }
 
         if (m_pRenderer->IsEnableMouseHitTest())
         {
-            Renderer::FRenderBatch& idBatch = m_pRenderer->AddObjectIDPassBatch();
-            Draw(idBatch, m_pMaterial->GetIDPSO());
+            RHI::FRHIPipelineState* pIDPSO = m_pMaterial->GetIDPSO();
+            if (pIDPSO)
+            {
+                Renderer::FRenderBatch& idBatch = m_pRenderer->AddObjectIDPassBatch();
+                Draw(idBatch, pIDPSO);
+            }
         }
 
         if (m_ID == m_pRenderer->GetMouseHitObjectID())
         {
-            Renderer::FRenderBatch& outlineBatch = m_pRenderer->AddOutlinePassBatch();
-            Draw(outlineBatch, m_pMaterial->GetOutlinePSO());
+            RHI::FRHIPipelineState* pOutlinePSO = m_pMaterial->GetOutlinePSO();
+            if (pOutlinePSO)
+            {
+                Renderer::FRenderBatch& outlineBatch = m_pRenderer->AddOutlinePassBatch();
+                Draw(outlineBatch, pOutlinePSO);
+            }
         }
     }
 
+    void FStaticMesh::RequestPSOs()
+    {
+        m_pMaterial->GetMeshletPSO();
+        m_pMaterial->GetIDPSO();
+        m_pMaterial->GetOutlinePSO();
+    }
+
     void FStaticMesh::OnGUI()
     {
         IVisibleObject::OnGUI();
@@ -64,9 +118,10 @@ namespace Scene
         m_pMaterial->OnGUI();
     }
 
-    bool FStaticMesh::FrustumCull(const float4 *plane, uint32_t planeCount) const
+    void FStaticMesh::GetBoundingSphere(float3 &center, float &radius) const
     {
-        return ::FrustumCull(plane, planeCount, m_InstanceData.Center, m_InstanceData.Radius);
+        center = m_InstanceData.Center;
+        radius = m_InstanceData.Radius;
     }
 
     // void StaticMesh::SetPosition(const float3 &position)
@@ -86,8 +141,6 @@ namespace Scene
 
     void FStaticMesh::UpdateConstants()
     {
-        m_pMaterial->UpdateConstants();
-
         m_InstanceData.IndexBufferAddress = m_IndexBuffer.offset;
         m_InstanceData.IndexStride = m_IndexBufferFormat == RHI::ERHIFormat::R16UI ? 2 : 4;
         m_InstanceData.TriangleCount = m_IndexCount / 3;
@@ -103,7 +156,7 @@ namespace Scene
         m_InstanceData.TangentBufferAddress = m_TangentBuffer.offset;
 
         m_InstanceData.bVertexAnimation = false;
-        m_InstanceData.MaterialDataAddress = m_pRenderer->AllocateSceneConstantBuffer((void*)m_pMaterial->GetMaterialConstants(), sizeof(FModelMaterialConstants));
+        m_InstanceData.MaterialDataAddress = m_MaterialBuffer.offset;
         m_InstanceData.ObjectID = m_ID;
         m_InstanceData.Scale = eastl::max(eastl::max(abs(m_Scale.x), abs(m_Scale.y)), abs(m_Scale.z));
 
@@ -25,12 +25,13 @@ namespace Scene
         virtual bool Create() override;
         virtual void Tick(float deltaTime) override;
         virtual void Render(Renderer::FRendererBase* pRenderer) override;
+        virtual void RequestPSOs() override;
         
         virtual void OnGUI() override;
         // virtual void SetPosition(const float3& position) override;
         // virtual void SetRotation(const quaternion& rotation) override;
         // virtual void SetScale(const float3& scale) override;
-        bool FrustumCull(const float4* plane, uint32_t planeCount) const override;
+        void GetBoundingSphere(float3& center, float& radius) const override;
 
         Assets::FMeshMaterial* GetMaterial() const { return m_pMaterial.get(); }
 
@@ -59,7 +60,9 @@ namespace Scene
         uint32_t m_VertexCount = 0;
 
         FInstanceData m_InstanceData = {};
-        uint32_t m_InstanceIndex = 0;
+        uint32_t m_InstanceIndex = INVALID_INSTANCE_INDEX;
+        OffsetAllocator::Allocation m_MaterialBuffer;
+        bool m_bInstanceDirty = true;
 
         float3 m_Center = float3(0.0f);
         float m_Radius = 0.0f;
@@ -6,11 +6,9 @@
 #include "Utilities/Math.hpp"
 #include "Utilities/Log.hpp"
 #include "Utilities/String.hpp"
-#include "Utilities/ParallelFor.hpp"
+#include "Utilities/JobGraph.hpp"
 #include "Utilities/GUIUtil.hpp"
 
-#include <EASTL/atomic.h>
-
 #include <tinyxml2/tinyxml2.h>
 
 inline float3 strToFloat3(const eastl::string& str)
@@ -23,6 +21,8 @@ inline float3 strToFloat3(const eastl::string& str)
 
 namespace Scene
 {
+    static constexpr uint32_t CULLING_CHUNK_SIZE = 256;
+
     inline void LoadVisibleObject(tinyxml2::XMLElement *element, IVisibleObject* object)
     {
         const tinyxml2::XMLAttribute* position = element->FindAttribute("Position");
@@ -77,6 +77,8 @@ namespace Scene
             VTNA_LOG_ERROR("Failed to load scene file: {}", file);
             return;
         }
+        // 渲染线程上的 batch 还引用着旧场景的资源
+        Core::FVultanaEngine::GetEngineInstance()->GetRenderer()->FlushRenderThread();
         ClearScene();
 
         tinyxml2::XMLNode* rootNode = xmlDoc.FirstChild();
@@ -87,6 +89,23 @@ namespace Scene
         }
     }
 
+    void FWorld::PrecompileShaders()
+    {
+        Renderer::FRendererBase* pRenderer = Core::FVultanaEngine::GetEngineInstance()->GetRenderer();
+
+        // 第一遍把编译任务全部投递到 worker，第二遍在主线程创建 PSO
+        for (size_t i = 0; i < m_Objects.size(); i++)
+        {
+            m_Objects[i]->RequestPSOs();
+        }
+        pRenderer->WaitForShaderCompilation();
+
+        for (size_t i = 0; i < m_Objects.size(); i++)
+        {
+            m_Objects[i]->RequestPSOs();
+        }
+    }
+
     void FWorld::AddObject(IVisibleObject *object)
     {
         assert(object != nullptr);
@@ -114,38 +133,60 @@ namespace Scene
 
     void FWorld::Tick(float deltaTime)
     {
+        // 相机和光源读取 ImGui 输入并提交 GUI 命令，留在主线程
         m_pCamera->Tick(deltaTime);
 
-        for (auto iter = m_Objects.begin(); iter != m_Objects.end(); ++iter)
+        for (auto iter = m_Lights.begin(); iter != m_Lights.end(); ++iter)
         {
             (*iter)->Tick(deltaTime);
         }
 
-        for (auto iter = m_Lights.begin(); iter != m_Lights.end(); ++iter)
+        // 物体之间没有依赖，每个阶段内按物体并行：
+        // Tick（变换、动画、蒙皮矩阵和 instance 数据） -> 分块视锥剔除 -> 合并可见列表 -> 提交 batch
+        Renderer::FRendererBase* pRender = Core::FVultanaEngine::GetEngineInstance()->GetRenderer();
+        const uint32_t objectCount = (uint32_t)m_Objects.size();
+        const uint32_t chunkCount = DivideRoundingUp(objectCount, CULLING_CHUNK_SIZE);
+        const float4* frustumPlanes = m_pCamera->GetFrustumPlanes();
+
+        m_ObjectBounds.Resize(objectCount);
+        m_VisibleObjects.resize(objectCount);
+        m_ChunkVisibleCounts.resize(chunkCount);
+        uint32_t visibleCount = 0;
+
+        Utilities::FJobGraph jobGraph;
+        Utilities::FJobGraph::FJobHandle tickJob = jobGraph.AddJob(objectCount, [&](uint32_t i, uint32_t)
         {
-            (*iter)->Tick(deltaTime);
-        }
+            m_Objects[i]->Tick(deltaTime);
 
-        #pragma region : Frustum Culling
-        eastl::vector<IVisibleObject*> visibleObjects(m_Objects.size());
-        eastl::atomic<uint32_t> visibleCount = 0;
-        
-        Utilities::ParallelFor((uint32_t)m_Objects.size(), [&](uint32_t i)
+            float3 center;
+            float radius;
+            m_Objects[i]->GetBoundingSphere(center, radius);
+            m_ObjectBounds.Set(i, center, radius);
+        });
+        // 每块把可见序号写到自己在 m_VisibleObjects 中的区间，不需要原子计数
+        Utilities::FJobGraph::FJobHandle cullJob = jobGraph.AddJob(chunkCount, [&](uint32_t chunk, uint32_t)
+        {
+            uint32_t begin = chunk * CULLING_CHUNK_SIZE;
+            uint32_t end = eastl::min(begin + CULLING_CHUNK_SIZE, objectCount);
+            m_ChunkVisibleCounts[chunk] = FrustumCullSpheres(frustumPlanes, 6, m_ObjectBounds, begin, end, m_VisibleObjects.data() + begin);
+        }, { tickJob });
+        // 各块结果依次前移拼接，写入位置不会超过读取位置
+        Utilities::FJobGraph::FJobHandle compactJob = jobGraph.AddJob(1, [&](uint32_t, uint32_t)
         {
-            if (m_Objects[i]->FrustumCull(m_pCamera->GetFrustumPlanes(), 6))
+            for (uint32_t chunk = 0; chunk < chunkCount; chunk++)
             {
-                uint32_t idx = visibleCount.fetch_add(1);
-                visibleObjects[idx] = m_Objects[i].get();
+                memmove(m_VisibleObjects.data() + visibleCount, m_VisibleObjects.data() + chunk * CULLING_CHUNK_SIZE, sizeof(uint32_t) * m_ChunkVisibleCounts[chunk]);
+                visibleCount += m_ChunkVisibleCounts[chunk];
             }
-        });
-        visibleObjects.resize(visibleCount);
-
-        Renderer::FRendererBase* pRender = Core::FVultanaEngine::GetEngineInstance()->GetRenderer();
-        for (auto iter = visibleObjects.begin(); iter != visibleObjects.end(); ++iter)
+        }, { cullJob });
+        jobGraph.AddJob(objectCount, [&](uint32_t i, uint32_t)
         {
-            (*iter)->Render(pRender);
-        }
-        #pragma endregion : Frustum Culling
+            if (i < visibleCount)
+            {
+                m_Objects[m_VisibleObjects[i]]->Render(pRender);
+            }
+        }, { compactJob });
+        jobGraph.Run();
     }
 
     IVisibleObject *FWorld::GetVisibleObject(uint32_t index) const
@@ -3,6 +3,7 @@
 #include "SceneComponent/Lights/Light.hpp"
 #include "SceneComponent/StaticMesh.hpp"
 #include "Camera.hpp"
+#include "Utilities/FrustumCulling.hpp"
 
 namespace tinyxml2
 {
@@ -20,6 +21,8 @@ namespace Scene
         FCamera* GetCamera() { return m_pCamera.get(); }
 
         void LoadScene(const eastl::string& file);
+        // 在第一帧之前编译场景引用的所有 shader 变体并创建 PSO
+        void PrecompileShaders();
 
         void AddObject(IVisibleObject* object);
         void AddLight(ILight* light);
@@ -45,5 +48,10 @@ namespace Scene
         eastl::vector<eastl::unique_ptr<IVisibleObject>> m_Objects;
         eastl::vector<eastl::unique_ptr<ILight>> m_Lights;
         ILight* m_pMainLight = nullptr;
+
+        // 与 m_Objects 一一对应，每帧 Tick 后刷新
+        FBoundingSphereSoA m_ObjectBounds;
+        eastl::vector<uint32_t> m_VisibleObjects;
+        eastl::vector<uint32_t> m_ChunkVisibleCounts;
     };
 }
\ No newline at end of file
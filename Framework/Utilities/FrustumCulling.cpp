@@ -0,0 +1,153 @@
+#include "FrustumCulling.hpp"
+
+#include <EASTL/algorithm.h>
+
+#if FRUSTUM_CULL_SIMD_WIDTH > 1
+    #if defined(__ARM_NEON)
+        #include <arm_neon.h>
+    #else
+        #include <immintrin.h>
+    #endif
+#endif
+
+namespace
+{
+    // 把一组结果的可见位写成序号，不分支地推进写指针
+    inline uint32_t CompactVisibleMask(uint32_t mask, uint32_t first, uint32_t laneCount, uint32_t* visibleIndices)
+    {
+        uint32_t count = 0;
+        for (uint32_t lane = 0; lane < laneCount; lane++)
+        {
+            visibleIndices[count] = first + lane;
+            count += (mask >> lane) & 1;
+        }
+        return count;
+    }
+}
+
+uint32_t FrustumCullSpheresScalar(const float4* planes, uint32_t planeCount, const FBoundingSphereSoA& bounds, uint32_t begin, uint32_t end, uint32_t* visibleIndices)
+{
+    assert(end <= bounds.GetCount());
+
+    uint32_t count = 0;
+    for (uint32_t i = begin; i < end; i++)
+    {
+        float3 center(bounds.GetCenterX()[i], bounds.GetCenterY()[i], bounds.GetCenterZ()[i]);
+        if (FrustumCull(planes, planeCount, center, bounds.GetRadius()[i]))
+        {
+            visibleIndices[count++] = i;
+        }
+    }
+    return count;
+}
+
+#if FRUSTUM_CULL_SIMD_WIDTH > 1
+
+uint32_t FrustumCullSpheres(const float4* planes, uint32_t planeCount, const FBoundingSphereSoA& bounds, uint32_t begin, uint32_t end, uint32_t* visibleIndices)
+{
+    assert(end <= bounds.GetCount());
+    assert(planeCount <= MAX_FRUSTUM_CULL_PLANES);
+
+    const float* centerX = bounds.GetCenterX();
+    const float* centerY = bounds.GetCenterY();
+    const float* centerZ = bounds.GetCenterZ();
+    const float* radius = bounds.GetRadius();
+
+    uint32_t count = 0;
+
+#if defined(__AVX__)
+    __m256 planeX[MAX_FRUSTUM_CULL_PLANES], planeY[MAX_FRUSTUM_CULL_PLANES], planeZ[MAX_FRUSTUM_CULL_PLANES], planeW[MAX_FRUSTUM_CULL_PLANES];
+    for (uint32_t p = 0; p < planeCount; p++)
+    {
+        planeX[p] = _mm256_set1_ps(planes[p].x);
+        planeY[p] = _mm256_set1_ps(planes[p].y);
+        planeZ[p] = _mm256_set1_ps(planes[p].z);
+        planeW[p] = _mm256_set1_ps(planes[p].w);
+    }
+    const __m256 zero = _mm256_setzero_ps();
+
+    for (uint32_t i = begin; i < end; i += 8)
+    {
+        __m256 x = _mm256_loadu_ps(centerX + i);
+        __m256 y = _mm256_loadu_ps(centerY + i);
+        __m256 z = _mm256_loadu_ps(centerZ + i);
+        __m256 r = _mm256_loadu_ps(radius + i);
+
+        __m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (uint32_t p = 0; p < planeCount; p++)
+        {
+            __m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, planeX[p]), _mm256_mul_ps(y, planeY[p])), _mm256_mul_ps(z, planeZ[p])), planeW[p]), r);
+            // NLT 与标量的 !(d < 0) 对 NaN 的处理一致
+            visible = _mm256_and_ps(visible, _mm256_cmp_ps(d, zero, _CMP_NLT_UQ));
+        }
+        uint32_t mask = (uint32_t)_mm256_movemask_ps(visible);
+        count += CompactVisibleMask(mask, i, eastl::min(8u, end - i), visibleIndices + count);
+    }
+#elif defined(__ARM_NEON)
+    float32x4_t planeX[MAX_FRUSTUM_CULL_PLANES], planeY[MAX_FRUSTUM_CULL_PLANES], planeZ[MAX_FRUSTUM_CULL_PLANES], planeW[MAX_FRUSTUM_CULL_PLANES];
+    for (uint32_t p = 0; p < planeCount; p++)
+    {
+        planeX[p] = vdupq_n_f32(planes[p].x);
+        planeY[p] = vdupq_n_f32(planes[p].y);
+        planeZ[p] = vdupq_n_f32(planes[p].z);
+        planeW[p] = vdupq_n_f32(planes[p].w);
+    }
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const uint32x4_t laneBits = { 1, 2, 4, 8 };
+
+    for (uint32_t i = begin; i < end; i += 4)
+    {
+        float32x4_t x = vld1q_f32(centerX + i);
+        float32x4_t y = vld1q_f32(centerY + i);
+        float32x4_t z = vld1q_f32(centerZ + i);
+        float32x4_t r = vld1q_f32(radius + i);
+
+        uint32x4_t culled = vdupq_n_u32(0);
+        for (uint32_t p = 0; p < planeCount; p++)
+        {
+            float32x4_t d = vaddq_f32(vaddq_f32(vaddq_f32(vaddq_f32(vmulq_f32(x, planeX[p]), vmulq_f32(y, planeY[p])), vmulq_f32(z, planeZ[p])), planeW[p]), r);
+            culled = vorrq_u32(culled, vcltq_f32(d, zero));
+        }
+        uint32_t mask = vaddvq_u32(vbicq_u32(laneBits, culled));
+        count += CompactVisibleMask(mask, i, eastl::min(4u, end - i), visibleIndices + count);
+    }
+#else
+    __m128 planeX[MAX_FRUSTUM_CULL_PLANES], planeY[MAX_FRUSTUM_CULL_PLANES], planeZ[MAX_FRUSTUM_CULL_PLANES], planeW[MAX_FRUSTUM_CULL_PLANES];
+    for (uint32_t p = 0; p < planeCount; p++)
+    {
+        planeX[p] = _mm_set1_ps(planes[p].x);
+        planeY[p] = _mm_set1_ps(planes[p].y);
+        planeZ[p] = _mm_set1_ps(planes[p].z);
+        planeW[p] = _mm_set1_ps(planes[p].w);
+    }
+    const __m128 zero = _mm_setzero_ps();
+
+    for (uint32_t i = begin; i < end; i += 4)
+    {
+        __m128 x = _mm_loadu_ps(centerX + i);
+        __m128 y = _mm_loadu_ps(centerY + i);
+        __m128 z = _mm_loadu_ps(centerZ + i);
+        __m128 r = _mm_loadu_ps(radius + i);
+
+        __m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (uint32_t p = 0; p < planeCount; p++)
+        {
+            __m128 d = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, planeX[p]), _mm_mul_ps(y, planeY[p])), _mm_mul_ps(z, planeZ[p])), planeW[p]), r);
+            visible = _mm_and_ps(visible, _mm_cmpnlt_ps(d, zero));
+        }
+        uint32_t mask = (uint32_t)_mm_movemask_ps(visible);
+        count += CompactVisibleMask(mask, i, eastl::min(4u, end - i), visibleIndices + count);
+    }
+#endif
+
+    return count;
+}
+
+#else
+
+uint32_t FrustumCullSpheres(const float4* planes, uint32_t planeCount, const FBoundingSphereSoA& bounds, uint32_t begin, uint32_t end, uint32_t* visibleIndices)
+{
+    return FrustumCullSpheresScalar(planes, planeCount, bounds, begin, end, visibleIndices);
+}
+
+#endif
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Math.hpp"
+
+#include <EASTL/vector.h>
+
+// SIMD kernel 每次迭代处理的球数：AVX 8 个，SSE/NEON 4 个
+#if defined(__AVX__)
+    #define FRUSTUM_CULL_SIMD_WIDTH 8
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(__ARM_NEON) && defined(__aarch64__))
+    #define FRUSTUM_CULL_SIMD_WIDTH 4
+#else
+    #define FRUSTUM_CULL_SIMD_WIDTH 1
+#endif
+
+static constexpr uint32_t MAX_FRUSTUM_CULL_PLANES = 8;
+
+// 包围球的 SoA 存储：每个分量各自连续，SIMD kernel 一次加载相邻的多个物体
+// 末尾多留一组 SIMD 宽度的空间，kernel 可以从任意 begin 整组加载，多读的部分不会出现在剔除结果里
+class FBoundingSphereSoA
+{
+public:
+    void Resize(uint32_t count)
+    {
+        uint32_t capacity = RoundUpPow2(count, 8) + 8;
+        m_CenterX.resize(capacity, 0.0f);
+        m_CenterY.resize(capacity, 0.0f);
+        m_CenterZ.resize(capacity, 0.0f);
+        m_Radius.resize(capacity, 0.0f);
+        m_Count = count;
+    }
+
+    // 不同线程可以同时写不同的 index
+    void Set(uint32_t index, const float3& center, float radius)
+    {
+        assert(index < m_Count);
+        m_CenterX[index] = center.x;
+        m_CenterY[index] = center.y;
+        m_CenterZ[index] = center.z;
+        m_Radius[index] = radius;
+    }
+
+    uint32_t GetCount() const { return m_Count; }
+    const float* GetCenterX() const { return m_CenterX.data(); }
+    const float* GetCenterY() const { return m_CenterY.data(); }
+    const float* GetCenterZ() const { return m_CenterZ.data(); }
+    const float* GetRadius() const { return m_Radius.data(); }
+
+private:
+    eastl::vector<float> m_CenterX;
+    eastl::vector<float> m_CenterY;
+    eastl::vector<float> m_CenterZ;
+    eastl::vector<float> m_Radius;
+    uint32_t m_Count = 0;
+};
+
+// 测试 [begin, end) 中的包围球，可见的序号按升序写入 visibleIndices（至少 end - begin 个元素），返回可见数量
+// 判定与 FrustumCull 一致：任一平面上 dot(center, plane.xyz) + plane.w + radius < 0 即剔除
+uint32_t FrustumCullSpheres(const float4* planes, uint32_t planeCount, const FBoundingSphereSoA& bounds, uint32_t begin, uint32_t end, uint32_t* visibleIndices);
+
+// 逐个调用 FrustumCull 的标量版本，用于对照和测试
+uint32_t FrustumCullSpheresScalar(const float4* planes, uint32_t planeCount, const FBoundingSphereSoA& bounds, uint32_t begin, uint32_t end, uint32_t* visibleIndices);
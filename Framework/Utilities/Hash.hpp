@@ -4,6 +4,16 @@
 
 #include <city.h>
 
+inline uint64_t HashCombine64(uint64_t hash0, uint64_t hash1)
+{
+    const uint64_t kMul = 0x9ddfea08eb382d69ULL;
+    uint64_t a = (hash1 ^ hash0) * kMul;
+    a ^= (a >> 47);
+    uint64_t b = (hash0 ^ a) * kMul;
+    b ^= (b >> 47);
+    return b * kMul;
+}
+
 namespace Utility
 {
     static constexpr uint32_t crcTable[256] = {
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Core/VultanaEngine.hpp"
+#include <enkiTS/TaskScheduler.h>
+
+#include <EASTL/algorithm.h>
+#include <EASTL/vector.h>
+#include <EASTL/unique_ptr.h>
+#include <EASTL/functional.h>
+
+#include <initializer_list>
+
+namespace Utilities
+{
+    // 一次性的任务图：每个节点是一个并行的 TaskSet，节点之间的依赖交给 enkiTS 调度
+    // 所有节点在 Run 之前添加，Run 阻塞到全部节点完成，调用线程也参与执行
+    class FJobGraph
+    {
+    public:
+        using FJobHandle = uint32_t;
+        using FJobFunc = eastl::function<void(uint32_t index, uint32_t threadNum)>;
+
+        FJobGraph() = default;
+        FJobGraph(const FJobGraph&) = delete;
+        FJobGraph& operator=(const FJobGraph&) = delete;
+
+        ~FJobGraph()
+        {
+            // 依赖关系记录在后添加的节点上，先销毁它们
+            while (!m_Jobs.empty())
+            {
+                m_Jobs.pop_back();
+            }
+        }
+
+        // func 对 [0, count) 中的每个元素调用一次，count 为 0 的节点同样参与依赖
+        FJobHandle AddJob(uint32_t count, FJobFunc func, std::initializer_list<FJobHandle> dependencies = {}, uint32_t minRange = 1)
+        {
+            FJobHandle handle = (FJobHandle)m_Jobs.size();
+            FJob* pJob = m_Jobs.emplace_back(eastl::make_unique<FJob>(count, eastl::move(func), minRange)).get();
+
+            for (FJobHandle dependency : dependencies)
+            {
+                assert(dependency < handle);
+                FJob* pDependency = m_Jobs[dependency].get();
+                pDependency->bHasDependents = true;
+
+                enki::Dependency& dep = *pJob->Dependencies.emplace_back(eastl::make_unique<enki::Dependency>());
+                pJob->SetDependency(dep, pDependency);
+            }
+            return handle;
+        }
+
+        void Run()
+        {
+            enki::TaskScheduler* ts = Core::FVultanaEngine::GetEngineInstance()->GetTaskScheduler();
+            for (auto& pJob : m_Jobs)
+            {
+                if (pJob->Dependencies.empty())
+                {
+                    ts->AddTaskSetToPipe(pJob.get());
+                }
+            }
+            // 依赖节点在前置节点完成时由 enkiTS 自动投递，只需等待没有后继的节点
+            for (auto& pJob : m_Jobs)
+            {
+                if (!pJob->bHasDependents)
+                {
+                    ts->WaitforTask(pJob.get());
+                }
+            }
+        }
+
+    private:
+        struct FJob : public enki::ITaskSet
+        {
+            FJob(uint32_t count, FJobFunc func, uint32_t minRange)
+                : enki::ITaskSet(eastl::max(count, 1u), minRange), Count(count), Func(eastl::move(func))
+            {
+            }
+
+            void ExecuteRange(enki::TaskSetPartition range, uint32_t threadNum) override
+            {
+                for (uint32_t i = range.start; i < range.end && i < Count; ++i)
+                {
+                    Func(i, threadNum);
+                }
+            }
+
+            uint32_t Count;
+            FJobFunc Func;
+            eastl::vector<eastl::unique_ptr<enki::Dependency>> Dependencies;
+            bool bHasDependents = false;
+        };
+
+        eastl::vector<eastl::unique_ptr<FJob>> m_Jobs;
+    };
+}
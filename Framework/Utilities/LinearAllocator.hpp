@@ -3,6 +3,8 @@
 #include "Math.hpp"
 #include "Memory.hpp"
 
+#include <atomic>
+
 class FLinearAllocator
 {
 public:
@@ -17,22 +19,27 @@ public:
         VTNA_FREE(m_pMemory);
     }
 
+    // 可以被多个线程同时调用，Reset 需要在没有其他线程分配时进行
     void* Allocate(uint32_t size, uint32_t alignment = 1)
     {
-        uint32_t address = RoundUpPow2(m_PointerOffset, alignment);
-        assert(address + size <= m_MemorySize);
-        m_PointerOffset = address + size;
+        uint32_t offset = m_PointerOffset.load(std::memory_order_relaxed);
+        uint32_t address;
+        do
+        {
+            address = RoundUpPow2(offset, alignment);
+            assert(address + size <= m_MemorySize);
+        } while (!m_PointerOffset.compare_exchange_weak(offset, address + size, std::memory_order_relaxed));
 
         return (char*)m_pMemory + address;
     }
 
     void Reset()
     {
-        m_PointerOffset = 0;
+        m_PointerOffset.store(0, std::memory_order_relaxed);
     }
 
 private:
     void* m_pMemory = nullptr;
     uint32_t m_MemorySize = 0;
-    uint32_t m_PointerOffset = 0;
+    std::atomic<uint32_t> m_PointerOffset = 0;
 };
\ No newline at end of file
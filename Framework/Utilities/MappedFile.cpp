@@ -0,0 +1,70 @@
+#include "MappedFile.hpp"
+
+#include <Windows.h>
+
+namespace Utility
+{
+    FMappedFile::~FMappedFile()
+    {
+        Close();
+    }
+
+    bool FMappedFile::Open(const eastl::string &file)
+    {
+        Close();
+
+        HANDLE fileHandle = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(fileHandle, &size) || size.QuadPart == 0)
+        {
+            CloseHandle(fileHandle);
+            return false;
+        }
+
+        HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mappingHandle == nullptr)
+        {
+            CloseHandle(fileHandle);
+            return false;
+        }
+
+        const void* data = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        if (data == nullptr)
+        {
+            CloseHandle(mappingHandle);
+            CloseHandle(fileHandle);
+            return false;
+        }
+
+        m_FileHandle = fileHandle;
+        m_MappingHandle = mappingHandle;
+        m_pData = data;
+        m_Size = (size_t)size.QuadPart;
+        return true;
+    }
+
+    void FMappedFile::Close()
+    {
+        if (m_pData)
+        {
+            UnmapViewOfFile(m_pData);
+            m_pData = nullptr;
+        }
+        if (m_MappingHandle)
+        {
+            CloseHandle((HANDLE)m_MappingHandle);
+            m_MappingHandle = nullptr;
+        }
+        if (m_FileHandle)
+        {
+            CloseHandle((HANDLE)m_FileHandle);
+            m_FileHandle = nullptr;
+        }
+        m_Size = 0;
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <EASTL/string.h>
+
+namespace Utility
+{
+    // 只读内存映射文件，数据在 Close/析构 前一直有效
+    class FMappedFile
+    {
+    public:
+        FMappedFile() = default;
+        ~FMappedFile();
+
+        FMappedFile(const FMappedFile&) = delete;
+        FMappedFile& operator=(const FMappedFile&) = delete;
+
+        bool Open(const eastl::string& file);
+        void Close();
+
+        bool IsOpen() const { return m_pData != nullptr; }
+        const void* GetData() const { return m_pData; }
+        size_t GetSize() const { return m_Size; }
+
+    private:
+        void* m_FileHandle = nullptr;
+        void* m_MappingHandle = nullptr;
+        const void* m_pData = nullptr;
+        size_t m_Size = 0;
+    };
+}
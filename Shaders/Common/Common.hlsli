@@ -63,6 +63,18 @@ bool ProjectSphere(float3 center, float radius, float znear, float P00, float P1
     return true;
 }
 
+bool FrustumCull(float3 center, float radius)
+{
+    for (uint i = 0; i < 6; ++i)
+    {
+        if (dot(center, GetCameraConstants().CullingData.FrustumPlanes[i].xyz) + GetCameraConstants().CullingData.FrustumPlanes[i].w + radius < 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool OcclusionCull(Texture2D<float> hzbTexture, uint2 hzbSize, float3 center, float radius)
 {
     center = mul(GetCameraConstants().MtxView, float4(center, 1.0)).xyz;
@@ -2,6 +2,8 @@
 
 #include "GlobalConstants.hlsli"
 
+static const uint INVALID_INSTANCE_INDEX = 0xFFFFFFFF;
+
 struct FInstanceData
 {
     uint IndexBufferAddress;
@@ -45,6 +47,13 @@ T LoadSceneConstantBuffer(uint bufferAddress)
     return buffer.Load<T>(bufferAddress);
 }
 
+template <typename T>
+T LoadSceneInstanceBuffer(uint bufferAddress)
+{
+    ByteAddressBuffer buffer = ResourceDescriptorHeap[SceneCB.SceneInstanceBufferSRV];
+    return buffer.Load<T>(bufferAddress);
+}
+
 template <typename T>
 T LoadSceneStaticBuffer(uint bufferAddress, uint elementID)
 {
@@ -68,6 +77,6 @@ void StoreSceneAnimationBuffer(uint bufferAddress, uint elementID, T value)
 
 FInstanceData GetInstanceData(uint instanceID)
 {
-    return LoadSceneConstantBuffer<FInstanceData>(SceneCB.instanceDataAddress + sizeof(FInstanceData) * instanceID);
+    return LoadSceneInstanceBuffer<FInstanceData>(sizeof(FInstanceData) * instanceID);
 }
 #endif
\ No newline at end of file
@@ -36,7 +36,7 @@ struct FSceneConstants
     uint SceneAnimationBufferUAV;
 
     float3 LightDirection;
-    uint instanceDataAddress;
+    uint SceneInstanceBufferSRV;
 
     float3 LightColor;
     float LightRadius;
@@ -82,7 +82,8 @@ struct FSceneConstants
     uint Aniso16xSampler;
 
     uint bShowMeshlets;
-    uint3 _Padding00;
+    float MeshletLodErrorThreshold;     // 像素
+    uint2 _Padding00;
 };
 
 #ifndef __cplusplus
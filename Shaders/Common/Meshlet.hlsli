@@ -11,6 +11,13 @@ struct FMeshlet
     uint TriangleCount;
     uint VertexOffset;
     uint TriangleOffset;
+
+    float3 LodCenter;
+    float LodRadius;
+    float3 ParentLodCenter;
+    float ParentLodRadius;
+    float LodError;
+    float ParentLodError;
 };
 
 struct FMeshletPayload
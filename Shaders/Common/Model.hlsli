@@ -6,7 +6,7 @@
 
 FModelMaterialConstants GetMaterialConstants(uint instanceID)
 {
-    return LoadSceneConstantBuffer<FModelMaterialConstants>(GetInstanceData(instanceID).MaterialDataAddress);
+    return LoadSceneInstanceBuffer<FModelMaterialConstants>(GetInstanceData(instanceID).MaterialDataAddress);
 }
 
 struct FVertexAttributes
@@ -0,0 +1,38 @@
+#include "Common/Common.hlsli"
+
+cbuffer RootConstants : register(b0)
+{
+    uint cUpdateBufferSRV;
+    uint cInstanceBufferUAV;
+    uint cFirstCommand;
+    uint cCommandCount;
+};
+
+// 与 FGPUScene::FPendingUpdate 对应
+struct FSceneUpdateCommand
+{
+    uint DstAddress;
+    uint SrcAddress;
+    uint DwordCount;
+    uint _Padding;
+};
+
+[numthreads(64, 1, 1)]
+void CSMain(uint3 groupID : SV_GroupID, uint3 groupThreadID : SV_GroupThreadID)
+{
+    uint commandIndex = cFirstCommand + groupID.x;
+    if (commandIndex >= cCommandCount)
+    {
+        return;
+    }
+
+    ByteAddressBuffer updateBuffer = ResourceDescriptorHeap[cUpdateBufferSRV];
+    RWByteAddressBuffer instanceBuffer = ResourceDescriptorHeap[cInstanceBufferUAV];
+
+    FSceneUpdateCommand command = updateBuffer.Load<FSceneUpdateCommand>(sizeof(FSceneUpdateCommand) * commandIndex);
+
+    for (uint i = groupThreadID.x; i < command.DwordCount; i += 64)
+    {
+        instanceBuffer.Store(command.DstAddress + sizeof(uint) * i, updateBuffer.Load(command.SrcAddress + sizeof(uint) * i));
+    }
+}
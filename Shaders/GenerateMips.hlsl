@@ -0,0 +1,51 @@
+cbuffer CB : register(b0)
+{
+    uint cSrcMipUAV;
+    uint cDstMipUAV;
+    uint2 cSrcSize;
+    uint2 cDstSize;
+};
+
+#if defined(MIP_TYPE_FLOAT)
+    #define MIP_TYPE float
+#elif defined(MIP_TYPE_FLOAT2)
+    #define MIP_TYPE float2
+#elif defined(MIP_TYPE_FLOAT4)
+    #define MIP_TYPE float4
+#else
+    #error "Unknown MIP_TYPE"
+#endif
+
+[numthreads(8, 8, 1)]
+void CSMain(uint2 dispatchThreadID : SV_DispatchThreadID)
+{
+    if (any(dispatchThreadID >= cDstSize))
+    {
+        return;
+    }
+
+    RWTexture2D<MIP_TYPE> srcTexture = ResourceDescriptorHeap[cSrcMipUAV];
+    RWTexture2D<MIP_TYPE> dstTexture = ResourceDescriptorHeap[cDstMipUAV];
+
+    // 源尺寸为奇数时一个目标纹素覆盖 3 个源纹素，按覆盖范围求平均
+    uint2 begin = dispatchThreadID * cSrcSize / cDstSize;
+    uint2 end = ((dispatchThreadID + 1) * cSrcSize + cDstSize - 1) / cDstSize;
+
+    MIP_TYPE sum = 0;
+    for (uint y = begin.y; y < end.y; y++)
+    {
+        for (uint x = begin.x; x < end.x; x++)
+        {
+            sum += srcTexture[uint2(x, y)];
+        }
+    }
+    MIP_TYPE result = sum / float((end.x - begin.x) * (end.y - begin.y));
+
+#if defined(NORMAL_MAP) && defined(MIP_TYPE_FLOAT4)
+    float3 normal = result.xyz * 2.0 - 1.0;
+    float len = length(normal);
+    result.xyz = (len > 0.0 ? normal / len : float3(0.0, 0.0, 1.0)) * 0.5 + 0.5;
+#endif
+
+    dstTexture[dispatchThreadID] = result;
+}
@@ -23,15 +23,47 @@ cbuffer BuildInstanceCullingCommandConstants : register(b0)
     uint cObjectListCounterBufferSRV;
 };
 
-cbuffer BuildMeshletListConstants : register(b0)
+// instance 列表按 PSO 分桶连续存放，桶表每项为 uint4(InstanceOffset, InstanceCount, MeshletListOffset, 0)
+cbuffer CompactInstancesConstants : register(b0)
 {
-    uint cDispatchIndex;
+    uint cBucketInstanceIndexAddress;
+    uint cBucketInstanceCount;
+    uint cBucketTableAddress;
+    uint cBucketCount;
     uint cCullingResultSRV;
-    uint cOriginMeshletListAddress;
-    uint cOriginMeshletCount;
-    uint cMeshletListOffset;
+    uint cVisibleInstanceListUAV;
+    uint cVisibleInstanceCounterUAV;
+    uint cMeshletListCounterUAV;
+};
+
+cbuffer BuildExpandMeshletsCommandConstants : register(b0)
+{
+    uint cExpandCommandBufferUAV;
+    uint cVisibleInstanceCounterSRV;
+};
+
+cbuffer BuildDrawIndexedCommandConstants : register(b0)
+{
+    uint cDrawBatchAddress;     // uint2(instanceIndex, indexCount)
+    uint cDrawBatchCount;
+    uint cDrawCullingResultSRV;
+    uint cDrawCommandBufferUAV;
+};
+
+struct FDrawIndexedCommand
+{
+    uint IndexCount;
+    uint InstanceCount;
+    uint FirstIndex;
+    int BaseVertex;
+    uint FirstInstance;
+};
+
+cbuffer ExpandMeshletsConstants : register(b0)
+{
+    uint cExpandVisibleInstanceListSRV;
+    uint cExpandVisibleInstanceCounterSRV;
     uint cMeshletListBufferUAV;
-    uint cMeshletListBufferCounterUAV;
 };
 
 cbuffer IndirectCommandConstants : register(b0)
@@ -114,7 +146,8 @@ void InstanceCulling(uint3 dispatchThreadID : SV_DispatchThreadID)
 
     Texture2D<float> hzbTexture = GetHZBTexture();
     uint2 hzbSize = uint2(SceneCB.HZBWidth, SceneCB.HZBHeight);
-    bool visible = OcclusionCull(hzbTexture, hzbSize, instanceData.Center, instanceData.Radius);
+    bool inFrustum = FrustumCull(instanceData.Center, instanceData.Radius);
+    bool visible = inFrustum && OcclusionCull(hzbTexture, hzbSize, instanceData.Center, instanceData.Radius);
 
     RWBuffer<uint> cullingResultBuffer = ResourceDescriptorHeap[cCullingResultUAV];
     cullingResultBuffer[instanceIndex] = visible ? 1 : 0;
@@ -122,7 +155,8 @@ void InstanceCulling(uint3 dispatchThreadID : SV_DispatchThreadID)
     CullingStats(visible, instanceData.TriangleCount);
 
 #if FIRST_PHASE
-    if (!visible)
+    // 视锥外的 instance 第二阶段也不可能可见
+    if (inFrustum && !visible)
     {
         RWBuffer<uint> instanceList2ndPhase = ResourceDescriptorHeap[cInstanceListUAV2ndPhase];
         RWBuffer<uint> instanceListCounter2ndPhase = ResourceDescriptorHeap[cInstanceListCounterUAV2ndPhase];
@@ -145,28 +179,139 @@ void BuildInstanceCullingCmd(uint3 dispatchThreadID : SV_DispatchThreadID)
 }
 
 [numthreads(64, 1, 1)]
-void BuildMeshletList(uint3 dispatchThreadID : SV_DispatchThreadID)
+void BuildDrawIndexedCmd(uint3 dispatchThreadID : SV_DispatchThreadID)
 {
-    if (dispatchThreadID.x >= cOriginMeshletCount)
+    uint batchIndex = dispatchThreadID.x;
+    if (batchIndex >= cDrawBatchCount)
     {
         return;
     }
 
-    ByteAddressBuffer constantBuffer = ResourceDescriptorHeap[SceneCB.SceneConstantBufferSRV];
-    uint2 meshlet = constantBuffer.Load2(cOriginMeshletListAddress + sizeof(uint2) * dispatchThreadID.x);
+    uint2 batch = LoadSceneConstantBuffer<uint2>(cDrawBatchAddress + sizeof(uint2) * batchIndex);
+    Buffer<uint> cullingResultBuffer = ResourceDescriptorHeap[cDrawCullingResultSRV];
+
+    FDrawIndexedCommand command;
+    command.IndexCount = batch.y;
+    command.InstanceCount = cullingResultBuffer[batch.x] == 1 ? 1 : 0;
+    command.FirstIndex = 0;
+    command.BaseVertex = 0;
+    command.FirstInstance = 0;
+
+    RWStructuredBuffer<FDrawIndexedCommand> commandBuffer = ResourceDescriptorHeap[cDrawCommandBufferUAV];
+    commandBuffer[batchIndex] = command;
+}
+
+uint4 LoadBucket(uint bucketIndex)
+{
+    return LoadSceneConstantBuffer<uint4>(cBucketTableAddress + sizeof(uint4) * bucketIndex);
+}
+
+uint FindBucket(uint position)
+{
+    uint low = 0;
+    uint high = cBucketCount - 1;
+    while (low < high)
+    {
+        uint mid = (low + high + 1) / 2;
+        if (LoadBucket(mid).x <= position)
+        {
+            low = mid;
+        }
+        else
+        {
+            high = mid - 1;
+        }
+    }
+    return low;
+}
+
+[numthreads(64, 1, 1)]
+void CompactVisibleInstances(uint3 dispatchThreadID : SV_DispatchThreadID)
+{
+    // 越界的线程归到最后一个桶，整个 wave 都参与下面的 wave 操作
+    uint position = dispatchThreadID.x;
+    uint bucket = cBucketCount - 1;
+    uint instanceIndex = INVALID_INSTANCE_INDEX;
+    uint meshletCount = 0;
 
-    Buffer<uint> cullingResultBuffer = ResourceDescriptorHeap[cCullingResultSRV];
-    bool visible = (cullingResultBuffer[meshlet.x] == 1);
+    if (position < cBucketInstanceCount)
+    {
+        ByteAddressBuffer constantBuffer = ResourceDescriptorHeap[SceneCB.SceneConstantBufferSRV];
+        instanceIndex = constantBuffer.Load(cBucketInstanceIndexAddress + sizeof(uint) * position);
+        bucket = FindBucket(position);
+
+        Buffer<uint> cullingResultBuffer = ResourceDescriptorHeap[cCullingResultSRV];
+        if (cullingResultBuffer[instanceIndex] == 1)
+        {
+            meshletCount = GetInstanceData(instanceIndex).MeshletCount;
+        }
+    }
+
+    // 在所属桶的 meshlet 列表中为整个 instance 分配连续的一段
+    // 同一个 wave 落在同一个桶时（分桶后的常见情况）先做 wave 内前缀和，只需一次原子操作
+    RWBuffer<uint> meshletListCounterBuffer = ResourceDescriptorHeap[cMeshletListCounterUAV];
+    uint meshletOffset = 0;
+    if (WaveActiveAllEqual(bucket))
+    {
+        uint waveMeshletCount = WaveActiveSum(meshletCount);
+        uint waveMeshletOffset = 0;
+        if (WaveIsFirstLane() && waveMeshletCount > 0)
+        {
+            InterlockedAdd(meshletListCounterBuffer[bucket], waveMeshletCount, waveMeshletOffset);
+        }
+        meshletOffset = WaveReadLaneFirst(waveMeshletOffset) + WavePrefixSum(meshletCount);
+    }
+    else if (meshletCount > 0)
+    {
+        InterlockedAdd(meshletListCounterBuffer[bucket], meshletCount, meshletOffset);
+    }
+
+    bool visible = meshletCount > 0;
+    uint waveVisibleCount = WaveActiveCountBits(visible);
+    uint listOffset = 0;
+    if (WaveIsFirstLane() && waveVisibleCount > 0)
+    {
+        RWBuffer<uint> visibleInstanceCounterBuffer = ResourceDescriptorHeap[cVisibleInstanceCounterUAV];
+        InterlockedAdd(visibleInstanceCounterBuffer[0], waveVisibleCount, listOffset);
+    }
+    listOffset = WaveReadLaneFirst(listOffset) + WavePrefixCountBits(visible);
 
     if (visible)
     {
-        RWStructuredBuffer<uint2> meshletListBuffer = ResourceDescriptorHeap[cMeshletListBufferUAV];
-        RWBuffer<uint> counterBuffer = ResourceDescriptorHeap[cMeshletListBufferCounterUAV];
+        RWStructuredBuffer<uint4> visibleInstanceListBuffer = ResourceDescriptorHeap[cVisibleInstanceListUAV];
+        visibleInstanceListBuffer[listOffset] = uint4(instanceIndex, LoadBucket(bucket).z + meshletOffset, meshletCount, 0);
+    }
+}
 
-        uint outIndex;
-        InterlockedAdd(counterBuffer[cDispatchIndex], 1, outIndex);
+[numthreads(1, 1, 1)]
+void BuildExpandMeshletsCmd(uint3 dispatchThreadID : SV_DispatchThreadID)
+{
+    Buffer<uint> visibleInstanceCounterBuffer = ResourceDescriptorHeap[cVisibleInstanceCounterSRV];
+    uint instanceCount = visibleInstanceCounterBuffer[0];
+
+    // 每个可见 instance 一个线程组，超过 65535 时折到 Y 方向
+    RWStructuredBuffer<uint3> commandBuffer = ResourceDescriptorHeap[cExpandCommandBufferUAV];
+    commandBuffer[0] = uint3(min(instanceCount, 65535), (instanceCount + 65534) / 65535, 1);
+}
+
+[numthreads(64, 1, 1)]
+void ExpandMeshlets(uint3 groupID : SV_GroupID, uint groupIndex : SV_GroupIndex)
+{
+    uint listIndex = groupID.y * 65535 + groupID.x;
 
-        meshletListBuffer[cMeshletListOffset +outIndex] = meshlet;
+    Buffer<uint> visibleInstanceCounterBuffer = ResourceDescriptorHeap[cExpandVisibleInstanceCounterSRV];
+    if (listIndex >= visibleInstanceCounterBuffer[0])
+    {
+        return;
+    }
+
+    StructuredBuffer<uint4> visibleInstanceListBuffer = ResourceDescriptorHeap[cExpandVisibleInstanceListSRV];
+    uint4 instance = visibleInstanceListBuffer[listIndex];
+
+    RWStructuredBuffer<uint2> meshletListBuffer = ResourceDescriptorHeap[cMeshletListBufferUAV];
+    for (uint i = groupIndex; i < instance.z; i += 64)
+    {
+        meshletListBuffer[instance.y + i] = uint2(instance.x, i);
     }
 }
 
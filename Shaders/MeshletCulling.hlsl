@@ -15,6 +15,24 @@ cbuffer MeshletCullingConstants : register(b0)
 
 groupshared FMeshletPayload s_Payload;
 
+float ProjectLodError(float3 center, float radius, float error)
+{
+    float distance = max(length(center - GetCameraConstants().CameraPosition) - radius, GetCameraConstants().NearPlane);
+    return error / distance * (SceneCB.RenderSize.y * 0.5 * GetCameraConstants().MtxProjection[1][1]);
+}
+
+// 自身误差可以接受且父节点误差不可接受的 meshlet 构成 LOD 切面，同一位置只会选中一个层级
+bool IsLodSelected(FMeshlet meshlet, FInstanceData instanceData)
+{
+    float3 lodCenter = mul(instanceData.MtxWorld, float4(meshlet.LodCenter, 1.0f)).xyz;
+    float3 parentLodCenter = mul(instanceData.MtxWorld, float4(meshlet.ParentLodCenter, 1.0f)).xyz;
+
+    float lodError = ProjectLodError(lodCenter, meshlet.LodRadius * instanceData.Scale, meshlet.LodError * instanceData.Scale);
+    float parentLodError = ProjectLodError(parentLodCenter, meshlet.ParentLodRadius * instanceData.Scale, meshlet.ParentLodError * instanceData.Scale);
+
+    return lodError <= SceneCB.MeshletLodErrorThreshold && parentLodError > SceneCB.MeshletLodErrorThreshold;
+}
+
 bool Cull(FMeshlet meshlet, uint instanceIndex, uint meshletIndex)
 {
     FInstanceData instanceData = GetInstanceData(instanceIndex);
@@ -91,17 +109,22 @@ void ASMain(uint3 dispatchThreadID : SV_DispatchThreadID)
         uint instanceIndex = dataPerMeshlet.x;
         uint meshletIndex = dataPerMeshlet.y;
 
-        FMeshlet meshlet = LoadSceneStaticBuffer<FMeshlet>(GetInstanceData(instanceIndex).MeshletBufferAddress, meshletIndex);
-
-        visible = Cull(meshlet, instanceIndex, meshletIndex);
+        FInstanceData instanceData = GetInstanceData(instanceIndex);
+        FMeshlet meshlet = LoadSceneStaticBuffer<FMeshlet>(instanceData.MeshletBufferAddress, meshletIndex);
 
-        if (cbFirstPass)
-        {
-            stats(visible ? STATS_1ST_PHASE_RENDERED_TRIANGLE : STATS_1ST_PHASE_CULLED_TRIANGLE, meshlet.TriangleCount);
-        }
-        else
+        // 未被 LOD 选中的 meshlet 不参与剔除，也不计入统计
+        if (IsLodSelected(meshlet, instanceData))
         {
-            stats(visible ? STATS_2ND_PHASE_RENDERED_TRIANGLE : STATS_2ND_PHASE_CULLED_TRIANGLE, meshlet.TriangleCount);
+            visible = Cull(meshlet, instanceIndex, meshletIndex);
+
+            if (cbFirstPass)
+            {
+                stats(visible ? STATS_1ST_PHASE_RENDERED_TRIANGLE : STATS_1ST_PHASE_CULLED_TRIANGLE, meshlet.TriangleCount);
+            }
+            else
+            {
+                stats(visible ? STATS_2ND_PHASE_RENDERED_TRIANGLE : STATS_2ND_PHASE_CULLED_TRIANGLE, meshlet.TriangleCount);
+            }
         }
 
         if (visible)
@@ -0,0 +1,99 @@
+// 视锥剔除微基准：逐物体标量 FrustumCull（AoS）、SoA 上的标量循环、SoA 上的 SIMD kernel
+// 用法：FrustumCullBenchmark [物体数量] [迭代次数]
+
+#include "Utilities/FrustumCulling.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    struct FSphere
+    {
+        float3 Center;
+        float Radius;
+    };
+
+    template <typename F>
+    double MeasureNanoseconds(uint32_t iterations, F func)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (uint32_t i = 0; i < iterations; i++)
+        {
+            func();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / iterations;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const uint32_t objectCount = argc > 1 ? (uint32_t)atoi(argv[1]) : 100000;
+    const uint32_t iterations = argc > 2 ? (uint32_t)atoi(argv[2]) : 200;
+
+    float4 planes[6] =
+    {
+        NormalizePlane(float4(1.0f, 0.0f, 1.0f, 0.0f)),
+        NormalizePlane(float4(-1.0f, 0.0f, 1.0f, 0.0f)),
+        NormalizePlane(float4(0.0f, -1.0f, 1.0f, 0.0f)),
+        NormalizePlane(float4(0.0f, 1.0f, 1.0f, 0.0f)),
+        float4(0.0f, 0.0f, 1.0f, -1.0f),
+        float4(0.0f, 0.0f, -1.0f, 1000.0f),
+    };
+
+    eastl::vector<FSphere> spheres(objectCount);
+    FBoundingSphereSoA bounds;
+    bounds.Resize(objectCount);
+
+    uint32_t seed = 1;
+    auto random = [&seed](float minValue, float maxValue)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return minValue + (maxValue - minValue) * (float)(seed >> 8) / (float)(1u << 24);
+    };
+    for (uint32_t i = 0; i < objectCount; i++)
+    {
+        spheres[i].Center = float3(random(-1000.0f, 1000.0f), random(-1000.0f, 1000.0f), random(-500.0f, 1500.0f));
+        spheres[i].Radius = random(0.5f, 20.0f);
+        bounds.Set(i, spheres[i].Center, spheres[i].Radius);
+    }
+
+    eastl::vector<uint32_t> visible(objectCount);
+    uint32_t visibleCount = 0;
+
+    double aosTime = MeasureNanoseconds(iterations, [&]()
+    {
+        visibleCount = 0;
+        for (uint32_t i = 0; i < objectCount; i++)
+        {
+            if (FrustumCull(planes, 6, spheres[i].Center, spheres[i].Radius))
+            {
+                visible[visibleCount++] = i;
+            }
+        }
+    });
+    const uint32_t aosVisible = visibleCount;
+
+    double scalarTime = MeasureNanoseconds(iterations, [&]()
+    {
+        visibleCount = FrustumCullSpheresScalar(planes, 6, bounds, 0, objectCount, visible.data());
+    });
+    const uint32_t scalarVisible = visibleCount;
+
+    double simdTime = MeasureNanoseconds(iterations, [&]()
+    {
+        visibleCount = FrustumCullSpheres(planes, 6, bounds, 0, objectCount, visible.data());
+    });
+    const uint32_t simdVisible = visibleCount;
+
+    printf("objects: %u, iterations: %u, SIMD width: %d\n", objectCount, iterations, FRUSTUM_CULL_SIMD_WIDTH);
+    printf("%-16s %12s %12s %10s\n", "path", "us/frame", "ns/object", "visible");
+    printf("%-16s %12.2f %12.3f %10u\n", "scalar (AoS)", aosTime / 1000.0, aosTime / objectCount, aosVisible);
+    printf("%-16s %12.2f %12.3f %10u\n", "scalar (SoA)", scalarTime / 1000.0, scalarTime / objectCount, scalarVisible);
+    printf("%-16s %12.2f %12.3f %10u\n", "SIMD (SoA)", simdTime / 1000.0, simdTime / objectCount, simdVisible);
+    printf("speedup vs AoS: %.2fx\n", aosTime / simdTime);
+
+    return (aosVisible == simdVisible && scalarVisible == simdVisible) ? 0 : 1;
+}
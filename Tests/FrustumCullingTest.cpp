@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include "Utilities/FrustumCulling.hpp"
+
+namespace
+{
+    // 类似透视相机的六个平面：近平面 z = 1，远平面 z = 100，左右上下四个面向外倾斜
+    void MakeTestFrustum(float4* planes)
+    {
+        planes[0] = NormalizePlane(float4(1.0f, 0.0f, 1.0f, 0.0f));
+        planes[1] = NormalizePlane(float4(-1.0f, 0.0f, 1.0f, 0.0f));
+        planes[2] = NormalizePlane(float4(0.0f, -1.0f, 1.0f, 0.0f));
+        planes[3] = NormalizePlane(float4(0.0f, 1.0f, 1.0f, 0.0f));
+        planes[4] = float4(0.0f, 0.0f, 1.0f, -1.0f);
+        planes[5] = float4(0.0f, 0.0f, -1.0f, 100.0f);
+    }
+
+    void FillRandomSpheres(FBoundingSphereSoA& bounds, uint32_t count)
+    {
+        bounds.Resize(count);
+        uint32_t seed = 4242;
+        auto random = [&seed](float minValue, float maxValue)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            return minValue + (maxValue - minValue) * (float)(seed >> 8) / (float)(1u << 24);
+        };
+        for (uint32_t i = 0; i < count; i++)
+        {
+            float3 center(random(-150.0f, 150.0f), random(-150.0f, 150.0f), random(-50.0f, 150.0f));
+            bounds.Set(i, center, random(0.1f, 10.0f));
+        }
+    }
+}
+
+TEST(FrustumCullingTest, MatchesScalarPath)
+{
+    float4 planes[6];
+    MakeTestFrustum(planes);
+
+    FBoundingSphereSoA bounds;
+    FillRandomSpheres(bounds, 1003);
+
+    // 不对齐的起点和不足一组的尾部都要覆盖
+    const uint32_t ranges[][2] = { { 0, 1003 }, { 1, 1003 }, { 5, 13 }, { 256, 512 }, { 1000, 1003 }, { 7, 7 } };
+    for (const auto& range : ranges)
+    {
+        eastl::vector<uint32_t> expected(range[1] - range[0] + 1);
+        eastl::vector<uint32_t> actual(range[1] - range[0] + 1);
+        uint32_t expectedCount = FrustumCullSpheresScalar(planes, 6, bounds, range[0], range[1], expected.data());
+        uint32_t actualCount = FrustumCullSpheres(planes, 6, bounds, range[0], range[1], actual.data());
+
+        ASSERT_EQ(actualCount, expectedCount) << "range " << range[0] << "-" << range[1];
+        for (uint32_t i = 0; i < expectedCount; i++)
+        {
+            EXPECT_EQ(actual[i], expected[i]);
+        }
+    }
+}
+
+TEST(FrustumCullingTest, CullsAgainstEachPlane)
+{
+    float4 planes[6];
+    MakeTestFrustum(planes);
+
+    FBoundingSphereSoA bounds;
+    bounds.Resize(9);
+    bounds.Set(0, float3(0.0f, 0.0f, 50.0f), 1.0f);        // 视锥中心
+    bounds.Set(1, float3(-80.0f, 0.0f, 50.0f), 1.0f);      // 左侧之外
+    bounds.Set(2, float3(80.0f, 0.0f, 50.0f), 1.0f);       // 右侧之外
+    bounds.Set(3, float3(0.0f, 80.0f, 50.0f), 1.0f);       // 上方之外
+    bounds.Set(4, float3(0.0f, -80.0f, 50.0f), 1.0f);      // 下方之外
+    bounds.Set(5, float3(0.0f, 0.0f, -5.0f), 1.0f);        // 近平面之前
+    bounds.Set(6, float3(0.0f, 0.0f, 120.0f), 1.0f);       // 远平面之后
+    bounds.Set(7, float3(0.0f, 0.0f, 101.0f), 2.0f);       // 与远平面相交
+    bounds.Set(8, float3(500.0f, 0.0f, 0.0f), FLT_MAX);    // 无限大包围球
+
+    uint32_t visible[9];
+    uint32_t count = FrustumCullSpheres(planes, 6, bounds, 0, 9, visible);
+    ASSERT_EQ(count, 3u);
+    EXPECT_EQ(visible[0], 0u);
+    EXPECT_EQ(visible[1], 7u);
+    EXPECT_EQ(visible[2], 8u);
+}
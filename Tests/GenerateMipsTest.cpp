@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include "RHI/RHI.hpp"
+#include "RHI/RHINull/RHICommandListNull.hpp"
+#include "Renderer/GenerateMips.hpp"
+
+#include <EASTL/unique_ptr.h>
+
+namespace
+{
+    // 在 Null 后端上检查逐级下采样录制的命令，不需要编译 shader
+    class FGenerateMipsTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            RHI::FRHIDeviceDesc desc;
+            desc.RenderBackend = RHI::ERHIRenderBackend::Null;
+            m_pDevice.reset(RHI::CreateRHIDevice(desc));
+            ASSERT_NE(m_pDevice, nullptr);
+
+            m_pCmdList.reset(m_pDevice->CreateCommandList(RHI::ERHICommandQueueType::Graphics, "GenerateMipsTest"));
+            m_pPSO.reset(m_pDevice->CreateComputePipelineState(RHI::FRHIComputePipelineStateDesc(), "GenerateMipsPSO"));
+            ASSERT_NE(m_pPSO, nullptr);
+        }
+
+        void CreateTexture(uint32_t width, uint32_t height, uint32_t levels)
+        {
+            RHI::FRHITextureDesc desc;
+            desc.Width = width;
+            desc.Height = height;
+            desc.MipLevels = levels;
+            desc.Format = RHI::ERHIFormat::RGBA8UNORM;
+            desc.Usage = RHI::RHITextureUsageUnorderedAccess;
+            m_pTexture.reset(m_pDevice->CreateTexture(desc, "GenerateMipsTexture"));
+            ASSERT_NE(m_pTexture, nullptr);
+
+            for (uint32_t mip = 0; mip < levels; mip++)
+            {
+                RHI::FRHIUnorderedAccessViewDesc uavDesc;
+                uavDesc.Format = desc.Format;
+                uavDesc.Texture.MipSlice = mip;
+                m_UAVs.emplace_back(m_pDevice->CreateUnorderedAccessView(m_pTexture.get(), uavDesc, "GenerateMipsUAV"));
+                m_UAVPointers.push_back(m_UAVs.back().get());
+            }
+        }
+
+        const eastl::vector<RHI::FNullCommand>& Record()
+        {
+            m_pCmdList->Begin();
+            Renderer::GenerateMips(m_pCmdList.get(), m_pPSO.get(), m_pTexture.get(), m_UAVPointers.data());
+            m_pCmdList->End();
+            return ((const RHI::FNullCommandList*)m_pCmdList.get())->GetCommands();
+        }
+
+    protected:
+        eastl::unique_ptr<RHI::FRHIDevice> m_pDevice;
+        eastl::unique_ptr<RHI::FRHICommandList> m_pCmdList;
+        eastl::unique_ptr<RHI::FRHIPipelineState> m_pPSO;
+        eastl::unique_ptr<RHI::FRHITexture> m_pTexture;
+        eastl::vector<eastl::unique_ptr<RHI::FRHIDescriptor>> m_UAVs;
+        eastl::vector<RHI::FRHIDescriptor*> m_UAVPointers;
+    };
+}
+
+TEST_F(FGenerateMipsTest, DispatchesEachMipAfterThePrevious)
+{
+    // 非 2 的幂，最后几级宽度被截断到 1
+    CreateTexture(100, 20, 4);
+    const eastl::vector<RHI::FNullCommand>& commands = Record();
+
+    // BeginEvent, SetPipelineState, 3 x (SetComputeConstants, Dispatch, TextureBarrier), EndEvent
+    ASSERT_EQ(commands.size(), 2u + 3u * 3u + 1u);
+    EXPECT_EQ(commands[0].Type, RHI::ENullCommandType::BeginEvent);
+    EXPECT_EQ(commands[1].Type, RHI::ENullCommandType::SetPipelineState);
+    EXPECT_EQ(commands[1].Resources[0], m_pPSO.get());
+    EXPECT_EQ(commands.back().Type, RHI::ENullCommandType::EndEvent);
+
+    const uint32_t groupCounts[3][2] = { { 7, 2 }, { 4, 1 }, { 2, 1 } };
+    for (uint32_t mip = 1; mip < 4; mip++)
+    {
+        const RHI::FNullCommand* mipCommands = &commands[2 + (mip - 1) * 3];
+
+        EXPECT_EQ(mipCommands[0].Type, RHI::ENullCommandType::SetComputeConstants);
+        EXPECT_EQ(mipCommands[0].Args[1], 6 * sizeof(uint32_t));
+
+        EXPECT_EQ(mipCommands[1].Type, RHI::ENullCommandType::Dispatch);
+        EXPECT_EQ(mipCommands[1].Args[0], groupCounts[mip - 1][0]) << "mip " << mip;
+        EXPECT_EQ(mipCommands[1].Args[1], groupCounts[mip - 1][1]) << "mip " << mip;
+        EXPECT_EQ(mipCommands[1].Args[2], 1u);
+
+        // 写完的这一级在下一次 dispatch 读取之前要有 UAV barrier
+        EXPECT_EQ(mipCommands[2].Type, RHI::ENullCommandType::TextureBarrier);
+        EXPECT_EQ(mipCommands[2].Resources[0], m_pTexture.get());
+        EXPECT_EQ(mipCommands[2].Args[0], RHI::CalcSubresource(m_pTexture->GetDesc(), mip, 0));
+        EXPECT_EQ(mipCommands[2].Args[1], (uint64_t)RHI::RHIAccessComputeUAV);
+        EXPECT_EQ(mipCommands[2].Args[2], (uint64_t)RHI::RHIAccessComputeUAV);
+    }
+}
+
+TEST_F(FGenerateMipsTest, SingleMipRecordsNothing)
+{
+    CreateTexture(64, 64, 1);
+    EXPECT_TRUE(Record().empty());
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include "AssetManager/MeshletLod.hpp"
+
+#include <cfloat>
+#include <cmath>
+
+namespace
+{
+    // 起伏的网格面，保证简化误差不为 0
+    class FMeshletLodTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            const uint32_t size = 64;
+            for (uint32_t y = 0; y <= size; y++)
+            {
+                for (uint32_t x = 0; x <= size; x++)
+                {
+                    m_Positions.push_back(float3((float)x, sinf(x * 0.3f) * cosf(y * 0.2f), (float)y));
+                }
+            }
+            for (uint32_t y = 0; y < size; y++)
+            {
+                for (uint32_t x = 0; x < size; x++)
+                {
+                    uint32_t v0 = y * (size + 1) + x;
+                    uint32_t v1 = v0 + 1;
+                    uint32_t v2 = v0 + size + 1;
+                    uint32_t v3 = v2 + 1;
+                    m_Indices.insert(m_Indices.end(), { v0, v2, v1, v1, v2, v3 });
+                }
+            }
+
+            Assets::BuildMeshletLods(m_Indices.data(), m_Indices.size(), (const float*)m_Positions.data(), m_Positions.size(), sizeof(float3), Assets::FMeshletLodSettings(), m_LodData);
+        }
+
+        uint32_t CountLevel0Triangles() const
+        {
+            uint32_t triangleCount = 0;
+            for (size_t i = 0; i < m_LodData.Meshlets.size(); i++)
+            {
+                triangleCount += m_LodData.Meshlets[i].LodError == 0.0f ? m_LodData.Meshlets[i].TriangleCount : 0;
+            }
+            return triangleCount;
+        }
+
+        // 与 MeshletCulling.hlsl 中的选择规则一致，误差直接按距离相除
+        uint32_t CountSelectedTriangles(float3 viewPosition, float threshold) const
+        {
+            auto project = [&](float3 center, float radius, float error)
+            {
+                return error / max(length(center - viewPosition) - radius, 0.1f);
+            };
+
+            uint32_t triangleCount = 0;
+            for (size_t i = 0; i < m_LodData.Meshlets.size(); i++)
+            {
+                const Assets::FMeshletBound& meshlet = m_LodData.Meshlets[i];
+                if (project(meshlet.LodCenter, meshlet.LodRadius, meshlet.LodError) <= threshold &&
+                    project(meshlet.ParentLodCenter, meshlet.ParentLodRadius, meshlet.ParentLodError) > threshold)
+                {
+                    triangleCount += meshlet.TriangleCount;
+                }
+            }
+            return triangleCount;
+        }
+
+    protected:
+        eastl::vector<float3> m_Positions;
+        eastl::vector<uint32_t> m_Indices;
+        Assets::FMeshletLodData m_LodData;
+    };
+}
+
+TEST_F(FMeshletLodTest, FinestLevelKeepsAllTriangles)
+{
+    EXPECT_GT(m_LodData.LevelCount, 1u);
+    EXPECT_EQ(CountLevel0Triangles(), m_Indices.size() / 3);
+}
+
+TEST_F(FMeshletLodTest, ErrorAndBoundsAreMonotonic)
+{
+    for (size_t i = 0; i < m_LodData.Meshlets.size(); i++)
+    {
+        const Assets::FMeshletBound& meshlet = m_LodData.Meshlets[i];
+        EXPECT_LE(meshlet.TriangleCount, 124u);
+        EXPECT_LE(meshlet.VertexCount, 64u);
+        EXPECT_GE(meshlet.ParentLodError, meshlet.LodError);
+        if (meshlet.ParentLodError != FLT_MAX)
+        {
+            float distance = length(meshlet.ParentLodCenter - meshlet.LodCenter);
+            EXPECT_LE(distance + meshlet.LodRadius, meshlet.ParentLodRadius * 1.0001f);
+        }
+    }
+}
+
+TEST_F(FMeshletLodTest, CutCoarsensWithDistance)
+{
+    // 阈值为 0 时只选最精细的一层，距离越远选中的三角形越少
+    uint32_t fullCount = CountSelectedTriangles(float3(32.0f, 10.0f, 32.0f), 0.0f);
+    uint32_t nearCount = CountSelectedTriangles(float3(32.0f, 10.0f, 32.0f), 0.002f);
+    uint32_t farCount = CountSelectedTriangles(float3(32.0f, 1000.0f, 32.0f), 0.002f);
+
+    EXPECT_EQ(fullCount, m_Indices.size() / 3);
+    EXPECT_LE(nearCount, fullCount);
+    EXPECT_LT(farCount, nearCount);
+}
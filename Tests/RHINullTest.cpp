@@ -0,0 +1,262 @@
+#include <gtest/gtest.h>
+
+#include "RHI/RHI.hpp"
+#include "RHI/RHINull/RHICommandListNull.hpp"
+#include "RHI/RHINull/RHISwapchainNull.hpp"
+
+#include <EASTL/unique_ptr.h>
+
+namespace
+{
+    class FRHINullTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            RHI::FRHIDeviceDesc desc;
+            desc.RenderBackend = RHI::ERHIRenderBackend::Null;
+            m_pDevice.reset(RHI::CreateRHIDevice(desc));
+            ASSERT_NE(m_pDevice, nullptr);
+        }
+
+        RHI::FRHIBuffer* CreateBuffer(uint32_t size, RHI::ERHIMemoryType memoryType, RHI::FRHIHeap* heap = nullptr, uint32_t heapOffset = 0)
+        {
+            RHI::FRHIBufferDesc desc;
+            desc.Size = size;
+            desc.MemoryType = memoryType;
+            desc.Heap = heap;
+            desc.HeapOffset = heapOffset;
+            return m_pDevice->CreateBuffer(desc, "TestBuffer");
+        }
+
+    protected:
+        eastl::unique_ptr<RHI::FRHIDevice> m_pDevice;
+    };
+}
+
+TEST_F(FRHINullTest, BufferMemoryIsVisibleOnlyForCPUMemoryTypes)
+{
+    eastl::unique_ptr<RHI::FRHIBuffer> upload(CreateBuffer(64, RHI::ERHIMemoryType::CPUToGPU));
+    eastl::unique_ptr<RHI::FRHIBuffer> gpu(CreateBuffer(64, RHI::ERHIMemoryType::GPUOnly));
+
+    EXPECT_NE(upload->GetCPUAddress(), nullptr);
+    EXPECT_EQ(gpu->GetCPUAddress(), nullptr);
+    EXPECT_NE(upload->GetGPUAddress(), gpu->GetGPUAddress());
+}
+
+TEST_F(FRHINullTest, CopiesExecuteOnSubmit)
+{
+    eastl::unique_ptr<RHI::FRHIBuffer> src(CreateBuffer(16, RHI::ERHIMemoryType::CPUToGPU));
+    eastl::unique_ptr<RHI::FRHIBuffer> dst(CreateBuffer(16, RHI::ERHIMemoryType::GPUToCPU));
+    eastl::unique_ptr<RHI::FRHICommandList> cmdList(m_pDevice->CreateCommandList(RHI::ERHICommandQueueType::Copy, "TestCmdList"));
+
+    const uint32_t values[4] = { 1, 2, 3, 4 };
+    memcpy(src->GetCPUAddress(), values, sizeof(values));
+
+    cmdList->Begin();
+    cmdList->CopyBuffer(src.get(), dst.get(), 4, 0, 12);
+    cmdList->WriteBuffer(dst.get(), 12, 42);
+    cmdList->End();
+
+    const uint32_t* result = (const uint32_t*)dst->GetCPUAddress();
+    EXPECT_EQ(result[0], 0u);
+
+    cmdList->Submit();
+    EXPECT_EQ(result[0], 2u);
+    EXPECT_EQ(result[1], 3u);
+    EXPECT_EQ(result[2], 4u);
+    EXPECT_EQ(result[3], 42u);
+}
+
+TEST_F(FRHINullTest, ResolvedQueriesReportAvailability)
+{
+    RHI::FRHIQueryPoolDesc poolDesc;
+    poolDesc.Type = RHI::ERHIQueryType::Timestamp;
+    poolDesc.QueryCount = 2;
+    eastl::unique_ptr<RHI::FRHIQueryPool> pool(m_pDevice->CreateQueryPool(poolDesc, "TestQueryPool"));
+    eastl::unique_ptr<RHI::FRHIBuffer> dst(CreateBuffer(4 * sizeof(uint64_t), RHI::ERHIMemoryType::GPUToCPU));
+    eastl::unique_ptr<RHI::FRHICommandList> cmdList(m_pDevice->CreateCommandList(RHI::ERHICommandQueueType::Graphics, "TestCmdList"));
+
+    // 只写入第一个查询
+    cmdList->Begin();
+    cmdList->ResetQueries(pool.get(), 0, 2);
+    cmdList->WriteTimestamp(pool.get(), 0);
+    cmdList->ResolveQueries(pool.get(), 0, 2, dst.get(), 0);
+    cmdList->End();
+    cmdList->Submit();
+
+    const uint64_t* result = (const uint64_t*)dst->GetCPUAddress();
+    EXPECT_NE(result[0], 0u);
+    EXPECT_NE(result[1], 0u);
+    EXPECT_EQ(result[3], 0u);
+}
+
+TEST_F(FRHINullTest, CommandsAreRecordedInOrder)
+{
+    eastl::unique_ptr<RHI::FRHICommandList> cmdList(m_pDevice->CreateCommandList(RHI::ERHICommandQueueType::Graphics, "TestCmdList"));
+
+    cmdList->Begin();
+    {
+        GPU_EVENT_DEBUG(cmdList.get(), "Pass");
+        cmdList->Draw(3);
+        cmdList->Dispatch(8, 4, 1);
+        cmdList->Draw(6, 2);
+    }
+    cmdList->End();
+
+    const RHI::FNullCommandList* nullCmdList = (const RHI::FNullCommandList*)cmdList.get();
+    const eastl::vector<RHI::FNullCommand>& commands = nullCmdList->GetCommands();
+    ASSERT_EQ(commands.size(), 5u);
+    EXPECT_EQ(commands[0].Type, RHI::ENullCommandType::BeginEvent);
+    EXPECT_EQ(commands[0].Label, "Pass");
+    EXPECT_EQ(commands[2].Type, RHI::ENullCommandType::Dispatch);
+    EXPECT_EQ(commands[2].Args[0], 8u);
+    EXPECT_EQ(commands[4].Type, RHI::ENullCommandType::EndEvent);
+    EXPECT_EQ(nullCmdList->GetCommandCount(RHI::ENullCommandType::Draw), 2u);
+
+    // 下一次 Begin 清空日志
+    cmdList->Begin();
+    cmdList->End();
+    EXPECT_TRUE(nullCmdList->GetCommands().empty());
+}
+
+TEST_F(FRHINullTest, SplitBarriersAreCountedLikeBatchedBarriers)
+{
+    eastl::unique_ptr<RHI::FRHIBuffer> bufferA(CreateBuffer(64, RHI::ERHIMemoryType::GPUOnly));
+    eastl::unique_ptr<RHI::FRHIBuffer> bufferB(CreateBuffer(64, RHI::ERHIMemoryType::GPUOnly));
+    eastl::unique_ptr<RHI::FRHICommandList> cmdList(m_pDevice->CreateCommandList(RHI::ERHICommandQueueType::Graphics, "TestCmdList"));
+
+    cmdList->Begin();
+    cmdList->ResetBarrierStats();
+    {
+        // 两个普通 barrier 合成一条命令
+        cmdList->BufferBarrier(bufferA.get(), RHI::RHIAccessCopyDst, RHI::RHIAccessVertexShaderSRV);
+        cmdList->BufferBarrier(bufferB.get(), RHI::RHIAccessCopyDst, RHI::RHIAccessVertexShaderSRV);
+        cmdList->FlushBarriers();
+
+        cmdList->BufferBarrier(bufferA.get(), RHI::RHIAccessVertexShaderSRV, RHI::RHIAccessPixelShaderSRV);
+        cmdList->BeginSplitBarriers(7);
+        cmdList->Draw(3);
+
+        // 没有排队的 barrier 时不记录
+        cmdList->BeginSplitBarriers(8);
+
+        cmdList->BufferBarrier(bufferA.get(), RHI::RHIAccessVertexShaderSRV, RHI::RHIAccessPixelShaderSRV);
+        cmdList->EndSplitBarriers(7);
+    }
+    cmdList->End();
+
+    const RHI::FNullCommandList* nullCmdList = (const RHI::FNullCommandList*)cmdList.get();
+    EXPECT_EQ(nullCmdList->GetCommandCount(RHI::ENullCommandType::BeginSplitBarriers), 1u);
+    EXPECT_EQ(nullCmdList->GetCommandCount(RHI::ENullCommandType::EndSplitBarriers), 1u);
+
+    const RHI::FRHIBarrierStats& stats = cmdList->GetBarrierStats();
+    EXPECT_EQ(stats.BarrierCommands, 3u);
+    EXPECT_EQ(stats.Barriers, 3u);
+    EXPECT_EQ(stats.SplitBarriers, 1u);
+}
+
+TEST_F(FRHINullTest, FencesCompleteOnSubmit)
+{
+    eastl::unique_ptr<RHI::FRHIFence> fence(m_pDevice->CreateFence("TestFence"));
+    eastl::unique_ptr<RHI::FRHICommandList> cmdList(m_pDevice->CreateCommandList(RHI::ERHICommandQueueType::Graphics, "TestCmdList"));
+
+    cmdList->Begin();
+    cmdList->Signal(fence.get(), 5);
+    cmdList->End();
+    EXPECT_EQ(fence->GetCompletedValue(), 0u);
+
+    cmdList->Submit();
+    EXPECT_EQ(fence->GetCompletedValue(), 5u);
+    fence->Wait(5);
+}
+
+TEST_F(FRHINullTest, PlacedBuffersAliasHeapMemory)
+{
+    RHI::FRHIHeapDesc heapDesc;
+    heapDesc.Size = 256;
+    eastl::unique_ptr<RHI::FRHIHeap> heap(m_pDevice->CreateHeap(heapDesc, "TestHeap"));
+
+    eastl::unique_ptr<RHI::FRHIBuffer> a(CreateBuffer(64, RHI::ERHIMemoryType::CPUToGPU, heap.get(), 128));
+    eastl::unique_ptr<RHI::FRHIBuffer> b(CreateBuffer(64, RHI::ERHIMemoryType::CPUToGPU, heap.get(), 128));
+    EXPECT_EQ(a->GetCPUAddress(), b->GetCPUAddress());
+
+    eastl::unique_ptr<RHI::FRHIBuffer> outOfRange(CreateBuffer(256, RHI::ERHIMemoryType::CPUToGPU, heap.get(), 128));
+    EXPECT_EQ(outOfRange, nullptr);
+}
+
+TEST_F(FRHINullTest, DescriptorIndicesAreRecycled)
+{
+    eastl::unique_ptr<RHI::FRHIBuffer> buffer(CreateBuffer(64, RHI::ERHIMemoryType::GPUOnly));
+
+    RHI::FRHIShaderResourceViewDesc srvDesc;
+    srvDesc.Type = RHI::ERHIShaderResourceViewType::RawBuffer;
+    srvDesc.Buffer.Size = 64;
+
+    RHI::FRHIDescriptor* first = m_pDevice->CreateShaderResourceView(buffer.get(), srvDesc, "SRV0");
+    eastl::unique_ptr<RHI::FRHIDescriptor> second(m_pDevice->CreateShaderResourceView(buffer.get(), srvDesc, "SRV1"));
+    EXPECT_NE(first->GetHeapIndex(), second->GetHeapIndex());
+
+    uint32_t freedIndex = first->GetHeapIndex();
+    delete first;
+
+    eastl::unique_ptr<RHI::FRHIDescriptor> third(m_pDevice->CreateShaderResourceView(buffer.get(), srvDesc, "SRV2"));
+    EXPECT_EQ(third->GetHeapIndex(), freedIndex);
+}
+
+TEST_F(FRHINullTest, SwapchainCyclesBackBuffers)
+{
+    RHI::FRHISwapchainDesc desc;
+    desc.Width = 64;
+    desc.Height = 32;
+    eastl::unique_ptr<RHI::FRHISwapchain> swapchain(m_pDevice->CreateSwapchain(desc, "TestSwapchain"));
+    eastl::unique_ptr<RHI::FRHICommandList> cmdList(m_pDevice->CreateCommandList(RHI::ERHICommandQueueType::Graphics, "TestCmdList"));
+
+    RHI::FRHITexture* first = swapchain->GetBackBuffer();
+    EXPECT_EQ(first->GetDesc().Width, 64u);
+
+    swapchain->AcquireNextBackBuffer();
+    EXPECT_NE(swapchain->GetBackBuffer(), first);
+
+    cmdList->Begin();
+    cmdList->Present(swapchain.get());
+    cmdList->End();
+    cmdList->Submit();
+    EXPECT_EQ(((RHI::FNullSwapchain*)swapchain.get())->GetPresentCount(), 1u);
+
+    EXPECT_TRUE(swapchain->Resize(128, 128));
+    EXPECT_EQ(swapchain->GetBackBuffer()->GetDesc().Width, 128u);
+}
+
+TEST_F(FRHINullTest, SecondaryCommandListsExecuteInOrder)
+{
+    eastl::unique_ptr<RHI::FRHIBuffer> buffer(CreateBuffer(16, RHI::ERHIMemoryType::GPUToCPU));
+    eastl::unique_ptr<RHI::FRHICommandList> cmdList(m_pDevice->CreateCommandList(RHI::ERHICommandQueueType::Graphics, "TestCmdList"));
+    eastl::unique_ptr<RHI::FRHICommandList> secondary0(m_pDevice->CreateSecondaryCommandList(RHI::ERHICommandQueueType::Graphics, "TestSecondary0"));
+    eastl::unique_ptr<RHI::FRHICommandList> secondary1(m_pDevice->CreateSecondaryCommandList(RHI::ERHICommandQueueType::Graphics, "TestSecondary1"));
+    EXPECT_FALSE(cmdList->IsSecondary());
+    EXPECT_TRUE(secondary0->IsSecondary());
+
+    // 二级列表的录制顺序与执行顺序无关
+    secondary1->Begin();
+    secondary1->WriteBuffer(buffer.get(), 0, 2);
+    secondary1->End();
+
+    secondary0->Begin();
+    secondary0->WriteBuffer(buffer.get(), 0, 1);
+    secondary0->WriteBuffer(buffer.get(), 4, 1);
+    secondary0->End();
+
+    cmdList->Begin();
+    cmdList->ExecuteCommandList(secondary0.get());
+    cmdList->ExecuteCommandList(secondary1.get());
+    cmdList->WriteBuffer(buffer.get(), 8, 3);
+    cmdList->End();
+    cmdList->Submit();
+
+    const uint32_t* result = (const uint32_t*)buffer->GetCPUAddress();
+    EXPECT_EQ(result[0], 2u);
+    EXPECT_EQ(result[1], 1u);
+    EXPECT_EQ(result[2], 3u);
+    EXPECT_EQ(((RHI::FNullCommandList*)cmdList.get())->GetCommandCount(RHI::ENullCommandType::WriteBuffer), 4u);
+}
@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+
+#include "RHI/RHI.hpp"
+#include "Renderer/RenderGraph/RenderGraphResourceAllocator.hpp"
+
+#include <EASTL/unique_ptr.h>
+
+namespace
+{
+    const uint32_t MB = 1024 * 1024;
+
+    class FRenderGraphAllocatorTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            RHI::FRHIDeviceDesc desc;
+            desc.RenderBackend = RHI::ERHIRenderBackend::Null;
+            m_pDevice.reset(RHI::CreateRHIDevice(desc));
+            ASSERT_NE(m_pDevice, nullptr);
+            m_pAllocator = eastl::make_unique<RG::FRenderGraphResourceAllocator>(m_pDevice.get());
+        }
+
+        void TearDown() override
+        {
+            m_pAllocator.reset();
+        }
+
+        RHI::FRHIBuffer* Allocate(uint32_t firstPass, uint32_t lastPass, uint32_t size)
+        {
+            RHI::FRHIBufferDesc desc;
+            desc.Size = size;
+            RHI::ERHIAccessFlags initialState;
+            return m_pAllocator->AllocateBuffer(firstPass, lastPass, RHI::RHIAccessMaskUAV, desc, "Test", initialState);
+        }
+
+        eastl::vector<RHI::FRHIResource*> GetAliased(RHI::FRHIResource* resource, uint32_t firstPass)
+        {
+            eastl::vector<RG::FRGAliasedResource> aliasedResources;
+            m_pAllocator->GetAliasedPreviousResources(resource, firstPass, aliasedResources);
+
+            eastl::vector<RHI::FRHIResource*> result;
+            for (const RG::FRGAliasedResource& aliasedRes : aliasedResources)
+            {
+                result.push_back(aliasedRes.Resource);
+            }
+            return result;
+        }
+
+        // 模拟 FRenderGraph::Clear
+        void EndFrame(const eastl::vector<RHI::FRHIBuffer*>& buffers)
+        {
+            for (size_t i = 0; i < buffers.size(); i++)
+            {
+                m_pAllocator->Free(buffers[i], RHI::RHIAccessMaskUAV, false);
+            }
+            m_pDevice->EndFrame();
+            m_pAllocator->Reset();
+        }
+
+    protected:
+        eastl::unique_ptr<RHI::FRHIDevice> m_pDevice;
+        eastl::unique_ptr<RG::FRenderGraphResourceAllocator> m_pAllocator;
+    };
+}
+
+TEST_F(FRenderGraphAllocatorTest, OverlappingLifetimesGetDisjointRanges)
+{
+    RHI::FRHIBuffer* a = Allocate(0, 2, 4 * MB);
+    RHI::FRHIBuffer* b = Allocate(1, 3, 4 * MB);
+
+    EXPECT_EQ(a->GetDesc().Heap, b->GetDesc().Heap);
+    EXPECT_EQ(a->GetDesc().HeapOffset, 0u);
+    EXPECT_EQ(b->GetDesc().HeapOffset, 4 * MB);
+}
+
+TEST_F(FRenderGraphAllocatorTest, DisjointLifetimesShareMemory)
+{
+    RHI::FRHIBuffer* a = Allocate(0, 1, 4 * MB);
+    RHI::FRHIBuffer* b = Allocate(2, 3, 2 * MB);
+
+    EXPECT_EQ(a->GetDesc().Heap, b->GetDesc().Heap);
+    EXPECT_EQ(b->GetDesc().HeapOffset, 0u);
+
+    EXPECT_EQ(GetAliased(b, 2), eastl::vector<RHI::FRHIResource*>{ a });
+    EXPECT_TRUE(GetAliased(a, 0).empty());
+}
+
+TEST_F(FRenderGraphAllocatorTest, StraddlingResourceAliasesEveryPredecessor)
+{
+    RHI::FRHIBuffer* a = Allocate(0, 1, 2 * MB);
+    RHI::FRHIBuffer* b = Allocate(0, 2, 2 * MB);
+    RHI::FRHIBuffer* c = Allocate(3, 4, 4 * MB);
+    ASSERT_EQ(b->GetDesc().HeapOffset, 2 * MB);
+    ASSERT_EQ(c->GetDesc().HeapOffset, 0u);
+
+    // c 同时覆盖 a 和 b，两者下一帧复用时都必须从 discard 开始
+    EXPECT_EQ(GetAliased(c, 3), (eastl::vector<RHI::FRHIResource*>{ a, b }));
+    EndFrame({ a, b, c });
+
+    RHI::ERHIAccessFlags initialState;
+    RHI::FRHIBufferDesc desc;
+    desc.Size = 2 * MB;
+    EXPECT_EQ(m_pAllocator->AllocateBuffer(0, 1, RHI::RHIAccessMaskUAV, desc, "Test", initialState), a);
+    EXPECT_TRUE(initialState & RHI::RHIAccessDiscard);
+    EXPECT_EQ(m_pAllocator->AllocateBuffer(0, 2, RHI::RHIAccessMaskUAV, desc, "Test", initialState), b);
+    EXPECT_TRUE(initialState & RHI::RHIAccessDiscard);
+}
+
+TEST_F(FRenderGraphAllocatorTest, UnusedCachedResourceIsDiscardedWhenOverwritten)
+{
+    RHI::FRHIBuffer* a = Allocate(0, 1, 4 * MB);
+    EndFrame({ a });
+
+    // a 本帧不使用，新的 buffer 放在它的内存上
+    RHI::FRHIBuffer* b = Allocate(0, 1, 2 * MB);
+    ASSERT_NE(b, a);
+    ASSERT_EQ(b->GetDesc().HeapOffset, 0u);
+    EndFrame({ b });
+
+    RHI::ERHIAccessFlags initialState;
+    RHI::FRHIBufferDesc desc;
+    desc.Size = 4 * MB;
+    ASSERT_EQ(m_pAllocator->AllocateBuffer(2, 3, RHI::RHIAccessMaskUAV, desc, "Test", initialState), a);
+    EXPECT_TRUE(initialState & RHI::RHIAccessDiscard);
+}
+
+TEST_F(FRenderGraphAllocatorTest, SmallResourcesFillBestGap)
+{
+    Allocate(0, 3, 4 * MB);
+    Allocate(0, 1, 3 * MB);
+    Allocate(0, 3, 2 * MB);
+    Allocate(0, 1, 2 * MB);
+    Allocate(0, 3, 1 * MB);
+
+    // pass 2 时 [4, 7) 和 [9, 11) 两个空隙都能放下，选较小的那个
+    RHI::FRHIBuffer* buffer = Allocate(2, 3, 2 * MB);
+    EXPECT_EQ(buffer->GetDesc().HeapOffset, 9 * MB);
+
+    m_pAllocator->UpdateStats();
+    const RG::FRenderGraphTransientStats& stats = m_pAllocator->GetStats();
+    EXPECT_EQ(stats.ResourceCount, 6u);
+    EXPECT_EQ(stats.RequestedSize, 14ull * MB);
+    EXPECT_EQ(stats.PeakLiveSize, 12ull * MB);
+    EXPECT_EQ(stats.PackedSize, 12ull * MB);
+}
+
+TEST_F(FRenderGraphAllocatorTest, LargeResourceGetsOwnHeap)
+{
+    RHI::FRHIBuffer* a = Allocate(0, 1, 4 * MB);
+    RHI::FRHIBuffer* b = Allocate(0, 1, 64 * MB);
+
+    EXPECT_NE(a->GetDesc().Heap, b->GetDesc().Heap);
+    EXPECT_GE(b->GetDesc().Heap->GetDesc().Size, 64u * MB);
+}
+
+TEST_F(FRenderGraphAllocatorTest, PlacementIsStableAcrossFrames)
+{
+    RHI::FRHIBuffer* a = Allocate(0, 1, 4 * MB);
+    RHI::FRHIBuffer* b = Allocate(1, 2, 4 * MB);
+    EndFrame({ a, b });
+
+    EXPECT_EQ(Allocate(0, 1, 4 * MB), a);
+    EXPECT_EQ(Allocate(1, 2, 4 * MB), b);
+}
+
+TEST_F(FRenderGraphAllocatorTest, MarkAliasDiscardedReplaysAliasQuery)
+{
+    RHI::FRHIBufferDesc desc;
+    desc.Size = 4 * MB;
+    RHI::ERHIAccessFlags initialState;
+
+    RHI::FRHIBuffer* a = m_pAllocator->AllocateBuffer(0, 1, RHI::RHIAccessMaskUAV, desc, "A", initialState);
+    RHI::FRHIBuffer* b = Allocate(2, 3, 2 * MB);
+    ASSERT_EQ(GetAliased(b, 2), eastl::vector<RHI::FRHIResource*>{ a });
+    EndFrame({ a, b });
+
+    EXPECT_EQ(m_pAllocator->AllocateBuffer(0, 1, RHI::RHIAccessMaskUAV, desc, "A", initialState), a);
+    const RHI::ERHIAccessFlags expectedState = initialState;
+    EXPECT_TRUE(expectedState & RHI::RHIAccessDiscard);
+
+    // 这一帧不再查询别名而是重放标记，下一帧 a 的初始状态应与查询时一致
+    EXPECT_EQ(Allocate(2, 3, 2 * MB), b);
+    m_pAllocator->MarkAliasDiscarded(a);
+    EndFrame({ a, b });
+
+    EXPECT_EQ(m_pAllocator->AllocateBuffer(0, 1, RHI::RHIAccessMaskUAV, desc, "A", initialState), a);
+    EXPECT_EQ(initialState, expectedState);
+}
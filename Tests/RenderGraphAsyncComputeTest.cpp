@@ -0,0 +1,280 @@
+#include <gtest/gtest.h>
+
+#include "RenderGraphTestUtils.hpp"
+
+namespace
+{
+    void ExecuteNothing(const FTestPassData&, RHI::FRHICommandList*)
+    {
+    }
+
+    class FRenderGraphAsyncComputeTest : public FRenderGraphTestBase
+    {
+    protected:
+        static RHI::FRHIBufferDesc GetBufferDesc()
+        {
+            RHI::FRHIBufferDesc desc;
+            desc.Stride = 4;
+            desc.Size = 256;
+            desc.Format = RHI::ERHIFormat::R32UI;
+            desc.Usage = RHI::RHIBufferUsageTypedBuffer;
+            return desc;
+        }
+
+        // 在图形队列上创建并写入若干 buffer，作为计算 pass 的输入
+        FTestPass& AddProducer(const char* name, std::initializer_list<RG::FRGHandle*> outputs)
+        {
+            return m_pGraph->AddPass<FTestPassData>(name, RG::RenderPassType::Graphics,
+                [&](FTestPassData& data, RG::FRGBuilder& builder)
+                {
+                    for (RG::FRGHandle* output : outputs)
+                    {
+                        *output = builder.Write(builder.Create<RG::FRGBuffer>(GetBufferDesc(), name));
+                    }
+                },
+                ExecuteNothing);
+        }
+
+        FTestPass& AddCompute(const char* name, const RG::FRGHandle& input, RG::FRGHandle& output, bool bAllowAsync = true)
+        {
+            return m_pGraph->AddPass<FTestPassData>(name, RG::RenderPassType::Compute,
+                [&](FTestPassData& data, RG::FRGBuilder& builder)
+                {
+                    if (!bAllowAsync)
+                    {
+                        builder.DisableAsyncCompute();
+                    }
+                    builder.Read(input);
+                    data.Output = output = builder.Write(output);
+                },
+                ExecuteNothing);
+        }
+
+        // 与计算 pass 无关的图形队列工作，提供重叠
+        FTestPass& AddIndependentGraphics(const char* name)
+        {
+            return m_pGraph->AddPass<FTestPassData>(name, RG::RenderPassType::Graphics,
+                [&](FTestPassData& data, RG::FRGBuilder& builder)
+                {
+                    data.Output = builder.Write(builder.Create<RG::FRGBuffer>(GetBufferDesc(), name));
+                    builder.SkipCulling();
+                },
+                ExecuteNothing);
+        }
+
+        FTestPass& AddConsumer(const char* name, const RG::FRGHandle& input)
+        {
+            return m_pGraph->AddPass<FTestPassData>(name, RG::RenderPassType::Graphics,
+                [&](FTestPassData& data, RG::FRGBuilder& builder)
+                {
+                    data.Output = builder.Read(input, 0, RG::RGBuilderFlag::ShaderStagePS);
+                    builder.SkipCulling();
+                },
+                ExecuteNothing);
+        }
+
+        static void ExpectGraphicsQueue(const RG::FRenderGraphPassBase& pass)
+        {
+            EXPECT_EQ(pass.GetType(), RG::RenderPassType::Compute);
+            EXPECT_FALSE(pass.IsAutoAsyncCompute());
+            EXPECT_FALSE(pass.HasWait());
+            EXPECT_FALSE(pass.HasSignal());
+        }
+    };
+}
+
+TEST_F(FRenderGraphAsyncComputeTest, OverlappingComputePassMovesToAsyncQueue)
+{
+    RG::FRGHandle input, output;
+    FTestPass& producer = AddProducer("Producer", { &input, &output });
+    FTestPass& compute = AddCompute("Compute", input, output);
+    AddIndependentGraphics("Overlap0");
+    AddIndependentGraphics("Overlap1");
+    FTestPass& consumer = AddConsumer("Consumer", output);
+
+    m_pGraph->Compile();
+
+    EXPECT_EQ(compute.GetType(), RG::RenderPassType::AsyncCompute);
+    EXPECT_TRUE(compute.IsAutoAsyncCompute());
+
+    // 计算队列等待 Producer 的 signal，Consumer 等待计算队列的 signal
+    ASSERT_TRUE(producer.HasSignal());
+    ASSERT_TRUE(compute.HasWait());
+    EXPECT_EQ(compute.GetWaitValue(), producer.GetSignalValue());
+    EXPECT_EQ(compute.GetWaitGraphicsPass(), producer.GetID());
+
+    ASSERT_TRUE(compute.HasSignal());
+    ASSERT_TRUE(consumer.HasWait());
+    EXPECT_EQ(consumer.GetWaitValue(), compute.GetSignalValue());
+    EXPECT_EQ(compute.GetSignalGraphicsPass(), consumer.GetID());
+    EXPECT_EQ(producer.GetSignalValue(), 1u);
+    EXPECT_EQ(compute.GetSignalValue(), 1u);
+}
+
+TEST_F(FRenderGraphAsyncComputeTest, DisabledAutoScheduleKeepsGraphicsQueue)
+{
+    m_pGraph->SetAutoAsyncCompute(false);
+
+    RG::FRGHandle input, output;
+    AddProducer("Producer", { &input, &output });
+    FTestPass& compute = AddCompute("Compute", input, output);
+    AddIndependentGraphics("Overlap0");
+    AddIndependentGraphics("Overlap1");
+    AddConsumer("Consumer", output);
+
+    m_pGraph->Compile();
+
+    ExpectGraphicsQueue(compute);
+}
+
+TEST_F(FRenderGraphAsyncComputeTest, InsufficientOverlapKeepsGraphicsQueue)
+{
+    // 等待点与 signal 点之间只有一个图形 pass，低于 RG_ASYNC_COMPUTE_MIN_OVERLAP
+    RG::FRGHandle input, output;
+    AddProducer("Producer", { &input, &output });
+    FTestPass& compute = AddCompute("Compute", input, output);
+    AddIndependentGraphics("Overlap0");
+    AddConsumer("Consumer", output);
+
+    m_pGraph->Compile();
+
+    ExpectGraphicsQueue(compute);
+}
+
+TEST_F(FRenderGraphAsyncComputeTest, OptedOutPassKeepsGraphicsQueue)
+{
+    RG::FRGHandle input, output;
+    AddProducer("Producer", { &input, &output });
+    FTestPass& compute = AddCompute("Compute", input, output, false);
+    AddIndependentGraphics("Overlap0");
+    AddIndependentGraphics("Overlap1");
+    AddConsumer("Consumer", output);
+
+    m_pGraph->Compile();
+
+    EXPECT_FALSE(compute.IsAsyncComputeAllowed());
+    ExpectGraphicsQueue(compute);
+}
+
+TEST_F(FRenderGraphAsyncComputeTest, RenderTargetInputIsRejected)
+{
+    // 输入的前一个状态是 RTV，计算队列无法做这个转换
+    RG::FRGHandle input, output;
+    AddProducer("Producer", { &output });
+    m_pGraph->AddPass<FTestPassData>("Draw", RG::RenderPassType::Graphics,
+        [&](FTestPassData& data, RG::FRGBuilder& builder)
+        {
+            RHI::FRHITextureDesc desc;
+            desc.Width = 16;
+            desc.Height = 16;
+            desc.Format = RHI::ERHIFormat::RGBA8UNORM;
+            desc.Usage = RHI::RHITextureUsageRenderTarget;
+            input = builder.WriteColor(0, builder.Create<RG::FRGTexture>(desc, "Color"), 0, RHI::ERHIRenderPassLoadOp::Clear);
+        },
+        ExecuteNothing);
+    FTestPass& compute = AddCompute("Compute", input, output);
+    AddIndependentGraphics("Overlap0");
+    AddIndependentGraphics("Overlap1");
+    AddConsumer("Consumer", output);
+
+    m_pGraph->Compile();
+
+    ExpectGraphicsQueue(compute);
+}
+
+TEST_F(FRenderGraphAsyncComputeTest, TransientCreatedByCandidateIsRejected)
+{
+    // 输出在这个 pass 中首次使用，初始化和别名 barrier 只能留在图形队列
+    RG::FRGHandle input, output;
+    AddProducer("Producer", { &input });
+    FTestPass& compute = m_pGraph->AddPass<FTestPassData>("Compute", RG::RenderPassType::Compute,
+        [&](FTestPassData& data, RG::FRGBuilder& builder)
+        {
+            builder.Read(input);
+            output = builder.Write(builder.Create<RG::FRGBuffer>(GetBufferDesc(), "Output"));
+        },
+        ExecuteNothing);
+    AddIndependentGraphics("Overlap0");
+    AddIndependentGraphics("Overlap1");
+    AddConsumer("Consumer", output);
+
+    m_pGraph->Compile();
+
+    ExpectGraphicsQueue(compute);
+}
+
+TEST_F(FRenderGraphAsyncComputeTest, GraphicsReaderInsideWindowIsRejected)
+{
+    // Reader 与计算 pass 读取同一版本，且位于等待点和 signal 点之间
+    RG::FRGHandle input, output;
+    AddProducer("Producer", { &input, &output });
+    FTestPass& compute = AddCompute("Compute", input, output);
+    m_pGraph->AddPass<FTestPassData>("Reader", RG::RenderPassType::Graphics,
+        [&](FTestPassData& data, RG::FRGBuilder& builder)
+        {
+            builder.Read(input, 0, RG::RGBuilderFlag::ShaderStagePS);
+            builder.SkipCulling();
+        },
+        ExecuteNothing);
+    AddIndependentGraphics("Overlap0");
+    AddIndependentGraphics("Overlap1");
+    AddConsumer("Consumer", output);
+
+    m_pGraph->Compile();
+
+    ExpectGraphicsQueue(compute);
+}
+
+TEST_F(FRenderGraphAsyncComputeTest, ConsecutivePassesShareOneWaitAndSignal)
+{
+    RG::FRGHandle input, intermediate, output;
+    FTestPass& producer = AddProducer("Producer", { &input, &intermediate, &output });
+    FTestPass& first = AddCompute("Compute0", input, intermediate);
+    FTestPass& second = AddCompute("Compute1", intermediate, output);
+    AddIndependentGraphics("Overlap0");
+    AddIndependentGraphics("Overlap1");
+    FTestPass& consumer = AddConsumer("Consumer", output);
+
+    m_pGraph->Compile();
+
+    EXPECT_EQ(first.GetType(), RG::RenderPassType::AsyncCompute);
+    EXPECT_EQ(second.GetType(), RG::RenderPassType::AsyncCompute);
+
+    // 整段只在开头等待一次、在结尾 signal 一次
+    EXPECT_TRUE(first.HasWait());
+    EXPECT_FALSE(first.HasSignal());
+    EXPECT_FALSE(second.HasWait());
+    EXPECT_TRUE(second.HasSignal());
+    EXPECT_EQ(first.GetWaitValue(), producer.GetSignalValue());
+    EXPECT_EQ(consumer.GetWaitValue(), second.GetSignalValue());
+
+    EXPECT_EQ(first.GetWaitGraphicsPass(), producer.GetID());
+    EXPECT_EQ(second.GetWaitGraphicsPass(), producer.GetID());
+    EXPECT_EQ(first.GetSignalGraphicsPass(), consumer.GetID());
+    EXPECT_EQ(second.GetSignalGraphicsPass(), consumer.GetID());
+}
+
+TEST_F(FRenderGraphAsyncComputeTest, CachedCompileRestoresSchedule)
+{
+    for (uint32_t frame = 0; frame < 2; frame++)
+    {
+        RG::FRGHandle input, output;
+        FTestPass& producer = AddProducer("Producer", { &input, &output });
+        FTestPass& compute = AddCompute("Compute", input, output);
+        AddIndependentGraphics("Overlap0");
+        AddIndependentGraphics("Overlap1");
+        FTestPass& consumer = AddConsumer("Consumer", output);
+
+        m_pGraph->Compile();
+
+        EXPECT_EQ(compute.GetType(), RG::RenderPassType::AsyncCompute);
+        EXPECT_EQ(compute.GetWaitValue(), producer.GetSignalValue());
+        EXPECT_EQ(consumer.GetWaitValue(), compute.GetSignalValue());
+
+        m_pGraph->Clear();
+        m_pDevice->EndFrame();
+    }
+
+    EXPECT_EQ(m_pGraph->GetCompileStats().CacheMisses, 1u);
+    EXPECT_EQ(m_pGraph->GetCompileStats().CacheHits, 1u);
+}
@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+
+#include "RenderGraphTestUtils.hpp"
+
+namespace
+{
+    using ELoadOp = RHI::ERHIRenderPassLoadOp;
+    using EStoreOp = RHI::ERHIRenderPassStoreOp;
+
+    class FRenderGraphAttachmentTest : public FRenderGraphTestBase
+    {
+    protected:
+        static RG::FRGTexture::Desc MakeDesc(RHI::ERHIFormat format, uint32_t mipLevels = 1)
+        {
+            RG::FRGTexture::Desc desc;
+            desc.Width = 64;
+            desc.Height = 64;
+            desc.MipLevels = mipLevels;
+            desc.Format = format;
+            return desc;
+        }
+
+        template<typename Setup>
+        FTestPass& AddPass(const char* name, Setup&& setup)
+        {
+            return m_pGraph->AddPass<FTestPassData>(name, RG::RenderPassType::Graphics,
+                [&](FTestPassData& data, RG::FRGBuilder& builder)
+                {
+                    setup(data, builder);
+                },
+                [](const FTestPassData&, RHI::FRHICommandList*) {});
+        }
+
+        FTestPass& AddColorPass(const char* name, const RG::FRGTexture::Desc& desc, ELoadOp loadOp)
+        {
+            return AddPass(name, [&](FTestPassData& data, RG::FRGBuilder& builder)
+            {
+                data.Output = builder.WriteColor(0, builder.Create<RG::FRGTexture>(desc, name), 0, loadOp);
+                builder.SkipCulling();
+            });
+        }
+
+        FTestPass& AddColorPass(const char* name, const RG::FRGHandle& input, ELoadOp loadOp)
+        {
+            return AddPass(name, [&](FTestPassData& data, RG::FRGBuilder& builder)
+            {
+                data.Output = builder.WriteColor(0, input, 0, loadOp);
+                builder.SkipCulling();
+            });
+        }
+
+        void AddReader(const char* name, const RG::FRGHandle& input)
+        {
+            AddPass(name, [&](FTestPassData& data, RG::FRGBuilder& builder)
+            {
+                builder.Read(input, 0, RG::RGBuilderFlag::ShaderStagePS);
+                builder.SkipCulling();
+            });
+        }
+
+        // attachment 的边从 pass 指向它写出的新版本
+        template<typename Edge>
+        const Edge* FindAttachment(const FTestPass& pass, RHI::ERHIAccessFlags usage) const
+        {
+            const RG::FDirectedAcyclicGraph& graph = m_pGraph->GetDAG();
+            RG::FDAGEdgeRange edges = graph.GetOutgoingEdges(&pass);
+            for (size_t i = 0; i < edges.size(); i++)
+            {
+                const RG::FRenderGraphEdge* edge = static_cast<const RG::FRenderGraphEdge*>(edges[i]);
+                if (edge->GetUsage() == usage)
+                {
+                    return static_cast<const Edge*>(edge);
+                }
+            }
+            return nullptr;
+        }
+
+        const RG::FRGEdgeColorAttachment* GetColorRT(const FTestPass& pass) const
+        {
+            return FindAttachment<RG::FRGEdgeColorAttachment>(pass, RHI::RHIAccessRTV);
+        }
+
+        const RG::FRGEdgeDepthAttachment* GetDepthRT(const FTestPass& pass) const
+        {
+            return FindAttachment<RG::FRGEdgeDepthAttachment>(pass, RHI::RHIAccessDSV);
+        }
+    };
+}
+
+TEST_F(FRenderGraphAttachmentTest, FirstWriterDoesNotLoad)
+{
+    FTestPass& writer = AddColorPass("Writer", MakeDesc(RHI::ERHIFormat::RGBA8UNORM), ELoadOp::Load);
+    AddReader("Reader", writer.GetData().Output);
+
+    m_pGraph->Compile();
+
+    const RG::FRGEdgeColorAttachment* colorRT = GetColorRT(writer);
+    ASSERT_NE(colorRT, nullptr);
+    EXPECT_EQ(colorRT->GetLoadOp(), ELoadOp::DontCare);
+    EXPECT_EQ(colorRT->GetStoreOp(), EStoreOp::Store);
+}
+
+TEST_F(FRenderGraphAttachmentTest, UnreadVersionIsNotStored)
+{
+    FTestPass& writer = AddColorPass("Writer", MakeDesc(RHI::ERHIFormat::RGBA8UNORM), ELoadOp::Clear);
+
+    m_pGraph->Compile();
+
+    EXPECT_EQ(GetColorRT(writer)->GetLoadOp(), ELoadOp::Clear);
+    EXPECT_EQ(GetColorRT(writer)->GetStoreOp(), EStoreOp::DontCare);
+}
+
+TEST_F(FRenderGraphAttachmentTest, ReaderThatClearsDropsPreviousStore)
+{
+    FTestPass& first = AddColorPass("First", MakeDesc(RHI::ERHIFormat::RGBA8UNORM), ELoadOp::Clear);
+    FTestPass& second = AddColorPass("Second", first.GetData().Output, ELoadOp::Clear);
+    FTestPass& third = AddColorPass("Third", second.GetData().Output, ELoadOp::Load);
+    AddReader("Reader", third.GetData().Output);
+
+    m_pGraph->Compile();
+
+    EXPECT_EQ(GetColorRT(first)->GetStoreOp(), EStoreOp::DontCare);
+    // Third 以 Load 读取，Second 的结果必须写回
+    EXPECT_EQ(GetColorRT(second)->GetStoreOp(), EStoreOp::Store);
+    EXPECT_EQ(GetColorRT(third)->GetLoadOp(), ELoadOp::Load);
+    EXPECT_EQ(GetColorRT(third)->GetStoreOp(), EStoreOp::Store);
+}
+
+TEST_F(FRenderGraphAttachmentTest, MultiSubresourceTextureKeepsStore)
+{
+    // 后面的 pass 只清除 mip 0，其它 mip 可能还会通过新版本读取
+    FTestPass& first = AddColorPass("First", MakeDesc(RHI::ERHIFormat::RGBA8UNORM, 2), ELoadOp::Clear);
+    AddColorPass("Second", first.GetData().Output, ELoadOp::Clear);
+
+    m_pGraph->Compile();
+
+    EXPECT_EQ(GetColorRT(first)->GetStoreOp(), EStoreOp::Store);
+}
+
+TEST_F(FRenderGraphAttachmentTest, PresentedTargetIsStored)
+{
+    FTestPass& writer = AddColorPass("Writer", MakeDesc(RHI::ERHIFormat::RGBA8UNORM), ELoadOp::Clear);
+    m_pGraph->Present(writer.GetData().Output, RHI::RHIAccessPixelShaderSRV);
+
+    m_pGraph->Compile();
+
+    EXPECT_EQ(GetColorRT(writer)->GetStoreOp(), EStoreOp::Store);
+    EXPECT_FALSE(m_pGraph->GetTexture(writer.GetData().Output)->IsTransientAttachment());
+}
+
+TEST_F(FRenderGraphAttachmentTest, ImportedTextureKeepsLoadAndStore)
+{
+    RG::FRGTexture::Desc desc = MakeDesc(RHI::ERHIFormat::RGBA8UNORM);
+    desc.Usage = RHI::RHITextureUsageRenderTarget;
+    eastl::unique_ptr<RHI::FRHITexture> texture(m_pDevice->CreateTexture(desc, "ImportedTexture"));
+    ASSERT_NE(texture, nullptr);
+
+    RG::FRGHandle imported = m_pGraph->Import(texture.get(), RHI::RHIAccessRTV);
+    FTestPass& writer = AddColorPass("Writer", imported, ELoadOp::Load);
+
+    m_pGraph->Compile();
+
+    EXPECT_EQ(GetColorRT(writer)->GetLoadOp(), ELoadOp::Load);
+    EXPECT_EQ(GetColorRT(writer)->GetStoreOp(), EStoreOp::Store);
+
+    // 导入的纹理先于图销毁
+    m_pGraph->Clear();
+}
+
+TEST_F(FRenderGraphAttachmentTest, DepthWithoutStencilIgnoresStencilOps)
+{
+    FTestPass& writer = AddPass("Depth", [&](FTestPassData& data, RG::FRGBuilder& builder)
+    {
+        RG::FRGHandle depth = builder.Create<RG::FRGTexture>(MakeDesc(RHI::ERHIFormat::D32F), "Depth");
+        data.Output = builder.WriteDepth(depth, 0, ELoadOp::Load, ELoadOp::Load);
+        builder.SkipCulling();
+    });
+
+    m_pGraph->Compile();
+
+    const RG::FRGEdgeDepthAttachment* depthRT = GetDepthRT(writer);
+    ASSERT_NE(depthRT, nullptr);
+    EXPECT_EQ(depthRT->GetDepthLoadOp(), ELoadOp::DontCare);
+    EXPECT_EQ(depthRT->GetStencilLoadOp(), ELoadOp::DontCare);
+    EXPECT_EQ(depthRT->GetDepthStoreOp(), EStoreOp::DontCare);
+    EXPECT_EQ(depthRT->GetStencilStoreOp(), EStoreOp::DontCare);
+}
+
+TEST_F(FRenderGraphAttachmentTest, SinglePassAttachmentIsTransient)
+{
+    FTestPass& writer = AddColorPass("Writer", MakeDesc(RHI::ERHIFormat::RGBA8UNORM), ELoadOp::Clear);
+
+    m_pGraph->Compile();
+
+    // lazily allocated，不占用瞬态 heap
+    RG::FRGTexture* texture = m_pGraph->GetTexture(writer.GetData().Output);
+    EXPECT_TRUE(texture->IsTransientAttachment());
+    EXPECT_EQ(texture->GetAllocationSize(), 0u);
+    EXPECT_FALSE(texture->IsOverlapping());
+}
+
+TEST_F(FRenderGraphAttachmentTest, AttachmentUsedLaterIsNotTransient)
+{
+    FTestPass& sampled = AddColorPass("Sampled", MakeDesc(RHI::ERHIFormat::RGBA8UNORM), ELoadOp::Clear);
+    AddReader("Reader", sampled.GetData().Output);
+
+    FTestPass& first = AddColorPass("First", MakeDesc(RHI::ERHIFormat::RGBA8UNORM), ELoadOp::Clear);
+    AddColorPass("Second", first.GetData().Output, ELoadOp::Load);
+
+    m_pGraph->Compile();
+
+    EXPECT_FALSE(m_pGraph->GetTexture(sampled.GetData().Output)->IsTransientAttachment());
+    EXPECT_FALSE(m_pGraph->GetTexture(first.GetData().Output)->IsTransientAttachment());
+    EXPECT_GT(m_pGraph->GetTexture(first.GetData().Output)->GetAllocationSize(), 0u);
+}
+
+TEST_F(FRenderGraphAttachmentTest, CachedCompileKeepsTransientAttachment)
+{
+    for (uint32_t frame = 0; frame < 2; frame++)
+    {
+        FTestPass& writer = AddColorPass("Writer", MakeDesc(RHI::ERHIFormat::RGBA8UNORM), ELoadOp::Load);
+
+        m_pGraph->Compile();
+
+        EXPECT_TRUE(m_pGraph->GetTexture(writer.GetData().Output)->IsTransientAttachment()) << "frame " << frame;
+        EXPECT_EQ(GetColorRT(writer)->GetLoadOp(), ELoadOp::DontCare) << "frame " << frame;
+
+        m_pGraph->Clear();
+        m_pDevice->EndFrame();
+    }
+
+    EXPECT_EQ(m_pGraph->GetCompileStats().CacheHits, 1u);
+}
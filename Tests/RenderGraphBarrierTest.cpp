@@ -0,0 +1,238 @@
+#include <gtest/gtest.h>
+
+#include "RenderGraphTestUtils.hpp"
+#include "RHI/RHINull/RHICommandListNull.hpp"
+
+#include <EASTL/hash_map.h>
+
+namespace
+{
+    // 每个 pass 录制一条命令，把 pass 开头和结尾的 barrier 分隔开
+    void DrawSomething(const FTestPassData&, RHI::FRHICommandList* pCmdList)
+    {
+        pCmdList->Draw(3);
+    }
+
+    uint32_t GetBeginPass(uint64_t splitID) { return (uint32_t)(splitID >> 32); }
+
+    // 拆分 barrier 的两端各自包含的资源，按录制顺序
+    struct FSplitGroups
+    {
+        eastl::vector<uint64_t> BeginOrder;
+        eastl::vector<uint64_t> EndOrder;
+        eastl::hash_map<uint64_t, eastl::vector<RHI::FRHIResource*>> Begin;
+        eastl::hash_map<uint64_t, eastl::vector<RHI::FRHIResource*>> End;
+    };
+
+    FSplitGroups CollectSplitGroups(const RHI::FRHICommandList* pCmdList)
+    {
+        FSplitGroups groups;
+        eastl::vector<RHI::FRHIResource*> pending;
+        for (const RHI::FNullCommand& command : static_cast<const RHI::FNullCommandList*>(pCmdList)->GetCommands())
+        {
+            switch (command.Type)
+            {
+            case RHI::ENullCommandType::TextureBarrier:
+            case RHI::ENullCommandType::BufferBarrier:
+                pending.push_back(command.Resources[0]);
+                break;
+            case RHI::ENullCommandType::BeginSplitBarriers:
+                groups.BeginOrder.push_back(command.Args[0]);
+                groups.Begin[command.Args[0]] = pending;
+                pending.clear();
+                break;
+            case RHI::ENullCommandType::EndSplitBarriers:
+                groups.EndOrder.push_back(command.Args[0]);
+                groups.End[command.Args[0]] = pending;
+                pending.clear();
+                break;
+            default:
+                pending.clear();
+                break;
+            }
+        }
+        return groups;
+    }
+
+    class FRenderGraphBarrierTest : public FRenderGraphTestBase
+    {
+    protected:
+        void SetUp() override
+        {
+            FRenderGraphTestBase::SetUp();
+            if (HasFatalFailure())
+            {
+                return;
+            }
+            // 只测试手动指定的队列
+            m_pGraph->SetAutoAsyncCompute(false);
+        }
+
+        FTestPass& AddProducer(const char* name, std::initializer_list<RG::FRGHandle*> outputs)
+        {
+            return m_pGraph->AddPass<FTestPassData>(name, RG::RenderPassType::Graphics,
+                [&](FTestPassData& data, RG::FRGBuilder& builder)
+                {
+                    RHI::FRHIBufferDesc desc;
+                    desc.Stride = 4;
+                    desc.Size = 256;
+                    desc.Format = RHI::ERHIFormat::R32UI;
+                    desc.Usage = RHI::RHIBufferUsageTypedBuffer;
+                    for (RG::FRGHandle* output : outputs)
+                    {
+                        *output = builder.Write(builder.Create<RG::FRGBuffer>(desc, name));
+                    }
+                },
+                DrawSomething);
+        }
+
+        // 与其它 pass 无关的图形队列工作，拉开 barrier 两端的距离
+        void AddIndependentPasses(uint32_t count)
+        {
+            for (uint32_t i = 0; i < count; i++)
+            {
+                m_pGraph->AddPass<FTestPassData>("Independent", RG::RenderPassType::Graphics,
+                    [&](FTestPassData& data, RG::FRGBuilder& builder)
+                    {
+                        builder.SkipCulling();
+                    },
+                    DrawSomething);
+            }
+        }
+
+        FTestPass& AddConsumer(const char* name, std::initializer_list<RG::FRGHandle> inputs)
+        {
+            return m_pGraph->AddPass<FTestPassData>(name, RG::RenderPassType::Graphics,
+                [&](FTestPassData& data, RG::FRGBuilder& builder)
+                {
+                    for (const RG::FRGHandle& input : inputs)
+                    {
+                        builder.Read(input, 0, RG::RGBuilderFlag::ShaderStagePS);
+                    }
+                    builder.SkipCulling();
+                },
+                DrawSomething);
+        }
+
+        FSplitGroups CompileAndExecute()
+        {
+            m_pGraph->Compile();
+
+            m_pGraphicsCmdList->Begin();
+            m_pComputeCmdList->Begin();
+            m_pGraph->Execute(nullptr, m_pGraphicsCmdList.get(), m_pComputeCmdList.get());
+            m_pGraphicsCmdList->End();
+            m_pComputeCmdList->End();
+
+            return CollectSplitGroups(m_pGraphicsCmdList.get());
+        }
+    };
+}
+
+TEST_F(FRenderGraphBarrierTest, AdjacentPassesDoNotSplit)
+{
+    // 中间只有一个图形 pass，距离为 RG_SPLIT_BARRIER_MIN_DISTANCE
+    RG::FRGHandle output;
+    AddProducer("Producer", { &output });
+    AddIndependentPasses(1);
+    AddConsumer("Consumer", { output });
+
+    FSplitGroups groups = CompileAndExecute();
+
+    EXPECT_TRUE(groups.BeginOrder.empty());
+    EXPECT_TRUE(groups.EndOrder.empty());
+    EXPECT_EQ(m_pGraph->GetBarrierStats().SplitBarriers, 0u);
+}
+
+TEST_F(FRenderGraphBarrierTest, DistantPassesSplit)
+{
+    RG::FRGHandle output;
+    FTestPass& producer = AddProducer("Producer", { &output });
+    AddIndependentPasses(2);
+    FTestPass& consumer = AddConsumer("Consumer", { output });
+
+    FSplitGroups groups = CompileAndExecute();
+
+    ASSERT_EQ(groups.BeginOrder.size(), 1u);
+    ASSERT_EQ(groups.EndOrder.size(), 1u);
+    EXPECT_EQ(groups.BeginOrder[0], ((uint64_t)producer.GetID() << 32) | consumer.GetID());
+    EXPECT_EQ(groups.EndOrder[0], groups.BeginOrder[0]);
+
+    RHI::FRHIResource* buffer = m_pGraph->GetBuffer(output)->GetBuffer();
+    EXPECT_EQ(groups.Begin[groups.BeginOrder[0]], eastl::vector<RHI::FRHIResource*>{ buffer });
+    EXPECT_EQ(groups.End[groups.EndOrder[0]], eastl::vector<RHI::FRHIResource*>{ buffer });
+    EXPECT_EQ(m_pGraph->GetBarrierStats().SplitBarriers, 1u);
+}
+
+TEST_F(FRenderGraphBarrierTest, AsyncComputeProducerDoesNotSplit)
+{
+    // 事件不能跨队列等待，即使图形队列上的距离足够也不拆分
+    RG::FRGHandle input, output;
+    AddProducer("Producer", { &input, &output });
+    FTestPass& compute = m_pGraph->AddPass<FTestPassData>("AsyncCompute", RG::RenderPassType::AsyncCompute,
+        [&](FTestPassData& data, RG::FRGBuilder& builder)
+        {
+            builder.Read(input);
+            output = builder.Write(output);
+        },
+        [](const FTestPassData&, RHI::FRHICommandList* pCmdList) { pCmdList->Dispatch(1, 1, 1); });
+    AddIndependentPasses(3);
+    AddConsumer("Consumer", { output });
+
+    FSplitGroups groups = CompileAndExecute();
+
+    // 等待和 signal 会提交并重新开始命令列表，开始端的命令不一定还在，用统计检查两个队列
+    EXPECT_EQ(compute.GetType(), RG::RenderPassType::AsyncCompute);
+    EXPECT_TRUE(compute.HasSignal());
+    EXPECT_TRUE(groups.EndOrder.empty());
+    EXPECT_EQ(m_pGraph->GetBarrierStats().SplitBarriers, 0u);
+}
+
+TEST_F(FRenderGraphBarrierTest, BeginAndEndGroupsMatch)
+{
+    // Consumer 以 C、B、A 的顺序声明，A 和 C 来自同一个 pass
+    RG::FRGHandle a, b, c;
+    FTestPass& producer0 = AddProducer("Producer0", { &a, &c });
+    FTestPass& producer1 = AddProducer("Producer1", { &b });
+    AddIndependentPasses(3);
+    FTestPass& consumer = AddConsumer("Consumer", { c, b, a });
+
+    FSplitGroups groups = CompileAndExecute();
+
+    const uint64_t id0 = ((uint64_t)producer0.GetID() << 32) | consumer.GetID();
+    const uint64_t id1 = ((uint64_t)producer1.GetID() << 32) | consumer.GetID();
+    ASSERT_EQ(groups.BeginOrder, (eastl::vector<uint64_t>{ id0, id1 }));
+    // 等待按开始的 pass 分组，与开始时的顺序相同
+    ASSERT_EQ(groups.EndOrder, (eastl::vector<uint64_t>{ id0, id1 }));
+
+    for (uint64_t id : groups.EndOrder)
+    {
+        EXPECT_EQ(groups.Begin[id], groups.End[id]) << "split barrier begun at pass " << GetBeginPass(id);
+    }
+    EXPECT_EQ(groups.Begin[id0].size(), 2u);
+    EXPECT_EQ(groups.Begin[id1].size(), 1u);
+    EXPECT_EQ(m_pGraph->GetBarrierStats().SplitBarriers, 3u);
+}
+
+TEST_F(FRenderGraphBarrierTest, CachedCompileReplaysSameGroups)
+{
+    FSplitGroups frames[2];
+    for (uint32_t frame = 0; frame < 2; frame++)
+    {
+        RG::FRGHandle a, b;
+        AddProducer("Producer0", { &a });
+        AddProducer("Producer1", { &b });
+        AddIndependentPasses(3);
+        AddConsumer("Consumer", { b, a });
+
+        frames[frame] = CompileAndExecute();
+
+        m_pGraph->Clear();
+        m_pDevice->EndFrame();
+    }
+
+    EXPECT_EQ(m_pGraph->GetCompileStats().CacheHits, 1u);
+    EXPECT_EQ(frames[0].BeginOrder, frames[1].BeginOrder);
+    EXPECT_EQ(frames[0].EndOrder, frames[1].EndOrder);
+    EXPECT_EQ(frames[1].BeginOrder.size(), 2u);
+}
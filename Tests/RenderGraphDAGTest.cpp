@@ -0,0 +1,263 @@
+#include <gtest/gtest.h>
+
+#include "Renderer/RenderGraph/DAG.hpp"
+
+#include <EASTL/unique_ptr.h>
+
+namespace
+{
+    // 节点/边的所有权交给测试夹具，FDirectedAcyclicGraph 本身只保存裸指针
+    class FDAGFixture
+    {
+    public:
+        RG::FDAGNode* AddNode()
+        {
+            m_Nodes.push_back(eastl::make_unique<RG::FDAGNode>(m_Graph));
+            return m_Nodes.back().get();
+        }
+
+        RG::FDAGEdge* AddEdge(RG::FDAGNode* from, RG::FDAGNode* to)
+        {
+            m_Edges.push_back(eastl::make_unique<RG::FDAGEdge>(m_Graph, from, to));
+            return m_Edges.back().get();
+        }
+
+        void Clear()
+        {
+            m_Graph.Clear();
+            m_Edges.clear();
+            m_Nodes.clear();
+        }
+
+        RG::FDirectedAcyclicGraph& GetGraph() { return m_Graph; }
+
+    private:
+        RG::FDirectedAcyclicGraph m_Graph;
+        eastl::vector<eastl::unique_ptr<RG::FDAGNode>> m_Nodes;
+        eastl::vector<eastl::unique_ptr<RG::FDAGEdge>> m_Edges;
+    };
+
+    // 模拟 render graph 的形状：pass -> resource -> pass -> resource ...，每个 pass 额外读取前若干个资源
+    void BuildPassChain(FDAGFixture& fixture, uint32_t passCount, eastl::vector<RG::FDAGNode*>& passes, eastl::vector<RG::FDAGNode*>& resources)
+    {
+        passes.clear();
+        resources.clear();
+
+        for (uint32_t i = 0; i < passCount; ++i)
+        {
+            RG::FDAGNode* pass = fixture.AddNode();
+            for (uint32_t j = 1; j <= 3 && j <= resources.size(); ++j)
+            {
+                fixture.AddEdge(resources[resources.size() - j], pass);
+            }
+            passes.push_back(pass);
+
+            RG::FDAGNode* resource = fixture.AddNode();
+            fixture.AddEdge(pass, resource);
+            resources.push_back(resource);
+        }
+    }
+}
+
+TEST(DAGTest, EdgeQueriesMatchRegistration)
+{
+    FDAGFixture fixture;
+    RG::FDirectedAcyclicGraph& graph = fixture.GetGraph();
+
+    RG::FDAGNode* a = fixture.AddNode();
+    RG::FDAGNode* b = fixture.AddNode();
+    RG::FDAGNode* c = fixture.AddNode();
+
+    RG::FDAGEdge* ab = fixture.AddEdge(a, b);
+    RG::FDAGEdge* ac = fixture.AddEdge(a, c);
+    RG::FDAGEdge* bc = fixture.AddEdge(b, c);
+
+    RG::FDAGEdgeRange outA = graph.GetOutgoingEdges(a);
+    ASSERT_EQ(outA.size(), 2u);
+    EXPECT_EQ(outA[0], ab);
+    EXPECT_EQ(outA[1], ac);
+
+    RG::FDAGEdgeRange inC = graph.GetIncomingEdges(c);
+    ASSERT_EQ(inC.size(), 2u);
+    EXPECT_EQ(inC[0], ac);
+    EXPECT_EQ(inC[1], bc);
+
+    EXPECT_TRUE(graph.GetIncomingEdges(a).empty());
+    EXPECT_TRUE(graph.GetOutgoingEdges(c).empty());
+
+    EXPECT_EQ(graph.GetEdge(a->GetID(), b->GetID()), ab);
+    EXPECT_EQ(graph.GetEdge(b->GetID(), c->GetID()), bc);
+    EXPECT_EQ(graph.GetEdge(c->GetID(), a->GetID()), nullptr);
+
+    eastl::vector<RG::FDAGEdge*> edges;
+    graph.GetIncomingEdges(b, edges);
+    ASSERT_EQ(edges.size(), 1u);
+    EXPECT_EQ(edges[0], ab);
+}
+
+TEST(DAGTest, EdgesAddedAfterQueryAreVisible)
+{
+    FDAGFixture fixture;
+    RG::FDirectedAcyclicGraph& graph = fixture.GetGraph();
+
+    RG::FDAGNode* a = fixture.AddNode();
+    RG::FDAGNode* b = fixture.AddNode();
+    fixture.AddEdge(a, b);
+    EXPECT_EQ(graph.GetOutgoingEdges(a).size(), 1u);
+
+    RG::FDAGNode* c = fixture.AddNode();
+    RG::FDAGEdge* bc = fixture.AddEdge(b, c);
+    ASSERT_EQ(graph.GetIncomingEdges(c).size(), 1u);
+    EXPECT_EQ(graph.GetIncomingEdges(c)[0], bc);
+}
+
+TEST(DAGTest, CullRemovesUnreachableNodes)
+{
+    FDAGFixture fixture;
+    RG::FDirectedAcyclicGraph& graph = fixture.GetGraph();
+
+    // a -> b -> target，c -> d 没有连到 target，应被剔除
+    RG::FDAGNode* a = fixture.AddNode();
+    RG::FDAGNode* b = fixture.AddNode();
+    RG::FDAGNode* target = fixture.AddNode();
+    RG::FDAGNode* c = fixture.AddNode();
+    RG::FDAGNode* d = fixture.AddNode();
+
+    fixture.AddEdge(a, b);
+    fixture.AddEdge(b, target);
+    fixture.AddEdge(c, d);
+    fixture.AddEdge(a, c);
+    target->MakeTarget();
+
+    graph.Cull();
+
+    EXPECT_FALSE(a->IsCulled());
+    EXPECT_FALSE(b->IsCulled());
+    EXPECT_FALSE(target->IsCulled());
+    EXPECT_TRUE(c->IsCulled());
+    EXPECT_TRUE(d->IsCulled());
+    EXPECT_EQ(a->GetRefCount(), 1u);
+}
+
+TEST(DAGTest, LargeGraphAdjacencyAndCull)
+{
+    const uint32_t passCount = 4096;
+
+    FDAGFixture fixture;
+    RG::FDirectedAcyclicGraph& graph = fixture.GetGraph();
+
+    eastl::vector<RG::FDAGNode*> passes;
+    eastl::vector<RG::FDAGNode*> resources;
+    BuildPassChain(fixture, passCount, passes, resources);
+
+    // 额外挂一条不输出到 target 的支路，全部应被剔除
+    eastl::vector<RG::FDAGNode*> deadNodes;
+    RG::FDAGNode* prev = resources[passCount / 2];
+    for (uint32_t i = 0; i < 1024; ++i)
+    {
+        RG::FDAGNode* node = fixture.AddNode();
+        fixture.AddEdge(prev, node);
+        deadNodes.push_back(node);
+        prev = node;
+    }
+
+    resources.back()->MakeTarget();
+
+    ASSERT_EQ(graph.GetNodeCount(), passCount * 2 + 1024);
+
+    size_t incomingTotal = 0;
+    size_t outgoingTotal = 0;
+    for (uint32_t i = 0; i < graph.GetNodeCount(); ++i)
+    {
+        RG::FDAGNode* node = graph.GetNode(i);
+        for (RG::FDAGEdge* edge : graph.GetIncomingEdges(node))
+        {
+            EXPECT_EQ(edge->GetToNode(), node->GetID());
+        }
+        for (RG::FDAGEdge* edge : graph.GetOutgoingEdges(node))
+        {
+            EXPECT_EQ(edge->GetFromNode(), node->GetID());
+            EXPECT_EQ(graph.GetEdge(edge->GetFromNode(), edge->GetToNode()), edge);
+        }
+        incomingTotal += graph.GetIncomingEdges(node).size();
+        outgoingTotal += graph.GetOutgoingEdges(node).size();
+    }
+    EXPECT_EQ(incomingTotal, graph.GetEdgeCount());
+    EXPECT_EQ(outgoingTotal, graph.GetEdgeCount());
+
+    for (uint32_t i = 3; i < passCount; ++i)
+    {
+        EXPECT_EQ(graph.GetIncomingEdges(passes[i]).size(), 3u);
+    }
+
+    graph.Cull();
+
+    for (uint32_t i = 0; i < passCount; ++i)
+    {
+        EXPECT_FALSE(passes[i]->IsCulled());
+        EXPECT_FALSE(resources[i]->IsCulled());
+    }
+    for (size_t i = 0; i < deadNodes.size(); ++i)
+    {
+        EXPECT_TRUE(deadNodes[i]->IsCulled());
+    }
+}
+
+TEST(DAGTest, ClearAndRebuild)
+{
+    FDAGFixture fixture;
+    RG::FDirectedAcyclicGraph& graph = fixture.GetGraph();
+
+    eastl::vector<RG::FDAGNode*> passes;
+    eastl::vector<RG::FDAGNode*> resources;
+
+    // 模拟逐帧重建：结构每帧变化，邻接信息不能残留上一帧的数据
+    for (uint32_t frame = 0; frame < 4; ++frame)
+    {
+        fixture.Clear();
+
+        const uint32_t passCount = 1000 + frame * 500;
+        BuildPassChain(fixture, passCount, passes, resources);
+        resources[passCount / 2]->MakeTarget();
+
+        graph.Cull();
+
+        EXPECT_FALSE(passes[passCount / 2]->IsCulled());
+        EXPECT_FALSE(passes[0]->IsCulled());
+        EXPECT_TRUE(passes[passCount - 1]->IsCulled());
+        EXPECT_TRUE(resources[passCount - 1]->IsCulled());
+        EXPECT_EQ(graph.GetIncomingEdges(passes[passCount - 1]).size(), 3u);
+    }
+}
+
+TEST(DAGTest, RestoreRefCountsMatchesCull)
+{
+    FDAGFixture fixture;
+    RG::FDirectedAcyclicGraph& graph = fixture.GetGraph();
+
+    eastl::vector<RG::FDAGNode*> passes;
+    eastl::vector<RG::FDAGNode*> resources;
+
+    const uint32_t passCount = 64;
+    BuildPassChain(fixture, passCount, passes, resources);
+    resources[passCount / 2]->MakeTarget();
+    graph.Cull();
+
+    eastl::vector<uint32_t> refCounts;
+    graph.GetRefCounts(refCounts);
+    ASSERT_EQ(refCounts.size(), graph.GetNodeCount());
+
+    // 下一帧声明同样的图，不 Cull 而是恢复上一帧的结果
+    fixture.Clear();
+    BuildPassChain(fixture, passCount, passes, resources);
+    resources[passCount / 2]->MakeTarget();
+    graph.SetRefCounts(refCounts);
+
+    for (uint32_t i = 0; i < passCount; ++i)
+    {
+        EXPECT_EQ(passes[i]->IsCulled(), i > passCount / 2);
+        EXPECT_EQ(resources[i]->IsCulled(), i > passCount / 2);
+    }
+    EXPECT_TRUE(resources[passCount / 2]->IsTarget());
+    EXPECT_EQ(passes[0]->GetRefCount(), refCounts[passes[0]->GetID()]);
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include "RenderGraphTestUtils.hpp"
+#include "Renderer/RenderGraph/RenderGraphProfiler.hpp"
+
+namespace
+{
+    using FScopeList = eastl::vector<eastl::pair<eastl::string, RHI::ERHICommandQueueType>>;
+
+    // 空设备每次写入时间戳前进 1000 tick，频率为 1GHz，即每次 0.001 ms
+    const double NULL_TIMESTAMP_STEP_MS = 0.001;
+
+    // 直接驱动 profiler，不经过基类的渲染图
+    class FRenderGraphProfilerTest : public FRenderGraphTestBase
+    {
+    protected:
+        void SetUp() override
+        {
+            FRenderGraphTestBase::SetUp();
+            if (HasFatalFailure())
+            {
+                return;
+            }
+            m_pProfiler = eastl::make_unique<RG::FRenderGraphProfiler>(m_pDevice.get());
+        }
+
+        // 计算队列先提交，图形队列上解析时它的时间戳已经写入
+        void RunFrame(const FScopeList& scopes, uint32_t unfinishedScope = UINT32_MAX)
+        {
+            m_pDevice->BeginFrame();
+            m_pGraphicsCmdList->Begin();
+            m_pComputeCmdList->Begin();
+
+            m_pProfiler->BeginFrame(m_pGraphicsCmdList.get(), m_pComputeCmdList.get(), scopes);
+            for (uint32_t i = 0; i < (uint32_t)scopes.size(); i++)
+            {
+                RHI::FRHICommandList* pCmdList = scopes[i].second == RHI::ERHICommandQueueType::Compute ? m_pComputeCmdList.get() : m_pGraphicsCmdList.get();
+                m_pProfiler->BeginScope(i, pCmdList);
+                if (i != unfinishedScope)
+                {
+                    m_pProfiler->EndScope(i, pCmdList);
+                }
+            }
+            m_pComputeCmdList->End();
+            m_pComputeCmdList->Submit();
+
+            m_pProfiler->EndFrame(m_pGraphicsCmdList.get());
+            m_pGraphicsCmdList->End();
+            m_pGraphicsCmdList->Submit();
+            m_pDevice->EndFrame();
+        }
+
+    protected:
+        eastl::unique_ptr<RG::FRenderGraphProfiler> m_pProfiler;
+    };
+}
+
+TEST_F(FRenderGraphProfilerTest, DisabledProfilerRecordsNothing)
+{
+    const FScopeList scopes = { { "GBuffer", RHI::ERHICommandQueueType::Graphics } };
+    for (uint32_t i = 0; i < RHI::RHI_MAX_INFLIGHT_FRAMES * 2; i++)
+    {
+        RunFrame(scopes);
+    }
+
+    EXPECT_TRUE(m_pProfiler->GetHistory().empty());
+}
+
+TEST_F(FRenderGraphProfilerTest, ResultsAreReadBackWhenFrameSlotIsReused)
+{
+    m_pProfiler->SetEnabled(true);
+
+    const FScopeList scopes = {
+        { "GBuffer", RHI::ERHICommandQueueType::Graphics },
+        { "Lighting", RHI::ERHICommandQueueType::Graphics },
+        { "SSAO", RHI::ERHICommandQueueType::Compute },
+    };
+
+    for (uint32_t i = 0; i < RHI::RHI_MAX_INFLIGHT_FRAMES; i++)
+    {
+        RunFrame(scopes);
+        EXPECT_TRUE(m_pProfiler->GetHistory().empty());
+    }
+
+    RunFrame(scopes);
+
+    RG::FRenderGraphFrameTiming frame;
+    ASSERT_TRUE(m_pProfiler->GetLatestFrame(frame));
+    EXPECT_EQ(frame.FrameID, 0u);
+    ASSERT_EQ(frame.Passes.size(), 3u);
+
+    // 计算队列先执行，最早的时间戳来自 SSAO
+    EXPECT_EQ(frame.Passes[0].Name, "GBuffer");
+    EXPECT_EQ(frame.Passes[2].Queue, RHI::ERHICommandQueueType::Compute);
+    EXPECT_DOUBLE_EQ(frame.Passes[2].BeginMs, 0.0);
+    EXPECT_DOUBLE_EQ(frame.Passes[0].BeginMs, 2 * NULL_TIMESTAMP_STEP_MS);
+    EXPECT_DOUBLE_EQ(frame.Passes[1].EndMs, 5 * NULL_TIMESTAMP_STEP_MS);
+    EXPECT_DOUBLE_EQ(frame.TotalMs, 5 * NULL_TIMESTAMP_STEP_MS);
+    for (const RG::FRenderGraphPassTiming& pass : frame.Passes)
+    {
+        EXPECT_DOUBLE_EQ(pass.GetDurationMs(), NULL_TIMESTAMP_STEP_MS);
+    }
+}
+
+TEST_F(FRenderGraphProfilerTest, UnfinishedScopesAreDropped)
+{
+    m_pProfiler->SetEnabled(true);
+
+    const FScopeList scopes = {
+        { "Shadow", RHI::ERHICommandQueueType::Graphics },
+        { "Broken", RHI::ERHICommandQueueType::Graphics },
+    };
+    for (uint32_t i = 0; i <= RHI::RHI_MAX_INFLIGHT_FRAMES; i++)
+    {
+        RunFrame(scopes, 1);
+    }
+
+    RG::FRenderGraphFrameTiming frame;
+    ASSERT_TRUE(m_pProfiler->GetLatestFrame(frame));
+    ASSERT_EQ(frame.Passes.size(), 1u);
+    EXPECT_EQ(frame.Passes[0].Name, "Shadow");
+}
+
+TEST_F(FRenderGraphProfilerTest, QueryPoolsGrowWithScopeCount)
+{
+    m_pProfiler->SetEnabled(true);
+
+    FScopeList scopes;
+    for (uint32_t i = 0; i < 200; i++)
+    {
+        scopes.push_back({ "Pass" + eastl::to_string(i), i % 4 == 0 ? RHI::ERHICommandQueueType::Compute : RHI::ERHICommandQueueType::Graphics });
+    }
+    for (uint32_t i = 0; i <= RHI::RHI_MAX_INFLIGHT_FRAMES; i++)
+    {
+        RunFrame(scopes);
+    }
+
+    RG::FRenderGraphFrameTiming frame;
+    ASSERT_TRUE(m_pProfiler->GetLatestFrame(frame));
+    ASSERT_EQ(frame.Passes.size(), scopes.size());
+    EXPECT_EQ(frame.Passes.back().Name, "Pass199");
+}
+
+TEST_F(FRenderGraphProfilerTest, HistoryIsBounded)
+{
+    m_pProfiler->SetEnabled(true);
+
+    const FScopeList scopes = { { "Tonemap", RHI::ERHICommandQueueType::Graphics } };
+    for (uint32_t i = 0; i < 300; i++)
+    {
+        RunFrame(scopes);
+    }
+
+    eastl::vector<RG::FRenderGraphFrameTiming> history = m_pProfiler->GetHistory();
+    ASSERT_FALSE(history.empty());
+    EXPECT_LT(history.size(), 300u);
+    EXPECT_EQ(history.back().FrameID, 300u - RHI::RHI_MAX_INFLIGHT_FRAMES - 1);
+    EXPECT_EQ(history.back().FrameID - history.front().FrameID + 1, history.size());
+}
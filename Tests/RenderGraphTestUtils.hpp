@@ -0,0 +1,49 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "RHI/RHI.hpp"
+#include "Renderer/RenderGraph/RenderGraph.hpp"
+
+#include <EASTL/unique_ptr.h>
+
+struct FTestPassData
+{
+    RG::FRGHandle Output;
+};
+
+using FTestPass = RG::TRenderGraphPass<FTestPassData>;
+
+// 渲染图测试共用的 Null 设备、图形/计算命令列表和渲染图
+// 派生类重写 SetUp 时先调用基类，并在 HasFatalFailure() 时直接返回
+class FRenderGraphTestBase : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        RHI::FRHIDeviceDesc desc;
+        desc.RenderBackend = RHI::ERHIRenderBackend::Null;
+        m_pDevice.reset(RHI::CreateRHIDevice(desc));
+        ASSERT_NE(m_pDevice, nullptr);
+
+        m_pGraphicsCmdList.reset(m_pDevice->CreateCommandList(RHI::ERHICommandQueueType::Graphics, "GraphicsCmdList"));
+        m_pComputeCmdList.reset(m_pDevice->CreateCommandList(RHI::ERHICommandQueueType::Compute, "ComputeCmdList"));
+        m_pGraph = eastl::make_unique<RG::FRenderGraph>(m_pDevice.get());
+    }
+
+    // 图中导入的外部资源可能先于设备销毁，先清空图
+    void TearDown() override
+    {
+        if (m_pGraph != nullptr)
+        {
+            m_pGraph->Clear();
+            m_pGraph.reset();
+        }
+    }
+
+protected:
+    eastl::unique_ptr<RHI::FRHIDevice> m_pDevice;
+    eastl::unique_ptr<RHI::FRHICommandList> m_pGraphicsCmdList;
+    eastl::unique_ptr<RHI::FRHICommandList> m_pComputeCmdList;
+    eastl::unique_ptr<RG::FRenderGraph> m_pGraph;
+};
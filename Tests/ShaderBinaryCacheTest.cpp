@@ -0,0 +1,265 @@
+#include <gtest/gtest.h>
+
+#include "Renderer/ShaderBinaryCache.hpp"
+
+#include <EASTL/hash_map.h>
+#include <EASTL/unique_ptr.h>
+
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+    // 用临时目录中的源文件和桩编译器驱动缓存，不需要 DXC 和 GPU
+    class FShaderBinaryCacheTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            m_Root = std::filesystem::absolute(std::filesystem::temp_directory_path() / "VultanaShaderBinaryCacheTest");
+            std::filesystem::remove_all(m_Root);
+
+            m_CacheDirectory = (m_Root / "Cache").string().c_str();
+            m_CacheDirectory += "/";
+
+            SetFile("Main.hlsl", "#include \"Common/A.hlsli\"\nfloat4 main() : SV_Target { return A(); }\n");
+            SetFile("Common/A.hlsli", "#include \"B.hlsli\"\nfloat4 A() { return B(); }\n");
+            SetFile("Common/B.hlsli", "float4 B() { return 1; }\n");
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(m_Root);
+        }
+
+        eastl::string GetPath(const char* file) const
+        {
+            return (m_Root / file).lexically_normal().string().c_str();
+        }
+
+        // include 按磁盘上的文件解析，内容通过 loader 读取
+        void SetFile(const char* file, const eastl::string& source)
+        {
+            eastl::string path = GetPath(file);
+            std::filesystem::create_directories(std::filesystem::path(path.c_str()).parent_path());
+            std::ofstream os(path.c_str(), std::ios::binary | std::ios::trunc);
+            os.write(source.data(), source.size());
+            m_Files[path] = source;
+        }
+
+        eastl::unique_ptr<Renderer::FShaderBinaryCache> CreateCache(const eastl::string& includeDirectory = "")
+        {
+            return eastl::make_unique<Renderer::FShaderBinaryCache>(m_CacheDirectory, [this](const eastl::string& file)
+            {
+                auto iter = m_Files.find(file);
+                return iter != m_Files.end() ? iter->second : eastl::string();
+            }, includeDirectory);
+        }
+
+        static uint64_t GetKey(Renderer::FShaderBinaryCache& cache, const Renderer::FShaderBinaryKeyDesc& desc)
+        {
+            uint64_t key = 0;
+            EXPECT_TRUE(cache.ComputeKey(desc, key));
+            return key;
+        }
+
+        Renderer::FShaderBinaryKeyDesc GetDesc() const
+        {
+            Renderer::FShaderBinaryKeyDesc desc;
+            desc.File = GetPath("Main.hlsl");
+            desc.EntryPoint = "main";
+            desc.Profile = "ps_6_6 spirv vulkan1.3";
+            desc.CompilerVersion = "dxc 1.8";
+            desc.Defines = { "USE_FOO=1" };
+            return desc;
+        }
+
+        // 桩编译器：输出源码本身，并记录调用次数
+        Renderer::FShaderBinaryCache::FCompiler GetCompiler()
+        {
+            return [this](const eastl::string& source, eastl::vector<uint8_t>& output)
+            {
+                m_CompileCount++;
+                output.assign(source.begin(), source.end());
+                return true;
+            };
+        }
+
+    protected:
+        std::filesystem::path m_Root;
+        eastl::string m_CacheDirectory;
+        eastl::hash_map<eastl::string, eastl::string> m_Files;
+        uint32_t m_CompileCount = 0;
+    };
+}
+
+TEST_F(FShaderBinaryCacheTest, MissThenHitAcrossInstances)
+{
+    eastl::vector<uint8_t> first;
+    {
+        auto cache = CreateCache();
+        ASSERT_TRUE(cache->GetOrCompile(GetDesc(), GetCompiler(), first));
+        EXPECT_EQ(cache->GetStats().MissCount, 1u);
+        EXPECT_EQ(m_CompileCount, 1u);
+    }
+
+    // 模拟下一次启动
+    auto cache = CreateCache();
+    eastl::vector<uint8_t> second;
+    ASSERT_TRUE(cache->GetOrCompile(GetDesc(), GetCompiler(), second));
+    EXPECT_EQ(cache->GetStats().HitCount, 1u);
+    EXPECT_EQ(m_CompileCount, 1u);
+    EXPECT_TRUE(first == second);
+}
+
+TEST_F(FShaderBinaryCacheTest, KeyCoversAllInputs)
+{
+    auto cache = CreateCache();
+    const uint64_t baseKey = GetKey(*cache, GetDesc());
+    EXPECT_EQ(GetKey(*cache, GetDesc()), baseKey);
+
+    Renderer::FShaderBinaryKeyDesc desc = GetDesc();
+    desc.EntryPoint = "main2";
+    EXPECT_NE(GetKey(*cache, desc), baseKey);
+
+    desc = GetDesc();
+    desc.Profile = "ps_6_7 spirv vulkan1.3";
+    EXPECT_NE(GetKey(*cache, desc), baseKey);
+
+    desc = GetDesc();
+    desc.Defines.push_back("USE_BAR=1");
+    EXPECT_NE(GetKey(*cache, desc), baseKey);
+
+    desc = GetDesc();
+    desc.CompileFlags = RHI::RHIShaderCompileFlagO3;
+    EXPECT_NE(GetKey(*cache, desc), baseKey);
+
+    // 间接 include 的头文件变化同样要让 key 失效
+    SetFile("Common/B.hlsli", "float4 B() { return 2; }\n");
+    EXPECT_NE(GetKey(*cache, GetDesc()), baseKey);
+}
+
+TEST_F(FShaderBinaryCacheTest, IncludeChangeRecompiles)
+{
+    auto cache = CreateCache();
+    eastl::vector<uint8_t> output;
+    ASSERT_TRUE(cache->GetOrCompile(GetDesc(), GetCompiler(), output));
+
+    SetFile("Common/B.hlsli", "float4 B() { return 0.5; }\n");
+    ASSERT_TRUE(cache->GetOrCompile(GetDesc(), GetCompiler(), output));
+    EXPECT_EQ(m_CompileCount, 2u);
+
+    ASSERT_TRUE(cache->GetOrCompile(GetDesc(), GetCompiler(), output));
+    EXPECT_EQ(m_CompileCount, 2u);
+}
+
+TEST_F(FShaderBinaryCacheTest, CompilerVersionMismatchRecompiles)
+{
+    eastl::vector<uint8_t> output;
+    CreateCache()->GetOrCompile(GetDesc(), GetCompiler(), output);
+
+    Renderer::FShaderBinaryKeyDesc desc = GetDesc();
+    desc.CompilerVersion = "dxc 1.9";
+
+    auto cache = CreateCache();
+    ASSERT_TRUE(cache->GetOrCompile(desc, GetCompiler(), output));
+    EXPECT_EQ(cache->GetStats().MissCount, 1u);
+    EXPECT_EQ(m_CompileCount, 2u);
+}
+
+TEST_F(FShaderBinaryCacheTest, CorruptedFileIsDiscarded)
+{
+    auto cache = CreateCache();
+    eastl::vector<uint8_t> expected;
+    ASSERT_TRUE(cache->GetOrCompile(GetDesc(), GetCompiler(), expected));
+
+    eastl::string path = cache->GetCacheFilePath(GetKey(*cache, GetDesc()));
+    ASSERT_TRUE(std::filesystem::exists(path.c_str()));
+
+    // 改坏最后一个字节
+    {
+        std::fstream fs(path.c_str(), std::ios::binary | std::ios::in | std::ios::out);
+        fs.seekp(-1, std::ios::end);
+        fs.put('#');
+    }
+
+    eastl::vector<uint8_t> output;
+    ASSERT_TRUE(cache->GetOrCompile(GetDesc(), GetCompiler(), output));
+    EXPECT_EQ(cache->GetStats().CorruptedCount, 1u);
+    EXPECT_EQ(m_CompileCount, 2u);
+    EXPECT_TRUE(output == expected);
+
+    // 重新编译的结果已经覆盖了坏文件
+    ASSERT_TRUE(cache->GetOrCompile(GetDesc(), GetCompiler(), output));
+    EXPECT_EQ(m_CompileCount, 2u);
+    EXPECT_EQ(cache->GetStats().HitCount, 1u);
+}
+
+TEST_F(FShaderBinaryCacheTest, TruncatedFileIsDiscarded)
+{
+    auto cache = CreateCache();
+    eastl::vector<uint8_t> output;
+    ASSERT_TRUE(cache->GetOrCompile(GetDesc(), GetCompiler(), output));
+
+    eastl::string path = cache->GetCacheFilePath(GetKey(*cache, GetDesc()));
+    std::filesystem::resize_file(path.c_str(), 10);
+
+    ASSERT_TRUE(cache->GetOrCompile(GetDesc(), GetCompiler(), output));
+    EXPECT_EQ(cache->GetStats().CorruptedCount, 1u);
+    EXPECT_EQ(m_CompileCount, 2u);
+}
+
+TEST_F(FShaderBinaryCacheTest, CompileFailureIsNotCached)
+{
+    auto cache = CreateCache();
+    eastl::vector<uint8_t> output;
+    EXPECT_FALSE(cache->GetOrCompile(GetDesc(), [](const eastl::string&, eastl::vector<uint8_t>&) { return false; }, output));
+    EXPECT_FALSE(std::filesystem::exists(cache->GetCacheFilePath(GetKey(*cache, GetDesc())).c_str()));
+
+    ASSERT_TRUE(cache->GetOrCompile(GetDesc(), GetCompiler(), output));
+    EXPECT_EQ(m_CompileCount, 1u);
+}
+
+TEST_F(FShaderBinaryCacheTest, IncludeResolvesFromMainFileDirectory)
+{
+    // 与 Shaders/Common/Stats.hlsli 一样，相对主文件目录 include 同一目录下的头文件
+    SetFile("Main.hlsl", "#include \"Common/A.hlsli\"\nfloat4 main() : SV_Target { return A(); }\n");
+    SetFile("Common/A.hlsli", "#include \"Common/B.hlsli\"\nfloat4 A() { return B(); }\n");
+
+    auto cache = CreateCache();
+    const uint64_t baseKey = GetKey(*cache, GetDesc());
+
+    SetFile("Common/B.hlsli", "float4 B() { return 2; }\n");
+    EXPECT_NE(GetKey(*cache, GetDesc()), baseKey);
+}
+
+TEST_F(FShaderBinaryCacheTest, IncludeResolvesFromIncludeDirectory)
+{
+    SetFile("Main.hlsl", "#include \"Root.hlsli\"\nfloat4 main() : SV_Target { return R(); }\n");
+    SetFile("Root/Root.hlsli", "float4 R() { return 1; }\n");
+
+    uint64_t key = 0;
+    EXPECT_FALSE(CreateCache()->ComputeKey(GetDesc(), key));
+
+    auto cache = CreateCache(GetPath("Root"));
+    const uint64_t baseKey = GetKey(*cache, GetDesc());
+
+    SetFile("Root/Root.hlsli", "float4 R() { return 2; }\n");
+    EXPECT_NE(GetKey(*cache, GetDesc()), baseKey);
+}
+
+TEST_F(FShaderBinaryCacheTest, UnresolvedIncludeBypassesCache)
+{
+    SetFile("Common/A.hlsli", "#include \"Missing.hlsli\"\nfloat4 A() { return 1; }\n");
+
+    auto cache = CreateCache();
+    eastl::vector<uint8_t> output;
+    ASSERT_TRUE(cache->GetOrCompile(GetDesc(), GetCompiler(), output));
+    ASSERT_TRUE(cache->GetOrCompile(GetDesc(), GetCompiler(), output));
+
+    // 每次都重新编译，且不写入缓存
+    EXPECT_EQ(m_CompileCount, 2u);
+    EXPECT_EQ(cache->GetStats().BypassCount, 2u);
+    EXPECT_EQ(cache->GetStats().HitCount, 0u);
+    EXPECT_TRUE(std::filesystem::is_empty(m_CacheDirectory.c_str()));
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include "Renderer/StagingBufferAllocator.hpp"
+
+#include <EASTL/unique_ptr.h>
+#include <EASTL/vector.h>
+#include <EASTL/algorithm.h>
+#include <random>
+
+namespace
+{
+    const uint32_t RING_SIZE = 1024 * 1024;
+
+    class FStagingBufferAllocatorTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            RHI::FRHIDeviceDesc desc;
+            desc.RenderBackend = RHI::ERHIRenderBackend::Null;
+            m_pDevice.reset(RHI::CreateRHIDevice(desc));
+            ASSERT_NE(m_pDevice, nullptr);
+
+            m_pFence.reset(m_pDevice->CreateFence("TestFence"));
+            m_pAllocator = eastl::make_unique<Renderer::FStagingBufferAllocator>(m_pDevice.get(), m_pFence.get(), RING_SIZE);
+            ASSERT_NE(m_pAllocator->GetRingBuffer(), nullptr);
+        }
+
+        // 与所有 GPU 尚未完成的区间都不重叠
+        void ExpectNoOverlap(const Renderer::FStagingBuffer& buffer) const
+        {
+            for (size_t i = 0; i < m_Inflight.size(); i++)
+            {
+                const FRange& range = m_Inflight[i];
+                if (range.Buffer.Buffer != buffer.Buffer || range.FenceValue <= m_pFence->GetCompletedValue())
+                {
+                    continue;
+                }
+                bool bOverlap = buffer.Offset < range.Buffer.Offset + range.Buffer.Size && range.Buffer.Offset < buffer.Offset + buffer.Size;
+                EXPECT_FALSE(bOverlap) << "[" << buffer.Offset << ", " << buffer.Offset + buffer.Size << ") overlaps in-flight range ["
+                    << range.Buffer.Offset << ", " << range.Buffer.Offset + range.Buffer.Size << ") of fence " << range.FenceValue;
+            }
+        }
+
+        struct FRange
+        {
+            Renderer::FStagingBuffer Buffer;
+            uint64_t FenceValue;
+        };
+
+    protected:
+        eastl::unique_ptr<RHI::FRHIDevice> m_pDevice;
+        eastl::unique_ptr<RHI::FRHIFence> m_pFence;
+        eastl::unique_ptr<Renderer::FStagingBufferAllocator> m_pAllocator;
+        eastl::vector<FRange> m_Inflight;
+    };
+}
+
+TEST_F(FStagingBufferAllocatorTest, RingWrapsWithoutOverlappingInflightRanges)
+{
+    // GPU 落后 CPU 两次提交，每次提交的总量不超过环形缓冲的四分之一
+    const uint64_t gpuLatency = 2;
+    std::mt19937 random(1234);
+    std::uniform_int_distribution<uint32_t> sizeDistribution(1, RING_SIZE / 32);
+
+    uint64_t fenceValue = 0;
+    uint64_t wrapCount = 0;
+    uint32_t lastOffset = 0;
+    for (uint32_t frame = 0; frame < 2000; frame++)
+    {
+        uint32_t frameSize = 0;
+        uint32_t allocationCount = random() % 8;
+        for (uint32_t i = 0; i < allocationCount && frameSize < RING_SIZE / 4 - RING_SIZE / 32; i++)
+        {
+            uint32_t size = sizeDistribution(random);
+            Renderer::FStagingBuffer buffer = m_pAllocator->Allocate(size);
+            ASSERT_EQ(buffer.Buffer, m_pAllocator->GetRingBuffer());
+            ASSERT_EQ(buffer.Size, size);
+            ASSERT_LE(buffer.Offset + buffer.Size, RING_SIZE);
+            EXPECT_EQ(buffer.Offset % 512, 0u);
+            ExpectNoOverlap(buffer);
+
+            wrapCount += buffer.Offset < lastOffset ? 1 : 0;
+            lastOffset = buffer.Offset;
+            frameSize += size;
+            m_Inflight.push_back({ buffer, fenceValue + 1 });
+        }
+
+        m_pAllocator->Retire(++fenceValue);
+        if (fenceValue > gpuLatency)
+        {
+            m_pFence->Signal(fenceValue - gpuLatency);
+        }
+
+        uint64_t completedValue = m_pFence->GetCompletedValue();
+        m_Inflight.erase(eastl::remove_if(m_Inflight.begin(), m_Inflight.end(), [completedValue](const FRange& range) { return range.FenceValue <= completedValue; }), m_Inflight.end());
+    }
+
+    EXPECT_GT(wrapCount, 10u);
+    EXPECT_EQ(m_pAllocator->GetDedicatedBufferCount(), 0u);
+}
+
+TEST_F(FStagingBufferAllocatorTest, FullRingWaitsForOldestSubmission)
+{
+    Renderer::FStagingBuffer first = m_pAllocator->Allocate(RING_SIZE / 2);
+    m_pAllocator->Retire(1);
+    Renderer::FStagingBuffer second = m_pAllocator->Allocate(RING_SIZE / 2);
+    m_pAllocator->Retire(2);
+    EXPECT_EQ(first.Buffer, second.Buffer);
+    EXPECT_NE(first.Offset, second.Offset);
+
+    // 第一次提交完成后复用它的空间，第二次提交仍在执行，不能被覆盖
+    m_pFence->Signal(1);
+    Renderer::FStagingBuffer third = m_pAllocator->Allocate(RING_SIZE / 4);
+    EXPECT_EQ(third.Buffer, m_pAllocator->GetRingBuffer());
+    EXPECT_EQ(third.Offset, first.Offset);
+    EXPECT_EQ(m_pAllocator->GetDedicatedBufferCount(), 0u);
+}
+
+TEST_F(FStagingBufferAllocatorTest, OversizeUploadsUseDedicatedBuffers)
+{
+    Renderer::FStagingBuffer large = m_pAllocator->Allocate(RING_SIZE);
+    EXPECT_NE(large.Buffer, nullptr);
+    EXPECT_NE(large.Buffer, m_pAllocator->GetRingBuffer());
+    EXPECT_EQ(large.Offset, 0u);
+    EXPECT_EQ(m_pAllocator->GetDedicatedBufferCount(), 1u);
+
+    // 同一次提交中未 Retire 的分配占满环形缓冲时也退回到独立 buffer
+    Renderer::FStagingBuffer a = m_pAllocator->Allocate(RING_SIZE / 2);
+    Renderer::FStagingBuffer b = m_pAllocator->Allocate(RING_SIZE / 2);
+    Renderer::FStagingBuffer c = m_pAllocator->Allocate(RING_SIZE / 2);
+    EXPECT_EQ(a.Buffer, m_pAllocator->GetRingBuffer());
+    EXPECT_EQ(b.Buffer, m_pAllocator->GetRingBuffer());
+    EXPECT_NE(c.Buffer, m_pAllocator->GetRingBuffer());
+    EXPECT_EQ(m_pAllocator->GetDedicatedBufferCount(), 2u);
+
+    m_pAllocator->Retire(1);
+    EXPECT_EQ(m_pAllocator->GetDedicatedBufferCount(), 2u);
+
+    // 对应的提交完成后，下一次分配时释放
+    m_pFence->Signal(1);
+    Renderer::FStagingBuffer d = m_pAllocator->Allocate(64);
+    EXPECT_EQ(d.Buffer, m_pAllocator->GetRingBuffer());
+    EXPECT_EQ(m_pAllocator->GetDedicatedBufferCount(), 0u);
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include "AssetManager/TextureCompressor.hpp"
+
+#include <EASTL/algorithm.h>
+
+#include <cmath>
+
+namespace
+{
+    using namespace Assets;
+
+    // 平滑渐变叠加固定种子的噪声，接近真实材质纹理的频率分布
+    eastl::vector<uint8_t> MakeTestImage(uint32_t width, uint32_t height, bool withAlpha)
+    {
+        eastl::vector<uint8_t> image(width * height * 4);
+        uint32_t seed = 12345;
+        for (uint32_t y = 0; y < height; y++)
+        {
+            for (uint32_t x = 0; x < width; x++)
+            {
+                seed = seed * 1664525u + 1013904223u;
+                int noise = (int)((seed >> 24) & 15) - 8;
+                uint8_t* pixel = &image[(y * width + x) * 4];
+                pixel[0] = (uint8_t)eastl::clamp((int)(x * 4) + noise, 0, 255);
+                pixel[1] = (uint8_t)eastl::clamp((int)(y * 4) - noise, 0, 255);
+                pixel[2] = (uint8_t)eastl::clamp((int)(128 + 100 * sinf(x * 0.1f + y * 0.05f)) + noise, 0, 255);
+                pixel[3] = withAlpha ? (uint8_t)eastl::clamp((int)(x + y) * 2, 0, 255) : 255;
+            }
+        }
+        return image;
+    }
+
+    float ComputePSNR(const eastl::vector<uint8_t>& a, const eastl::vector<uint8_t>& b, uint32_t channelMask)
+    {
+        double sum = 0.0;
+        uint32_t count = 0;
+        for (size_t i = 0; i < a.size(); i++)
+        {
+            if ((channelMask & (1 << (i % 4))) == 0)
+            {
+                continue;
+            }
+            double d = (double)a[i] - (double)b[i];
+            sum += d * d;
+            count++;
+        }
+        double mse = sum / count;
+        return mse == 0.0 ? 100.0f : (float)(10.0 * log10(255.0 * 255.0 / mse));
+    }
+
+    float RoundTripPSNR(RHI::ERHIFormat format, uint32_t channelMask, bool withAlpha, uint32_t width = 64, uint32_t height = 64)
+    {
+        eastl::vector<uint8_t> image = MakeTestImage(width, height, withAlpha);
+        eastl::vector<uint8_t> compressed;
+        EXPECT_TRUE(CompressTexture(image.data(), width, height, format, compressed));
+        EXPECT_EQ(compressed.size(), GetCompressedSize(format, width, height));
+
+        eastl::vector<uint8_t> decoded;
+        EXPECT_TRUE(DecompressTexture(compressed.data(), width, height, format, decoded));
+        return ComputePSNR(image, decoded, channelMask);
+    }
+}
+
+TEST(TextureCompressorTest, SelectFormatByRole)
+{
+    EXPECT_EQ(SelectCompressedFormat(ETextureRole::Generic, true, false), RHI::ERHIFormat::Unknown);
+    EXPECT_EQ(SelectCompressedFormat(ETextureRole::Albedo, true, false), RHI::ERHIFormat::BC1SRGB);
+    EXPECT_EQ(SelectCompressedFormat(ETextureRole::Albedo, true, true), RHI::ERHIFormat::BC3SRGB);
+    EXPECT_EQ(SelectCompressedFormat(ETextureRole::Normal, false, false), RHI::ERHIFormat::BC5UNORM);
+    EXPECT_EQ(SelectCompressedFormat(ETextureRole::RoughnessMetallic, false, false), RHI::ERHIFormat::BC7UNORM);
+    EXPECT_EQ(SelectCompressedFormat(ETextureRole::Occlusion, false, false), RHI::ERHIFormat::BC4UNORM);
+}
+
+TEST(TextureCompressorTest, RoundTripQuality)
+{
+    EXPECT_GT(RoundTripPSNR(RHI::ERHIFormat::BC1UNORM, 0x7, false), 33.0f);
+    EXPECT_GT(RoundTripPSNR(RHI::ERHIFormat::BC3UNORM, 0xF, true), 34.0f);
+    EXPECT_GT(RoundTripPSNR(RHI::ERHIFormat::BC4UNORM, 0x1, false), 46.0f);
+    EXPECT_GT(RoundTripPSNR(RHI::ERHIFormat::BC5UNORM, 0x3, false), 46.0f);
+    EXPECT_GT(RoundTripPSNR(RHI::ERHIFormat::BC7UNORM, 0xF, true), 35.0f);
+}
+
+TEST(TextureCompressorTest, PartialEdgeBlocks)
+{
+    EXPECT_GT(RoundTripPSNR(RHI::ERHIFormat::BC1UNORM, 0x7, false, 13, 7), 33.0f);
+    EXPECT_GT(RoundTripPSNR(RHI::ERHIFormat::BC7UNORM, 0xF, true, 5, 3), 38.0f);
+}
+
+TEST(TextureCompressorTest, ConstantBlockIsExact)
+{
+    // 565 可精确表示且各分量为奇数，BC7 mode 6 的 p-bit 也能精确还原
+    const uint8_t color[4] = { 255, 69, 41, 255 };
+    eastl::vector<uint8_t> image;
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        image.insert(image.end(), color, color + 4);
+    }
+
+    const RHI::ERHIFormat formats[] = { RHI::ERHIFormat::BC1UNORM, RHI::ERHIFormat::BC3UNORM, RHI::ERHIFormat::BC4UNORM, RHI::ERHIFormat::BC5UNORM, RHI::ERHIFormat::BC7UNORM };
+    const uint32_t masks[] = { 0x7, 0xF, 0x1, 0x3, 0xF };
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        eastl::vector<uint8_t> compressed, decoded;
+        ASSERT_TRUE(CompressTexture(image.data(), 4, 4, formats[i], compressed));
+        ASSERT_TRUE(DecompressTexture(compressed.data(), 4, 4, formats[i], decoded));
+        EXPECT_EQ(ComputePSNR(image, decoded, masks[i]), 100.0f) << "format index " << i;
+    }
+}
+
+TEST(TextureCompressorTest, Deterministic)
+{
+    eastl::vector<uint8_t> image = MakeTestImage(32, 32, true);
+    for (RHI::ERHIFormat format : { RHI::ERHIFormat::BC1UNORM, RHI::ERHIFormat::BC3UNORM, RHI::ERHIFormat::BC5UNORM, RHI::ERHIFormat::BC7UNORM })
+    {
+        eastl::vector<uint8_t> first, second;
+        CompressTexture(image.data(), 32, 32, format, first);
+        CompressTexture(image.data(), 32, 32, format, second);
+        EXPECT_EQ(first, second);
+    }
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include "AssetManager/TextureLoader.hpp"
+
+#include <EASTL/algorithm.h>
+#include <EASTL/vector.h>
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+    using namespace Assets;
+
+    // 未压缩的 32 位 TGA，像素从左上角开始按 RGBA 传入
+    eastl::string WriteTGA(const char* name, uint32_t width, uint32_t height, const eastl::vector<uint8_t>& rgba)
+    {
+        std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+
+        uint8_t header[18] = {};
+        header[2] = 2;
+        header[12] = (uint8_t)(width & 0xFF);
+        header[13] = (uint8_t)(width >> 8);
+        header[14] = (uint8_t)(height & 0xFF);
+        header[15] = (uint8_t)(height >> 8);
+        header[16] = 32;
+        header[17] = 0x28;
+
+        std::ofstream file(path, std::ios::binary);
+        file.write((const char*)header, sizeof(header));
+        for (uint32_t i = 0; i < width * height; i++)
+        {
+            const uint8_t bgra[4] = { rgba[i * 4 + 2], rgba[i * 4 + 1], rgba[i * 4 + 0], rgba[i * 4 + 3] };
+            file.write((const char*)bgra, sizeof(bgra));
+        }
+        return path.string().c_str();
+    }
+
+    // 相邻两列分别为黑和白，缩小一级后每个像素是两者的平均
+    eastl::vector<uint8_t> MakeStripes(uint32_t width, uint32_t height)
+    {
+        eastl::vector<uint8_t> image(width * height * 4);
+        for (uint32_t y = 0; y < height; y++)
+        {
+            for (uint32_t x = 0; x < width; x++)
+            {
+                uint8_t value = (x % 2) ? 255 : 0;
+                uint8_t* pixel = &image[(y * width + x) * 4];
+                pixel[0] = pixel[1] = pixel[2] = value;
+                pixel[3] = 255;
+            }
+        }
+        return image;
+    }
+
+    const uint8_t* GetMip(const FTextureLoader& loader, uint32_t mip)
+    {
+        const uint8_t* data = (const uint8_t*)loader.GetData();
+        for (uint32_t i = 0; i < mip; i++)
+        {
+            data += eastl::max(loader.GetWidth() >> i, 1u) * eastl::max(loader.GetHeight() >> i, 1u) * 4;
+        }
+        return data;
+    }
+}
+
+TEST(TextureLoaderTest, MipChainOfNonPowerOfTwoImageIsComplete)
+{
+    eastl::string file = WriteTGA("VultanaMipChain.tga", 7, 5, MakeStripes(7, 5));
+
+    FTextureLoader loader;
+    ASSERT_TRUE(loader.Load(file, false));
+
+    // 7x5 -> 3x2 -> 1x1
+    EXPECT_EQ(loader.GetWidth(), 7u);
+    EXPECT_EQ(loader.GetHeight(), 5u);
+    EXPECT_EQ(loader.GetMipLevels(), 3u);
+    EXPECT_EQ(loader.GetDataSize(), (7u * 5u + 3u * 2u + 1u * 1u) * 4u);
+
+    std::filesystem::remove(file.c_str());
+}
+
+TEST(TextureLoaderTest, SRGBMipsAverageInLinearSpace)
+{
+    eastl::string file = WriteTGA("VultanaMipSRGB.tga", 8, 8, MakeStripes(8, 8));
+
+    FTextureLoader srgbLoader;
+    ASSERT_TRUE(srgbLoader.Load(file, true));
+    ASSERT_EQ(srgbLoader.GetFormat(), RHI::ERHIFormat::RGBA8SRGB);
+
+    FTextureLoader linearLoader;
+    ASSERT_TRUE(linearLoader.Load(file, false));
+    ASSERT_EQ(linearLoader.GetFormat(), RHI::ERHIFormat::RGBA8UNORM);
+
+    // 线性空间的 0.5 编码为 sRGB 约为 188，直接平均编码值则为 128
+    const uint8_t* srgbMip = GetMip(srgbLoader, 1);
+    const uint8_t* linearMip = GetMip(linearLoader, 1);
+    for (uint32_t i = 0; i < 4 * 4; i++)
+    {
+        EXPECT_NEAR(srgbMip[i * 4 + 0], 188, 2);
+        EXPECT_NEAR(linearMip[i * 4 + 0], 128, 2);
+        EXPECT_EQ(srgbMip[i * 4 + 3], 255);
+    }
+
+    std::filesystem::remove(file.c_str());
+}
+
+TEST(TextureLoaderTest, NormalMapMipsAreRenormalized)
+{
+    // 交替向左、向右倾斜的法线，直接平均后长度只有 0.8
+    const uint32_t width = 6;
+    const uint32_t height = 6;
+    eastl::vector<uint8_t> image(width * height * 4);
+    for (uint32_t y = 0; y < height; y++)
+    {
+        for (uint32_t x = 0; x < width; x++)
+        {
+            uint8_t* pixel = &image[(y * width + x) * 4];
+            pixel[0] = (x % 2) ? 51 : 204;
+            pixel[1] = 128;
+            pixel[2] = 230;
+            pixel[3] = 255;
+        }
+    }
+    // 尺寸不是 4 的倍数，不会压缩成 BC5，可以直接检查 mip 数据
+    eastl::string file = WriteTGA("VultanaMipNormal.tga", width, height, image);
+
+    FTextureLoader loader;
+    ASSERT_TRUE(loader.Load(file, true, ETextureRole::Normal));
+    ASSERT_EQ(loader.GetFormat(), RHI::ERHIFormat::RGBA8UNORM);
+    ASSERT_EQ(loader.GetMipLevels(), 3u);
+
+    for (uint32_t mip = 1; mip < loader.GetMipLevels(); mip++)
+    {
+        const uint8_t* data = GetMip(loader, mip);
+        const uint32_t pixelCount = eastl::max(width >> mip, 1u) * eastl::max(height >> mip, 1u);
+        for (uint32_t i = 0; i < pixelCount; i++)
+        {
+            float nx = data[i * 4 + 0] / 255.0f * 2.0f - 1.0f;
+            float ny = data[i * 4 + 1] / 255.0f * 2.0f - 1.0f;
+            float nz = data[i * 4 + 2] / 255.0f * 2.0f - 1.0f;
+            EXPECT_NEAR(sqrtf(nx * nx + ny * ny + nz * nz), 1.0f, 0.02f) << "mip " << mip << " pixel " << i;
+        }
+    }
+
+    std::filesystem::remove(file.c_str());
+    std::filesystem::remove((file + ".bc").c_str());
+}